@@ -3,7 +3,6 @@
 #include <time.h>
 #include <gnl_fss_api.h>
 #include <gnl_queue_t.h>
-#include <gnl_file_saver.h>
 #include <gnl_print_table.h>
 #include "./gnl_opt_rts.c"
 #include "../include/gnl_opt_arg.h"
@@ -249,12 +248,16 @@ static int gnl_opt_arg_read_file(const char *filename, const char *store_dirname
 
     // read the file
     void *buf = NULL;
-    size_t size;
+    size_t size = 0;
 
     // wait if we have to
     wait_milliseconds();
 
-    int res_read = gnl_fss_api_read_file(filename, &buf, &size);
+    // if the file has to be stored, then it is written on disk
+    // while it is received
+    int res_read = store_dirname != NULL
+            ? gnl_fss_api_read_file_to(filename, store_dirname, &size)
+            : gnl_fss_api_read_file(filename, &buf, &size);
     int errno_read = errno;
 
     print_log("Read file", filename, res_read, "%d bytes read", size);
@@ -270,19 +273,11 @@ static int gnl_opt_arg_read_file(const char *filename, const char *store_dirname
 
     print_log("Close file", filename, res_close, NULL);
 
-    // check first if there was an error during the read
-    GNL_MINUS1_CHECK(res_read, errno_read, -1);
-
-    // store the read file on disk
-    if (store_dirname != NULL) {
-        res = gnl_file_saver_save(filename, store_dirname, buf, size);
-    }
-
     //free memory
     free(buf);
 
-    // check first if there was an error during the save
-    GNL_MINUS1_CHECK(res, errno, -1);
+    // check first if there was an error during the read
+    GNL_MINUS1_CHECK(res_read, errno_read, -1);
 
     // check if there was an error during the close_file
     GNL_MINUS1_CHECK(res_close, errno_close, -1);
@@ -7,8 +7,12 @@
  */
 struct gnl_huffman_tree_t {
 
-    // the bytes dictionary
-    char **dictionary;
+    // the canonical code of each byte, right aligned
+    unsigned int codes[256];
+
+    // the code length in bits of each byte,
+    // 0 if the byte is not present
+    unsigned char lengths[256];
 
     // the root node of the tree
     struct gnl_huffman_tree_node_t *root;
@@ -46,6 +50,8 @@ extern void gnl_huffman_tree_destroy_artifact(struct gnl_huffman_tree_artifact *
 
 /**
  * Encode the given bytes using the Huffman data compression algorithm.
+ * The codes are canonical, so the artifact stores only the code length
+ * of each byte and not the tree.
  *
  * @param bytes The bytes to encode.
  * @param count The number of bytes to encode.
@@ -68,11 +74,31 @@ extern struct gnl_huffman_tree_artifact *gnl_huffman_tree_encode(const void *byt
 extern int gnl_huffman_tree_decode(struct gnl_huffman_tree_artifact *artifact, void **bytes, size_t *count);
 
 /**
- * Get the size of the given artifact.
+ * Decode up to count bytes of the given artifact directly into dest. Unlike
+ * gnl_huffman_tree_decode, the artifact is not modified nor destroyed, so it
+ * can be decoded any number of times, also concurrently. The decoding tables
+ * are built on the first call and reused by the next ones.
+ *
+ * @param artifact  The artifact to use for decoding. It is returned from the
+ *                  encoding call.
+ * @param dest      The destination where to put the decoded bytes, it must
+ *                  be at least count bytes long.
+ * @param count     The maximum number of bytes to decode.
+ *
+ * @return          Returns the number of bytes decoded on success,
+ *                  -1 otherwise.
+ */
+extern int gnl_huffman_tree_decode_into(const struct gnl_huffman_tree_artifact *artifact, void *dest, size_t count);
+
+/**
+ * Get the stored size of the given artifact: the size of the code plus
+ * the size of the artifact itself, which holds the code lengths table
+ * needed to decode. The decoding tables built on the first decode are
+ * a cache and they are not counted.
  *
  * @param artifact  The artifact of which get the size.
  *
- * @return          The size of the given artifact on success,
+ * @return          The stored size of the given artifact on success,
  *                  -1 otherwise.
  */
 extern int gnl_huffman_tree_size(struct gnl_huffman_tree_artifact *artifact);
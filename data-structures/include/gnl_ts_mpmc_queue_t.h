@@ -0,0 +1,63 @@
+#ifndef GNL_TS_MPMC_QUEUE_H
+#define GNL_TS_MPMC_QUEUE_H
+
+/**
+ * Holds the thread-safe blocking bounded multi-producer multi-consumer queue information.
+ */
+struct gnl_ts_mpmc_queue_t;
+
+/**
+ * Create a new thread-safe blocking bounded multi-producer multi-consumer
+ * queue of ints. The elements are stored inline into an array, whose size
+ * is the bound rounded up to the next power of two.
+ *
+ * @param bound The min number of elements storable in the queue.
+ *
+ * @return      Returns the new queue created on success,
+ *              NULL otherwise.
+ */
+extern struct gnl_ts_mpmc_queue_t *gnl_ts_mpmc_queue_init(unsigned long bound);
+
+/**
+ * Destroy a thread-safe blocking bounded multi-producer multi-consumer queue.
+ * This is not an atomic operation! Call this method only in
+ * a main thread where you are sure there are not other threads
+ * using the queue q.
+ *
+ * @param q The queue to be destroyed.
+ */
+extern void gnl_ts_mpmc_queue_destroy(struct gnl_ts_mpmc_queue_t *q);
+
+/**
+ * Put an element "el" into the queue "q". If the queue is full,
+ * wait until there is a room.
+ *
+ * @param q     The queue where to enqueue the element.
+ * @param el    The element.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_ts_mpmc_queue_enqueue(struct gnl_ts_mpmc_queue_t *q, int el);
+
+/**
+ * Delete an element from the queue "q" and put it into "el".
+ * If the queue is empty, wait until there is an element.
+ *
+ * @param q     The queue from where to dequeue the element.
+ * @param el    The pointer where to put the element.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_ts_mpmc_queue_dequeue(struct gnl_ts_mpmc_queue_t *q, int *el);
+
+/**
+ * Return the size of the queue "q". The size is only a snapshot,
+ * other threads may change it at any time.
+ *
+ * @param q The queue from where to get the size.
+ *
+ * @return  Returns the queue size.
+ */
+extern unsigned long gnl_ts_mpmc_queue_size(struct gnl_ts_mpmc_queue_t *q);
+
+#endif //GNL_TS_MPMC_QUEUE_H
@@ -0,0 +1,65 @@
+#ifndef GNL_TS_MPSC_RING_H
+#define GNL_TS_MPSC_RING_H
+
+/**
+ * Holds the thread-safe lock-free multi-producer single-consumer ring information.
+ */
+struct gnl_ts_mpsc_ring_t;
+
+/**
+ * Create a new thread-safe lock-free multi-producer single-consumer
+ * ring of ints. The capacity of the ring is the bound rounded up to
+ * the next power of two.
+ *
+ * @param bound The min number of elements storable in the ring.
+ *
+ * @return      Returns the new ring created on success,
+ *              NULL otherwise.
+ */
+extern struct gnl_ts_mpsc_ring_t *gnl_ts_mpsc_ring_init(unsigned long bound);
+
+/**
+ * Destroy a thread-safe lock-free multi-producer single-consumer ring.
+ * This is not an atomic operation! Call this method only in
+ * a main thread where you are sure there are not other threads
+ * using the ring.
+ *
+ * @param ring  The ring to be destroyed.
+ */
+extern void gnl_ts_mpsc_ring_destroy(struct gnl_ts_mpsc_ring_t *ring);
+
+/**
+ * Put an element "el" into the ring "ring". Any number of threads
+ * can push at the same time.
+ *
+ * @param ring  The ring where to push the element.
+ * @param el    The element.
+ *
+ * @return      Returns 0 on success, -1 otherwise. If the ring
+ *              is full, errno is set to EAGAIN.
+ */
+extern int gnl_ts_mpsc_ring_push(struct gnl_ts_mpsc_ring_t *ring, int el);
+
+/**
+ * Delete an element from the ring "ring" and put it into "el".
+ * Only one thread per time can pop.
+ *
+ * @param ring  The ring from where to pop the element.
+ * @param el    The pointer where to put the element.
+ *
+ * @return      Returns 0 on success, -1 otherwise. If the ring
+ *              is empty, errno is set to EAGAIN.
+ */
+extern int gnl_ts_mpsc_ring_pop(struct gnl_ts_mpsc_ring_t *ring, int *el);
+
+/**
+ * Return the capacity of the ring "ring".
+ *
+ * @param ring  The ring from where to get the capacity.
+ *
+ * @return      Returns the ring capacity on success,
+ *              0 otherwise.
+ */
+extern unsigned long gnl_ts_mpsc_ring_capacity(struct gnl_ts_mpsc_ring_t *ring);
+
+#endif //GNL_TS_MPSC_RING_H
@@ -1,9 +1,19 @@
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <pthread.h>
 #include "../include/gnl_huffman_tree.h"
 #include "./gnl_min_heap_t.c"
 #include <gnl_macro_beg.h>
 
+// the maximum length in bits of a code, the frequencies are
+// scaled down until the tree fits within this depth
+#define GNL_HUFFMAN_TREE_MAX_CODE_LEN 32
+
+// the number of bits resolved by a single lookup
+// into the decoding table
+#define GNL_HUFFMAN_TREE_LOOKUP_BITS 11
+
 /**
  * The node structure of the huffman tree.
  */
@@ -27,17 +37,55 @@ struct gnl_huffman_tree_node_t {
  */
 struct gnl_huffman_tree_artifact {
 
-    // the root node of the tree
-    struct gnl_huffman_tree_node_t *root;
+    // the code length in bits of each byte, the canonical
+    // codes are rebuilt from the lengths only
+    unsigned char lengths[256];
+
+    // the number of decoded bytes
+    size_t count;
 
-    // the number of elements into the code array
+    // the number of bytes of the code array
     size_t size;
 
     // the number of bits set into the code array
     size_t bit_count;
 
-    // the encoded series
-    int *code;
+    // the encoded series, most significant bit first
+    unsigned char *code;
+
+    // the decoding tables, built on the first decode and
+    // reused by the next ones, NULL until then
+    struct gnl_huffman_tree_decoder *decoder;
+
+    // the lock of the decoding tables build
+    pthread_mutex_t mtx;
+};
+
+/**
+ * The canonical decoding tables of an artifact.
+ */
+struct gnl_huffman_tree_decoder {
+
+    // the lookup table indexed by the next GNL_HUFFMAN_TREE_LOOKUP_BITS
+    // bits of the code: every entry holds the decoded byte in the
+    // high bits and the code length in the low 4 bits, or 0 if
+    // the code is longer than GNL_HUFFMAN_TREE_LOOKUP_BITS
+    unsigned short lookup[1 << GNL_HUFFMAN_TREE_LOOKUP_BITS];
+
+    // the first canonical code of each length
+    unsigned int first_code[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1];
+
+    // the number of codes of each length
+    unsigned int length_count[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1];
+
+    // the index into symbols of the first code of each length
+    unsigned int first_index[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1];
+
+    // the bytes sorted by code length and by value
+    unsigned char symbols[256];
+
+    // the maximum code length
+    int max_length;
 };
 
 /**
@@ -224,107 +272,157 @@ static int tree_depth(struct gnl_huffman_tree_node_t *node) {
 }
 
 /**
- * Recursively create a dictionary for the given tree node.
+ * Recursively assign to each leaf of the sub-tree of the given
+ * node its code length, that is the depth of the leaf.
  *
- * @param node          The node to use to start.
- * @param dictionary    The pointer where to store the dictionary.
- * @param code          The code of the current node. It is filled during
- *                      the recursive calls.
- * @param index         The current index of the code char array. It is
- *                      assigned during the recursive calls.
- *
- * @return              Returns 0 on success, -1 otherwise.
+ * @param node      The node to use to start.
+ * @param lengths   The array where to store the code lengths.
+ * @param depth     The depth of the given node.
  */
-static int create_dictionary_recursive(struct gnl_huffman_tree_node_t *node, char **dictionary, unsigned char *code, int index) {
-    // validate parameters
-    GNL_NULL_CHECK(node, EINVAL, -1)
-    GNL_NULL_CHECK(dictionary, EINVAL, -1)
-    GNL_NULL_CHECK(code, EINVAL, -1)
-
-    int res;
+static void assign_lengths(struct gnl_huffman_tree_node_t *node, unsigned char *lengths, int depth) {
+    if (node == NULL) {
+        return;
+    }
 
-    // check the left node
-    if (node->left != NULL) {
-        code[index] = '0';
+    if (is_leaf(node)) {
+        // a tree of a single byte still needs 1 bit per code
+        lengths[(int)node->byte] = depth > 0 ? depth : 1;
 
-        // repeat on the sub-tree
-        res = create_dictionary_recursive(node->left, dictionary, code, index + 1);
-        GNL_MINUS1_CHECK(res, errno, -1)
+        return;
     }
 
-    // check the right node
-    if (node->right != NULL) {
-        code[index] = '1';
+    assign_lengths(node->left, lengths, depth + 1);
+    assign_lengths(node->right, lengths, depth + 1);
+}
 
-        // repeat on the sub-tree
-        res = create_dictionary_recursive(node->right, dictionary, code, index + 1);
-        GNL_MINUS1_CHECK(res, errno, -1)
-    }
+/**
+ * Assign the canonical codes to the given code lengths: the codes of
+ * the same length are consecutive integers assigned in byte order, and
+ * each length starts right after the codes of the shorter lengths.
+ *
+ * @param lengths   The code length of each byte.
+ * @param codes     The array where to store the code of each byte.
+ */
+static void assign_canonical_codes(const unsigned char *lengths, unsigned int *codes) {
+    unsigned int length_count[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1] = {0};
+    unsigned int next_code[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1] = {0};
 
-    // if the node is a leaf
-    if (is_leaf(node)) {
-        // allocate memory for the dictionary
-        dictionary[(int)node->byte] = calloc(index+1, (sizeof(char)));
-        GNL_NULL_CHECK(dictionary[(int)node->byte], ENOMEM, -1)
+    // count the codes of each length
+    for (size_t i=0; i<256; i++) {
+        length_count[lengths[i]]++;
+    }
 
-        // assign the code to the byte into the dictionary
-        for (size_t i=0; i<index; i++) {
-            dictionary[(int)node->byte][i] = code[i];
-        }
+    length_count[0] = 0;
 
-        // close the code
-        dictionary[(int)node->byte][index] = '\0';
+    // calculate the first code of each length
+    unsigned int code = 0;
+    for (size_t len=1; len<=GNL_HUFFMAN_TREE_MAX_CODE_LEN; len++) {
+        code = (code + length_count[len - 1]) << 1;
+        next_code[len] = code;
     }
 
-    return 0;
+    // assign the codes
+    for (size_t i=0; i<256; i++) {
+        codes[i] = lengths[i] > 0 ? next_code[lengths[i]]++ : 0;
+    }
 }
 
 /**
- * Create a dictionary for the given tree.
- *
- * @param tree  The huffman tree to use.
+ * Build the decoding tables for the given code lengths.
  *
- * @return      Returns 0 on success, -1 otherwise.
+ * @param lengths   The code length of each byte.
+ * @param decoder   The decoder to build.
  */
-static int create_dictionary(struct gnl_huffman_tree_t *tree) {
-    // validate parameters
-    GNL_NULL_CHECK(tree, EINVAL, -1)
+static void build_decoder(const unsigned char *lengths, struct gnl_huffman_tree_decoder *decoder) {
+    unsigned int codes[256];
+    assign_canonical_codes(lengths, codes);
 
-    // allocate memory
-    tree->dictionary = (char **)calloc(256, sizeof(char *));
-    GNL_NULL_CHECK(tree->dictionary, ENOMEM, -1)
+    memset(decoder->lookup, 0, sizeof(decoder->lookup));
+    memset(decoder->length_count, 0, sizeof(decoder->length_count));
+    decoder->max_length = 0;
 
-    // get the tree depth
-    int depth = tree_depth(tree->root);
+    // count the codes of each length
+    for (size_t i=0; i<256; i++) {
+        if (lengths[i] > 0) {
+            decoder->length_count[lengths[i]]++;
 
-    // allocate memory for the code
-    unsigned char *code = malloc(depth * sizeof(unsigned char));
-    GNL_NULL_CHECK(code, ENOMEM, -1)
+            if (lengths[i] > decoder->max_length) {
+                decoder->max_length = lengths[i];
+            }
+        }
+    }
 
-    create_dictionary_recursive(tree->root, tree->dictionary, code, 0);
+    // calculate the first code and the first symbol index of each length
+    unsigned int code = 0;
+    unsigned int index = 0;
+    decoder->first_code[0] = 0;
+    decoder->first_index[0] = 0;
+    for (size_t len=1; len<=GNL_HUFFMAN_TREE_MAX_CODE_LEN; len++) {
+        code = (code + decoder->length_count[len - 1]) << 1;
+        decoder->first_code[len] = code;
+        decoder->first_index[len] = index;
+        index += decoder->length_count[len];
+    }
 
-    // free memory
-    free(code);
+    // sort the bytes by code length, the bytes with
+    // the same length are already in byte order
+    unsigned int next_index[GNL_HUFFMAN_TREE_MAX_CODE_LEN + 1];
+    memcpy(next_index, decoder->first_index, sizeof(next_index));
+    for (size_t i=0; i<256; i++) {
+        if (lengths[i] > 0) {
+            decoder->symbols[next_index[lengths[i]]++] = i;
+        }
+    }
+
+    // fill the lookup table with the short codes: a code of length len
+    // fills all the entries having the code as prefix
+    for (size_t i=0; i<256; i++) {
+        int len = lengths[i];
+
+        if (len == 0 || len > GNL_HUFFMAN_TREE_LOOKUP_BITS) {
+            continue;
+        }
+
+        unsigned int first = codes[i] << (GNL_HUFFMAN_TREE_LOOKUP_BITS - len);
+        unsigned int last = first + (1 << (GNL_HUFFMAN_TREE_LOOKUP_BITS - len));
 
-    return 0;
+        for (unsigned int j=first; j<last; j++) {
+            decoder->lookup[j] = (unsigned short)((i << 4) | len);
+        }
+    }
 }
 
 /**
- * Destroy the given huffman tree but preserve his nodes.
+ * Get the decoding tables of the given artifact, building them on the
+ * first call. The tables are a cache derived from the code lengths, so
+ * building them does not change the content of the artifact.
+ *
+ * @param artifact  The artifact of which get the decoding tables.
  *
- * @param tree  The tree to destroy.
+ * @return          Returns the decoding tables on success,
+ *                  NULL otherwise.
  */
-static void destroy_tree_safe(struct gnl_huffman_tree_t *tree) {
-    if (tree == NULL) {
-        return;
-    }
+static const struct gnl_huffman_tree_decoder *get_decoder(const struct gnl_huffman_tree_artifact *artifact) {
+    struct gnl_huffman_tree_artifact *cache = (struct gnl_huffman_tree_artifact *)artifact;
 
-    for (size_t i=0; i<256; i++) {
-        free(tree->dictionary[i]);
+    int res = pthread_mutex_lock(&(cache->mtx));
+    GNL_MINUS1_CHECK(-1 * (res != 0), res, NULL)
+
+    if (cache->decoder == NULL) {
+        cache->decoder = (struct gnl_huffman_tree_decoder *)malloc(sizeof(struct gnl_huffman_tree_decoder));
+
+        if (cache->decoder != NULL) {
+            build_decoder(cache->lengths, cache->decoder);
+        }
     }
 
-    free(tree->dictionary);
-    free(tree);
+    struct gnl_huffman_tree_decoder *decoder = cache->decoder;
+
+    pthread_mutex_unlock(&(cache->mtx));
+
+    GNL_NULL_CHECK(decoder, ENOMEM, NULL)
+
+    return decoder;
 }
 
 /**
@@ -336,24 +434,57 @@ struct gnl_huffman_tree_t *gnl_huffman_tree_init(const void *bytes, size_t count
 
     // calculate the frequencies
     int *freq = calculate_frequencies(bytes, count);
+    GNL_NULL_CHECK(freq, errno, NULL)
 
-    // create the mean heap
-    struct gnl_min_heap_t *min_heap = create_min_heap(freq);
-    GNL_NULL_CHECK(min_heap, errno, NULL)
+    struct gnl_huffman_tree_t *tree;
 
-    // free memory
-    free(freq);
+    while (1) {
+        // create the min heap
+        struct gnl_min_heap_t *min_heap = create_min_heap(freq);
+        if (min_heap == NULL) {
+            free(freq);
 
-    // build the tree
-    struct gnl_huffman_tree_t *tree = create_tree(min_heap);
-    GNL_NULL_CHECK(tree, errno, NULL)
+            // let the errno bubble
+            return NULL;
+        }
+
+        // build the tree
+        tree = create_tree(min_heap);
+
+        // free memory
+        gnl_min_heap_destroy(min_heap, NULL);
+
+        if (tree == NULL) {
+            free(freq);
+
+            // let the errno bubble
+            return NULL;
+        }
+
+        // the depth of the root is 1, so the
+        // longest code is 1 bit shorter
+        if (tree_depth(tree->root) - 1 <= GNL_HUFFMAN_TREE_MAX_CODE_LEN) {
+            break;
+        }
+
+        // the tree is too deep: flatten the frequencies
+        // and build it again
+        gnl_huffman_tree_destroy(tree);
+
+        for (size_t i=0; i<256; i++) {
+            if (freq[i] > 0) {
+                freq[i] = (freq[i] + 1) / 2;
+            }
+        }
+    }
 
     // free memory
-    gnl_min_heap_destroy(min_heap, NULL);
+    free(freq);
 
-    // assign codes
-    int res = create_dictionary(tree);
-    GNL_MINUS1_CHECK(res, errno, NULL)
+    // assign the canonical codes
+    memset(tree->lengths, 0, sizeof(tree->lengths));
+    assign_lengths(tree->root, tree->lengths, 0);
+    assign_canonical_codes(tree->lengths, tree->codes);
 
     return tree;
 }
@@ -367,7 +498,7 @@ void gnl_huffman_tree_destroy(struct gnl_huffman_tree_t *tree) {
     }
 
     destroy_node(tree->root);
-    destroy_tree_safe(tree);
+    free(tree);
 }
 
 /**
@@ -379,7 +510,8 @@ void gnl_huffman_tree_destroy_artifact(struct gnl_huffman_tree_artifact *artifac
     }
 
     free(artifact->code);
-    destroy_node(artifact->root);
+    free(artifact->decoder);
+    pthread_mutex_destroy(&(artifact->mtx));
     free(artifact);
 }
 
@@ -390,71 +522,87 @@ struct gnl_huffman_tree_artifact *gnl_huffman_tree_encode(const void *bytes, siz
     // validate parameters
     GNL_NULL_CHECK(bytes, EINVAL, NULL)
 
-    // allocate memory
-    struct gnl_huffman_tree_artifact *artifact = (struct gnl_huffman_tree_artifact *)malloc(sizeof(struct gnl_huffman_tree_artifact));
-    GNL_NULL_CHECK(artifact, errno, NULL)
-
     struct gnl_huffman_tree_t *tree = gnl_huffman_tree_init(bytes, count);
     GNL_NULL_CHECK(tree, errno, NULL)
 
-    // initialize the destination
-    artifact->code = NULL;
-
-    // the current offset of the destination
-    int offset = 0;
-    int bit_count = 0;
-
-    // for each byte to encode
-    for (size_t i=0; i<count; i++) {
-
-        // get the single byte
-        unsigned char byte = *((unsigned char *)bytes + i);
-
-        // get the size of the byte code
-        int code_len = strlen(tree->dictionary[(int)byte]);
+    // allocate memory
+    struct gnl_huffman_tree_artifact *artifact = (struct gnl_huffman_tree_artifact *)malloc(sizeof(struct gnl_huffman_tree_artifact));
+    if (artifact == NULL) {
+        gnl_huffman_tree_destroy(tree);
+        errno = ENOMEM;
 
-        // for each code element of the current byte
-        for (size_t j=0; j<code_len; j++) {
+        return NULL;
+    }
 
-            // if we used all the 32 bits of an element,
-            // then allocate another element into the
-            // code array
-            if (bit_count % 32 == 0) {
+    const unsigned char *input = bytes;
 
-                // increase the offset
-                offset++;
+    // calculate the exact size of the code
+    size_t bit_count = 0;
+    for (size_t i=0; i<count; i++) {
+        bit_count += tree->lengths[input[i]];
+    }
 
-                // re-allocate memory
-                int *temp = realloc(artifact->code, (offset) * sizeof(int));
-                GNL_NULL_CHECK(temp, ENOMEM, NULL)
+    artifact->decoder = NULL;
+    if (pthread_mutex_init(&(artifact->mtx), NULL) != 0) {
+        gnl_huffman_tree_destroy(tree);
+        free(artifact);
 
-                artifact->code = temp;
+        return NULL;
+    }
 
-                // clear the bit array
-                artifact->code[offset - 1] = 0;
-            }
+    artifact->count = count;
+    artifact->bit_count = bit_count;
+    artifact->size = (bit_count + 7) / 8;
+    memcpy(artifact->lengths, tree->lengths, sizeof(artifact->lengths));
+
+    // allocate the code once
+    artifact->code = malloc(artifact->size > 0 ? artifact->size : 1);
+    if (artifact->code == NULL) {
+        gnl_huffman_tree_destroy(tree);
+        pthread_mutex_destroy(&(artifact->mtx));
+        free(artifact);
+        errno = ENOMEM;
+
+        return NULL;
+    }
 
-            // if the code element is equal to 0, then set the
-            // next bit to 0, otherwise set it to 1
-            if (tree->dictionary[(int)byte][j] == '0') {
-                GNL_CLEAR_BIT(artifact->code, bit_count);
-            } else {
-                GNL_SET_BIT(artifact->code, bit_count);
-            }
+    // the bit buffer: the pending bits are the
+    // nbits least significant bits of acc
+    uint64_t acc = 0;
+    int nbits = 0;
+    unsigned char *out = artifact->code;
 
-            // increase the bit index
-            bit_count++;
+    // for each byte to encode
+    for (size_t i=0; i<count; i++) {
+        // append the code of the byte, there are always less
+        // than 32 pending bits, so the buffer never overflows
+        acc = (acc << tree->lengths[input[i]]) | tree->codes[input[i]];
+        nbits += tree->lengths[input[i]];
+
+        // write 32 bits at a time
+        if (nbits >= 32) {
+            nbits -= 32;
+
+            uint32_t word = (uint32_t)(acc >> nbits);
+            out[0] = word >> 24;
+            out[1] = word >> 16;
+            out[2] = word >> 8;
+            out[3] = word;
+            out += 4;
         }
     }
 
-    // build the artifact
-    artifact->root = tree->root;
-    artifact->size = offset;
-    artifact->bit_count = bit_count;
+    // write the pending bits, the last byte is padded with zeros
+    while (nbits >= 8) {
+        nbits -= 8;
+        *out++ = (unsigned char)(acc >> nbits);
+    }
+
+    if (nbits > 0) {
+        *out = (unsigned char)(acc << (8 - nbits));
+    }
 
-    // destroy the tree but preserve his nodes
-    // for the artifact
-    destroy_tree_safe(tree);
+    gnl_huffman_tree_destroy(tree);
 
     return artifact;
 }
@@ -470,56 +618,108 @@ int gnl_huffman_tree_decode(struct gnl_huffman_tree_artifact *artifact, void **b
     *bytes = NULL;
     *count = 0;
 
-    // start from the root of the artifact huffman tree
-    struct gnl_huffman_tree_node_t *node = artifact->root;
+    // allocate the destination once
+    *bytes = malloc(artifact->count > 0 ? artifact->count : 1);
+    if (*bytes == NULL) {
+        gnl_huffman_tree_destroy_artifact(artifact);
+        errno = ENOMEM;
 
-    // for each byte of the code
-    for (size_t i=0; i<artifact->bit_count; i++) {
+        return -1;
+    }
 
-        // re-assign the current node based on
-        // the current bit of the code
-        if (GNL_TEST_BIT(artifact->code, i) == 0) {
-            node = node->left;
-        } else {
-            node = node->right;
+    int res = gnl_huffman_tree_decode_into(artifact, *bytes, artifact->count);
+
+    // if the decoding failed, then the
+    // given artifact or code is invalid
+    if (res == -1) {
+        free(*bytes);
+        *bytes = NULL;
+    } else {
+        *count = res;
+        res = 0;
+    }
+
+    // free memory
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_huffman_tree_decode_into(const struct gnl_huffman_tree_artifact *artifact, void *dest, size_t count) {
+    // validate parameters
+    GNL_NULL_CHECK(artifact, EINVAL, -1)
+    GNL_NULL_CHECK(dest, EINVAL, -1)
+
+    // do not decode more than the encoded bytes
+    if (count > artifact->count) {
+        count = artifact->count;
+    }
+
+    const struct gnl_huffman_tree_decoder *decoder = get_decoder(artifact);
+    GNL_NULL_CHECK(decoder, errno, -1)
+
+    // the bit buffer: the next bits to decode are the
+    // nbits least significant bits of acc, the bytes
+    // past the end of the code are read as zeros
+    uint64_t acc = 0;
+    int nbits = 0;
+    size_t pos = 0;
+    size_t consumed = 0;
+
+    unsigned char *output = dest;
+
+    for (size_t i=0; i<count; i++) {
+
+        // refill the buffer, so that it always contains
+        // at least a code of the maximum length
+        while (nbits <= 56) {
+            acc = (acc << 8) | (pos < artifact->size ? artifact->code[pos] : 0);
+            pos++;
+            nbits += 8;
         }
 
-        // if the node is a leaf, then it is time to decode
-        if (is_leaf(node)) {
-            // re-allocate memory for the destination
-            unsigned char *temp = realloc(*bytes, (*count + 1) * sizeof(unsigned char));
-            GNL_NULL_CHECK(temp, ENOMEM, -1)
+        // resolve the short codes with a single lookup
+        unsigned int peek = (unsigned int)(acc >> (nbits - GNL_HUFFMAN_TREE_LOOKUP_BITS)) & ((1 << GNL_HUFFMAN_TREE_LOOKUP_BITS) - 1);
+        unsigned short entry = decoder->lookup[peek];
+        int len = entry & 0xF;
 
-            // re-assign the pointer
-            *bytes = temp;
+        if (len > 0) {
+            output[i] = entry >> 4;
+        } else {
+            // resolve the long codes with the canonical first codes
+            for (len=GNL_HUFFMAN_TREE_LOOKUP_BITS + 1; len<=decoder->max_length; len++) {
+                unsigned int code = (unsigned int)(acc >> (nbits - len)) & (unsigned int)((1ULL << len) - 1);
+                unsigned int offset = code - decoder->first_code[len];
+
+                if (code >= decoder->first_code[len] && offset < decoder->length_count[len]) {
+                    output[i] = decoder->symbols[decoder->first_index[len] + offset];
+                    break;
+                }
+            }
 
-            // actual decode: assign the byte to the
-            // current destination offset and increase
-            // the number of bytes
-            ((unsigned char *)(*bytes))[(*count)++] = node->byte;
+            // no code matches the given bits
+            if (len > decoder->max_length) {
+                errno = EINVAL;
 
-            // reset the node
-            node = artifact->root;
+                return -1;
+            }
         }
-    }
 
-    // validate the decode
-    int res = 0;
+        nbits -= len;
+        consumed += len;
+    }
 
-    // if artifact->root != node, then the
-    // given artifact or code is invalid
-    if (artifact->root != node) {
+    // the code can not be shorter than the decoded bytes
+    if (consumed > artifact->bit_count) {
         errno = EINVAL;
-        free(*bytes);
-        *count = 0;
 
-        res = -1;
+        return -1;
     }
 
-    // free memory
-    gnl_huffman_tree_destroy_artifact(artifact);
-
-    return res;
+    return count;
 }
 
 /**
@@ -529,7 +729,12 @@ int gnl_huffman_tree_size(struct gnl_huffman_tree_artifact *artifact) {
     // validate parameters
     GNL_NULL_CHECK(artifact, EINVAL, -1)
 
-    return artifact->size;
+    // the code and the artifact itself, which holds the
+    // code lengths table needed to decode
+    return sizeof(struct gnl_huffman_tree_artifact) + artifact->size;
 }
 
-#include <gnl_macro_end.h>
\ No newline at end of file
+#undef GNL_HUFFMAN_TREE_MAX_CODE_LEN
+#undef GNL_HUFFMAN_TREE_LOOKUP_BITS
+
+#include <gnl_macro_end.h>
@@ -0,0 +1,317 @@
+/*
+ * This is a simple concurrent thead-safe blocking bounded multi-producer multi-consumer
+ * queue of ints, it does not intend to be exhaustive.
+ *
+ * The elements are stored inline into an array of cells, every cell holds a sequence
+ * number telling whose turn it is: a producer can fill the cell at position pos when
+ * its sequence is pos, a consumer can empty it when its sequence is pos + 1. Producers
+ * and consumers reserve a position with a compare and swap, so no lock is taken while
+ * the queue is neither full nor empty.
+ *
+ * A thread finding the queue full (empty) parks on a futex word, which is bumped by
+ * a consumer (producer) only if someone is parked, so the wake up syscall is paid
+ * only when it is needed.
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "../include/gnl_ts_mpmc_queue_t.h"
+#include <gnl_macro_beg.h>
+
+// the size of a cache line, to keep the producers and the consumers apart
+#define GNL_TS_MPMC_QUEUE_CACHE_LINE 64
+
+/**
+ * sequence The turn of the cell.
+ * el       The element stored into the cell.
+ */
+struct gnl_ts_mpmc_queue_cell {
+    unsigned long sequence;
+    int el;
+};
+
+/**
+ * cells                The cells of the queue.
+ * mask                 The capacity of the queue minus one.
+ * tail                 The next position to fill, shared by the producers.
+ * head                 The next position to empty, shared by the consumers.
+ * el_added             The futex word bumped when an element is added.
+ * el_removed           The futex word bumped when an element is removed.
+ * consumers_parked     The number of consumers parked on el_added, it may
+ *                      count more threads than the parked ones, never less.
+ * producers_parked     The number of producers parked on el_removed, it may
+ *                      count more threads than the parked ones, never less.
+ */
+struct gnl_ts_mpmc_queue_t {
+    struct gnl_ts_mpmc_queue_cell *cells;
+    unsigned long mask;
+    char pad_tail[GNL_TS_MPMC_QUEUE_CACHE_LINE];
+    unsigned long tail;
+    char pad_head[GNL_TS_MPMC_QUEUE_CACHE_LINE];
+    unsigned long head;
+    char pad_parking[GNL_TS_MPMC_QUEUE_CACHE_LINE];
+    unsigned int el_added;
+    unsigned int el_removed;
+    unsigned int consumers_parked;
+    unsigned int producers_parked;
+};
+
+/**
+ * Park the calling thread on the given futex word while it holds the given value.
+ *
+ * @param word  The futex word.
+ * @param value The value the futex word had when the queue was checked.
+ */
+static void futex_wait(unsigned int *word, unsigned int value) {
+    // a spurious wake up is harmless, the caller checks the queue again
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+}
+
+/**
+ * Bump the given futex word and wake up one of the threads parked on it,
+ * only if there is someone parked. The parked thread is taken off the count
+ * by the waker, so a thread woken but not running yet is not woken again.
+ *
+ * @param word      The futex word.
+ * @param parked    The number of threads parked on the futex word.
+ */
+static void futex_wake(unsigned int *word, unsigned int *parked) {
+    // the element published must be visible before checking the parked threads
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    unsigned int count = __atomic_load_n(parked, __ATOMIC_RELAXED);
+
+    do {
+        if (count == 0) {
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(parked, &count, count - 1, 1, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    __atomic_add_fetch(word, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+/**
+ * Try to put an element "el" into the queue "q" without waiting.
+ *
+ * @param q     The queue where to enqueue the element.
+ * @param el    The element.
+ *
+ * @return      Returns 0 on success, -1 if the queue is full.
+ */
+static int try_enqueue(struct gnl_ts_mpmc_queue_t *q, int el) {
+    struct gnl_ts_mpmc_queue_cell *cell;
+    unsigned long pos = __atomic_load_n(&(q->tail), __ATOMIC_RELAXED);
+    long diff;
+
+    for (;;) {
+        cell = &(q->cells[pos & q->mask]);
+        diff = (long)(__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) - pos);
+
+        // the cell is free, try to reserve it
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&(q->tail), &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            // on failure pos is updated with the current tail
+            continue;
+        }
+
+        // the cell still holds the element of the previous lap
+        if (diff < 0) {
+            return -1;
+        }
+
+        // another producer took the cell, retry
+        pos = __atomic_load_n(&(q->tail), __ATOMIC_RELAXED);
+    }
+
+    cell->el = el;
+
+    // publish the element to the consumers
+    __atomic_store_n(&(cell->sequence), pos + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/**
+ * Try to delete an element from the queue "q" without waiting.
+ *
+ * @param q     The queue from where to dequeue the element.
+ * @param el    The pointer where to put the element.
+ *
+ * @return      Returns 0 on success, -1 if the queue is empty.
+ */
+static int try_dequeue(struct gnl_ts_mpmc_queue_t *q, int *el) {
+    struct gnl_ts_mpmc_queue_cell *cell;
+    unsigned long pos = __atomic_load_n(&(q->head), __ATOMIC_RELAXED);
+    long diff;
+
+    for (;;) {
+        cell = &(q->cells[pos & q->mask]);
+        diff = (long)(__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) - (pos + 1));
+
+        // the cell is published, try to reserve it
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&(q->head), &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            // on failure pos is updated with the current head
+            continue;
+        }
+
+        // the element is not published yet
+        if (diff < 0) {
+            return -1;
+        }
+
+        // another consumer took the cell, retry
+        pos = __atomic_load_n(&(q->head), __ATOMIC_RELAXED);
+    }
+
+    *el = cell->el;
+
+    // give the cell back to the producers for the next lap
+    __atomic_store_n(&(cell->sequence), pos + q->mask + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_ts_mpmc_queue_t *gnl_ts_mpmc_queue_init(unsigned long bound) {
+    if (bound == 0 || bound > (1UL << (sizeof(unsigned long) * 8 - 2))) {
+        errno = EINVAL;
+
+        return NULL;
+    }
+
+    // round the bound up to the next power of two
+    unsigned long capacity = 1;
+    while (capacity < bound) {
+        capacity <<= 1;
+    }
+
+    struct gnl_ts_mpmc_queue_t *queue = (struct gnl_ts_mpmc_queue_t *)malloc(sizeof(struct gnl_ts_mpmc_queue_t));
+    GNL_NULL_CHECK(queue, ENOMEM, NULL)
+
+    queue->cells = (struct gnl_ts_mpmc_queue_cell *)malloc(capacity * sizeof(struct gnl_ts_mpmc_queue_cell));
+    if (queue->cells == NULL) {
+        free(queue);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    // every cell is ready to be filled at its own position
+    for (unsigned long i=0; i<capacity; i++) {
+        queue->cells[i].sequence = i;
+        queue->cells[i].el = 0;
+    }
+
+    queue->mask = capacity - 1;
+    queue->tail = 0;
+    queue->head = 0;
+    queue->el_added = 0;
+    queue->el_removed = 0;
+    queue->consumers_parked = 0;
+    queue->producers_parked = 0;
+
+    return queue;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_ts_mpmc_queue_destroy(struct gnl_ts_mpmc_queue_t *q) {
+    if (q == NULL) {
+        return;
+    }
+
+    free(q->cells);
+    free(q);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_ts_mpmc_queue_enqueue(struct gnl_ts_mpmc_queue_t *q, int el) {
+    GNL_NULL_CHECK(q, EINVAL, -1)
+
+    unsigned int seen;
+
+    while (try_enqueue(q, el) == -1) {
+        // announce the parking, then check the queue again: a consumer
+        // removing an element from now on will wake us up
+        seen = __atomic_load_n(&(q->el_removed), __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&(q->producers_parked), 1, __ATOMIC_SEQ_CST);
+
+        // if the count is not taken back, a waker will
+        // take it wasting only a wake up
+        if (try_enqueue(q, el) == 0) {
+            break;
+        }
+
+        futex_wait(&(q->el_removed), seen);
+    }
+
+    futex_wake(&(q->el_added), &(q->consumers_parked));
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_ts_mpmc_queue_dequeue(struct gnl_ts_mpmc_queue_t *q, int *el) {
+    GNL_NULL_CHECK(q, EINVAL, -1)
+    GNL_NULL_CHECK(el, EINVAL, -1)
+
+    unsigned int seen;
+
+    while (try_dequeue(q, el) == -1) {
+        // announce the parking, then check the queue again: a producer
+        // adding an element from now on will wake us up
+        seen = __atomic_load_n(&(q->el_added), __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&(q->consumers_parked), 1, __ATOMIC_SEQ_CST);
+
+        // if the count is not taken back, a waker will
+        // take it wasting only a wake up
+        if (try_dequeue(q, el) == 0) {
+            break;
+        }
+
+        futex_wait(&(q->el_added), seen);
+    }
+
+    futex_wake(&(q->el_removed), &(q->producers_parked));
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+unsigned long gnl_ts_mpmc_queue_size(struct gnl_ts_mpmc_queue_t *q) {
+    GNL_NULL_CHECK(q, EINVAL, 0)
+
+    unsigned long head = __atomic_load_n(&(q->head), __ATOMIC_ACQUIRE);
+    unsigned long tail = __atomic_load_n(&(q->tail), __ATOMIC_ACQUIRE);
+
+    // the positions are read one after the other, do not go below zero
+    if (tail < head) {
+        return 0;
+    }
+
+    return tail - head;
+}
+
+#undef GNL_TS_MPMC_QUEUE_CACHE_LINE
+
+#include <gnl_macro_end.h>
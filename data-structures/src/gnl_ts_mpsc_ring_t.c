@@ -0,0 +1,176 @@
+/*
+ * This is a simple concurrent thead-safe lock-free multi-producer single-consumer
+ * bounded ring of ints, it does not intend to be exhaustive.
+ *
+ * Every cell holds a sequence number telling whose turn it is: a producer can fill
+ * the cell at position pos when its sequence is pos, the consumer can empty it when
+ * its sequence is pos + 1. Producers reserve a position with a compare and swap on
+ * the tail, so a push is a single atomic operation when there is no contention.
+ */
+
+#include <stdlib.h>
+#include <errno.h>
+#include "../include/gnl_ts_mpsc_ring_t.h"
+#include <gnl_macro_beg.h>
+
+// the size of a cache line, to keep the producers and the consumer apart
+#define GNL_TS_MPSC_RING_CACHE_LINE 64
+
+/**
+ * sequence The turn of the cell.
+ * el       The element stored into the cell.
+ */
+struct gnl_ts_mpsc_ring_cell {
+    unsigned long sequence;
+    int el;
+};
+
+/**
+ * cells    The cells of the ring.
+ * mask     The capacity of the ring minus one.
+ * tail     The next position to fill, shared by the producers.
+ * head     The next position to empty, owned by the consumer.
+ */
+struct gnl_ts_mpsc_ring_t {
+    struct gnl_ts_mpsc_ring_cell *cells;
+    unsigned long mask;
+    char pad_tail[GNL_TS_MPSC_RING_CACHE_LINE];
+    unsigned long tail;
+    char pad_head[GNL_TS_MPSC_RING_CACHE_LINE];
+    unsigned long head;
+};
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_ts_mpsc_ring_t *gnl_ts_mpsc_ring_init(unsigned long bound) {
+    if (bound == 0 || bound > (1UL << (sizeof(unsigned long) * 8 - 2))) {
+        errno = EINVAL;
+
+        return NULL;
+    }
+
+    // round the bound up to the next power of two
+    unsigned long capacity = 1;
+    while (capacity < bound) {
+        capacity <<= 1;
+    }
+
+    struct gnl_ts_mpsc_ring_t *ring = (struct gnl_ts_mpsc_ring_t *)malloc(sizeof(struct gnl_ts_mpsc_ring_t));
+    GNL_NULL_CHECK(ring, ENOMEM, NULL)
+
+    ring->cells = (struct gnl_ts_mpsc_ring_cell *)malloc(capacity * sizeof(struct gnl_ts_mpsc_ring_cell));
+    if (ring->cells == NULL) {
+        free(ring);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    // every cell is ready to be filled at its own position
+    for (unsigned long i=0; i<capacity; i++) {
+        ring->cells[i].sequence = i;
+        ring->cells[i].el = 0;
+    }
+
+    ring->mask = capacity - 1;
+    ring->tail = 0;
+    ring->head = 0;
+
+    return ring;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_ts_mpsc_ring_destroy(struct gnl_ts_mpsc_ring_t *ring) {
+    if (ring == NULL) {
+        return;
+    }
+
+    free(ring->cells);
+    free(ring);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_ts_mpsc_ring_push(struct gnl_ts_mpsc_ring_t *ring, int el) {
+    GNL_NULL_CHECK(ring, EINVAL, -1)
+
+    struct gnl_ts_mpsc_ring_cell *cell;
+    unsigned long pos = __atomic_load_n(&(ring->tail), __ATOMIC_RELAXED);
+    long diff;
+
+    for (;;) {
+        cell = &(ring->cells[pos & ring->mask]);
+        diff = (long)(__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) - pos);
+
+        // the cell is free, try to reserve it
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&(ring->tail), &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+
+            // on failure pos is updated with the current tail
+            continue;
+        }
+
+        // the cell still holds the element of the previous lap
+        if (diff < 0) {
+            errno = EAGAIN;
+
+            return -1;
+        }
+
+        // another producer took the cell, retry
+        pos = __atomic_load_n(&(ring->tail), __ATOMIC_RELAXED);
+    }
+
+    cell->el = el;
+
+    // publish the element to the consumer
+    __atomic_store_n(&(cell->sequence), pos + 1, __ATOMIC_RELEASE);
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_ts_mpsc_ring_pop(struct gnl_ts_mpsc_ring_t *ring, int *el) {
+    GNL_NULL_CHECK(ring, EINVAL, -1)
+    GNL_NULL_CHECK(el, EINVAL, -1)
+
+    unsigned long pos = ring->head;
+    struct gnl_ts_mpsc_ring_cell *cell = &(ring->cells[pos & ring->mask]);
+
+    // the element is not published yet
+    if (__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) != pos + 1) {
+        errno = EAGAIN;
+
+        return -1;
+    }
+
+    *el = cell->el;
+
+    // give the cell back to the producers for the next lap
+    __atomic_store_n(&(cell->sequence), pos + ring->mask + 1, __ATOMIC_RELEASE);
+
+    ring->head = pos + 1;
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+unsigned long gnl_ts_mpsc_ring_capacity(struct gnl_ts_mpsc_ring_t *ring) {
+    GNL_NULL_CHECK(ring, EINVAL, 0)
+
+    return ring->mask + 1;
+}
+
+#undef GNL_TS_MPSC_RING_CACHE_LINE
+
+#include <gnl_macro_end.h>
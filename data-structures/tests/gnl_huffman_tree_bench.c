@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <gnl_colorshell.h>
+#include <gnl_file_to_pointer.h>
+#include "../src/gnl_huffman_tree.c"
+
+// the size of the payloads to encode
+#define BENCH_SIZE (8 * 1024 * 1024)
+
+// the number of runs of every benchmark
+#define BENCH_RUNS 5
+
+/**
+ * Get the elapsed seconds since the given start.
+ *
+ * @param start The start clock.
+ *
+ * @return      Returns the elapsed seconds.
+ */
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Encode and decode the given payload BENCH_RUNS times, and
+ * print the encoding and the decoding throughput.
+ *
+ * @param name  The name of the payload.
+ * @param bytes The payload.
+ * @param count The size of the payload.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int bench(const char *name, const void *bytes, size_t count) {
+    double encode_time = 0;
+    double decode_time = 0;
+    size_t size = 0;
+    clock_t start;
+
+    void *decoded = malloc(count);
+    if (decoded == NULL) {
+        return -1;
+    }
+
+    for (size_t i=0; i<BENCH_RUNS; i++) {
+        start = clock();
+        struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(bytes, count);
+        encode_time += elapsed(start);
+
+        if (artifact == NULL) {
+            return -1;
+        }
+
+        start = clock();
+        int res = gnl_huffman_tree_decode_into(artifact, decoded, count);
+        decode_time += elapsed(start);
+
+        if (res != count || memcmp(decoded, bytes, count) != 0) {
+            return -1;
+        }
+
+        size = gnl_huffman_tree_size(artifact);
+        gnl_huffman_tree_destroy_artifact(artifact);
+    }
+
+    double mb = (double)count * BENCH_RUNS / (1024 * 1024);
+
+    printf("%-8s ratio %5.3f   encode %8.2f MB/s   decode %8.2f MB/s\n", name, (double)size / count,
+           mb / encode_time, mb / decode_time);
+
+    free(decoded);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_huffman_tree benchmark:\n\n");
+
+    long size;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1 || size <= 0) {
+        return 1;
+    }
+
+    unsigned char *payload = malloc(BENCH_SIZE);
+    if (payload == NULL) {
+        return 1;
+    }
+
+    // text: the test file repeated
+    for (size_t i=0; i<BENCH_SIZE; i++) {
+        payload[i] = content[i % size];
+    }
+
+    res = bench("text", payload, BENCH_SIZE);
+    if (res == -1) {
+        return 1;
+    }
+
+    // random: a payload that can not be compressed
+    srand(42);
+    for (size_t i=0; i<BENCH_SIZE; i++) {
+        payload[i] = rand() & 0xFF;
+    }
+
+    res = bench("random", payload, BENCH_SIZE);
+    if (res == -1) {
+        return 1;
+    }
+
+    free(payload);
+    free(content);
+
+    printf("\n");
+
+    return 0;
+}
+
+#undef BENCH_SIZE
+#undef BENCH_RUNS
@@ -66,38 +66,53 @@ int can_get_tree() {
         return -1;
     }
 
-    char expected[255][40] = {0};
-    strcpy(expected['\0'], "0000110");
-    strcpy(expected[' '], "110");
-    strcpy(expected[','], "010100");
-    strcpy(expected['-'], "0000111");
-    strcpy(expected['L'], "0101101");
-    strcpy(expected['N'], "0101010");
-    strcpy(expected['O'], "0100110");
-    strcpy(expected['a'], "0111");
-    strcpy(expected['c'], "010000");
-    strcpy(expected['d'], "010010");
-    strcpy(expected['e'], "100");
-    strcpy(expected['g'], "0011");
-    strcpy(expected['h'], "0010");
-    strcpy(expected['i'], "1011");
-    strcpy(expected['k'], "000010");
-    strcpy(expected['l'], "010001");
-    strcpy(expected['m'], "11100");
-    strcpy(expected['n'], "1010");
-    strcpy(expected['o'], "0001");
-    strcpy(expected['p'], "00000");
-    strcpy(expected['r'], "1111");
-    strcpy(expected['s'], "11101");
-    strcpy(expected['t'], "0110");
-    strcpy(expected['u'], "0101011");
-    strcpy(expected['v'], "0101110");
-    strcpy(expected['w'], "0101111");
-    strcpy(expected['x'], "0101100");
-    strcpy(expected['y'], "0100111");
+    // the codes are canonical: the codes of the same length are
+    // consecutive, and they are assigned in byte order
+    char expected[256][40] = {0};
+    strcpy(expected['\0'], "1110110");
+    strcpy(expected[' '], "000");
+    strcpy(expected[','], "110110");
+    strcpy(expected['-'], "1110111");
+    strcpy(expected['L'], "1111000");
+    strcpy(expected['N'], "1111001");
+    strcpy(expected['O'], "1111010");
+    strcpy(expected['a'], "0100");
+    strcpy(expected['c'], "110111");
+    strcpy(expected['d'], "111000");
+    strcpy(expected['e'], "001");
+    strcpy(expected['g'], "0101");
+    strcpy(expected['h'], "0110");
+    strcpy(expected['i'], "0111");
+    strcpy(expected['k'], "111001");
+    strcpy(expected['l'], "111010");
+    strcpy(expected['m'], "11000");
+    strcpy(expected['n'], "1000");
+    strcpy(expected['o'], "1001");
+    strcpy(expected['p'], "11001");
+    strcpy(expected['r'], "1010");
+    strcpy(expected['s'], "11010");
+    strcpy(expected['t'], "1011");
+    strcpy(expected['u'], "1111011");
+    strcpy(expected['v'], "1111100");
+    strcpy(expected['w'], "1111101");
+    strcpy(expected['x'], "1111110");
+    strcpy(expected['y'], "1111111");
+
+    char code[40];
 
     for (size_t i=0; i<256; i++) {
-        if (strcmp(expected[i], "") != 0 && strcmp(expected[i], tree->dictionary[i]) != 0) {
+        if (strlen(expected[i]) != tree->lengths[i]) {
+            return -1;
+        }
+
+        // write the code as a string of bits
+        for (size_t j=0; j<tree->lengths[i]; j++) {
+            code[j] = (tree->codes[i] >> (tree->lengths[i] - j - 1)) & 1 ? '1' : '0';
+        }
+
+        code[tree->lengths[i]] = '\0';
+
+        if (strcmp(expected[i], code) != 0) {
             return -1;
         }
     }
@@ -150,6 +165,149 @@ int can_decode_encoded() {
     return 0;
 }
 
+int can_decode_into() {
+    const char *str = "One Late Night is a short immersive horror-game experience, starring an unnamed graphic designer "
+                      "employee, working late one night at the";
+
+    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(str, strlen(str) + 1);
+    if (artifact == NULL) {
+        return -1;
+    }
+
+    char decoded_string[strlen(str) + 1];
+
+    // the decoding tables are not built until the first decode
+    if (artifact->decoder != NULL) {
+        return -1;
+    }
+
+    const struct gnl_huffman_tree_decoder *decoder = NULL;
+
+    // the artifact is not consumed, so it can be decoded twice
+    for (size_t i=0; i<2; i++) {
+        memset(decoded_string, 0, strlen(str) + 1);
+
+        int res = gnl_huffman_tree_decode_into(artifact, decoded_string, strlen(str) + 1);
+        if (res != strlen(str) + 1) {
+            return -1;
+        }
+
+        if (strcmp(str, decoded_string) != 0) {
+            return -1;
+        }
+
+        // the second decode reuses the decoding tables of the first one
+        if (artifact->decoder == NULL || (decoder != NULL && artifact->decoder != decoder)) {
+            return -1;
+        }
+
+        decoder = artifact->decoder;
+    }
+
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    // a single byte series is encoded with 0 bits
+    artifact = gnl_huffman_tree_encode("aaaa", 4);
+    if (artifact == NULL) {
+        return -1;
+    }
+
+    int res = gnl_huffman_tree_decode_into(artifact, decoded_string, 4);
+    if (res != 4) {
+        return -1;
+    }
+
+    if (memcmp(decoded_string, "aaaa", 4) != 0) {
+        return -1;
+    }
+
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    return 0;
+}
+
+int can_get_the_stored_size() {
+    const char *str = "One Late Night is a short immersive horror-game experience";
+
+    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(str, strlen(str));
+    if (artifact == NULL) {
+        return -1;
+    }
+
+    // the code lengths table is stored with the code
+    if (gnl_huffman_tree_size(artifact) != sizeof(struct gnl_huffman_tree_artifact) + artifact->size) {
+        return -1;
+    }
+
+    if (gnl_huffman_tree_size(artifact) <= sizeof(artifact->lengths)) {
+        return -1;
+    }
+
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    return 0;
+}
+
+int can_decode_long_codes() {
+    // fibonacci frequencies build the deepest possible tree,
+    // so most of the codes are longer than a single lookup
+    size_t freq[20];
+    size_t size = 0;
+
+    for (size_t i=0; i<20; i++) {
+        freq[i] = i < 2 ? 1 : freq[i - 1] + freq[i - 2];
+        size += freq[i];
+    }
+
+    unsigned char *bytes = malloc(size);
+    if (bytes == NULL) {
+        return -1;
+    }
+
+    size_t offset = 0;
+    for (size_t i=0; i<20; i++) {
+        for (size_t j=0; j<freq[i]; j++) {
+            bytes[offset++] = 'a' + i;
+        }
+    }
+
+    struct gnl_huffman_tree_t *tree = gnl_huffman_tree_init(bytes, size);
+    if (tree == NULL) {
+        return -1;
+    }
+
+    if (tree->lengths['a'] <= 11) {
+        return -1;
+    }
+
+    gnl_huffman_tree_destroy(tree);
+
+    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(bytes, size);
+    if (artifact == NULL) {
+        return -1;
+    }
+
+    void *decoded;
+    size_t count;
+    int res = gnl_huffman_tree_decode(artifact, &decoded, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    if (count != size) {
+        return -1;
+    }
+
+    if (memcmp(decoded, bytes, size) != 0) {
+        return -1;
+    }
+
+    free(decoded);
+    free(bytes);
+
+    return 0;
+}
+
 int can_decode_file() {
     long size;
     char *content = NULL;
@@ -246,6 +404,9 @@ int main() {
     gnl_assert(can_calculate_frequencies, "can calculate the frequencies of a string.");
     gnl_assert(can_get_tree, "can build an huffman tree.");
     gnl_assert(can_decode_encoded, "can decode an encoded string.");
+    gnl_assert(can_decode_into, "can decode an encoded string into a buffer without consuming the artifact.");
+    gnl_assert(can_get_the_stored_size, "can get the stored size of an artifact.");
+    gnl_assert(can_decode_long_codes, "can decode codes longer than the lookup table.");
     gnl_assert(can_decode_file, "can decode an encoded file.");
 
     // the following test is heavy for valgrind
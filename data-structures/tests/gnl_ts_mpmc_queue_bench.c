@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <gnl_colorshell.h>
+#include "../src/gnl_ts_bb_queue_t.c"
+#include "../src/gnl_ts_mpmc_queue_t.c"
+
+// the number of elements moved by every benchmark
+#define BENCH_ELEMENTS 2000000
+
+// the number of runs of every benchmark
+#define BENCH_RUNS 3
+
+/**
+ * The arguments of a producer or consumer thread.
+ *
+ * bb_queue     The gnl_ts_bb_queue_t instance, or NULL.
+ * mpmc_queue   The gnl_ts_mpmc_queue_t instance, or NULL.
+ * count        The number of elements to move.
+ */
+struct bench_args {
+    struct gnl_ts_bb_queue_t *bb_queue;
+    struct gnl_ts_mpmc_queue_t *mpmc_queue;
+    long count;
+};
+
+/**
+ * Get the elapsed seconds since the given start.
+ *
+ * @param start The start time.
+ *
+ * @return      Returns the elapsed seconds.
+ */
+static double elapsed(const struct timespec *start) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void *producer(void *ptr) {
+    struct bench_args *args = (struct bench_args *)ptr;
+
+    for (long i=0; i<args->count; i++) {
+        if (args->bb_queue != NULL) {
+            // the way the thread pool dispatches a client
+            int *el = malloc(sizeof(int));
+            *el = (int)i;
+            gnl_ts_bb_queue_enqueue(args->bb_queue, el);
+        } else {
+            gnl_ts_mpmc_queue_enqueue(args->mpmc_queue, (int)i);
+        }
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *ptr) {
+    struct bench_args *args = (struct bench_args *)ptr;
+    int el;
+
+    for (long i=0; i<args->count; i++) {
+        if (args->bb_queue != NULL) {
+            int *raw = gnl_ts_bb_queue_dequeue(args->bb_queue);
+            el = *raw;
+            free(raw);
+        } else {
+            gnl_ts_mpmc_queue_dequeue(args->mpmc_queue, &el);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Move BENCH_ELEMENTS through a queue with the given number of producers
+ * and consumers BENCH_RUNS times, and print the throughput.
+ *
+ * @param name      The name of the queue.
+ * @param mpmc      If 1 use a gnl_ts_mpmc_queue_t, otherwise a gnl_ts_bb_queue_t.
+ * @param producers The number of producers.
+ * @param consumers The number of consumers.
+ * @param bound     The bound of the queue.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int bench(const char *name, int mpmc, int producers, int consumers, int bound) {
+    double time = 0;
+    struct timespec start;
+
+    pthread_t threads[producers + consumers];
+    struct bench_args producer_args;
+    struct bench_args consumer_args;
+
+    for (size_t run=0; run<BENCH_RUNS; run++) {
+        producer_args.bb_queue = NULL;
+        producer_args.mpmc_queue = NULL;
+
+        if (mpmc) {
+            producer_args.mpmc_queue = gnl_ts_mpmc_queue_init(bound);
+            if (producer_args.mpmc_queue == NULL) {
+                return -1;
+            }
+        } else {
+            producer_args.bb_queue = gnl_ts_bb_queue_init(bound);
+            if (producer_args.bb_queue == NULL) {
+                return -1;
+            }
+        }
+
+        consumer_args = producer_args;
+        producer_args.count = BENCH_ELEMENTS / producers;
+        consumer_args.count = BENCH_ELEMENTS / consumers;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (int i=0; i<consumers; i++) {
+            if (pthread_create(&threads[i], NULL, &consumer, &consumer_args) != 0) {
+                return -1;
+            }
+        }
+
+        for (int i=0; i<producers; i++) {
+            if (pthread_create(&threads[consumers + i], NULL, &producer, &producer_args) != 0) {
+                return -1;
+            }
+        }
+
+        for (int i=0; i<producers + consumers; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        time += elapsed(&start);
+
+        gnl_ts_mpmc_queue_destroy(producer_args.mpmc_queue);
+        gnl_ts_bb_queue_destroy(producer_args.bb_queue, free);
+    }
+
+    double mops = (double)BENCH_ELEMENTS * BENCH_RUNS / 1e6;
+
+    printf("%-18s %dP/%dC bound %5d   %8.2f Mops/s\n", name, producers, consumers, bound, mops / time);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_ts_mpmc_queue_t benchmark:\n\n");
+
+    // the shapes of the thread pool: one master, some workers
+    int shapes[][3] = {
+            {1, 1, 4},
+            {1, 4, 4},
+            {4, 4, 4},
+            {1, 4, 1024},
+            {4, 4, 1024},
+    };
+
+    for (size_t i=0; i<sizeof(shapes) / sizeof(shapes[0]); i++) {
+        if (bench("gnl_ts_bb_queue_t", 0, shapes[i][0], shapes[i][1], shapes[i][2]) == -1) {
+            return 1;
+        }
+
+        if (bench("gnl_ts_mpmc_queue_t", 1, shapes[i][0], shapes[i][1], shapes[i][2]) == -1) {
+            return 1;
+        }
+    }
+
+    printf("\n");
+
+    return 0;
+}
+
+#undef BENCH_ELEMENTS
+#undef BENCH_RUNS
@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <pthread.h>
+#include <gnl_colorshell.h>
+#include <gnl_assert.h>
+#include "../src/gnl_ts_mpmc_queue_t.c"
+
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define ELEMENTS_PER_PRODUCER 100000
+
+int can_create_a_queue() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(100);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+int can_not_create_an_empty_queue() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(0);
+
+    if (queue != NULL) {
+        return -1;
+    }
+
+    if (errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_enqueue_an_int() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(100);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    if (gnl_ts_mpmc_queue_size(queue) != 0) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_enqueue(queue, 42);
+
+    if (gnl_ts_mpmc_queue_size(queue) != 1) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+int can_dequeue_an_int() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(100);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_enqueue(queue, 42);
+
+    int actual;
+    if (gnl_ts_mpmc_queue_dequeue(queue, &actual) != 0) {
+        return -1;
+    }
+
+    if (actual != 42) {
+        return -1;
+    }
+
+    if (gnl_ts_mpmc_queue_size(queue) != 0) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+int can_use_a_fifo_queue() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(16);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    int actual;
+
+    // go around the array several times
+    for (int lap=0; lap<10; lap++) {
+        for (int i=0; i<10; i++) {
+            gnl_ts_mpmc_queue_enqueue(queue, lap * 10 + i);
+        }
+
+        for (int i=0; i<10; i++) {
+            gnl_ts_mpmc_queue_dequeue(queue, &actual);
+
+            if (actual != lap * 10 + i) {
+                return -1;
+            }
+        }
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+static void *slow_consumer(void *args) {
+    struct gnl_ts_mpmc_queue_t *queue = (struct gnl_ts_mpmc_queue_t *)args;
+    int el;
+
+    usleep(100000);
+    gnl_ts_mpmc_queue_dequeue(queue, &el);
+
+    return NULL;
+}
+
+int can_wait_for_a_room() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    queue = gnl_ts_mpmc_queue_init(2);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_enqueue(queue, 1);
+    gnl_ts_mpmc_queue_enqueue(queue, 2);
+
+    pthread_t consumer;
+    if (pthread_create(&consumer, NULL, &slow_consumer, queue) != 0) {
+        return -1;
+    }
+
+    // the queue is full, this waits for the consumer
+    gnl_ts_mpmc_queue_enqueue(queue, 3);
+
+    pthread_join(consumer, NULL);
+
+    int actual;
+    gnl_ts_mpmc_queue_dequeue(queue, &actual);
+    if (actual != 2) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_dequeue(queue, &actual);
+    if (actual != 3) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+static long long consumed_sum = 0;
+
+static void *producer(void *args) {
+    struct gnl_ts_mpmc_queue_t *queue = (struct gnl_ts_mpmc_queue_t *)args;
+
+    for (int i=1; i<=ELEMENTS_PER_PRODUCER; i++) {
+        gnl_ts_mpmc_queue_enqueue(queue, i);
+    }
+
+    return NULL;
+}
+
+static void *consumer(void *args) {
+    struct gnl_ts_mpmc_queue_t *queue = (struct gnl_ts_mpmc_queue_t *)args;
+    long long sum = 0;
+    int el;
+
+    for (;;) {
+        gnl_ts_mpmc_queue_dequeue(queue, &el);
+
+        // a negative element ends the consumer
+        if (el < 0) {
+            break;
+        }
+
+        sum += el;
+    }
+
+    __atomic_add_fetch(&consumed_sum, sum, __ATOMIC_SEQ_CST);
+
+    return NULL;
+}
+
+int can_be_used_by_many_threads() {
+    struct gnl_ts_mpmc_queue_t *queue;
+
+    // a small queue, to park both producers and consumers
+    queue = gnl_ts_mpmc_queue_init(8);
+
+    if (queue == NULL) {
+        return -1;
+    }
+
+    pthread_t producers[PRODUCERS];
+    pthread_t consumers[CONSUMERS];
+
+    for (int i=0; i<CONSUMERS; i++) {
+        if (pthread_create(&consumers[i], NULL, &consumer, queue) != 0) {
+            return -1;
+        }
+    }
+
+    for (int i=0; i<PRODUCERS; i++) {
+        if (pthread_create(&producers[i], NULL, &producer, queue) != 0) {
+            return -1;
+        }
+    }
+
+    for (int i=0; i<PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+
+    for (int i=0; i<CONSUMERS; i++) {
+        gnl_ts_mpmc_queue_enqueue(queue, -1);
+    }
+
+    for (int i=0; i<CONSUMERS; i++) {
+        pthread_join(consumers[i], NULL);
+    }
+
+    // every element must be dequeued exactly once
+    long long expected = (long long)PRODUCERS * ELEMENTS_PER_PRODUCER * (ELEMENTS_PER_PRODUCER + 1) / 2;
+
+    if (consumed_sum != expected) {
+        return -1;
+    }
+
+    if (gnl_ts_mpmc_queue_size(queue) != 0) {
+        return -1;
+    }
+
+    gnl_ts_mpmc_queue_destroy(queue);
+
+    return 0;
+}
+
+int can_pass_null_queue() {
+    int el;
+
+    gnl_ts_mpmc_queue_enqueue(NULL, 0);
+    gnl_ts_mpmc_queue_dequeue(NULL, &el);
+    gnl_ts_mpmc_queue_size(NULL);
+    gnl_ts_mpmc_queue_destroy(NULL);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_ts_mpmc_queue_t test:\n\n");
+
+    gnl_assert(can_create_a_queue, "can create a thread-safe blocking bounded multi-producer multi-consumer queue.");
+    gnl_assert(can_not_create_an_empty_queue, "can not create a thread-safe blocking bounded multi-producer multi-consumer queue with bound 0.");
+
+    gnl_assert(can_enqueue_an_int, "can push an int element into a thread-safe blocking bounded multi-producer multi-consumer queue.");
+    gnl_assert(can_dequeue_an_int, "can pop an int element from a thread-safe blocking bounded multi-producer multi-consumer queue.");
+
+    gnl_assert(can_use_a_fifo_queue, "can respect the FIFO protocol.");
+    gnl_assert(can_wait_for_a_room, "can wait for a room if the queue is full.");
+    gnl_assert(can_be_used_by_many_threads, "can be used by many producers and consumers at the same time.");
+
+    gnl_assert(can_pass_null_queue, "can give a null queue safely to the thread-safe blocking bounded multi-producer multi-consumer queue interface.");
+
+    // the gnl_ts_mpmc_queue_destroy method is implicitly tested in every assertion
+
+    printf("\n");
+}
+
+#undef PRODUCERS
+#undef CONSUMERS
+#undef ELEMENTS_PER_PRODUCER
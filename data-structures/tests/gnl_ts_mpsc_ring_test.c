@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <pthread.h>
+#include <gnl_colorshell.h>
+#include <gnl_assert.h>
+#include "../src/gnl_ts_mpsc_ring_t.c"
+
+#define PRODUCERS 4
+#define ELEMENTS_PER_PRODUCER 100000
+
+int can_create_a_ring() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(100);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    // the capacity is rounded up to the next power of two
+    if (gnl_ts_mpsc_ring_capacity(ring) != 128) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_not_create_an_empty_ring() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(0);
+
+    if (ring != NULL) {
+        return -1;
+    }
+
+    if (errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_push_an_int() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(8);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    if (gnl_ts_mpsc_ring_push(ring, 42) != 0) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_pop_an_int() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(8);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_push(ring, 42);
+
+    int actual;
+    if (gnl_ts_mpsc_ring_pop(ring, &actual) != 0) {
+        return -1;
+    }
+
+    if (actual != 42) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_not_pop_from_an_empty_ring() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(8);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    int actual;
+    if (gnl_ts_mpsc_ring_pop(ring, &actual) != -1) {
+        return -1;
+    }
+
+    if (errno != EAGAIN) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_not_push_into_a_full_ring() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(8);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    for (int i=0; i<8; i++) {
+        if (gnl_ts_mpsc_ring_push(ring, i) != 0) {
+            return -1;
+        }
+    }
+
+    if (gnl_ts_mpsc_ring_push(ring, 8) != -1) {
+        return -1;
+    }
+
+    if (errno != EAGAIN) {
+        return -1;
+    }
+
+    // a pop frees a cell
+    int actual;
+    gnl_ts_mpsc_ring_pop(ring, &actual);
+
+    if (gnl_ts_mpsc_ring_push(ring, 8) != 0) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_use_a_fifo_ring() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(16);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    int actual;
+
+    // go around the ring several times
+    for (int lap=0; lap<10; lap++) {
+        for (int i=0; i<10; i++) {
+            gnl_ts_mpsc_ring_push(ring, lap * 10 + i);
+        }
+
+        for (int i=0; i<10; i++) {
+            if (gnl_ts_mpsc_ring_pop(ring, &actual) != 0) {
+                return -1;
+            }
+
+            if (actual != lap * 10 + i) {
+                return -1;
+            }
+        }
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+static void *producer(void *args) {
+    struct gnl_ts_mpsc_ring_t *ring = (struct gnl_ts_mpsc_ring_t *)args;
+
+    for (int i=1; i<=ELEMENTS_PER_PRODUCER; i++) {
+        while (gnl_ts_mpsc_ring_push(ring, i) == -1);
+    }
+
+    return NULL;
+}
+
+int can_push_from_many_threads() {
+    struct gnl_ts_mpsc_ring_t *ring;
+
+    ring = gnl_ts_mpsc_ring_init(64);
+
+    if (ring == NULL) {
+        return -1;
+    }
+
+    pthread_t producers[PRODUCERS];
+
+    for (int i=0; i<PRODUCERS; i++) {
+        if (pthread_create(&producers[i], NULL, &producer, ring) != 0) {
+            return -1;
+        }
+    }
+
+    // every element must be popped exactly once
+    long long expected = (long long)PRODUCERS * ELEMENTS_PER_PRODUCER * (ELEMENTS_PER_PRODUCER + 1) / 2;
+    long long actual = 0;
+    long popped = 0;
+    int el;
+
+    while (popped < (long)PRODUCERS * ELEMENTS_PER_PRODUCER) {
+        if (gnl_ts_mpsc_ring_pop(ring, &el) == 0) {
+            actual += el;
+            popped++;
+        }
+    }
+
+    for (int i=0; i<PRODUCERS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+
+    if (actual != expected) {
+        return -1;
+    }
+
+    if (gnl_ts_mpsc_ring_pop(ring, &el) != -1) {
+        return -1;
+    }
+
+    gnl_ts_mpsc_ring_destroy(ring);
+
+    return 0;
+}
+
+int can_pass_null_ring() {
+    int el;
+
+    gnl_ts_mpsc_ring_push(NULL, 0);
+    gnl_ts_mpsc_ring_pop(NULL, &el);
+    gnl_ts_mpsc_ring_capacity(NULL);
+    gnl_ts_mpsc_ring_destroy(NULL);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_ts_mpsc_ring_t test:\n\n");
+
+    gnl_assert(can_create_a_ring, "can create a thread-safe lock-free multi-producer single-consumer ring.");
+    gnl_assert(can_not_create_an_empty_ring, "can not create a thread-safe lock-free multi-producer single-consumer ring with bound 0.");
+
+    gnl_assert(can_push_an_int, "can push an int element into a thread-safe lock-free multi-producer single-consumer ring.");
+    gnl_assert(can_pop_an_int, "can pop an int element from a thread-safe lock-free multi-producer single-consumer ring.");
+
+    gnl_assert(can_not_pop_from_an_empty_ring, "can not pop an element from an empty ring.");
+    gnl_assert(can_not_push_into_a_full_ring, "can not push an element into a full ring.");
+
+    gnl_assert(can_use_a_fifo_ring, "can respect the FIFO protocol.");
+    gnl_assert(can_push_from_many_threads, "can push elements from many threads at the same time.");
+
+    gnl_assert(can_pass_null_ring, "can give a null ring safely to the thread-safe lock-free multi-producer single-consumer ring interface.");
+
+    // the gnl_ts_mpsc_ring_destroy method is implicitly tested in every assertion
+
+    printf("\n");
+}
+
+#undef PRODUCERS
+#undef ELEMENTS_PER_PRODUCER
@@ -0,0 +1,89 @@
+#ifndef GNL_SIMFS_CODEC_H
+#define GNL_SIMFS_CODEC_H
+
+#include <stddef.h>
+
+/**
+ * The possible compressions of the files of the file system.
+ * Every chunk of a file records the codec used to store it,
+ * so the compression can be chosen write by write.
+ */
+enum gnl_simfs_compression {
+
+    // the bytes are stored as they are
+    GNL_SIMFS_COMPRESSION_NONE,
+
+    // the bytes are compressed with the Huffman algorithm
+    GNL_SIMFS_COMPRESSION_HUFFMAN,
+
+    // the bytes are compressed with the LZ77 algorithm
+    GNL_SIMFS_COMPRESSION_LZ,
+
+    // the codec is chosen on every write: the bytes that
+    // look incompressible are stored as they are, the
+    // others are compressed with the Huffman algorithm
+    GNL_SIMFS_COMPRESSION_AUTO
+};
+
+/**
+ * Encode the given bytes with the given compression.
+ *
+ * @param compression   The compression to use.
+ * @param bytes         The bytes to encode.
+ * @param count         The number of bytes to encode.
+ * @param codec         The destination where to write the codec actually used,
+ *                      it is never GNL_SIMFS_COMPRESSION_AUTO.
+ * @param size          The destination where to write the size in bytes
+ *                      of the encoded data.
+ *
+ * @return              Returns the encoded data on success, NULL otherwise.
+ */
+extern void *gnl_simfs_codec_encode(enum gnl_simfs_compression compression, const void *bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size);
+
+/**
+ * Encode the bytes of the given buffer with the given compression, like
+ * gnl_simfs_codec_encode does, but without copying the bytes that are
+ * stored as they are: in that case the buffer is adopted as the encoded
+ * data and the pointer to it is set to NULL, otherwise the buffer is
+ * left to the caller.
+ *
+ * @param compression   The compression to use.
+ * @param bytes         The pointer to the buffer holding the bytes to encode,
+ *                      the buffer must be allocated with malloc.
+ * @param count         The number of bytes to encode.
+ * @param codec         The destination where to write the codec actually used,
+ *                      it is never GNL_SIMFS_COMPRESSION_AUTO.
+ * @param size          The destination where to write the size in bytes
+ *                      of the encoded data.
+ *
+ * @return              Returns the encoded data on success, NULL otherwise.
+ */
+extern void *gnl_simfs_codec_encode_buffer(enum gnl_simfs_compression compression, void **bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size);
+
+/**
+ * Decode the given data into dest. The data is not modified.
+ *
+ * @param codec The codec used to encode the data.
+ * @param data  The encoded data.
+ * @param size  The size in bytes of the encoded data.
+ * @param dest  The destination where to put the decoded bytes, it must
+ *              be at least count bytes long.
+ * @param count The number of bytes to decode.
+ *
+ * @return      Returns the number of bytes decoded on success,
+ *              -1 otherwise.
+ */
+extern int gnl_simfs_codec_decode(enum gnl_simfs_compression codec, const void *data, size_t size, void *dest,
+        size_t count);
+
+/**
+ * Destroy the given encoded data.
+ *
+ * @param codec The codec used to encode the data.
+ * @param data  The encoded data to destroy.
+ */
+extern void gnl_simfs_codec_destroy(enum gnl_simfs_compression codec, void *data);
+
+#endif //GNL_SIMFS_CODEC_H
@@ -1,21 +1,32 @@
 #ifndef GNL_SIMFS_EVICTED_FILE_H
 #define GNL_SIMFS_EVICTED_FILE_H
 
+#include <stddef.h>
+
+struct gnl_simfs_inode_chunk;
+
 /**
  * The evicted file structure. This structure is
  * returned as an element of the evicted list set during
- * an open or write operations.
+ * an open or write operations, and, already decoded, as
+ * an element of the list of the files read at once.
  */
 struct gnl_simfs_evicted_file {
 
     // the name of the file evicted
     char *name;
 
-    // the buffer of bytes evicted
+    // the buffer of bytes evicted, it is NULL
+    // until the evicted chunks are decoded
     void *bytes;
 
-    // the number of bytes evicted
+    // the number of bytes evicted, once decoded
     size_t count;
+
+    // the compressed chunks detached from the evicted file as
+    // they are stored, they are decoded into bytes outside the
+    // locks of the file system, NULL once decoded
+    struct gnl_simfs_inode_chunk *chunks;
 };
 
 /**
@@ -26,6 +37,18 @@ struct gnl_simfs_evicted_file {
  */
 extern struct gnl_simfs_evicted_file *gnl_simfs_evicted_file_init();
 
+/**
+ * Decode the compressed chunks of the given evicted_file instance into
+ * its bytes, releasing the chunks. It does nothing if the chunks are
+ * already decoded. It does not need any lock of the file system, so
+ * the cost of the decompression is not paid by the other clients.
+ *
+ * @param evicted_file  The evicted_file instance to decode.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_evicted_file_decode(struct gnl_simfs_evicted_file *evicted_file);
+
 /**
  * Destroy the given evicted_file instance.
  *
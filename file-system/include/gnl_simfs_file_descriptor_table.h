@@ -3,6 +3,23 @@
 
 #include "./gnl_simfs_inode.h"
 
+/**
+ * A file descriptor of the file descriptor table. It refers the inode
+ * of the opened file by handle, so it does not hold a copy of it.
+ */
+struct gnl_simfs_file_descriptor {
+
+    // the owner id of the file descriptor
+    unsigned int owner;
+
+    // the handle of the inode of the opened file
+    struct gnl_simfs_inode_handle handle;
+
+    // the writes on the opened file not flushed yet, they are
+    // owned by the file descriptor until they are flushed
+    struct gnl_simfs_inode_buffer buffer;
+};
+
 /**
  * The file descriptor table data structure.
  */
@@ -27,21 +44,22 @@ extern struct gnl_simfs_file_descriptor_table *gnl_simfs_file_descriptor_table_i
 extern void gnl_simfs_file_descriptor_table_destroy(struct gnl_simfs_file_descriptor_table *table);
 
 /**
- * Insert an inode into the given file descriptor table.
+ * Insert an inode handle into the given file descriptor table.
  *
- * @param table The file descriptor table instance where to put the inode.
- * @param inode The inode to insert into the given file descriptor table.
- * @param pid   The owner of the entry that will be created.
+ * @param table     The file descriptor table instance where to put the handle.
+ * @param handle    The handle of the inode to insert into the given file
+ *                  descriptor table, it is copied.
+ * @param pid       The owner of the entry that will be created.
  *
- * @return      On success, returns the file descriptor of the file within
- *              the inserted inode, on failure returns -1.
+ * @return          On success, returns the file descriptor of the file referred
+ *                  by the inserted handle, on failure returns -1.
  */
-extern int gnl_simfs_file_descriptor_table_put(struct gnl_simfs_file_descriptor_table *table, const struct gnl_simfs_inode *inode,
-        unsigned long pid);
+extern int gnl_simfs_file_descriptor_table_put(struct gnl_simfs_file_descriptor_table *table,
+        const struct gnl_simfs_inode_handle *handle, unsigned long pid);
 
 /**
  * Remove a file descriptor from the given file descriptor table. It will not delete
- * the associated inode.
+ * the associated inode, but it will discard the writes not flushed yet.
  *
  * @param table The file descriptor table instance from where delete the file descriptor.
  * @param fd    The file descriptor to remove from the given file descriptor table.
@@ -64,15 +82,16 @@ extern int gnl_simfs_file_descriptor_table_remove(struct gnl_simfs_file_descript
 extern int gnl_simfs_file_descriptor_table_remove_pid(struct gnl_simfs_file_descriptor_table *table, unsigned int pid);
 
 /**
- * Get a file descriptor inode from the given file descriptor table.
+ * Get a file descriptor from the given file descriptor table. The returned file
+ * descriptor can be used by its owner until it removes it.
  *
  * @param table The file descriptor table instance from where to get the file descriptor.
  * @param fd    The file descriptor to get from the given file descriptor table.
  * @param pid   The id of the process that invoked this method, it should be the owner of the entry
  *
- * @return      Return the inode of the given fd on success, NULL otherwise.
+ * @return      Return the file descriptor of the given fd on success, NULL otherwise.
  */
-extern struct gnl_simfs_inode *gnl_simfs_file_descriptor_table_get(const struct gnl_simfs_file_descriptor_table *table,
+extern struct gnl_simfs_file_descriptor *gnl_simfs_file_descriptor_table_get(struct gnl_simfs_file_descriptor_table *table,
         unsigned int fd, unsigned int pid);
 
 /**
@@ -83,20 +102,6 @@ extern struct gnl_simfs_inode *gnl_simfs_file_descriptor_table_get(const struct
  * @return  Returns the size of the given file descriptor table
  *          on success, -1 on failure.
  */
-extern int gnl_simfs_file_descriptor_table_size(const struct gnl_simfs_file_descriptor_table *table);
-
-/**
- * Get the number of times that the given pid put the given inode into
- * the given file descriptor table.
- *
- * @param table The file descriptor table instance.
- * @param inode The inode of which to get the pid opens.
- * @param pid   The id of the process to get the size.
- *
- * @return  Returns the number of times the given pid put the given inode
- *          on success, -1 on failure.
- */
-extern int gnl_simfs_file_descriptor_table_pid_inode_size(const struct gnl_simfs_file_descriptor_table *table,
-        const struct gnl_simfs_inode *inode, unsigned int pid);
+extern int gnl_simfs_file_descriptor_table_size(struct gnl_simfs_file_descriptor_table *table);
 
 #endif //GNL_SIMFS_FILE_DESCRIPTOR_TABLE_H
\ No newline at end of file
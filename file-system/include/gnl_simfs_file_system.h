@@ -40,8 +40,58 @@ enum gnl_simfs_replacement_policy {
     // evict the most recently used file
     GNL_SIMFS_RP_MRU,
 
-    // evict the least often used file
+    // evict the least often used file, the access
+    // frequency ages if the frequency_aging is set
     GNL_SIMFS_RP_LFU,
+
+    // adaptive replacement cache: balance the recently
+    // and the frequently used files, learning from the
+    // files re-created after their eviction
+    GNL_SIMFS_RP_ARC,
+
+    // evict the files accessed only once first, so a
+    // scan does not flush the frequently used files
+    GNL_SIMFS_RP_2Q,
+
+    // evict the least recently used file of a small
+    // window, or of the main segments when the window
+    // file is more frequent according to a sketch
+    GNL_SIMFS_RP_WTINYLFU,
+
+    // greedy dual size frequency: evict the file with the
+    // lowest access frequency per byte, aged over time
+    GNL_SIMFS_RP_GDSF,
+};
+
+/**
+ * The status of a file, as returned by the gnl_simfs_file_system_stat
+ * and gnl_simfs_file_system_fstat methods. It is a copy, so it is not
+ * updated by the operations on the file done after it is taken.
+ */
+struct gnl_simfs_stat {
+
+    // the name of the file, it is owned by the caller
+    char *name;
+
+    // the size in bytes of the file (compressed)
+    unsigned int size;
+
+    // the number of references to the file
+    unsigned int reference_count;
+
+    // the creation, last modification, last access
+    // and last status change timestamps of the file
+    time_t btime;
+    time_t mtime;
+    time_t atime;
+    time_t ctime;
+
+    // the logical time of the last access to the file
+    unsigned long long access_clock;
+
+    // the count of the accesses to the file, aged
+    // in accordance with the replacement policy
+    unsigned long frequency;
 };
 
 /**
@@ -63,12 +113,18 @@ struct gnl_simfs_file_system;
  * @param replacement_policy    The replacement policy to adopt in case the file system reaches the given
  *                              memory_limit or the given file_limit. In this case one or more file/s will be
  *                              evicted in accordance with the policy chosen.
+ * @param compression           The compression of the written files. The memory_limit is accounted
+ *                              on the stored (compressed) size of the files.
+ * @param frequency_aging       The number of accesses after which the access frequencies of the files are
+ *                              halved, so the files popular only in the past can be evicted by the LFU
+ *                              replacement policy. If 0, the access frequencies never age.
  *
  * @return                      Returns the new gnl_simfs_file_system created on success,
  *                              NULL otherwise.
  */
 extern struct gnl_simfs_file_system *gnl_simfs_file_system_init(unsigned int memory_limit, unsigned int file_limit,
-        const char *log_path, const char *log_level, enum gnl_simfs_replacement_policy replacement_policy);
+        const char *log_path, const char *log_level, enum gnl_simfs_replacement_policy replacement_policy,
+        enum gnl_simfs_compression compression, unsigned int frequency_aging);
 
 /**
  * Destroy the given file system. Every file into it will be lost, all the allocated memory
@@ -87,7 +143,7 @@ extern void gnl_simfs_file_system_destroy(struct gnl_simfs_file_system *file_sys
  * @param filename      The filename of the file to open.
  * @param flags         If GNL_SIMFS_O_CREATE is given, the file will be created,
  *                      if GNL_SIMFS_O_LOCK is given, the file will be opened in
- *                      locked mode.
+ *                      locked mode, as gnl_simfs_file_system_lock does.
  * @param pid           The id of the process who invoked this method.ì
  *
  * @return              Returns a file descriptor referring to the opened file
@@ -114,6 +170,79 @@ extern int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system,
 extern int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system, int fd, const void *buf, size_t count,
         unsigned int pid, struct gnl_list_t **evicted_list);
 
+/**
+ * Write count bytes from the buffer pointed by buf to the file referred to by
+ * the file descriptor fd, like gnl_simfs_file_system_write does, but without
+ * copying the bytes if they are stored as they are: in that case the file
+ * system takes the ownership of the buffer and *buf is set to NULL, even if
+ * the write fails afterwards, otherwise the buffer is left to the caller.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param buf           The pointer to the buffer containing the data to write,
+ *                      the buffer must be allocated with malloc.
+ * @param count         The count of bytes to write.
+ * @param pid           The id of the process who invoked this method.
+ * @param evicted_list  The pointer to the list where to put the eventual evicted
+ *                      files in accordance with the replacement policy given at
+ *                      the moment of the file system initialization.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_write_buffer(struct gnl_simfs_file_system *file_system, int fd, void **buf,
+        size_t count, unsigned int pid, struct gnl_list_t **evicted_list);
+
+/**
+ * Begin a chunked write on the file referred to by the file descriptor fd: the
+ * bytes are given chunk by chunk with gnl_simfs_file_system_write_chunk, and
+ * they are appended to the file at once by gnl_simfs_file_system_write_end.
+ * The chunks of a previous chunked write never ended are discarded. Other
+ * operations on the same file descriptor should not be interleaved with a
+ * chunked write, since they may append the chunks given so far.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_write_begin(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid);
+
+/**
+ * Compress count bytes from the buffer pointed by buf into the pending chunks
+ * of the chunked write on the file referred to by the file descriptor fd, so
+ * only the compressed bytes are kept until the write ends. The ownership of the
+ * buffer is handled as by gnl_simfs_file_system_write_buffer. If the compressed
+ * chunks exceed the memory limit the chunked write fails and they are discarded.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param buf           The pointer to the buffer containing the data to write,
+ *                      the buffer must be allocated with malloc.
+ * @param count         The count of bytes to write.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_write_chunk(struct gnl_simfs_file_system *file_system, int fd, void **buf,
+        size_t count, unsigned int pid);
+
+/**
+ * End the chunked write on the file referred to by the file descriptor fd,
+ * appending all its chunks to the file at once.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param pid           The id of the process who invoked this method.
+ * @param evicted_list  The pointer to the list where to put the eventual evicted
+ *                      files in accordance with the replacement policy given at
+ *                      the moment of the file system initialization.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_write_end(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid,
+        struct gnl_list_t **evicted_list);
+
 /**
  * Read the whole file pointed by the given file descriptor fd into buf, and
  * write the number of bytes read into count.
@@ -129,6 +258,28 @@ extern int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system
 extern int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd, void **buf, size_t *count,
         unsigned int pid);
 
+/**
+ * Read a piece of the file pointed by the given file descriptor fd, starting
+ * at the given offset, into buf, and write the number of bytes read into count,
+ * so that a file can be read in bounded pieces. A piece ends at the end of the
+ * chunk of the file holding the offset, and it is at most max bytes long, as
+ * described by gnl_simfs_inode_read_chunk.
+ *
+ * @param file_system   The file system instance from where to read the file.
+ * @param fd            The file descriptor referring the file to read.
+ * @param offset        The offset of the first byte to read.
+ * @param max           The maximum number of bytes to read, it must be > 0.
+ * @param buf           The buffer pointer where to write the read data, it is
+ *                      set to NULL if the offset is past the end of the file.
+ * @param count         The count of bytes read, 0 if the offset is past the
+ *                      end of the file.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_read_chunk(struct gnl_simfs_file_system *file_system, int fd, size_t offset,
+        size_t max, void **buf, size_t *count, unsigned int pid);
+
 /**
  * Close the given file descriptor. After this invocation the given file descriptor will no
  * longer be valid.
@@ -156,7 +307,10 @@ extern int gnl_simfs_file_system_remove(struct gnl_simfs_file_system *file_syste
 
 /**
  * Lock the file pointed by the given filename. After this invocation the file locked
- * can not be accessed by other pid.
+ * can not be accessed by other pid. This method never waits: if the file is opened by
+ * other pids it fails with EBUSY, and the pid is marked as waiting to lock the file
+ * until it locks or closes it; meanwhile, the other pids can not open the file, and
+ * a second pid trying to lock it fails with EDEADLK.
  *
  * @param file_system   The file system instance where to lock the given file name.
  * @param fd            The file descriptor to lock.
@@ -178,6 +332,24 @@ extern int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system,
  */
 extern int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid);
 
+/**
+ * Read up to n files of the file system at once, from a single snapshot taken
+ * holding the locks of all the shards. The files locked by another pid are
+ * skipped. Every file read counts as an access for the replacement policy.
+ *
+ * @param file_system   The file system instance from where to read the files.
+ * @param n             The maximum number of files to read, if n <= 0 all the
+ *                      files are read.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return the list of the files read as decoded
+ *                      gnl_simfs_evicted_file elements on success, NULL
+ *                      otherwise; an empty file system is returned as
+ *                      NULL with errno set to 0.
+ */
+extern struct gnl_list_t *gnl_simfs_file_system_read_n(struct gnl_simfs_file_system *file_system, int n,
+        unsigned int pid);
+
 /**
  * Get the list of all files present into the file system.
  *
@@ -189,31 +361,31 @@ extern int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_syste
 extern struct gnl_list_t *gnl_simfs_file_system_ls(struct gnl_simfs_file_system *file_system, unsigned int pid);
 
 /**
- * Get a copy of the inode of the given filename. The inode returned is put
- * into the given buf.
+ * Get the status of the file of the given filename. The status is put
+ * into the given buf, whose name must be freed by the caller.
  *
- * @param file_system   The file system instance where to get the inode.
+ * @param file_system   The file system instance where to get the status.
  * @param filename      The filename of the file to get the information.
- * @param buf           The pointer to use to get the inode.
+ * @param buf           The pointer to use to get the status.
  * @param pid           The id of the process who invoked this method.
  *
  * @return              Return 0 on success, -1 otherwise.
  */
 extern int gnl_simfs_file_system_stat(struct gnl_simfs_file_system *file_system, const char *filename,
-        struct gnl_simfs_inode *buf, unsigned int pid);
+        struct gnl_simfs_stat *buf, unsigned int pid);
 
 /**
- * Get a copy of the inode of the given fd. The inode returned is put
- * into the given buf.
+ * Get the status of the file of the given fd. The status is put
+ * into the given buf, whose name must be freed by the caller.
  *
- * @param file_system   The file system instance where to get the inode.
- * @param fd            The file descriptor of which get the inode.
- * @param buf           The pointer to use to get the inode.
+ * @param file_system   The file system instance where to get the status.
+ * @param fd            The file descriptor of which get the status.
+ * @param buf           The pointer to use to get the status.
  * @param pid           The id of the process who invoked this method.
  *
  * @return              Return 0 on success, -1 otherwise.
  */
-extern int gnl_simfs_file_system_fstat(struct gnl_simfs_file_system *file_system, int fd, struct gnl_simfs_inode *buf,
+extern int gnl_simfs_file_system_fstat(struct gnl_simfs_file_system *file_system, int fd, struct gnl_simfs_stat *buf,
         unsigned int pid);
 
 /**
@@ -237,16 +409,52 @@ extern int gnl_simfs_file_system_status(struct gnl_simfs_file_system *file_syste
  */
 extern int gnl_simfs_file_system_get_replacement_policy(struct gnl_simfs_file_system *file_system, char **dest);
 
+/**
+ * Get the string representation of the compression of the given
+ * file system. The output string dest will be written with the
+ * string type of the compression.
+ *
+ * @param file_system   The file system instance.
+ * @param dest          The pointer where to put the string representation.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_file_system_get_compression(struct gnl_simfs_file_system *file_system, char **dest);
+
+/**
+ * Reclaim memory ahead of the writes: if the heap size of the given file system is
+ * above the high watermark, evict files in accordance with the replacement policy
+ * until the heap size is not above the low watermark. The evicted files are parked
+ * into a queue and handed over to the evicted list of the next write, no parked file
+ * is ever dropped: while too many files are parked, nothing is evicted until a write
+ * drains them.
+ *
+ * @param file_system       The file system instance where to reclaim memory.
+ * @param high_watermark    The percentage of the memory limit above which to start evicting.
+ * @param low_watermark     The percentage of the memory limit where to stop evicting,
+ *                          it can not be greater than the high_watermark.
+ *
+ * @return                  Returns the count of bytes freed on success, -1 otherwise.
+ */
+extern long long gnl_simfs_file_system_reclaim(struct gnl_simfs_file_system *file_system, unsigned int high_watermark,
+        unsigned int low_watermark);
+
 /**
  * Clean the file descriptor table and unlock the files locked by the
  * given pid. This function should be called if a pid ends his session
- * within the given file system.
+ * within the given file system. If a file can not be closed or unlocked,
+ * the others are closed and unlocked anyway, and the errno of the first
+ * failure is set.
  *
  * @param file_system   The file system instance to use to clean the pid session.
  * @param pid           The pid to remove from the file system.
+ * @param targets       If not NULL, the pointer to a list where to insert the names
+ *                      of the files closed or unlocked, so that the pids waiting
+ *                      for them can try again; a name may be inserted twice.
  *
  * @return              Returns 0 on success, -1 otherwise.
  */
-extern int gnl_simfs_file_system_remove_session(struct gnl_simfs_file_system *file_system, unsigned int pid);
+extern int gnl_simfs_file_system_remove_session(struct gnl_simfs_file_system *file_system, unsigned int pid,
+        struct gnl_list_t **targets);
 
 #endif //GNL_SIMFS_FILE_SYSTEM_H
\ No newline at end of file
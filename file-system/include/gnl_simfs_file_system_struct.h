@@ -1,14 +1,36 @@
 #ifndef GNL_SIMFS_FILE_SYSTEM_STRUCT_H
 #define GNL_SIMFS_FILE_SYSTEM_STRUCT_H
 
+/**
+ * A shard of the file system, it holds the partition of the files
+ * whose filename hash falls into it.
+ */
+struct gnl_simfs_file_system_shard {
+
+    // the identifier of the shard, it is its index
+    // into the shards array of the file system
+    int id;
+
+    // the shard file table, contains the inodes of the
+    // files that belong to the shard
+    struct gnl_simfs_file_table *file_table;
+
+    // the lock of the shard, it guards the file table
+    // and the inodes of the shard
+    pthread_mutex_t mtx;
+};
+
 /**
  * The file system structure.
  */
 struct gnl_simfs_file_system {
 
-    // the file system file table, contains all the inodes of the
-    // files present into the file system
-    struct gnl_simfs_file_table *file_table;
+    // the file system shards, all together they contain
+    // all the inodes of the files present into the file system
+    struct gnl_simfs_file_system_shard *shards;
+
+    // the number of shards of the file system
+    int shards_count;
 
     // the number of files that can be handled by the file system
     int files_limit;
@@ -21,9 +43,28 @@ struct gnl_simfs_file_system {
     // copy of the inode of the file.
     struct gnl_simfs_file_descriptor_table *file_descriptor_table;
 
-    // the lock of the file system
+    // the sessions of the pids, they list the open file
+    // descriptors and the locks held by every pid
+    struct gnl_simfs_session_table *session_table;
+
+    // the eviction lock of the file system, it serializes the global
+    // quota checks and the evictions, which are the only operations
+    // that coordinate across the shards
     pthread_mutex_t mtx;
 
+    // the lock of the global accounting, it guards the monitor,
+    // the reserved bytes and the evicted queue
+    pthread_mutex_t quota_mtx;
+
+    // the bytes reserved by the writes in progress, they are
+    // counted as used until the write ends
+    unsigned long long reserved_bytes;
+
+    // the files evicted in background by the reclaimer, they are
+    // parked here until a write drains them into its evicted list;
+    // it is guarded by the lock of the global accounting
+    struct gnl_queue_t *evicted_queue;
+
     // the logger instance to use for logging
     struct gnl_logger *logger;
 
@@ -31,6 +72,13 @@ struct gnl_simfs_file_system {
     // the given memory_limit or the given file_limit
     enum gnl_simfs_replacement_policy replacement_policy;
 
+    // the index of the files ordered in accordance with the
+    // replacement policy, it gives the next victim to evict
+    struct gnl_simfs_policy_index *policy_index;
+
+    // the compression of the files written into the file system
+    enum gnl_simfs_compression compression;
+
     // the monitor instance to store the operations stats
     struct gnl_simfs_monitor *monitor;
 };
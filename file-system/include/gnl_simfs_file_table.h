@@ -1,7 +1,8 @@
 #ifndef GNL_SIMFS_FILE_TABLE_H
 #define GNL_SIMFS_FILE_TABLE_H
 
-#include <gnl_list_t.h>
+#include <stddef.h>
+#include "./gnl_simfs_inode.h"
 
 /**
  * The file table data structure.
@@ -44,14 +45,29 @@ static unsigned long gnl_simfs_file_table_size(struct gnl_simfs_file_table *file
 static int gnl_simfs_file_table_count(struct gnl_simfs_file_table *file_table);
 
 /**
- * Get a copy of the file list of the given file table.
- *
- * @param file_table    The file table instance from where to get the file list.
- *
- * @return              Returns a copy of the file list of the given file table on success,
- *                      NULL otherwise.
+ * Visit in place the inodes of the given file table, without copying them.
+ * The entries are visited backwards from the given cursor, that is updated
+ * to resume the visit later: a visit starts with the cursor set to the count
+ * of the file table and it is over when the cursor is 0. The visitor must not
+ * remove entries from the file table.
+ *
+ * A visit can be paged releasing the lock of the file table between two pages:
+ * the files present for the whole visit are visited at least once, the files
+ * removed in the meanwhile can move an already visited file under the cursor.
+ *
+ * @param file_table    The file table instance to visit.
+ * @param cursor        The cursor of the visit.
+ * @param max           The maximum number of inodes to visit, if <= 0 all the
+ *                      inodes under the cursor are visited.
+ * @param visit         The visitor to call on every inode, it returns 0 to go
+ *                      on with the visit, 1 to stop it, -1 on error.
+ * @param arg           The argument to pass to the visitor.
+ *
+ * @return              Returns the number of inodes visited on success,
+ *                      -1 otherwise.
  */
-static struct gnl_list_t *gnl_simfs_file_table_list(struct gnl_simfs_file_table *file_table);
+static int gnl_simfs_file_table_visit(struct gnl_simfs_file_table *file_table, size_t *cursor, int max,
+                                      int (*visit)(struct gnl_simfs_inode *inode, void *arg), void *arg);
 
 /**
  * Get the inode of the given filename.
@@ -76,15 +92,41 @@ static struct gnl_simfs_inode *gnl_simfs_file_table_get(struct gnl_simfs_file_ta
 static struct gnl_simfs_inode *gnl_simfs_file_table_create(struct gnl_simfs_file_table *file_table, const char *filename);
 
 /**
- * Flush the given inode into the given file table.
+ * Get the inode referred by the given handle. The shard of the
+ * handle is not checked, it is up to the caller to give the handle
+ * to the file table of its shard.
+ *
+ * @param file_table    The file table instance from where to get the inode.
+ * @param handle        The handle of the inode to get.
+ *
+ * @return              Returns the inode of the given handle on success,
+ *                      NULL otherwise: if the inode was removed from the
+ *                      file table the errno is set to ENOENT.
+ */
+static struct gnl_simfs_inode *gnl_simfs_file_table_get_by_handle(struct gnl_simfs_file_table *file_table,
+                                                                  const struct gnl_simfs_inode_handle *handle);
+
+/**
+ * Fill the given handle with the hash and the generation of the given
+ * inode of the file table, the shard is left to the caller.
+ *
+ * @param inode     The inode of the file table.
+ * @param handle    The handle to fill.
+ */
+static void gnl_simfs_file_table_handle(const struct gnl_simfs_inode *inode, struct gnl_simfs_inode_handle *handle);
+
+/**
+ * Flush the given buffer into the file of the given inode of the file table.
  *
- * @param file_table    The file table instance where to flush the inode.
- * @param inode         The inode to use to flush. It must be a copy of an original
+ * @param file_table    The file table instance where to flush the buffer.
+ * @param inode         The inode where to flush the buffer, it must be an
  *                      inode got from the file table.
+ * @param buffer        The buffer to flush, it is reset.
  *
  * @return              Returns 0 on success, -1 otherwise.
  */
-static int gnl_simfs_file_table_fflush(struct gnl_simfs_file_table *file_table, struct gnl_simfs_inode *new_inode);
+static int gnl_simfs_file_table_fflush(struct gnl_simfs_file_table *file_table, struct gnl_simfs_inode *inode,
+                                       struct gnl_simfs_inode_buffer *buffer);
 
 /**
  * Remove an existing file table entry.
@@ -17,20 +17,12 @@ extern struct gnl_simfs_inode *gnl_simfs_inode_init(const char *name);
 
 /**
  * Destroy the given gnl_simfs_inode. Attention! This invocation
- * will delete also the file pointed by the given inode. If you want
- * to delete an inode-copy, use gnl_simfs_inode_copy_destroy instead.
+ * will delete also the file pointed by the given inode.
  *
  * @param inode The inode instance to destroy.
  */
 extern void gnl_simfs_inode_destroy(struct gnl_simfs_inode *inode);
 
-/**
- * Destroy the given gnl_simfs_inode but preserve the pointed file.
- *
- * @param inode The inode instance to destroy.
- */
-extern void gnl_simfs_inode_copy_destroy(struct gnl_simfs_inode *inode);
-
 /**
  * Check whether the file of the given inode is locked or not.
  *
@@ -41,20 +33,6 @@ extern void gnl_simfs_inode_copy_destroy(struct gnl_simfs_inode *inode);
  */
 extern int gnl_simfs_inode_is_file_locked(struct gnl_simfs_inode *inode);
 
-/**
- * Wait for a file to became available using condition variable.
- * Attention! This method will suspend the process execution
- * until the target file will become available.
- *
- * @param inode The inode instance containing the file where
- *              to wait the unlock.
- * @param mtx   The lock of the invoking process to release and
- *              subsequently re-acquire on the file unlock.
- *
- * @return      Returns 0 on success, -1 otherwise.
- */
-extern int gnl_simfs_inode_wait_file_lockability(struct gnl_simfs_inode *inode, pthread_mutex_t *mtx);
-
 /**
  * Increase the reference count of the given inode.
  *
@@ -85,6 +63,17 @@ extern int gnl_simfs_inode_decrease_refs(struct gnl_simfs_inode *inode, unsigned
  */
 extern int gnl_simfs_inode_has_refs(struct gnl_simfs_inode *inode);
 
+/**
+ * Get the reference count of the given inode, that is the sum of
+ * the references counted for each of its owners.
+ *
+ * @param inode The inode instance to check.
+ *
+ * @return      Returns the reference count of the inode on success,
+ *              -1 otherwise.
+ */
+extern int gnl_simfs_inode_reference_count(struct gnl_simfs_inode *inode);
+
 /**
  * Check if the inode has any other pid references besides the given pid.
  *
@@ -120,53 +109,44 @@ extern int gnl_simfs_inode_file_lock(struct gnl_simfs_inode *inode, unsigned int
 extern int gnl_simfs_inode_file_unlock(struct gnl_simfs_inode *inode, unsigned int pid);
 
 /**
- * Increase the pending locks count of the given inode.
+ * Mark the given pid as the one waiting to lock the file of the given
+ * inode. Only one pid per time can wait: if two pids holding the file
+ * open waited for each other to close it, none of them would ever lock it.
  *
- * @param inode The inode instance where to increase the
- *              pending locks count.
+ * @param inode The inode instance containing the file to lock.
+ * @param pid   The id of the process who waits to lock the file.
  *
- * @return      Returns 0 on success, -1 otherwise.
+ * @return      Returns 0 on success, -1 otherwise, with errno set to
+ *              EDEADLK if another pid is already waiting.
  */
-extern int gnl_simfs_inode_increase_pending_locks(struct gnl_simfs_inode *inode);
+extern int gnl_simfs_inode_set_pending_lock(struct gnl_simfs_inode *inode, unsigned int pid);
 
 /**
- * Decrease the pending locks count of the given inode.
+ * Stop waiting to lock the file of the given inode. If the given pid
+ * is not the one waiting, nothing happens.
  *
- * @param inode The inode instance where to decrease the
- *              pending locks count.
+ * @param inode The inode instance containing the file to lock.
+ * @param pid   The id of the process who waited to lock the file.
  *
  * @return      Returns 0 on success, -1 otherwise.
  */
-extern int gnl_simfs_inode_decrease_pending_locks(struct gnl_simfs_inode *inode);
+extern int gnl_simfs_inode_clear_pending_lock(struct gnl_simfs_inode *inode, unsigned int pid);
 
 /**
- * Check whether the inode has pending_locks.
+ * Check whether a pid is waiting to lock the file of the given inode.
  *
  * @param inode The inode instance to check.
  *
- * @return      Returns 1 if the inode has one or more pending locks,
- *              0 otherwise, if an error occurred, returns -1.
+ * @return      Returns the id of the process waiting to lock the file,
+ *              0 if there is none, -1 on error.
  */
 extern int gnl_simfs_inode_has_pending_locks(struct gnl_simfs_inode *inode);
 
-/**
- * Write up to count bytes from the buffer starting at buf to the
- * file within the given inode. This method updates the given inode
- * size and mtime attributes.
- *
- * @param inode The inode instance where to write to the file.
- * @param buf   The buffer pointer containing the data to write.
- * @param count The count of bytes to write.
- *
- * @return      Returns the number of bytes wrote into the file on success,
- *              -1 otherwise.
- */
-extern int gnl_simfs_inode_write(struct gnl_simfs_inode *inode, const void *buf, size_t count);
-
 /**
  * Read the whole file within the given inode into the given buffer, and
- * write the number of bytes read into the given count. This method updates
- * the given inode atime attribute.
+ * write the number of bytes read into the given count. The chunks of the
+ * file are decompressed straight into the given buffer, and they are not
+ * modified by the read. This method updates the given inode atime attribute.
  *
  * @param inode The inode instance where to write to the file.
  * @param buf   The buffer pointer where to write the read data.
@@ -177,24 +157,70 @@ extern int gnl_simfs_inode_write(struct gnl_simfs_inode *inode, const void *buf,
 extern int gnl_simfs_inode_read(struct gnl_simfs_inode *inode, void **buf, size_t *count);
 
 /**
- * Create and return a copy of the given inode. The copy does not preserve
- * the original inode buffer and the original reference list.
+ * Read a piece of the file within the given inode, starting at the given
+ * offset, into a new buffer, so that a file can be read in bounded pieces.
+ * The piece ends at the end of the chunk holding the offset, and it is at
+ * most max bytes long. A compressed chunk is decoded as a whole, so a max
+ * not smaller than GNL_SIMFS_INODE_CHUNK_MAX_COUNT reads every chunk with
+ * one decoding. This method updates the given inode atime attribute.
  *
- * @param inode The inode instance to copy.
+ * @param inode     The inode instance where to read the file.
+ * @param offset    The offset of the first byte to read.
+ * @param max       The maximum number of bytes to read, it must be > 0.
+ * @param buf       The buffer pointer where to write the read data, it is
+ *                  set to NULL if the offset is past the end of the file.
+ * @param count     The count of bytes read, 0 if the offset is past the
+ *                  end of the file.
  *
- * @return      Returns a copy of the given inode on success, -1 otherwise.
+ * @return          Returns 0 on success, -1 otherwise.
  */
-extern struct gnl_simfs_inode *gnl_simfs_inode_copy(const struct gnl_simfs_inode *inode);
+extern int gnl_simfs_inode_read_chunk(struct gnl_simfs_inode *inode, size_t offset, size_t max, void **buf,
+        size_t *count);
 
 /**
- * Flush the buffer of the given inode into his direct pointer. This method
- * will reset the buffer and will update the mtime, ctime, size and direct_ptr
- * attributes of the given inode.
+ * Write up to count bytes from the buffer starting at buf to the given
+ * buffer. The bytes are compressed into a new chunk once and for all. The
+ * given buffer is not bound to any inode, so the bytes can be written
+ * without holding the inode, and appended to it later by the
+ * gnl_simfs_inode_fflush_buffer method. More than
+ * GNL_SIMFS_INODE_CHUNK_MAX_COUNT bytes are split into more chunks, and
+ * their ownership is never taken.
  *
- * @param inode The inode to be flushed.
+ * @param buffer        The buffer where to write.
+ * @param compression   The compression to use for the bytes.
+ * @param buf           The buffer pointer containing the data to write.
+ * @param owned         The pointer to buf, if its ownership can be taken,
+ *                      NULL otherwise: if the bytes are stored as they are,
+ *                      the new chunk takes the buffer and *owned is set
+ *                      to NULL.
+ * @param count         The count of bytes to write.
  *
- * @return      Returns 0 on success, -1 otherwise.
+ * @return              Returns the number of bytes wrote into the buffer on
+ *                      success, -1 otherwise.
+ */
+extern int gnl_simfs_inode_buffer_write(struct gnl_simfs_inode_buffer *buffer, enum gnl_simfs_compression compression,
+        const void *buf, void **owned, size_t count);
+
+/**
+ * Discard the given buffer, destroying the chunks not flushed yet.
+ *
+ * @param buffer    The buffer to discard.
+ */
+extern void gnl_simfs_inode_buffer_clear(struct gnl_simfs_inode_buffer *buffer);
+
+/**
+ * Flush the given buffer into the file of the given inode. The buffered
+ * chunks are appended to the file without any further compression, so the
+ * cost of a flush does not depend on the size of the file. The inode takes
+ * the ownership of the chunks and the given buffer is reset. This method
+ * updates the mtime, ctime, size, direct_ptr and last_chunk attributes of
+ * the given inode.
+ *
+ * @param inode     The inode where to flush the buffer.
+ * @param buffer    The buffer to flush.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
  */
-extern int gnl_simfs_inode_fflush(struct gnl_simfs_inode *inode);
+extern int gnl_simfs_inode_fflush_buffer(struct gnl_simfs_inode *inode, struct gnl_simfs_inode_buffer *buffer);
 
 #endif //GNL_SIMFS_INODE_H
\ No newline at end of file
@@ -1,14 +1,140 @@
 #ifndef GNL_SIMFS_INODE_STRUCT_H
 #define GNL_SIMFS_INODE_STRUCT_H
 
-#include <pthread.h>
-#include <gnl_list_t.h>
+#include <time.h>
+#include "./gnl_simfs_codec.h"
+
+/**
+ * A chunk of a file within an inode. Every write appends new,
+ * independently compressed, chunks to the file, so the bytes
+ * already written are never decompressed or compressed again.
+ */
+struct gnl_simfs_inode_chunk {
+
+    // the codec used to store the chunk
+    enum gnl_simfs_compression codec;
+
+    // the stored bytes of the chunk
+    void *data;
+
+    // the size in bytes of the stored bytes
+    size_t size;
+
+    // the size in bytes of the chunk once decompressed
+    size_t count;
+
+    // the next chunk of the file
+    struct gnl_simfs_inode_chunk *next;
+};
+
+/**
+ * The max number of bytes of a file held by a chunk once decompressed:
+ * the bigger writes are split into more chunks, so a file can be read
+ * in bounded pieces without decoding a chunk more than once.
+ */
+#define GNL_SIMFS_INODE_CHUNK_MAX_COUNT 1048576
+
+/**
+ * A buffer of the writes on a file, it contains the compressed
+ * chunks not flushed yet into the file.
+ */
+struct gnl_simfs_inode_buffer {
+
+    // the chunks not flushed yet
+    struct gnl_simfs_inode_chunk *chunks;
+
+    // the size in bytes of the chunks (compressed)
+    int size;
+};
+
+/**
+ * The handle of an inode. It refers an inode without pointing it, so
+ * it can outlive the inode: a handle of a removed inode is never resolved,
+ * not even to a new inode with the same name.
+ */
+struct gnl_simfs_inode_handle {
+
+    // the shard of the file system where the inode resides
+    unsigned int shard;
+
+    // the hash of the name of the inode into its file table
+    unsigned int hash;
+
+    // the generation of the inode into its file table
+    unsigned long generation;
+};
+
+/**
+ * The number of reference owners of an inode stored within the inode
+ * itself, the others are stored into a separated array.
+ */
+#define GNL_SIMFS_INODE_INLINE_REFS 2
+
+/**
+ * A reference owner of an inode, with the count of its references.
+ */
+struct gnl_simfs_inode_ref {
+
+    // the id of the reference owner
+    unsigned int pid;
+
+    // the count of the references of the owner
+    unsigned int count;
+};
 
 /**
  * File's inode for the Simplified In Memory File System (SIMFS).
  */
 struct gnl_simfs_inode {
 
+    // the attributes checked by every access to the file are
+    // placed first, so they lie within the first 64 bytes of the
+    // inode and an access touches as few cache lines as possible
+
+    // the logical time of the last access to the file, it is
+    // given by a counter of the policy index incremented on
+    // every access, so two accesses never tie
+    unsigned long long access_clock;
+
+    // the size in bytes of the file within the inode
+    unsigned int size;
+
+    // the owner id of the lock, it should be a number > 0:
+    // if 0 then the inode is unlocked, if > 0 the inode is locked;
+    // we do not use native lock implementation here because
+    // the lock status must persist between different methods invocations
+    unsigned int locked;
+
+    // the id of the pid waiting to lock the pointed file, it
+    // should be a number > 0: if 0 then no pid is waiting
+    unsigned int pending_lock;
+
+    // the reference owners of the inode, each one once with the
+    // count of its references, whose sum is the reference count
+    // of the inode; the first GNL_SIMFS_INODE_INLINE_REFS
+    // owners are stored here, so the common case of a file opened
+    // by one or two processes does not allocate memory
+    struct gnl_simfs_inode_ref refs[GNL_SIMFS_INODE_INLINE_REFS];
+
+    // the reference owners of the inode when they are more than
+    // GNL_SIMFS_INODE_INLINE_REFS, NULL otherwise: once allocated,
+    // it holds all the owners until none of them is left
+    struct gnl_simfs_inode_ref *refs_spill;
+
+    // the number of the reference owners of the inode
+    unsigned short refs_size;
+
+    // the capacity of the refs_spill array
+    unsigned short refs_capacity;
+
+    // the name of the file pointed by
+    // the direct_ptr attribute
+    char *name;
+
+    // the generation of the inode, it is given by its file
+    // table and it is never given to another inode of the table
+    unsigned long generation;
+
     // the creation time timestamp of the file
     // within the inode, it is set on file
     // creation and not changed subsequently.
@@ -27,39 +153,42 @@ struct gnl_simfs_inode {
     // sets on the inode information
     time_t ctime;
 
-    // the size in bytes of the file within the inode
-    unsigned int size;
-
-    // the name of the file pointed by
-    // the direct_ptr attribute
-    char *name;
-
-    // the direct pointer to read from the file
-    void *direct_ptr;
-
-    // the buffer to write in a file
-    void *buffer;
-
-    // the buffer size in bytes
-    int buffer_size;
-
-    // the owner id of the lock, it should be a number > 0:
-    // if 0 then the inode is unlocked, if > 0 the inode is locked;
-    // we do not use native lock implementation here because
-    // the lock status must persist between different methods invocations
-    unsigned int locked;
-
-    // the condition variable to track if a file can be locked
-    pthread_cond_t file_is_lockable;
-
-    // the reference count of the inode
-    unsigned int reference_count;
-
-    // the list containing the reference owners of the inode
-    struct gnl_list_t *reference_list;
-
-    // the count of pid that want to lock the pointed file
-    unsigned int pending_locks;
+    // the direct pointer to read from the file,
+    // it points to the first chunk of the file
+    struct gnl_simfs_inode_chunk *direct_ptr;
+
+    // the last chunk of the file, the flushed
+    // chunks are appended after it
+    struct gnl_simfs_inode_chunk *last_chunk;
+
+    // the previous and the next inode in the policy index
+    // of the file system, they are set only on original inodes
+    struct gnl_simfs_inode *policy_prev;
+    struct gnl_simfs_inode *policy_next;
+
+    // the frequency bucket of the inode in the policy index,
+    // it is used only by the LFU replacement policy
+    struct gnl_simfs_policy_bucket *policy_bucket;
+
+    // the position of the inode into the priority heap of the
+    // policy index and its priority, they are used only by the
+    // GDSF replacement policy
+    size_t policy_position;
+    double policy_priority;
+
+    // the count of the accesses to the file, halved on every
+    // aging of the policy index
+    unsigned long frequency;
+
+    // the queue of the policy index where the inode resides, the
+    // policies with more than one queue (ARC, 2Q, W-TinyLFU) move
+    // the inode among them, -1 if the inode is not indexed
+    int policy_queue;
+
+    // the aging epoch of the policy index when the frequency
+    // was last updated, the agings occurred since then are
+    // applied lazily on the next access
+    unsigned int frequency_epoch;
 };
 
-#endif //GNL_SIMFS_INODE_STRUCT_H
\ No newline at end of file
+#endif //GNL_SIMFS_INODE_STRUCT_H
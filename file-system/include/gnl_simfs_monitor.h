@@ -73,4 +73,20 @@ extern int gnl_simfs_monitor_bytes_removed(struct gnl_simfs_monitor *monitor, un
  */
 extern int gnl_simfs_monitor_eviction_started(struct gnl_simfs_monitor *monitor);
 
+/**
+ * Track a hit. It should be called whenever an
+ * existing file is looked up and found.
+ * @param monitor   The monitor instance where to track.
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_monitor_file_hit(struct gnl_simfs_monitor *monitor);
+
+/**
+ * Track a miss. It should be called whenever an
+ * existing file is looked up but not found.
+ * @param monitor   The monitor instance where to track.
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_monitor_file_missed(struct gnl_simfs_monitor *monitor);
+
 #endif //GNL_SIMFS_MONITOR_H
\ No newline at end of file
@@ -0,0 +1,135 @@
+#ifndef GNL_SIMFS_POLICY_INDEX_H
+#define GNL_SIMFS_POLICY_INDEX_H
+
+#include "./gnl_simfs_inode_struct.h"
+#include "./gnl_simfs_file_system.h"
+
+/**
+ * The policy index data structure. It keeps the inodes of a file system
+ * ordered in accordance with a replacement policy, so the next victim
+ * can be got in constant time. The index is updated on every access
+ * to an inode, instead of being rebuilt on every eviction.
+ */
+struct gnl_simfs_policy_index;
+
+/**
+ * Create a new policy index instance.
+ *
+ * @param policy    The replacement policy that orders the index.
+ * @param aging     The number of accesses after which the access frequencies
+ *                  of all the inodes are halved, so the files that were
+ *                  popular only in the past can be evicted. If 0, the
+ *                  frequencies never age.
+ *
+ * @return          Returns the new gnl_simfs_policy_index created on success,
+ *                  NULL otherwise.
+ */
+struct gnl_simfs_policy_index *gnl_simfs_policy_index_init(enum gnl_simfs_replacement_policy policy, unsigned int aging);
+
+/**
+ * Destroy the given policy index. The indexed inodes are not destroyed.
+ *
+ * @param index The policy index instance to destroy.
+ */
+void gnl_simfs_policy_index_destroy(struct gnl_simfs_policy_index *index);
+
+/**
+ * Insert the given inode into the given policy index. It should be called
+ * whenever a file is created.
+ *
+ * @param index The policy index instance where to insert the inode.
+ * @param inode The original inode to insert.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_policy_index_insert(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode);
+
+/**
+ * Track a reference to the given inode: its access clock and its access frequency
+ * are updated, and so its position into the given policy index. It should be
+ * called whenever the file pointed by the inode is opened.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The original inode accessed.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_policy_index_touch(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode);
+
+/**
+ * Track a use of the given inode within the open that referenced it: its access
+ * clock is updated, and so its recency and its size into the given policy index,
+ * but not its access frequency, since the reads and the writes of an open are
+ * correlated to it. It should be called whenever the file pointed by the inode
+ * is read or written.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The original inode used.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_policy_index_update(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode);
+
+/**
+ * Remove the given inode from the given policy index. It should be
+ * called whenever a file is removed, before its inode is destroyed.
+ * Removing an inode already evicted has no effect.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The original inode to remove.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_policy_index_remove(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode);
+
+/**
+ * Remove the given victim from the given policy index, keeping the history
+ * needed by the replacement policy: ARC and 2Q remember the name of the
+ * victim, so a file re-created soon after its eviction is recognized as
+ * frequently used, while GDSF inflates the priorities of the next accesses.
+ * It should be called whenever a file is evicted, before its inode is destroyed.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The original inode to evict.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_policy_index_evict(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode);
+
+/**
+ * Get the next victim of the given policy index, the victim is not removed.
+ * W-TinyLFU settles here the admission of the candidates moved out of its
+ * window: each of them duels the victim of the main segments and the
+ * winners enter the probation segment.
+ *
+ * @param index The policy index instance from where to get the victim.
+ *
+ * @return      Returns the inode of the next victim on success,
+ *              NULL otherwise. If the index is empty, the errno
+ *              is set to ENOENT.
+ */
+static struct gnl_simfs_inode *gnl_simfs_policy_index_victim(struct gnl_simfs_policy_index *index);
+
+/**
+ * Get the access frequency of the given inode, with all the agings
+ * of the given policy index applied.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The original inode.
+ *
+ * @return      Returns the access frequency of the given inode on success,
+ *              -1 otherwise.
+ */
+static long gnl_simfs_policy_index_frequency(struct gnl_simfs_policy_index *index, const struct gnl_simfs_inode *inode);
+
+/**
+ * Get the count of the inodes present into the given policy index.
+ *
+ * @param index The policy index instance from where to get the count.
+ *
+ * @return      Returns the count of the indexed inodes on success,
+ *              -1 otherwise.
+ */
+static int gnl_simfs_policy_index_count(struct gnl_simfs_policy_index *index);
+
+#endif //GNL_SIMFS_POLICY_INDEX_H
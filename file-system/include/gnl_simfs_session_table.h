@@ -0,0 +1,125 @@
+#ifndef GNL_SIMFS_SESSION_TABLE_H
+#define GNL_SIMFS_SESSION_TABLE_H
+
+/**
+ * The session of a pid. It lists what the pid is using of
+ * the file system, so its teardown does not need to scan
+ * all the files of the file system.
+ */
+struct gnl_simfs_session {
+
+    // the id of the process of the session
+    unsigned int pid;
+
+    // the file descriptors opened by the pid
+    int *fds;
+
+    // the number of file descriptors opened by the pid
+    int fds_count;
+
+    // the number of file descriptors allocated
+    int fds_capacity;
+
+    // the names of the files locked by the pid
+    char **locks;
+
+    // the number of files locked by the pid
+    int locks_count;
+
+    // the number of file names allocated
+    int locks_capacity;
+
+    // the next session of the same bucket
+    struct gnl_simfs_session *next;
+};
+
+/**
+ * The session table data structure, it indexes
+ * the sessions of the file system by pid.
+ */
+struct gnl_simfs_session_table;
+
+/**
+ * Create a new session table instance.
+ *
+ * @return  Returns the new gnl_simfs_session_table created on success,
+ *          NULL otherwise.
+ */
+extern struct gnl_simfs_session_table *gnl_simfs_session_table_init();
+
+/**
+ * Destroy the given session table.
+ *
+ * @param table The session table instance to destroy.
+ */
+extern void gnl_simfs_session_table_destroy(struct gnl_simfs_session_table *table);
+
+/**
+ * Track a file descriptor opened by the given pid.
+ *
+ * @param table The session table instance.
+ * @param pid   The id of the process who opened the file descriptor.
+ * @param fd    The file descriptor opened.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_session_table_add_fd(struct gnl_simfs_session_table *table, unsigned int pid, int fd);
+
+/**
+ * Stop tracking a file descriptor closed by the given pid.
+ *
+ * @param table The session table instance.
+ * @param pid   The id of the process who closed the file descriptor.
+ * @param fd    The file descriptor closed.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_session_table_remove_fd(struct gnl_simfs_session_table *table, unsigned int pid, int fd);
+
+/**
+ * Track a file locked by the given pid. A file already tracked
+ * is not tracked twice.
+ *
+ * @param table     The session table instance.
+ * @param pid       The id of the process who locked the file.
+ * @param filename  The name of the file locked.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_session_table_add_lock(struct gnl_simfs_session_table *table, unsigned int pid,
+        const char *filename);
+
+/**
+ * Stop tracking a file unlocked, or removed, by the given pid.
+ *
+ * @param table     The session table instance.
+ * @param pid       The id of the process who unlocked the file.
+ * @param filename  The name of the file unlocked.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_simfs_session_table_remove_lock(struct gnl_simfs_session_table *table, unsigned int pid,
+        const char *filename);
+
+/**
+ * Detach the session of the given pid from the given session table. The caller
+ * takes the ownership of the session and must destroy it with the
+ * gnl_simfs_session_destroy method.
+ *
+ * @param table The session table instance.
+ * @param pid   The id of the process of the session to detach.
+ *
+ * @return      Returns the session of the given pid on success, NULL
+ *              otherwise. If the pid has no session the errno is set to 0.
+ */
+extern struct gnl_simfs_session *gnl_simfs_session_table_detach(struct gnl_simfs_session_table *table,
+        unsigned int pid);
+
+/**
+ * Destroy the given session.
+ *
+ * @param session   The session to destroy.
+ */
+extern void gnl_simfs_session_destroy(struct gnl_simfs_session *session);
+
+#endif //GNL_SIMFS_SESSION_TABLE_H
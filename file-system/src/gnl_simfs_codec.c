@@ -0,0 +1,604 @@
+#include <stdlib.h>
+#include <errno.h>
+#include <string.h>
+#include <stdint.h>
+#include <gnl_huffman_tree.h>
+#include "../include/gnl_simfs_codec.h"
+#include <gnl_macro_beg.h>
+
+// the max number of bytes sampled to estimate the entropy
+#define GNL_SIMFS_CODEC_SAMPLE_SIZE 4096
+
+// the min number of bytes for the entropy estimate to be meaningful:
+// the estimate of n samples can not exceed log2(n), so on fewer bytes
+// even random ones would look compressible
+#define GNL_SIMFS_CODEC_MIN_SAMPLE_SIZE 1024
+
+// the entropy in bits per byte above which the bytes
+// are considered incompressible by the auto compression
+#define GNL_SIMFS_CODEC_MAX_ENTROPY 7.5
+
+// the size of the code lengths table stored with every Huffman
+// artifact, no fewer bytes can be compressed by the Huffman codec
+#define GNL_SIMFS_CODEC_HUFFMAN_TABLE_SIZE 256
+
+// the min length of a match of the LZ codec
+#define GNL_SIMFS_LZ_MIN_MATCH 4
+
+// the max distance of a match of the LZ codec
+#define GNL_SIMFS_LZ_MAX_OFFSET 65535
+
+// the number of bits of the hash table of the LZ codec
+#define GNL_SIMFS_LZ_HASH_BITS 12
+
+/**
+ * The interface of a codec.
+ */
+struct gnl_simfs_codec {
+
+    // encode count bytes, write the size of the
+    // encoded data into size and return the data
+    void *(*encode)(const void *bytes, size_t count, size_t *size);
+
+    // decode the data of the given size into dest,
+    // and return the number of bytes decoded
+    int (*decode)(const void *data, size_t size, void *dest, size_t count);
+
+    // destroy the encoded data
+    void (*destroy)(void *data);
+};
+
+/**
+ * Store the given bytes as they are.
+ *
+ * @param bytes The bytes to encode.
+ * @param count The number of bytes to encode.
+ * @param size  The destination where to write the size of the encoded data.
+ *
+ * @return      Returns a copy of the given bytes on success, NULL otherwise.
+ */
+static void *raw_encode(const void *bytes, size_t count, size_t *size) {
+    void *data = malloc(count > 0 ? count : 1);
+    GNL_NULL_CHECK(data, ENOMEM, NULL)
+
+    memcpy(data, bytes, count);
+    *size = count;
+
+    return data;
+}
+
+/**
+ * Decode the given raw data.
+ *
+ * @param data  The data to decode.
+ * @param size  The size of the data.
+ * @param dest  The destination where to put the decoded bytes.
+ * @param count The number of bytes to decode.
+ *
+ * @return      Returns the number of bytes decoded.
+ */
+static int raw_decode(const void *data, size_t size, void *dest, size_t count) {
+    if (count > size) {
+        count = size;
+    }
+
+    memcpy(dest, data, count);
+
+    return count;
+}
+
+/**
+ * Encode the given bytes with the Huffman algorithm.
+ *
+ * @param bytes The bytes to encode.
+ * @param count The number of bytes to encode.
+ * @param size  The destination where to write the size of the encoded data.
+ *
+ * @return      Returns the huffman artifact on success, NULL otherwise.
+ */
+static void *huffman_encode(const void *bytes, size_t count, size_t *size) {
+    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(bytes, count);
+    GNL_NULL_CHECK(artifact, errno, NULL)
+
+    *size = gnl_huffman_tree_size(artifact);
+
+    return artifact;
+}
+
+/**
+ * Decode the given huffman artifact.
+ *
+ * @param data  The artifact to decode.
+ * @param size  The size of the artifact.
+ * @param dest  The destination where to put the decoded bytes.
+ * @param count The number of bytes to decode.
+ *
+ * @return      Returns the number of bytes decoded on success,
+ *              -1 otherwise.
+ */
+static int huffman_decode(const void *data, size_t size, void *dest, size_t count) {
+    return gnl_huffman_tree_decode_into(data, dest, count);
+}
+
+/**
+ * Destroy the given huffman artifact.
+ *
+ * @param data  The artifact to destroy.
+ */
+static void huffman_destroy(void *data) {
+    gnl_huffman_tree_destroy_artifact(data);
+}
+
+/**
+ * Write the extension of a length of the LZ codec: the part of
+ * the length exceeding the 4 bits of the token is written as
+ * a series of 255 bytes closed by a byte < 255.
+ *
+ * @param out   The destination where to write the length.
+ * @param len   The part of the length exceeding the token.
+ *
+ * @return      Returns the number of bytes written.
+ */
+static size_t lz_write_length(unsigned char *out, size_t len) {
+    size_t written = 0;
+
+    while (len >= 255) {
+        out[written++] = 255;
+        len -= 255;
+    }
+
+    out[written++] = len;
+
+    return written;
+}
+
+/**
+ * Write a sequence of the LZ codec: a token with the lengths,
+ * the literals and, if match_len > 0, the offset of the match.
+ *
+ * @param out           The destination where to write the sequence.
+ * @param literals      The literals of the sequence.
+ * @param literal_len   The number of literals.
+ * @param offset        The distance of the match.
+ * @param match_len     The length of the match, 0 for the last sequence.
+ *
+ * @return              Returns the number of bytes written.
+ */
+static size_t lz_write_sequence(unsigned char *out, const unsigned char *literals, size_t literal_len, size_t offset,
+        size_t match_len) {
+    size_t written = 1;
+
+    // the token holds the literals length in the high bits,
+    // the match length minus the min match in the low bits
+    unsigned char token = (literal_len >= 15 ? 15 : literal_len) << 4;
+    if (match_len > 0) {
+        token |= match_len - GNL_SIMFS_LZ_MIN_MATCH >= 15 ? 15 : match_len - GNL_SIMFS_LZ_MIN_MATCH;
+    }
+
+    out[0] = token;
+
+    if (literal_len >= 15) {
+        written += lz_write_length(out + written, literal_len - 15);
+    }
+
+    memcpy(out + written, literals, literal_len);
+    written += literal_len;
+
+    // the last sequence has no match
+    if (match_len == 0) {
+        return written;
+    }
+
+    out[written++] = offset & 0xFF;
+    out[written++] = offset >> 8;
+
+    if (match_len - GNL_SIMFS_LZ_MIN_MATCH >= 15) {
+        written += lz_write_length(out + written, match_len - GNL_SIMFS_LZ_MIN_MATCH - 15);
+    }
+
+    return written;
+}
+
+/**
+ * Encode the given bytes with the LZ77 algorithm. The matches are
+ * found with a hash table of the last position of every 4 bytes
+ * sequence, so the encoding is done in a single pass.
+ *
+ * @param bytes The bytes to encode.
+ * @param count The number of bytes to encode.
+ * @param size  The destination where to write the size of the encoded data.
+ *
+ * @return      Returns the encoded data on success, NULL otherwise.
+ */
+static void *lz_encode(const void *bytes, size_t count, size_t *size) {
+    const unsigned char *in = bytes;
+
+    // the worst case is a single sequence of literals
+    unsigned char *out = malloc(count + count / 255 + 16);
+    GNL_NULL_CHECK(out, ENOMEM, NULL)
+
+    // the last position + 1 of each hashed sequence, 0 if none
+    size_t *table = calloc(1 << GNL_SIMFS_LZ_HASH_BITS, sizeof(size_t));
+    if (table == NULL) {
+        free(out);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    size_t written = 0;
+    size_t anchor = 0;
+    size_t i = 0;
+    uint32_t sequence;
+
+    while (i + GNL_SIMFS_LZ_MIN_MATCH <= count) {
+        memcpy(&sequence, in + i, sizeof(uint32_t));
+
+        uint32_t hash = (sequence * 2654435761U) >> (32 - GNL_SIMFS_LZ_HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = i + 1;
+
+        // check if the candidate is a real match within reach
+        if (candidate == 0 || i - (candidate - 1) > GNL_SIMFS_LZ_MAX_OFFSET
+            || memcmp(in + candidate - 1, in + i, GNL_SIMFS_LZ_MIN_MATCH) != 0) {
+            i++;
+
+            continue;
+        }
+
+        // extend the match
+        size_t ref = candidate - 1;
+        size_t match_len = GNL_SIMFS_LZ_MIN_MATCH;
+        while (i + match_len < count && in[ref + match_len] == in[i + match_len]) {
+            match_len++;
+        }
+
+        written += lz_write_sequence(out + written, in + anchor, i - anchor, i - ref, match_len);
+
+        i += match_len;
+        anchor = i;
+    }
+
+    // the last sequence contains the remaining literals
+    written += lz_write_sequence(out + written, in + anchor, count - anchor, 0, 0);
+
+    free(table);
+
+    // release the unused memory
+    unsigned char *temp = realloc(out, written);
+    if (temp != NULL) {
+        out = temp;
+    }
+
+    *size = written;
+
+    return out;
+}
+
+/**
+ * Read the extension of a length of the LZ codec.
+ *
+ * @param in    The encoded data.
+ * @param size  The size of the encoded data.
+ * @param pos   The current position into the encoded data, it is
+ *              moved after the length.
+ * @param len   The length to extend.
+ *
+ * @return      Returns 0 on success, -1 if the data is truncated.
+ */
+static int lz_read_length(const unsigned char *in, size_t size, size_t *pos, size_t *len) {
+    unsigned char byte;
+
+    do {
+        if (*pos >= size) {
+            return -1;
+        }
+
+        byte = in[(*pos)++];
+        *len += byte;
+    } while (byte == 255);
+
+    return 0;
+}
+
+/**
+ * Decode the given LZ77 data.
+ *
+ * @param data  The data to decode.
+ * @param size  The size of the data.
+ * @param dest  The destination where to put the decoded bytes.
+ * @param count The number of bytes to decode.
+ *
+ * @return      Returns the number of bytes decoded on success,
+ *              -1 otherwise.
+ */
+static int lz_decode(const void *data, size_t size, void *dest, size_t count) {
+    const unsigned char *in = data;
+    unsigned char *out = dest;
+    size_t pos = 0;
+    size_t decoded = 0;
+
+    for (;;) {
+        // the stream must end with a sequence of literals only
+        if (pos == size) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        unsigned char token = in[pos++];
+
+        // copy the literals
+        size_t literal_len = token >> 4;
+        if (literal_len == 15 && lz_read_length(in, size, &pos, &literal_len) == -1) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        if (literal_len > size - pos || literal_len > count - decoded) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        memcpy(out + decoded, in + pos, literal_len);
+        pos += literal_len;
+        decoded += literal_len;
+
+        // the last sequence has no match
+        if (pos == size) {
+            break;
+        }
+
+        // copy the match
+        if (size - pos < 2) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        size_t offset = in[pos] | (in[pos + 1] << 8);
+        pos += 2;
+
+        size_t match_len = token & 0xF;
+        if (match_len == 15 && lz_read_length(in, size, &pos, &match_len) == -1) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        match_len += GNL_SIMFS_LZ_MIN_MATCH;
+
+        if (offset == 0 || offset > decoded || match_len > count - decoded) {
+            errno = EINVAL;
+
+            return -1;
+        }
+
+        // the match may overlap the bytes it is writing,
+        // so it is copied byte by byte
+        for (size_t i=0; i<match_len; i++) {
+            out[decoded + i] = out[decoded - offset + i];
+        }
+
+        decoded += match_len;
+    }
+
+    return decoded;
+}
+
+/**
+ * Destroy the given raw or LZ77 data.
+ *
+ * @param data  The data to destroy.
+ */
+static void plain_destroy(void *data) {
+    free(data);
+}
+
+/**
+ * The codecs, indexed by compression.
+ */
+static const struct gnl_simfs_codec gnl_simfs_codecs[] = {
+    [GNL_SIMFS_COMPRESSION_NONE] = {raw_encode, raw_decode, plain_destroy},
+    [GNL_SIMFS_COMPRESSION_HUFFMAN] = {huffman_encode, huffman_decode, huffman_destroy},
+    [GNL_SIMFS_COMPRESSION_LZ] = {lz_encode, lz_decode, plain_destroy}
+};
+
+/**
+ * Get an approximation of log2 of the given number, the error
+ * is less than 0.09. It avoids the dependency on the math library.
+ *
+ * @param x The number, it must be > 0.
+ *
+ * @return  Returns the approximated log2 of x.
+ */
+static double log2_approx(unsigned int x) {
+    int exponent = 0;
+
+    while ((x >> exponent) > 1) {
+        exponent++;
+    }
+
+    // interpolate linearly between the powers of 2
+    return exponent + (double)(x - (1U << exponent)) / (1U << exponent);
+}
+
+/**
+ * Estimate the entropy in bits per byte of the given bytes,
+ * sampling at most GNL_SIMFS_CODEC_SAMPLE_SIZE bytes.
+ *
+ * @param bytes The bytes.
+ * @param count The number of bytes.
+ *
+ * @return      Returns the estimated entropy.
+ */
+static double estimate_entropy(const void *bytes, size_t count) {
+    unsigned int freq[256] = {0};
+    const unsigned char *in = bytes;
+
+    // sample the bytes evenly
+    size_t step = count / GNL_SIMFS_CODEC_SAMPLE_SIZE + 1;
+    unsigned int samples = 0;
+
+    for (size_t i=0; i<count; i+=step) {
+        freq[in[i]]++;
+        samples++;
+    }
+
+    // H = log2(n) - sum(f * log2(f)) / n
+    double sum = 0;
+    for (size_t i=0; i<256; i++) {
+        if (freq[i] > 0) {
+            sum += freq[i] * log2_approx(freq[i]);
+        }
+    }
+
+    return log2_approx(samples) - sum / samples;
+}
+
+/**
+ * Store raw the given bytes: if the buffer is owned by the caller it is
+ * adopted as the encoded data, otherwise the bytes are copied.
+ *
+ * @param bytes The bytes to store.
+ * @param count The number of bytes to store.
+ * @param size  The destination where to write the size of the encoded data.
+ * @param owned The pointer to the buffer holding the bytes, if its ownership
+ *              can be taken, NULL otherwise. On adoption it is set to NULL.
+ *
+ * @return      Returns the encoded data on success, NULL otherwise.
+ */
+static void *store_raw(const void *bytes, size_t count, size_t *size, void **owned) {
+    if (owned == NULL) {
+        return raw_encode(bytes, count, size);
+    }
+
+    void *data = *owned;
+    *owned = NULL;
+    *size = count;
+
+    return data;
+}
+
+/**
+ * Encode the given bytes with the given compression.
+ *
+ * @param compression   The compression to use.
+ * @param bytes         The bytes to encode.
+ * @param count         The number of bytes to encode.
+ * @param codec         The destination where to write the codec actually used.
+ * @param size          The destination where to write the size of the encoded data.
+ * @param owned         The pointer to the buffer holding the bytes, if its ownership
+ *                      can be taken, NULL otherwise.
+ *
+ * @return              Returns the encoded data on success, NULL otherwise.
+ */
+static void *encode(enum gnl_simfs_compression compression, const void *bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size, void **owned) {
+    // validate the parameters
+    GNL_NULL_CHECK(bytes, EINVAL, NULL)
+    GNL_NULL_CHECK(codec, EINVAL, NULL)
+    GNL_NULL_CHECK(size, EINVAL, NULL)
+
+    if (compression != GNL_SIMFS_COMPRESSION_AUTO) {
+        if (compression > GNL_SIMFS_COMPRESSION_AUTO) {
+            errno = EINVAL;
+
+            return NULL;
+        }
+
+        *codec = compression;
+
+        if (compression == GNL_SIMFS_COMPRESSION_NONE) {
+            return store_raw(bytes, count, size, owned);
+        }
+
+        return gnl_simfs_codecs[compression].encode(bytes, count, size);
+    }
+
+    // store raw the bytes that can not pay for the code lengths
+    // table, or that look incompressible; the entropy is estimated
+    // only on enough bytes, the fewer ones are just encoded
+    if (count <= GNL_SIMFS_CODEC_HUFFMAN_TABLE_SIZE || (count >= GNL_SIMFS_CODEC_MIN_SAMPLE_SIZE
+        && estimate_entropy(bytes, count) >= GNL_SIMFS_CODEC_MAX_ENTROPY)) {
+        *codec = GNL_SIMFS_COMPRESSION_NONE;
+
+        return store_raw(bytes, count, size, owned);
+    }
+
+    *codec = GNL_SIMFS_COMPRESSION_HUFFMAN;
+
+    void *data = huffman_encode(bytes, count, size);
+    GNL_NULL_CHECK(data, errno, NULL)
+
+    // the stored size of the artifact, code lengths table
+    // included, is not smaller, so store raw the bytes
+    if (*size >= count) {
+        huffman_destroy(data);
+
+        *codec = GNL_SIMFS_COMPRESSION_NONE;
+
+        return store_raw(bytes, count, size, owned);
+    }
+
+    return data;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void *gnl_simfs_codec_encode(enum gnl_simfs_compression compression, const void *bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size) {
+    return encode(compression, bytes, count, codec, size, NULL);
+}
+
+/**
+ * {@inheritDoc}
+ */
+void *gnl_simfs_codec_encode_buffer(enum gnl_simfs_compression compression, void **bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size) {
+    GNL_NULL_CHECK(bytes, EINVAL, NULL)
+
+    return encode(compression, *bytes, count, codec, size, bytes);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_codec_decode(enum gnl_simfs_compression codec, const void *data, size_t size, void *dest,
+        size_t count) {
+    // validate the parameters
+    GNL_NULL_CHECK(data, EINVAL, -1)
+    GNL_NULL_CHECK(dest, EINVAL, -1)
+
+    if (codec >= GNL_SIMFS_COMPRESSION_AUTO) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    return gnl_simfs_codecs[codec].decode(data, size, dest, count);
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_simfs_codec_destroy(enum gnl_simfs_compression codec, void *data) {
+    if (data == NULL || codec >= GNL_SIMFS_COMPRESSION_AUTO) {
+        return;
+    }
+
+    gnl_simfs_codecs[codec].destroy(data);
+}
+
+#undef GNL_SIMFS_CODEC_SAMPLE_SIZE
+#undef GNL_SIMFS_CODEC_MIN_SAMPLE_SIZE
+#undef GNL_SIMFS_CODEC_MAX_ENTROPY
+#undef GNL_SIMFS_CODEC_HUFFMAN_TABLE_SIZE
+#undef GNL_SIMFS_LZ_MIN_MATCH
+#undef GNL_SIMFS_LZ_MAX_OFFSET
+#undef GNL_SIMFS_LZ_HASH_BITS
+
+#include <gnl_macro_end.h>
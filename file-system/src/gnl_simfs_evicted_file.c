@@ -1,8 +1,29 @@
+#include <stdlib.h>
 #include <errno.h>
 #include <string.h>
 #include "../include/gnl_simfs_evicted_file.h"
+#include "../include/gnl_simfs_inode_struct.h"
 #include <gnl_macro_beg.h>
 
+/**
+ * Destroy the given list of evicted chunks, and the
+ * compressed bytes within them.
+ *
+ * @param chunk The first chunk of the list to destroy.
+ */
+static void destroy_evicted_chunks(struct gnl_simfs_inode_chunk *chunk) {
+    struct gnl_simfs_inode_chunk *next;
+
+    while (chunk != NULL) {
+        next = chunk->next;
+
+        gnl_simfs_codec_destroy(chunk->codec, chunk->data);
+        free(chunk);
+
+        chunk = next;
+    }
+}
+
 /**
  * {@inheritDoc}
  */
@@ -13,10 +34,61 @@ struct gnl_simfs_evicted_file *gnl_simfs_evicted_file_init() {
     evicted_file->name = NULL;
     evicted_file->bytes = NULL;
     evicted_file->count = 0;
+    evicted_file->chunks = NULL;
 
     return evicted_file;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_evicted_file_decode(struct gnl_simfs_evicted_file *evicted_file) {
+    // validate the parameters
+    GNL_NULL_CHECK(evicted_file, EINVAL, -1)
+
+    // the chunks are already decoded
+    if (evicted_file->bytes != NULL) {
+        return 0;
+    }
+
+    struct gnl_simfs_inode_chunk *chunk;
+    size_t size = 0;
+
+    // calculate the size of the decompressed file
+    for (chunk = evicted_file->chunks; chunk != NULL; chunk = chunk->next) {
+        size += chunk->count;
+    }
+
+    // an empty file is decoded as a 1 byte zeroed buffer
+    void *bytes = calloc(size > 0 ? size : 1, 1);
+    GNL_NULL_CHECK(bytes, ENOMEM, -1)
+
+    // decode the chunks one after the other
+    size_t offset = 0;
+    int res;
+    for (chunk = evicted_file->chunks; chunk != NULL; chunk = chunk->next) {
+        res = gnl_simfs_codec_decode(chunk->codec, chunk->data, chunk->size, (char *)bytes + offset, chunk->count);
+
+        // the chunk must be decoded entirely
+        if (res != chunk->count) {
+            free(bytes);
+
+            errno = res == -1 ? errno : EINVAL;
+            return -1;
+        }
+
+        offset += chunk->count;
+    }
+
+    destroy_evicted_chunks(evicted_file->chunks);
+    evicted_file->chunks = NULL;
+
+    evicted_file->bytes = bytes;
+    evicted_file->count = size;
+
+    return 0;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -25,6 +97,8 @@ void gnl_simfs_evicted_file_destroy(struct gnl_simfs_evicted_file *evicted_file)
         return;
     }
 
+    destroy_evicted_chunks(evicted_file->chunks);
+
     free(evicted_file->name);
     free(evicted_file->bytes);
     free(evicted_file);
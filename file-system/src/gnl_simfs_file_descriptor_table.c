@@ -1,20 +1,40 @@
 #include <stdlib.h>
-#include <string.h>
 #include <errno.h>
-#include <gnl_min_heap_t.h>
+#include <pthread.h>
 #include "../include/gnl_simfs_file_descriptor_table.h"
 #include <gnl_macro_beg.h>
 
+/**
+ * Macro to acquire the lock of the file descriptor table.
+ */
+#define GNL_SIMFS_FDT_LOCK_ACQUIRE(table, return_value) {               \
+    int fdt_lock_acquire_res = pthread_mutex_lock(&((table)->mtx));     \
+    GNL_MINUS1_CHECK(fdt_lock_acquire_res, errno, return_value)         \
+}
+
+/**
+ * Macro to release the lock of the file descriptor table.
+ */
+#define GNL_SIMFS_FDT_LOCK_RELEASE(table, return_value) {               \
+    int fdt_lock_release_res = pthread_mutex_unlock(&((table)->mtx));   \
+    GNL_MINUS1_CHECK(fdt_lock_release_res, errno, return_value)         \
+}
+
 /**
  * The entry struct of the file descriptor table.
  */
 struct gnl_simfs_file_descriptor_table_el {
 
-    // the owner id of the entry
-    unsigned int owner;
+    // the file descriptor of the entry
+    struct gnl_simfs_file_descriptor fd;
+
+    // 1 if the file descriptor is open, 0 otherwise
+    int open;
 
-    // the pointer to a inode copy
-    struct gnl_simfs_inode *inode;
+    // the index of the next free entry of the free-list,
+    // -1 if the entry is the last one; it is meaningful
+    // only if the file descriptor is not open
+    int next_free;
 };
 
 /**
@@ -29,22 +49,25 @@ struct gnl_simfs_file_descriptor_table {
     // the current size of the file descriptor table
     unsigned int size;
 
-    // the greater file descriptor currently
-    // present into the table
-    unsigned int max_fd;
-
-    // the map of the free file descriptor table index available,
-    // it becomes useful to implement the "first fit" policy in
-    // case an inode was removed from the table and a new one
-    // must be inserted
-    struct gnl_min_heap_t *free_index_map;
-
-    // the inodes array, it will grow dynamically
-    // until the given limit is reached; a removed
-    // element does not cause a table shrink, but it
-    // creates a "hole" that may will be filled on the
-    // next put thankful to the "first fit" policy
-    struct gnl_simfs_file_descriptor_table_el **table;
+    // the slab of the entries, it is allocated once for all the
+    // limit entries, so the file descriptors never move and a put
+    // or a remove never allocate memory; the file descriptor
+    // is the index of its entry into the slab
+    struct gnl_simfs_file_descriptor_table_el *slab;
+
+    // the number of entries of the slab ever used, the
+    // entries after them were never touched
+    unsigned int used;
+
+    // the head of the free-list of the entries removed, it is
+    // a stack so the last file descriptor removed is the first
+    // to be reused; -1 if the free-list is empty
+    int free_head;
+
+    // the lock of the file descriptor table, the table is shared
+    // among all the shards of the file system, so every access to
+    // it must be serialized
+    pthread_mutex_t mtx;
 };
 
 /**
@@ -60,15 +83,24 @@ struct gnl_simfs_file_descriptor_table *gnl_simfs_file_descriptor_table_init(uns
     // initialize the size
     t->size = 0;
 
-    // initialize the max fd
-    t->max_fd = 0;
+    // allocate the slab, the pages of the entries never
+    // used are not touched until they are needed
+    t->slab = calloc(limit > 0 ? limit : 1, sizeof(struct gnl_simfs_file_descriptor_table_el));
+    if (t->slab == NULL) {
+        free(t);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    t->used = 0;
 
-    // initialize the free index map
-    t->free_index_map = gnl_min_heap_init();
-    GNL_NULL_CHECK(t->free_index_map, errno, NULL)
+    // initialize the free-list
+    t->free_head = -1;
 
-    // the table space will be allocated on demand
-    t->table = NULL;
+    // initialize the lock
+    int res = pthread_mutex_init(&(t->mtx), NULL);
+    GNL_MINUS1_CHECK(res, errno, NULL)
 
     return t;
 }
@@ -78,33 +110,20 @@ struct gnl_simfs_file_descriptor_table *gnl_simfs_file_descriptor_table_init(uns
  *
  * @param table The file descriptor table instance from where delete the file descriptor.
  * @param fd    The file descriptor to remove from the given file descriptor table.
- *
- * @return      Return 0 on success, -1 otherwise.
  */
-static int remove_fd(struct gnl_simfs_file_descriptor_table *table, unsigned int fd) {
-    GNL_NULL_CHECK(table, EINVAL, -1)
-
-    // remove the file descriptor
-    gnl_simfs_inode_copy_destroy(table->table[fd]->inode);
-    free(table->table[fd]);
-    table->table[fd] = NULL;
-
-    // Add the removed file descriptor into the free index map
+static void remove_fd(struct gnl_simfs_file_descriptor_table *table, unsigned int fd) {
+    struct gnl_simfs_file_descriptor_table_el *el = table->slab + fd;
 
-    // make a deep copy of the fd
-    unsigned int *fd_copy = malloc(sizeof(int));
-    GNL_NULL_CHECK(fd_copy, ENOMEM, -1)
+    // discard the writes not flushed yet
+    gnl_simfs_inode_buffer_clear(&(el->fd.buffer));
 
-    *fd_copy = fd;
-
-    // add the deep copy into the free index map
-    int res = gnl_min_heap_insert(table->free_index_map, fd_copy, fd);
-    GNL_MINUS1_CHECK(res, errno, -1)
+    // push the entry into the free-list
+    el->open = 0;
+    el->next_free = table->free_head;
+    table->free_head = fd;
 
     // decrease the table size
     table->size--;
-
-    return 0;
 }
 
 /**
@@ -115,151 +134,113 @@ void gnl_simfs_file_descriptor_table_destroy(struct gnl_simfs_file_descriptor_ta
         return;
     }
 
-    // if the table is not empty...
-    if (table->size > 0) {
-
-        // we do not want to free the "holes" left by a remove
-        // (because they are already been removed), so create a bitmap
-        // to map the elements to be freed: if 1 the element is still
-        // present in the table, if 0 the element was present but not anymore
-        int bitmap[table->max_fd];
-
-        // initialize the bitmap
-        for (size_t i=0; i<=table->max_fd; i++) {
-            bitmap[i] = 1;
-        }
-
-        // fill the bitmap
-        void *raw_fd;
-        while ((raw_fd = gnl_min_heap_extract_min(table->free_index_map)) != NULL) {
-            bitmap[*(int *)raw_fd] = 0;
-
-            // free the deep copy of the fd
-            free(raw_fd);
-        }
-
-        // destroy the table elements
-        for (size_t i=0; i<=table->max_fd; i++) {
-            if (bitmap[i] > 0) {
-                gnl_simfs_inode_copy_destroy(table->table[i]->inode);
-                free(table->table[i]);
-            }
+    // discard the writes not flushed yet of the
+    // file descriptors still open
+    for (size_t i=0; i<table->used; i++) {
+        if (table->slab[i].open) {
+            gnl_simfs_inode_buffer_clear(&(table->slab[i].fd.buffer));
         }
     }
 
-    // destroy the table
-    free(table->table);
+    // destroy the slab
+    free(table->slab);
 
-    // destroy the free index map, the free callback is
-    // necessary for the cases where the table has size 0,
-    // but its free index map contains some fds
-    gnl_min_heap_destroy(table->free_index_map, free);
+    // destroy the lock, proceed on error
+    pthread_mutex_destroy(&(table->mtx));
 
     free(table);
 }
 
 /**
- * Get the first file descriptor available in the given
- * file descriptor table, implementing the "first fit" policy.
+ * Insert an inode handle into the given file descriptor table.
+ * The caller must hold the lock of the table.
  *
- * @param table The file descriptor table instance.
+ * @param table     The file descriptor table instance where to put the handle.
+ * @param handle    The handle of the inode to insert into the given file descriptor table.
+ * @param pid       The owner of the entry that will be created.
  *
- * @return      Returns a file descriptor.
+ * @return          On success, returns the file descriptor of the file referred
+ *                  by the inserted handle, on failure returns -1.
  */
-static unsigned int get_file_descriptor(struct gnl_simfs_file_descriptor_table *table) {
-    unsigned int fd;
-
-    // check if there is a free index into the free index map
-    void *raw_fd = gnl_min_heap_extract_min(table->free_index_map);
-
-    // if there is a free index...
-    if (raw_fd != NULL) {
-        // cast the file descriptor
-        fd = *(int *)raw_fd;
+static int put_fd(struct gnl_simfs_file_descriptor_table *table, const struct gnl_simfs_inode_handle *handle,
+        unsigned long pid) {
+    // check if we can insert another element
+    if (table->size == table->limit) {
+        errno = EMFILE;
 
-        // free the deep copy of the fd
-        free(raw_fd);
-    }
-    // if there is not a free index...
-    else {
-        fd = table->size;
+        return -1;
     }
 
-    return fd;
-}
+    // get the file descriptor, reusing the last one removed
+    // or, if there is none, the first entry never used
+    unsigned int fd;
+    if (table->free_head != -1) {
+        fd = table->free_head;
+        table->free_head = table->slab[fd].next_free;
+    } else {
+        fd = table->used++;
+    }
 
-/**
- * Create a new table file descriptor entry.
- *
- * @param inode The inode to copy into the entry.
- * @param pid   The owner id of the entry.
- *
- * @return      Returns the created entry on success, NULL otherwise.
- */
-static struct gnl_simfs_file_descriptor_table_el *create_entry(const struct gnl_simfs_inode *inode, unsigned long pid) {
-    struct gnl_simfs_file_descriptor_table_el *entry = (struct gnl_simfs_file_descriptor_table_el *)malloc(sizeof(struct gnl_simfs_file_descriptor_table_el));
-    GNL_NULL_CHECK(entry, ENOMEM, NULL)
+    // fill the entry
+    struct gnl_simfs_file_descriptor_table_el *el = table->slab + fd;
 
-    // set the owner of the entry
-    entry->owner = pid;
+    el->fd.owner = pid;
+    el->fd.handle = *handle;
+    el->fd.buffer.chunks = NULL;
+    el->fd.buffer.size = 0;
+    el->open = 1;
 
-    // create a deep copy of the given inode
-    entry->inode = gnl_simfs_inode_copy(inode);
-    GNL_NULL_CHECK(entry->inode, ENOMEM, NULL)
+    // increase the table size
+    table->size++;
 
-    return entry;
+    // return the file descriptor
+    return fd;
 }
 
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_file_descriptor_table_put(struct gnl_simfs_file_descriptor_table *table, const struct gnl_simfs_inode *inode,
-        unsigned long pid) {
+int gnl_simfs_file_descriptor_table_put(struct gnl_simfs_file_descriptor_table *table,
+        const struct gnl_simfs_inode_handle *handle, unsigned long pid) {
     GNL_NULL_CHECK(table, EINVAL, -1)
+    GNL_NULL_CHECK(handle, EINVAL, -1)
 
-    // check if we can insert another element
-    if (table->size == table->limit) {
-        errno = EMFILE;
+    GNL_SIMFS_FDT_LOCK_ACQUIRE(table, -1)
 
-        return -1;
-    }
+    int fd = put_fd(table, handle, pid);
 
-    // get the file descriptor
-    unsigned int fd = get_file_descriptor(table);
-
-    // reallocate space for the table if necessary, there are three cases:
-    // - case 1 (fd == 0):              this is the first use of the table, so a
-    //                                  memory allocation is mandatory
-    // - case 2 (fd > table->max_fd):   the table needs extra space for the new fd
-    //                                  because it has reached its border
-    // - case 3 (none of the above):    there is a "hole" left by a previous remove,
-    //                                  so the table already has the necessary space
-    if (table->max_fd == 0 || fd > table->max_fd) {
-        struct gnl_simfs_file_descriptor_table_el **temp = realloc(table->table, (fd + 1) * sizeof(struct gnl_simfs_file_descriptor_table_el *));
-        GNL_NULL_CHECK(temp, errno, -1)
-
-        table->table = temp;
-    }
+    GNL_SIMFS_FDT_LOCK_RELEASE(table, -1)
 
-    // allocate space for the new table entry
+    return fd;
+}
 
-    // create the entry
-    struct gnl_simfs_file_descriptor_table_el *entry = create_entry(inode, pid);
-    GNL_NULL_CHECK(entry, errno, -1)
+/**
+ * Get a file descriptor owned by the given pid from the given file
+ * descriptor table. The caller must hold the lock of the table.
+ *
+ * @param table The file descriptor table instance from where to get the file descriptor.
+ * @param fd    The file descriptor to get from the given file descriptor table.
+ * @param pid   The id of the process that invoked this method, it should be the owner of the entry
+ *
+ * @return      Return the file descriptor of the given fd on success, NULL otherwise.
+ */
+static struct gnl_simfs_file_descriptor *get_owned_fd(const struct gnl_simfs_file_descriptor_table *table,
+        unsigned int fd, unsigned int pid) {
+    // check that the given file descriptor is active
+    if (fd >= table->used || !table->slab[fd].open) {
+        errno = EBADF;
 
-    // assign the entry
-    *(table->table + fd) = entry;
+        return NULL;
+    }
 
-    // increase the table size
-    table->size++;
+    // check that we are allowed to use the file descriptor
+    if (table->slab[fd].fd.owner != pid) {
+        errno = EPERM;
 
-    // update the max fd
-    if (fd > table->max_fd) {
-        table->max_fd = fd;
+        return NULL;
     }
 
-    // return the file descriptor
-    return fd;
+    return &(table->slab[fd].fd);
 }
 
 /**
@@ -268,22 +249,19 @@ int gnl_simfs_file_descriptor_table_put(struct gnl_simfs_file_descriptor_table *
 int gnl_simfs_file_descriptor_table_remove(struct gnl_simfs_file_descriptor_table *table, unsigned int fd, unsigned int pid) {
     GNL_NULL_CHECK(table, EINVAL, -1)
 
-    // check that the given file descriptor is active
-    if (table->size == 0 || fd > table->max_fd || table->table[fd] == NULL) {
-        errno = EBADF;
-
-        return -1;
-    }
+    GNL_SIMFS_FDT_LOCK_ACQUIRE(table, -1)
 
-    // check that we are allowed to remove the file descriptor
-    if (table->table[fd]->owner != pid) {
-        errno = EPERM;
+    int res = -1;
 
-        return -1;
+    // remove the file descriptor if we are allowed to
+    if (get_owned_fd(table, fd, pid) != NULL) {
+        remove_fd(table, fd);
+        res = 0;
     }
 
-    // remove the file descriptor
-    return remove_fd(table, fd);
+    GNL_SIMFS_FDT_LOCK_RELEASE(table, -1)
+
+    return res;
 }
 
 /**
@@ -292,81 +270,58 @@ int gnl_simfs_file_descriptor_table_remove(struct gnl_simfs_file_descriptor_tabl
 int gnl_simfs_file_descriptor_table_remove_pid(struct gnl_simfs_file_descriptor_table *table, unsigned int pid) {
     GNL_NULL_CHECK(table, EINVAL, -1)
 
-    int res;
+    GNL_SIMFS_FDT_LOCK_ACQUIRE(table, -1)
 
-    for (size_t i=0; i<=table->max_fd; i++) {
+    for (size_t i=0; i<table->used; i++) {
         // check that the i-th file descriptor is owned by the given pid
-        if (table->size == 0 || table->table[i] == NULL || table->table[i]->owner != pid) {
+        if (!table->slab[i].open || table->slab[i].fd.owner != pid) {
             continue;
         }
 
         // remove the file descriptor
-        res = remove_fd(table, i);
-        if (res == -1) {
-            // let the errno bubble
-            return -1;
-        }
+        remove_fd(table, i);
     }
 
+    GNL_SIMFS_FDT_LOCK_RELEASE(table, -1)
+
     return 0;
 }
 
 /**
  * {@inheritDoc}
  */
-struct gnl_simfs_inode * gnl_simfs_file_descriptor_table_get(const struct gnl_simfs_file_descriptor_table *table, unsigned int fd,
-        unsigned int pid) {
+struct gnl_simfs_file_descriptor *gnl_simfs_file_descriptor_table_get(struct gnl_simfs_file_descriptor_table *table,
+        unsigned int fd, unsigned int pid) {
     GNL_NULL_CHECK(table, EINVAL, NULL)
 
-    // check that the given file descriptor is active
-    if (table->size == 0 || fd > table->max_fd || table->table[fd] == NULL) {
-        errno = EBADF;
+    GNL_SIMFS_FDT_LOCK_ACQUIRE(table, NULL)
 
-        return NULL;
-    }
-
-    // check that we are allowed to get the file descriptor
-    if (table->table[fd]->owner != pid) {
-        errno = EPERM;
+    // the returned file descriptor is owned by pid, so it can be
+    // used after the lock is released: only its owner can remove
+    // it, and the slab never moves it
+    struct gnl_simfs_file_descriptor *file_descriptor = get_owned_fd(table, fd, pid);
 
-        return NULL;
-    }
+    GNL_SIMFS_FDT_LOCK_RELEASE(table, NULL)
 
-    // return the file descriptor
-    return table->table[fd]->inode;
-}
-
-/**
- * {@inheritDoc}
- */
-int gnl_simfs_file_descriptor_table_size(const struct gnl_simfs_file_descriptor_table *table) {
-    GNL_NULL_CHECK(table, EINVAL, -1)
-
-    return table->size;
+    return file_descriptor;
 }
 
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_file_descriptor_table_pid_inode_size(const struct gnl_simfs_file_descriptor_table *table,
-                                                   const struct gnl_simfs_inode *inode, unsigned int pid) {
+int gnl_simfs_file_descriptor_table_size(struct gnl_simfs_file_descriptor_table *table) {
     GNL_NULL_CHECK(table, EINVAL, -1)
-    GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    int size = 0;
+    GNL_SIMFS_FDT_LOCK_ACQUIRE(table, -1)
 
-    for (size_t i=0; i<=table->max_fd; i++) {
-        // check that the i-th file descriptor is equal to the given
-        // inode and owned by the given pid
-        if (table->size == 0 || table->table[i] == NULL || table->table[i]->owner != pid
-            || strcmp(table->table[i]->inode->name, inode->name) != 0) {
-            continue;
-        }
+    int size = table->size;
 
-        size++;
-    }
+    GNL_SIMFS_FDT_LOCK_RELEASE(table, -1)
 
     return size;
 }
 
+#undef GNL_SIMFS_FDT_LOCK_ACQUIRE
+#undef GNL_SIMFS_FDT_LOCK_RELEASE
+
 #include <gnl_macro_end.h>
@@ -12,22 +12,29 @@
 // the maximum number of simultaneously open files allowed
 #define GNL_SIMFS_MAX_OPEN_FILES 10240
 
+// the number of shards in which the files are partitioned
+#define GNL_SIMFS_SHARDS_COUNT 16
+
+// the number of evicted files parked by the reclaimer
+// above which the reclaimer stops evicting
+#define GNL_SIMFS_EVICTED_QUEUE_BOUND 64
+
 /**
- * Macro to acquire the lock.
+ * Macro to acquire the lock of the current shard.
  */
-#define GNL_SIMFS_LOCK_ACQUIRE(return_value, pid) {                         \
-    int lock_acquire_res = pthread_mutex_lock(&(file_system->mtx));         \
-    GNL_MINUS1_CHECK(lock_acquire_res, errno, return_value)                 \
-    gnl_logger_debug(file_system->logger, "Pid %d acquired the lock", pid); \
+#define GNL_SIMFS_LOCK_ACQUIRE(return_value, pid) {                                                 \
+    int lock_acquire_res = pthread_mutex_lock(&(shard->mtx));                                       \
+    GNL_MINUS1_CHECK(lock_acquire_res, errno, return_value)                                         \
+    gnl_logger_debug(file_system->logger, "Pid %d acquired the lock of shard %d", pid, shard->id);  \
 }
 
 /**
- * Macro to release the lock.
+ * Macro to release the lock of the current shard.
  */
-#define GNL_SIMFS_LOCK_RELEASE(return_value, pid) {                         \
-    int lock_release_res = pthread_mutex_unlock(&(file_system->mtx));       \
-    GNL_MINUS1_CHECK(lock_release_res, errno, return_value)                 \
-    gnl_logger_debug(file_system->logger, "Pid %d released the lock", pid); \
+#define GNL_SIMFS_LOCK_RELEASE(return_value, pid) {                                                 \
+    int lock_release_res = pthread_mutex_unlock(&(shard->mtx));                                     \
+    GNL_MINUS1_CHECK(lock_release_res, errno, return_value)                                         \
+    gnl_logger_debug(file_system->logger, "Pid %d released the lock of shard %d", pid, shard->id);  \
 }
 
 /**
@@ -63,7 +70,8 @@
  * {@inheritDoc}
  */
 struct gnl_simfs_file_system *gnl_simfs_file_system_init(unsigned int memory_limit, unsigned int files_limit,
-        const char *log_path, const char *log_level, enum gnl_simfs_replacement_policy replacement_policy) {
+        const char *log_path, const char *log_level, enum gnl_simfs_replacement_policy replacement_policy,
+        enum gnl_simfs_compression compression, unsigned int frequency_aging) {
     struct gnl_simfs_file_system *fs = (struct gnl_simfs_file_system *)malloc(sizeof(struct gnl_simfs_file_system));
     GNL_NULL_CHECK(fs, ENOMEM, NULL)
 
@@ -71,17 +79,42 @@ struct gnl_simfs_file_system *gnl_simfs_file_system_init(unsigned int memory_lim
     fs->memory_limit = mb_to_bytes(memory_limit);
     fs->files_limit = files_limit;
 
-    // initialize the file table
-    fs->file_table = gnl_simfs_file_table_init();
-    GNL_NULL_CHECK(fs->file_table, errno, NULL)
+    // initialize the shards
+    fs->shards_count = GNL_SIMFS_SHARDS_COUNT;
+    fs->shards = calloc(fs->shards_count, sizeof(struct gnl_simfs_file_system_shard));
+    GNL_NULL_CHECK(fs->shards, ENOMEM, NULL)
+
+    int res;
+
+    for (size_t i=0; i<fs->shards_count; i++) {
+        fs->shards[i].id = i;
+
+        // initialize the file table of the shard
+        fs->shards[i].file_table = gnl_simfs_file_table_init();
+        GNL_NULL_CHECK(fs->shards[i].file_table, errno, NULL)
+
+        // initialize the lock of the shard
+        res = pthread_mutex_init(&(fs->shards[i].mtx), NULL);
+        GNL_MINUS1_CHECK(res, errno, NULL)
+    }
 
     // initialize the file descriptor table
     fs->file_descriptor_table = gnl_simfs_file_descriptor_table_init(GNL_SIMFS_MAX_OPEN_FILES);
     GNL_NULL_CHECK(fs->file_descriptor_table, errno, NULL)
 
+    // initialize the session table
+    fs->session_table = gnl_simfs_session_table_init();
+    GNL_NULL_CHECK(fs->session_table, errno, NULL)
+
     // initialize the replacement policy
     fs->replacement_policy = replacement_policy;
 
+    fs->policy_index = gnl_simfs_policy_index_init(replacement_policy, frequency_aging);
+    GNL_NULL_CHECK(fs->policy_index, errno, NULL)
+
+    // initialize the compression
+    fs->compression = compression;
+
     // initialize the logger
     if (log_path == NULL) {
         // if no log_path is given do not create a logger
@@ -110,16 +143,26 @@ struct gnl_simfs_file_system *gnl_simfs_file_system_init(unsigned int memory_lim
         GNL_NULL_CHECK(fs->logger, errno, NULL)
     }
 
-    // initialize lock
-    int res = pthread_mutex_init(&(fs->mtx), NULL);
+    // initialize the locks
+    res = pthread_mutex_init(&(fs->mtx), NULL);
     GNL_MINUS1_CHECK(res, errno, NULL)
 
+    res = pthread_mutex_init(&(fs->quota_mtx), NULL);
+    GNL_MINUS1_CHECK(res, errno, NULL)
+
+    // no bytes are reserved at the beginning
+    fs->reserved_bytes = 0;
+
+    // initialize the queue of the files evicted in background
+    fs->evicted_queue = gnl_queue_init();
+    GNL_NULL_CHECK(fs->evicted_queue, errno, NULL)
+
     // initialize the monitor
     fs->monitor = gnl_simfs_monitor_init();
     GNL_NULL_CHECK(fs->monitor, errno, NULL)
 
-    gnl_logger_debug(fs->logger, "File system initialized. Memory limit: %f MB, max storable files: %d.",
-                     bytes_to_mb(fs->memory_limit), fs->files_limit);
+    gnl_logger_debug(fs->logger, "File system initialized. Memory limit: %f MB, max storable files: %d, shards: %d.",
+                     bytes_to_mb(fs->memory_limit), fs->files_limit, fs->shards_count);
 
     return fs;
 }
@@ -137,11 +180,28 @@ void gnl_simfs_file_system_destroy(struct gnl_simfs_file_system *file_system) {
     // destroy the file descriptor table
     gnl_simfs_file_descriptor_table_destroy(file_system->file_descriptor_table);
 
-    // destroy the file table
-    gnl_simfs_file_table_destroy(file_system->file_table);
+    // destroy the session table
+    gnl_simfs_session_table_destroy(file_system->session_table);
+
+    // destroy the shards
+    for (size_t i=0; i<file_system->shards_count; i++) {
+        gnl_simfs_file_table_destroy(file_system->shards[i].file_table);
+
+        // destroy the lock of the shard, proceed on error
+        pthread_mutex_destroy(&(file_system->shards[i].mtx));
+    }
+
+    free(file_system->shards);
+
+    // destroy the policy index
+    gnl_simfs_policy_index_destroy(file_system->policy_index);
+
+    // destroy the files evicted in background not yet drained
+    gnl_queue_destroy(file_system->evicted_queue, gnl_simfs_rts_destroy_evicted_file);
 
-    // destroy the lock, proceed on error
+    // destroy the locks, proceed on error
     pthread_mutex_destroy(&(file_system->mtx));
+    pthread_mutex_destroy(&(file_system->quota_mtx));
 
     // destroy the monitor
     gnl_simfs_monitor_destroy(file_system->monitor);
@@ -159,14 +219,20 @@ void gnl_simfs_file_system_destroy(struct gnl_simfs_file_system *file_system) {
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const char *filename, int flags, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(filename, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (strlen(filename) == 0), EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-    GNL_SIMFS_MINUS1_CHECK(-1 * (strlen(filename) == 0), EINVAL, -1, pid)
-
     int res;
+    int created = 0;
 
     gnl_logger_debug(file_system->logger, "Open: pid %d is trying to open the file \"%s\"", pid, filename);
 
@@ -191,7 +257,7 @@ int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const
     }
 
     // get the inode of the filename
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_system->file_table, filename);
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(shard->file_table, filename);
 
     // check getting error
     if (inode == NULL && errno != ENOENT) {
@@ -221,9 +287,15 @@ int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const
         // the file is not present, create it
         inode = gnl_simfs_rts_create_inode(file_system, filename);
         GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
+
+        created = 1;
     }
     // if the file must be present
     else {
+        // track the lookup for the hit ratio
+        res = gnl_simfs_rts_track_lookup(file_system, inode != NULL);
+        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
         // if the file is not present return an error
         if (inode == NULL) {
             gnl_logger_warn(file_system->logger, "Open failed: GNL_SIMFS_O_CREATE flag not provided but file \"%s\" "
@@ -263,8 +335,8 @@ int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const
             // lock the file
             res = gnl_simfs_rts_lock_inode(file_system, inode, pid);
             if (res == -1) {
-                gnl_logger_warn(file_system->logger, "Open failed: file \"%s\" has a pending lock and it can not be "
-                                                     "locked by pid %d, deadlock avoided", inode->name, pid);
+                gnl_logger_warn(file_system->logger, "Open failed: file \"%s\" can not be locked by pid %d yet: %s",
+                                inode->name, pid, strerror(errno));
 
                 GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -294,18 +366,34 @@ int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const
         }
     }
 
-    // put the inode into the file descriptor table (the inode will be copied)
-    int fd = gnl_simfs_file_descriptor_table_put(file_system->file_descriptor_table, inode, pid);
+    // put the handle of the inode into the file descriptor table,
+    // the inode is referred without being copied
+    struct gnl_simfs_inode_handle handle;
+    handle.shard = shard - file_system->shards;
+    gnl_simfs_file_table_handle(inode, &handle);
+
+    int fd = gnl_simfs_file_descriptor_table_put(file_system->file_descriptor_table, &handle, pid);
     GNL_SIMFS_MINUS1_CHECK(fd, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Open: created file descriptor %d for file %s", fd, filename);
 
+    // track the file descriptor into the session of the pid
+    res = gnl_simfs_session_table_add_fd(file_system->session_table, pid, fd);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
     // increase the inode reference count
     res = gnl_simfs_inode_increase_refs(inode, pid);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Open: reference count of file %s increased, the file has now %d "
-                                          "references", filename, inode->reference_count);
+                                          "references", filename, gnl_simfs_inode_reference_count(inode));
+
+    // track the reference to the file, a created file
+    // enters the policy index as never referenced
+    if (!created) {
+        res = gnl_simfs_rts_touch_inode(file_system, inode);
+        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+    }
 
     gnl_logger_debug(file_system->logger, "Open: open on file \"%s\" succeeded, returning fd %d to pid %d", filename, fd, pid);
 
@@ -316,28 +404,72 @@ int gnl_simfs_file_system_open(struct gnl_simfs_file_system *file_system, const
 }
 
 /**
- * {@inheritDoc}
+ * Check that the file referred to by the file descriptor fd can be written
+ * by the given pid, before any byte of a write is compressed.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file to write.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
  */
-int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system, int fd, const void *buf, size_t count,
-        unsigned int pid, struct gnl_list_t **evicted_list) {
+static int check_write(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
 
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
+    // search the file of the file descriptor
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
+    GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
+
+    // check if the file is not locked or if we own the lock, no other
+    // pid can lock the file while the file descriptor is open
+    int res = gnl_simfs_rts_check_write_lock(file_system, inode, pid);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+    // release the lock
+    GNL_SIMFS_LOCK_RELEASE(-1, pid)
+
+    return 0;
+}
+
+/**
+ * Compress up to count bytes from the buffer starting at buf into the buffer of
+ * the file descriptor fd, without appending them to the file yet.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param buf           The buffer pointer containing the data to write.
+ * @param owned         The pointer to buf, if its ownership can be taken by the
+ *                      file system, NULL otherwise.
+ * @param count         The count of bytes to write.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+static int buffer_file(struct gnl_simfs_file_system *file_system, int fd, const void *buf, void **owned, size_t count,
+        unsigned int pid) {
+
     // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
 
     gnl_logger_debug(file_system->logger, "Write: pid %d is trying to write %d bytes in file descriptor %d", pid, count, fd);
 
-    // compress the file to get the final size
-    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(buf, count);
-    GNL_SIMFS_NULL_CHECK(artifact, errno, -1, pid)
+    // search the file descriptor in the file descriptor table
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_rts_get_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(file_descriptor, errno, -1)
 
-    int final_count = gnl_huffman_tree_size(artifact);
-    GNL_SIMFS_MINUS1_CHECK(final_count, errno, -1, pid)
-
-    // destroy the artifact
-    gnl_huffman_tree_destroy_artifact(artifact);
+    // compress the given buf into the file descriptor, this is the
+    // only compression of the written bytes and it does not need
+    // any lock, since the file descriptor is owned by the pid
+    int final_count = gnl_simfs_rts_write_buffer(file_system, file_descriptor, buf, owned, count);
+    GNL_MINUS1_CHECK(final_count, errno, -1)
 
     gnl_logger_debug(file_system->logger, "Write: file pointed by file descriptor %d compressed", fd);
     gnl_logger_debug(file_system->logger, "Write: original size %d bytes", count);
@@ -350,85 +482,150 @@ int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system, int f
                                              "Memory limit: %f MB, file size (compressed): %d bytes.",
                                              fd, bytes_to_mb(file_system->memory_limit), final_count);
 
+        gnl_simfs_inode_buffer_clear(&(file_descriptor->buffer));
         errno = E2BIG;
-        GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
         return -1;
     }
 
-    int res;
+    return 0;
+}
 
-    // check if there is enough space left to write the file
-    int available_bytes;
-    while (final_count > (available_bytes = gnl_simfs_rts_available_bytes(file_system))) {
-        // check if there was an error on the gnl_simfs_rts_available_bytes invocation
-        GNL_SIMFS_MINUS1_CHECK(available_bytes, errno, -1, pid);
+/**
+ * Append the bytes compressed into the buffer of the file descriptor fd
+ * to the file referred by it.
+ *
+ * @param file_system   The file system instance where to write the file.
+ * @param fd            The file descriptor referring the file where to write.
+ * @param pid           The id of the process who invoked this method.
+ * @param evicted_list  The pointer to the list where to put the eventual evicted
+ *                      files.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+static int commit_file(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid,
+        struct gnl_list_t **evicted_list) {
 
-        // if this point is reached, then there is no space left
-        // into the file system to write final_count bytes
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
 
-        // if there is no replacement policy, then fail (with honor)
-        if (file_system->replacement_policy == GNL_SIMFS_RP_NONE) {
-            // get the heap size
-            int size = gnl_simfs_file_table_size(file_system->file_table);
+    // search the file descriptor in the file descriptor table
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_rts_get_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(file_descriptor, errno, -1)
 
-            gnl_logger_warn(file_system->logger, "Write on file descriptor %d failed, max heap size reached."
-                                                 "Memory limit: %f MB, current heap size: %lld bytes (%f MB), "
-                                                 "prevented heap size overflowing by %d bytes", fd,
-                                                 bytes_to_mb(file_system->memory_limit), size, bytes_to_mb(size),
-                                                 final_count - available_bytes);
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = file_system->shards + file_descriptor->handle.shard;
 
-            errno = EDQUOT;
-            GNL_SIMFS_LOCK_RELEASE(-1, pid)
+    int final_count = file_descriptor->buffer.size;
 
-            return -1;
-        }
+    // reserve the space to write the file, evicting some files
+    // if necessary; this is the only step of the write that
+    // coordinates across the shards
+    int res = gnl_simfs_rts_reserve_bytes(file_system, final_count, evicted_list, pid);
+    if (res == -1) {
+        int reserve_errno = errno;
+
+        gnl_logger_warn(file_system->logger, "Write on file descriptor %d failed, unable to reserve %d bytes: %s",
+                        fd, final_count, strerror(errno));
 
-        gnl_logger_debug(file_system->logger, "No space available to write %d bytes, evicting some files", final_count);
+        gnl_simfs_inode_buffer_clear(&(file_descriptor->buffer));
+        errno = reserve_errno;
 
-        // else evict a file
-        res = gnl_simfs_rts_evict(file_system, evicted_list);
-        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid);
+        return -1;
     }
 
-    // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
-    GNL_SIMFS_NULL_CHECK(inode_copy, errno, -1, pid)
+    // acquire the lock
+    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    gnl_logger_debug(file_system->logger, "Write: got file descriptor %d's inode", fd);
+    // append the compressed chunks to the file, if it was not
+    // removed in the meanwhile; the written bytes are accounted
+    // by the flush
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
 
-    // get if the file is locked information
-    int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode_copy);
-    GNL_SIMFS_MINUS1_CHECK(file_locked_by_pid, errno, -1, pid)
+    res = inode == NULL ? -1 : gnl_simfs_rts_fflush_inode(file_system, inode, &(file_descriptor->buffer));
+    int write_errno = errno;
 
-    // check if the file is not locked or if we own the lock
-    if (file_locked_by_pid > 0 && file_locked_by_pid != pid) {
-        errno = EBUSY;
+    // if the flush failed the chunks are no longer needed
+    if (res == -1) {
+        gnl_simfs_inode_buffer_clear(&(file_descriptor->buffer));
+    }
 
-        gnl_logger_warn(file_system->logger, "Write failed: file \"%s\" is locked by pid %d and it can not be "
-                                              "accessed", inode_copy->name, file_locked_by_pid);
+    // the write is over, so release the reserved bytes
+    gnl_simfs_rts_release_bytes(file_system, final_count);
 
-        GNL_SIMFS_LOCK_RELEASE(-1, pid)
+    // release the lock
+    GNL_SIMFS_LOCK_RELEASE(-1, pid)
+
+    if (res == -1) {
+        errno = write_errno;
 
         return -1;
     }
 
-    // write the given buf into the inode copy buffer
-    int nwrite = gnl_simfs_inode_write(inode_copy, buf, count);
-    GNL_SIMFS_MINUS1_CHECK(nwrite, errno, -1, pid)
+    gnl_logger_debug(file_system->logger, "Write: inode flushed, write on file descriptor %d succeeded", fd);
 
-    gnl_logger_debug(file_system->logger, "Write: %d bytes written into file descriptor %d's inode buffer", nwrite, fd);
+    // hand over the files evicted in background to the writer
+    if (evicted_list != NULL) {
+        res = gnl_simfs_rts_drain_evicted(file_system, evicted_list);
+        GNL_MINUS1_CHECK(res, errno, -1)
 
-    // update the inode into the file table, this invocation is
-    // mandatory because we are working on a copy of the inode,
-    // so the original one needs to be updated with the modified copy
-    res = gnl_simfs_rts_fflush_inode(file_system, inode_copy);
-    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+        if (res > 0) {
+            gnl_logger_debug(file_system->logger, "Write: %d files evicted in background handed over", res);
+        }
+    }
 
-    gnl_logger_debug(file_system->logger, "Write: inode flushed, write on file descriptor %d succeeded", fd);
+    return 0;
+}
 
-    // release the lock
-    GNL_SIMFS_LOCK_RELEASE(-1, pid)
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system, int fd, const void *buf, size_t count,
+        unsigned int pid, struct gnl_list_t **evicted_list) {
+    int res = check_write(file_system, fd, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    res = buffer_file(file_system, fd, buf, NULL, count, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return commit_file(file_system, fd, pid, evicted_list);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_write_buffer(struct gnl_simfs_file_system *file_system, int fd, void **buf, size_t count,
+        unsigned int pid, struct gnl_list_t **evicted_list) {
+    GNL_NULL_CHECK(buf, EINVAL, -1)
+
+    int res = check_write(file_system, fd, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    res = buffer_file(file_system, fd, *buf, buf, count, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return commit_file(file_system, fd, pid, evicted_list);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_write_begin(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // fail before any byte is sent if the file can not be written
+    int res = check_write(file_system, fd, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // search the file descriptor in the file descriptor table
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_rts_get_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(file_descriptor, errno, -1)
+
+    // discard the chunks of a previous write never ended
+    gnl_simfs_inode_buffer_clear(&(file_descriptor->buffer));
+
+    gnl_logger_debug(file_system->logger, "Write: pid %d began a chunked write on file descriptor %d", pid, fd);
 
     return 0;
 }
@@ -436,23 +633,58 @@ int gnl_simfs_file_system_write(struct gnl_simfs_file_system *file_system, int f
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd, void **buf, size_t *count, unsigned int pid) {
-    // acquire the lock
-    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
+int gnl_simfs_file_system_write_chunk(struct gnl_simfs_file_system *file_system, int fd, void **buf, size_t count,
+        unsigned int pid) {
+    GNL_NULL_CHECK(buf, EINVAL, -1)
 
+    return buffer_file(file_system, fd, *buf, buf, count, pid);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_write_end(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid,
+        struct gnl_list_t **evicted_list) {
+    return commit_file(file_system, fd, pid, evicted_list);
+}
+
+/**
+ * Read the file pointed by the given file descriptor fd into buf, the whole
+ * file or a piece of it as described by gnl_simfs_file_system_read_chunk.
+ *
+ * @param file_system   The file system instance from where to read the file.
+ * @param fd            The file descriptor referring the file to read.
+ * @param offset        The offset of the first byte to read, if max > 0.
+ * @param max           The maximum number of bytes of the piece to read,
+ *                      0 to read the whole file.
+ * @param buf           The buffer pointer where to write the read data.
+ * @param count         The count of bytes read.
+ * @param pid           The id of the process who invoked this method.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+static int read_file(struct gnl_simfs_file_system *file_system, int fd, size_t offset, size_t max, void **buf,
+        size_t *count, unsigned int pid) {
     // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
+    // acquire the lock
+    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
     gnl_logger_debug(file_system->logger, "Read: pid %d is trying to read from file descriptor %d", pid, fd);
 
-    // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
-    GNL_SIMFS_NULL_CHECK(inode_copy, errno, -1, pid)
+    // search the file of the file descriptor
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
+    GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Read: got file descriptor %d's inode", fd);
 
     // get if the file is locked information
-    int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode_copy);
+    int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode);
     GNL_SIMFS_MINUS1_CHECK(file_locked_by_pid, errno, -1, pid)
 
     // check if the file is not locked or if we own the lock
@@ -460,7 +692,7 @@ int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd
         errno = EBUSY;
 
         gnl_logger_warn(file_system->logger, "Read failed: file \"%s\" is locked by pid %d and it can not be "
-                                              "accessed", inode_copy->name, file_locked_by_pid);
+                                              "accessed", inode->name, file_locked_by_pid);
 
         GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -468,15 +700,14 @@ int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd
     }
 
     // read the file into the given buf
-    int res = gnl_simfs_rts_read_inode(file_system, inode_copy, buf, count);
+    int res = gnl_simfs_rts_read_inode(file_system, inode, offset, max, buf, count);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Read: %d bytes read from file descriptor %d's inode", *count, fd);
 
-    // update the inode into the file table, this invocation is
-    // mandatory because we are working on a copy of the inode,
-    // so the original one needs to be updated with the modified copy
-    res = gnl_simfs_rts_fflush_inode(file_system, inode_copy);
+    // the file was used by the open that referenced it,
+    // so update its recency into the policy index
+    res = gnl_simfs_policy_index_update(file_system->policy_index, inode);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Read: read on file descriptor %d succeeded, inode updated", fd);
@@ -487,62 +718,69 @@ int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd
     return 0;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_read(struct gnl_simfs_file_system *file_system, int fd, void **buf, size_t *count, unsigned int pid) {
+    return read_file(file_system, fd, 0, 0, buf, count, pid);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_read_chunk(struct gnl_simfs_file_system *file_system, int fd, size_t offset, size_t max,
+        void **buf, size_t *count, unsigned int pid) {
+    // a max of 0 would read the whole file
+    GNL_MINUS1_CHECK(-1 * (max == 0), EINVAL, -1)
+
+    return read_file(file_system, fd, offset, max, buf, count, pid);
+}
+
 /**
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_close(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-
     gnl_logger_debug(file_system->logger, "Close: pid %d is trying to close file descriptor %d", pid, fd);
 
-    // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
-    GNL_SIMFS_NULL_CHECK(inode_copy, errno, -1, pid)
+    // search the file of the file descriptor, it may have been removed
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
+    if (inode == NULL && errno != ENOENT) {
+        gnl_logger_error(file_system->logger, "Close failed: %s", strerror(errno));
 
-    // copy the filename
-    char *filename = calloc(sizeof (char), (strlen(inode_copy->name) + 1));
-    GNL_SIMFS_NULL_CHECK(filename, ENOMEM, -1, pid)
+        GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
-    strncpy(filename, inode_copy->name, strlen(inode_copy->name));
+        return -1;
+    }
 
     // remove the file descriptor from the file descriptor table
     int res = gnl_simfs_file_descriptor_table_remove(file_system->file_descriptor_table, fd, pid);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
-    gnl_logger_debug(file_system->logger, "Close: file descriptor %d removed", fd);
-
-    // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(file_system, filename);
+    // stop tracking the file descriptor into the session of the pid
+    res = gnl_simfs_session_table_remove_fd(file_system->session_table, pid, fd);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
-    // free memory
-    free(filename);
+    gnl_logger_debug(file_system->logger, "Close: file descriptor %d removed", fd);
 
-    // check the returning value
+    // if the file is not found it was surely deleted, return success
     if (inode == NULL) {
-
-        // if the file is not found it was surely deleted, ignore the
-        // error and return success
-        if (errno == ENOENT) {
-            gnl_logger_debug(file_system->logger, "Close: close on file descriptor %d succeeded, "
-                                                  "file descriptor %d destroyed, inode not found, it was probably "
-                                                  "deleted", fd, fd);
-
-            res = 0;
-        }
-        // else propagate the errno
-        else {
-            gnl_logger_error(file_system->logger, "Close failed: %s", strerror(errno));
-
-            res = -1;
-        }
+        gnl_logger_debug(file_system->logger, "Close: close on file descriptor %d succeeded, "
+                                              "file descriptor %d destroyed, inode not found, it was probably "
+                                              "deleted", fd, fd);
 
         GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
-        return res;
+        return 0;
     }
 
     gnl_logger_debug(file_system->logger, "Close: entry \"%s\" found, closing file", inode->name);
@@ -563,8 +801,12 @@ int gnl_simfs_file_system_close(struct gnl_simfs_file_system *file_system, int f
     res = gnl_simfs_inode_decrease_refs(inode, pid);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
+    // a pid closing the file does not wait to lock it anymore
+    res = gnl_simfs_inode_clear_pending_lock(inode, pid);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
     gnl_logger_debug(file_system->logger, "Close: reference count of file %s decreased, the file has now %d "
-                                          "references", inode->name, inode->reference_count);
+                                          "references", inode->name, gnl_simfs_inode_reference_count(inode));
 
     gnl_logger_debug(file_system->logger, "Close: close on file descriptor %d succeeded, "
                                           "file descriptor %d destroyed, inode updated", fd, fd);
@@ -579,13 +821,18 @@ int gnl_simfs_file_system_close(struct gnl_simfs_file_system *file_system, int f
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_remove(struct gnl_simfs_file_system *file_system, const char *filename, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(filename, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (strlen(filename) == 0), EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-    GNL_SIMFS_MINUS1_CHECK(-1 * (strlen(filename) == 0), EINVAL, -1, pid)
-
     gnl_logger_debug(file_system->logger, "Remove: pid %d is trying to remove file %s", pid, filename);
 
     // search the file in the file table
@@ -616,12 +863,16 @@ int gnl_simfs_file_system_remove(struct gnl_simfs_file_system *file_system, cons
     int res = gnl_simfs_rts_remove_inode(file_system, filename);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
-    // get the table size for logging
-    int size = gnl_simfs_file_table_size(file_system->file_table);
+    // the lock of the file is gone with it
+    res = gnl_simfs_session_table_remove_lock(file_system->session_table, pid, filename);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+    // get the shard table size for logging
+    unsigned long size = gnl_simfs_file_table_size(shard->file_table);
 
     gnl_logger_debug(file_system->logger, "Remove: remove of file \"%s\" succeeded, inode destoyed", filename);
-    gnl_logger_debug(file_system->logger, "Remove: new heap size %ldd bytes (%f MB), %d bytes freed",
-                     size, bytes_to_mb(size), inode_size);
+    gnl_logger_debug(file_system->logger, "Remove: new heap size of shard %d %ld bytes (%f MB), %d bytes freed",
+                     shard->id, size, bytes_to_mb(size), inode_size);
 
     // release the lock
     GNL_SIMFS_LOCK_RELEASE(-1, pid)
@@ -633,23 +884,23 @@ int gnl_simfs_file_system_remove(struct gnl_simfs_file_system *file_system, cons
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-
     gnl_logger_debug(file_system->logger, "Lock: pid %d is trying to lock file descriptor %d", pid, fd);
 
-    // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
-    GNL_SIMFS_NULL_CHECK(inode_copy, errno, -1, pid)
-
-    // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(file_system, inode_copy->name);
+    // search the file of the file descriptor
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
     GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
 
-    gnl_logger_debug(file_system->logger, "Lock: entry \"%s\" found, locking file", inode_copy->name);
+    gnl_logger_debug(file_system->logger, "Lock: entry \"%s\" found, locking file", inode->name);
 
     // get if the file is locked information
     int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode);
@@ -660,7 +911,7 @@ int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd
 
         // if the file is locked by the given pid return with success
         if (file_locked_by_pid == pid) {
-            gnl_logger_debug(file_system->logger, "Lock: file \"%s\" already locked by pid %d, returning", inode_copy->name, pid);
+            gnl_logger_debug(file_system->logger, "Lock: file \"%s\" already locked by pid %d, returning", inode->name, pid);
 
             GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -671,7 +922,7 @@ int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd
             errno = EBUSY;
 
             gnl_logger_warn(file_system->logger, "Lock failed: file \"%s\" is locked by pid %d and it can "
-                                                  "not be accessed", inode_copy->name, file_locked_by_pid);
+                                                  "not be accessed", inode->name, file_locked_by_pid);
 
             GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -682,8 +933,8 @@ int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd
     // lock the inode
     int res = gnl_simfs_rts_lock_inode(file_system, inode, pid);
     if (res == -1) {
-        gnl_logger_warn(file_system->logger, "Lock failed: file \"%s\" has a pending lock and it can not be "
-                                             "locked by pid %d, deadlock avoided", inode->name, pid);
+        gnl_logger_warn(file_system->logger, "Lock failed: file \"%s\" can not be locked by pid %d yet: %s",
+                        inode->name, pid, strerror(errno));
 
         GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -691,8 +942,8 @@ int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd
         return -1;
     }
 
-    gnl_logger_debug(file_system->logger, "Lock: file \"%s\" locked by pid %d", inode_copy->name, pid);
-    gnl_logger_debug(file_system->logger, "Lock: lock of file \"%s\" succeeded, inode updated", inode_copy->name);
+    gnl_logger_debug(file_system->logger, "Lock: file \"%s\" locked by pid %d", inode->name, pid);
+    gnl_logger_debug(file_system->logger, "Lock: lock of file \"%s\" succeeded, inode updated", inode->name);
 
     // release the lock
     GNL_SIMFS_LOCK_RELEASE(-1, pid)
@@ -704,23 +955,23 @@ int gnl_simfs_file_system_lock(struct gnl_simfs_file_system *file_system, int fd
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-
     gnl_logger_debug(file_system->logger, "Unlock: pid %d is trying to unlock file descriptor %d", pid, fd);
 
-    // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
-    GNL_SIMFS_NULL_CHECK(inode_copy, errno, -1, pid)
-
-    // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(file_system, inode_copy->name);
+    // search the file of the file descriptor
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
     GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
 
-    gnl_logger_debug(file_system->logger, "Unlock: entry \"%s\" found, unlocking file", inode_copy->name);
+    gnl_logger_debug(file_system->logger, "Unlock: entry \"%s\" found, unlocking file", inode->name);
 
     // get if the file is locked information
     int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode);
@@ -731,7 +982,7 @@ int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int
         errno = EPERM;
 
         gnl_logger_warn(file_system->logger, "Unlock failed: file \"%s\" is already unlocked, it can not be "
-                                              "unlocked further by pid %d", inode_copy->name, pid);
+                                              "unlocked further by pid %d", inode->name, pid);
 
         GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -743,7 +994,7 @@ int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int
         errno = EBUSY;
 
         gnl_logger_warn(file_system->logger, "Unlock failed: file \"%s\" is locked by pid %d and it can "
-                                              "not be accessed", inode_copy->name, file_locked_by_pid);
+                                              "not be accessed", inode->name, file_locked_by_pid);
 
         GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
@@ -754,9 +1005,13 @@ int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int
     int res = gnl_simfs_inode_file_unlock(inode, pid);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
-    gnl_logger_debug(file_system->logger, "Unlock: file \"%s\" unlocked by pid %d", inode_copy->name, pid);
+    // stop tracking the lock into the session of the pid
+    res = gnl_simfs_session_table_remove_lock(file_system->session_table, pid, inode->name);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+    gnl_logger_debug(file_system->logger, "Unlock: file \"%s\" unlocked by pid %d", inode->name, pid);
 
-    gnl_logger_debug(file_system->logger, "Unlock: unlock of file \"%s\" succeeded, inode updated", inode_copy->name);
+    gnl_logger_debug(file_system->logger, "Unlock: unlock of file \"%s\" succeeded, inode updated", inode->name);
 
     // release the lock
     GNL_SIMFS_LOCK_RELEASE(-1, pid)
@@ -768,47 +1023,112 @@ int gnl_simfs_file_system_unlock(struct gnl_simfs_file_system *file_system, int
  * {@inheritDoc}
  */
 struct gnl_list_t *gnl_simfs_file_system_ls(struct gnl_simfs_file_system *file_system, unsigned int pid) {
-    // acquire the lock
-    GNL_SIMFS_LOCK_ACQUIRE(NULL, pid)
-
     // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, NULL, pid)
+    GNL_NULL_CHECK(file_system, EINVAL, NULL)
 
     gnl_logger_debug(file_system->logger, "ls: pid %d is trying to list the files of the file system", pid);
 
-    // get a list of all the files present into the file system
+    struct gnl_simfs_file_system_shard *shard;
+    struct gnl_list_t *list = NULL;
+    int res;
+
+    // get a list of all the files present into the file system,
+    // visiting one shard per time
+    for (size_t i=0; i<file_system->shards_count; i++) {
+        shard = file_system->shards + i;
+
+        // acquire the lock
+        GNL_SIMFS_LOCK_ACQUIRE(NULL, pid)
+
+        res = gnl_simfs_rts_shard_list(shard, &list);
+
+        // if an error occurred
+        if (res == -1) {
+            gnl_logger_error(file_system->logger, "ls failed: %s", strerror(errno));
+
+            gnl_list_destroy(&list, free);
+
+            GNL_SIMFS_LOCK_RELEASE(NULL, pid)
+
+            return NULL;
+        }
+
+        // release the lock
+        GNL_SIMFS_LOCK_RELEASE(NULL, pid)
+    }
+
+    // the list is NULL if the file system is empty
     errno = 0;
-    struct gnl_list_t *res = gnl_simfs_file_table_list(file_system->file_table);
+
+    gnl_logger_debug(file_system->logger, "ls: list of files succeeded");
+
+    return list;
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_list_t *gnl_simfs_file_system_read_n(struct gnl_simfs_file_system *file_system, int n, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, NULL)
+
+    gnl_logger_debug(file_system->logger, "Read N: pid %d is trying to read %d files of the file system", pid, n);
+
+    struct gnl_list_t *list = NULL;
+    int read_count = 0;
+    int res = 0;
+
+    // the files are read from a single snapshot of the
+    // file system, so all the shards must be locked
+    GNL_MINUS1_CHECK(gnl_simfs_rts_lock_shards(file_system), errno, NULL)
+
+    for (size_t i=0; i<file_system->shards_count && (n <= 0 || read_count < n); i++) {
+        res = gnl_simfs_rts_shard_read_files(file_system, file_system->shards + i, n <= 0 ? 0 : n - read_count, pid,
+                                             &list);
+        if (res == -1) {
+            break;
+        }
+
+        read_count += res;
+    }
+
+    int read_errno = errno;
+    gnl_simfs_rts_unlock_shards(file_system);
 
     // if an error occurred
-    if (res == NULL && errno != 0) {
-        gnl_logger_error(file_system->logger, "ls failed: %s", strerror(errno));
+    if (res == -1) {
+        gnl_logger_error(file_system->logger, "Read N failed: %s", strerror(read_errno));
 
-        GNL_SIMFS_LOCK_RELEASE(NULL, pid)
+        gnl_list_destroy(&list, gnl_simfs_rts_destroy_evicted_file);
+        errno = read_errno;
 
         return NULL;
     }
 
-    gnl_logger_debug(file_system->logger, "ls: list of files succeeded");
+    // the list is NULL if the file system is empty
+    errno = 0;
 
-    // release the lock
-    GNL_SIMFS_LOCK_RELEASE(NULL, pid)
+    gnl_logger_debug(file_system->logger, "Read N: %d files read", read_count);
 
-    return res;
+    return list;
 }
 
 /**
  * {@inheritDoc}
  */
 int gnl_simfs_file_system_stat(struct gnl_simfs_file_system *file_system, const char *filename,
-                               struct gnl_simfs_inode *buf, unsigned int pid) {
+                               struct gnl_simfs_stat *buf, unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(filename, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-    GNL_SIMFS_NULL_CHECK(filename, EINVAL, -1, pid)
-
     gnl_logger_debug(file_system->logger, "Stat: pid %d is trying to stat the file \"%s\"", pid, filename);
 
     // get the inode of the filename
@@ -827,16 +1147,9 @@ int gnl_simfs_file_system_stat(struct gnl_simfs_file_system *file_system, const
         return -1;
     }
 
-    // copy the inode
-    buf->btime = inode->btime;
-    buf->mtime = inode->mtime;
-    buf->atime = inode->atime;
-    buf->ctime = inode->ctime;
-    buf->size = inode->size;
-    buf->reference_count = inode->reference_count;
-
-    GNL_CALLOC(buf->name, strlen(inode->name) + 1, -1)
-    strcpy(buf->name, inode->name);
+    // copy the status of the inode
+    int res = gnl_simfs_rts_stat_inode(file_system, inode, buf);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
     gnl_logger_debug(file_system->logger, "Stat: stat of file \"%s\" succeeded", filename);
 
@@ -849,29 +1162,25 @@ int gnl_simfs_file_system_stat(struct gnl_simfs_file_system *file_system, const
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_file_system_fstat(struct gnl_simfs_file_system *file_system, int fd, struct gnl_simfs_inode *buf,
+int gnl_simfs_file_system_fstat(struct gnl_simfs_file_system *file_system, int fd, struct gnl_simfs_stat *buf,
         unsigned int pid) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
     // acquire the lock
     GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
 
-    // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
-
-    // get the inode of the fd
-    // search the file in the file descriptor table
+    // search the file of the file descriptor
     struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
     GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
 
-    // copy the inode
-    buf->btime = inode->btime;
-    buf->mtime = inode->mtime;
-    buf->atime = inode->atime;
-    buf->ctime = inode->ctime;
-    buf->size = inode->size;
-    buf->reference_count = inode->reference_count;
-
-    GNL_CALLOC(buf->name, strlen(inode->name) + 1, -1)
-    strcpy(buf->name, inode->name);
+    // copy the status of the inode
+    int res = gnl_simfs_rts_stat_inode(file_system, inode, buf);
+    GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
     // release the lock
     GNL_SIMFS_LOCK_RELEASE(-1, pid)
@@ -879,6 +1188,21 @@ int gnl_simfs_file_system_fstat(struct gnl_simfs_file_system *file_system, int f
     return 0;
 }
 
+/**
+ * Print the name of the given inode. It should be passed
+ * to the gnl_simfs_file_table_visit method.
+ *
+ * @param inode The inode visited.
+ * @param arg   Unused.
+ *
+ * @return      Returns always 0.
+ */
+static int print_inode_name(struct gnl_simfs_inode *inode, void *arg) {
+    printf("%s\n", inode->name);
+
+    return 0;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -902,6 +1226,10 @@ int gnl_simfs_file_system_status(struct gnl_simfs_file_system *file_system) {
            file_system->monitor->bytes_peak);
     printf("Number of evictions (replacement policy: %s): %d\n", dest, file_system->monitor->file_evictions);
 
+    int lookups = file_system->monitor->file_hits + file_system->monitor->file_misses;
+    printf("Hit ratio: %f (%d hits, %d misses)\n", lookups == 0 ? 0 : (double)file_system->monitor->file_hits / lookups,
+           file_system->monitor->file_hits, file_system->monitor->file_misses);
+
     // free memory
     free(dest);
 
@@ -911,39 +1239,32 @@ int gnl_simfs_file_system_status(struct gnl_simfs_file_system *file_system) {
 
     printf("File list:\n");
 
-    // reset the errno
-    errno = 0;
+    size_t cursor;
+    int files = 0;
 
-    struct gnl_list_t *list = gnl_simfs_file_table_list(file_system->file_table);
+    // print the filenames visiting the file tables in place
+    for (size_t i=0; i<file_system->shards_count; i++) {
+        cursor = gnl_simfs_file_table_count(file_system->shards[i].file_table);
 
-    // check the result
-    if (list == NULL) {
+        res = gnl_simfs_file_table_visit(file_system->shards[i].file_table, &cursor, 0, print_inode_name, NULL);
 
         // if an error occurred
-        if (errno != 0) {
+        if (res == -1) {
             perror("error on getting the files");
 
             return -1;
         }
 
-        printf("no files stored");
-        printf("\n");
-
-        return 0;
+        files += res;
     }
 
-    // print the file list
-    struct gnl_list_t *current = list;
-    while(current != NULL) {
-        printf("%s\n", (char *)current->el);
-
-        current = current->next;
+    // check the result
+    if (files == 0) {
+        printf("no files stored");
     }
 
     printf("\n");
 
-    gnl_list_destroy(&list, free);
-
     return 0;
 }
 
@@ -986,6 +1307,26 @@ int gnl_simfs_file_system_get_replacement_policy(struct gnl_simfs_file_system *f
             strcpy(*dest, "LFU");
             break;
 
+        case GNL_SIMFS_RP_ARC:
+        GNL_CALLOC(*dest, 4, -1);
+            strcpy(*dest, "ARC");
+            break;
+
+        case GNL_SIMFS_RP_2Q:
+        GNL_CALLOC(*dest, 3, -1);
+            strcpy(*dest, "2Q");
+            break;
+
+        case GNL_SIMFS_RP_WTINYLFU:
+        GNL_CALLOC(*dest, 9, -1);
+            strcpy(*dest, "WTINYLFU");
+            break;
+
+        case GNL_SIMFS_RP_GDSF:
+        GNL_CALLOC(*dest, 5, -1);
+            strcpy(*dest, "GDSF");
+            break;
+
         default:
             errno = EINVAL;
             return -1;
@@ -998,77 +1339,253 @@ int gnl_simfs_file_system_get_replacement_policy(struct gnl_simfs_file_system *f
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_file_system_remove_session(struct gnl_simfs_file_system *file_system, unsigned int pid) {
-    // acquire the lock
-    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
+int gnl_simfs_file_system_get_compression(struct gnl_simfs_file_system *file_system, char **dest) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
 
+    switch (file_system->compression) {
+
+        case GNL_SIMFS_COMPRESSION_NONE:
+        GNL_CALLOC(*dest, 5, -1);
+            strcpy(*dest, "none");
+            break;
+
+        case GNL_SIMFS_COMPRESSION_HUFFMAN:
+        GNL_CALLOC(*dest, 8, -1);
+            strcpy(*dest, "huffman");
+            break;
+
+        case GNL_SIMFS_COMPRESSION_LZ:
+        GNL_CALLOC(*dest, 3, -1);
+            strcpy(*dest, "lz");
+            break;
+
+        case GNL_SIMFS_COMPRESSION_AUTO:
+        GNL_CALLOC(*dest, 5, -1);
+            strcpy(*dest, "auto");
+            break;
+
+        default:
+            errno = EINVAL;
+            return -1;
+            /* UNREACHED */
+    }
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+long long gnl_simfs_file_system_reclaim(struct gnl_simfs_file_system *file_system, unsigned int high_watermark,
+        unsigned int low_watermark) {
     // validate the parameters
-    GNL_SIMFS_NULL_CHECK(file_system, EINVAL, -1, pid)
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (high_watermark > 100 || low_watermark > high_watermark), EINVAL, -1)
 
-    gnl_logger_debug(file_system->logger, "Remove session: removing pid %d session from the file system", pid);
+    // without a replacement policy nothing can be evicted
+    if (file_system->replacement_policy == GNL_SIMFS_RP_NONE) {
+        return 0;
+    }
+
+    // do not evict until the parked files are drained by the writes,
+    // so the parked files are bounded and none of them is dropped
+    long parked = gnl_simfs_rts_count_evicted(file_system);
+    GNL_MINUS1_CHECK(parked, errno, -1)
+
+    if (parked >= GNL_SIMFS_EVICTED_QUEUE_BOUND) {
+        gnl_logger_debug(file_system->logger, "Reclaim: %ld evicted files still parked, reclaim skipped", parked);
 
-    // unlock the inodes locked by pid
-    gnl_logger_debug(file_system->logger, "Remove session: unlocking every files locked by pid %d", pid);
+        return 0;
+    }
 
-    // get a list of files present into the file system
-    struct gnl_list_t *list = gnl_simfs_file_table_list(file_system->file_table);
-    GNL_SIMFS_NULL_CHECK(list, errno, -1, pid)
+    long long high_bytes = file_system->memory_limit * high_watermark / 100;
+    long long low_bytes = file_system->memory_limit * low_watermark / 100;
 
-    struct gnl_list_t *current = list;
+    // acquire the eviction lock, so the reclaim is
+    // serialized with the writes reserving bytes
+    int res = pthread_mutex_lock(&(file_system->mtx));
+    GNL_MINUS1_CHECK(res, errno, -1)
 
-    int res;
+    // the bytes reserved by the writes in progress are considered as used
+    long long used_bytes = (long long)file_system->memory_limit - gnl_simfs_rts_available_bytes(file_system);
 
-    // scan the list
-    while (current != NULL) {
-        char *filename = (char *)current->el;
+    if (used_bytes <= high_bytes) {
+        res = pthread_mutex_unlock(&(file_system->mtx));
+        GNL_MINUS1_CHECK(res, errno, -1)
 
-        // get the original inode of the filename
-        struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(file_system, filename);
-        GNL_SIMFS_NULL_CHECK(inode, errno, -1, pid)
+        return 0;
+    }
 
-        // get the number of open file by pid
-        int open_files = gnl_simfs_file_descriptor_table_pid_inode_size(file_system->file_descriptor_table, inode, pid);
-        GNL_SIMFS_MINUS1_CHECK(open_files, errno, -1, pid)
+    gnl_logger_debug(file_system->logger, "Reclaim: heap size of %lld bytes above the high watermark (%u%%), "
+                                          "evicting down to the low watermark (%u%%)", used_bytes, high_watermark,
+                                          low_watermark);
 
-        if (open_files > 0) {
-            // decrease refs
-            gnl_logger_debug(file_system->logger, "Remove session: decreasing refs of inode \"%s\" (%d refs)",
-                             filename, open_files);
+    struct gnl_list_t *evicted_list = NULL;
+    long long freed = -1;
+    int reclaim_errno;
 
-            while (open_files > 0) {
-                res = gnl_simfs_inode_decrease_refs(inode, pid);
-                GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+    // the victims can be any file of the file system,
+    // so all the shards must be locked
+    res = gnl_simfs_rts_lock_shards(file_system);
+    reclaim_errno = errno;
 
-                open_files--;
-            }
-        }
+    if (res == 0) {
+        freed = gnl_simfs_rts_evict(file_system, used_bytes - low_bytes, &evicted_list);
+        reclaim_errno = errno;
 
-        // if the given pid locked the inode, then unlock it
-        if (gnl_simfs_inode_is_file_locked(inode) == pid) {
-            res = gnl_simfs_inode_file_unlock(inode, pid);
+        gnl_simfs_rts_unlock_shards(file_system);
+    }
 
-            if (res == -1) {
-                // let the errno bubble
-                return -1;
-            }
+    // release the eviction lock
+    res = pthread_mutex_unlock(&(file_system->mtx));
+    GNL_MINUS1_CHECK(res, errno, -1)
 
-            gnl_logger_debug(file_system->logger, "Remove session: unlocked file \"%s\" previously locked by pid %d",
-                             inode->name, pid);
-        }
+    // if the used bytes are all reserved, there is nothing to evict
+    if (freed == -1 && reclaim_errno == EDQUOT) {
+        freed = 0;
+    }
+
+    // park the evicted files, even on error, since
+    // they are not into the file system anymore
+    res = gnl_simfs_rts_park_evicted(file_system, &evicted_list);
+
+    if (freed == -1) {
+        errno = reclaim_errno;
+
+        return -1;
+    }
+
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_logger_debug(file_system->logger, "Reclaim: %lld bytes freed", freed);
+
+    return freed;
+}
+
+/**
+ * Insert a copy of the given filename into the given list of targets.
+ *
+ * @param targets   The pointer to the list where to insert the filename,
+ *                  if NULL nothing is inserted.
+ * @param filename  The filename to insert.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int add_target(struct gnl_list_t **targets, const char *filename) {
+    if (targets == NULL) {
+        return 0;
+    }
+
+    char *target = calloc(strlen(filename) + 1, sizeof(char));
+    GNL_NULL_CHECK(target, ENOMEM, -1)
+
+    strcpy(target, filename);
 
-        current = current->next;
+    int res = gnl_list_insert(targets, target);
+    if (res == -1) {
+        free(target);
+
+        return -1;
     }
 
-    // remove the inodes of pid from the file descriptor table
-    gnl_logger_debug(file_system->logger, "Remove session: removing pid %d open files", pid);
+    return 0;
+}
 
-    res = gnl_simfs_file_descriptor_table_remove_pid(file_system->file_descriptor_table, pid);
+/**
+ * Close the given file descriptor of the session of the given pid, dropping the
+ * reference of the pid to its file.
+ *
+ * @param file_system   The file system instance where the session resides.
+ * @param fd            The file descriptor to close.
+ * @param pid           The id of the process of the session.
+ * @param targets       The pointer to the list where to insert the name of the
+ *                      file closed, NULL to not insert it.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int remove_session_fd(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid,
+        struct gnl_list_t **targets) {
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard_by_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(shard, errno, -1)
+
+    // acquire the lock
+    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
+
+    // the file may have been removed in the meanwhile
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode_by_fd(file_system, fd, pid);
+    if (inode == NULL && errno != ENOENT) {
+        GNL_SIMFS_LOCK_RELEASE(-1, pid)
+
+        return -1;
+    }
+
+    if (inode != NULL) {
+        // decrease refs
+        gnl_logger_debug(file_system->logger, "Remove session: decreasing refs of inode \"%s\"", inode->name);
+
+        int res = gnl_simfs_inode_decrease_refs(inode, pid);
+        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+        // the pid does not wait to lock the file anymore
+        res = gnl_simfs_inode_clear_pending_lock(inode, pid);
+        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+        // report the file closed, a failure must not keep the file descriptor
+        if (add_target(targets, inode->name) == -1) {
+            gnl_logger_warn(file_system->logger, "Remove session: file \"%s\" closed can not be reported: %s",
+                            inode->name, strerror(errno));
+        }
+    }
+
+    // remove the file descriptor
+    int res = gnl_simfs_file_descriptor_table_remove(file_system->file_descriptor_table, fd, pid);
     GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
 
-    // free memory
-    gnl_list_destroy(&list, free);
+    // release the lock
+    GNL_SIMFS_LOCK_RELEASE(-1, pid)
 
-    gnl_logger_debug(file_system->logger, "Remove session: remove session of pid %d succeeded", pid);
+    return 0;
+}
+
+/**
+ * Release the lock held by the session of the given pid on the given file.
+ *
+ * @param file_system   The file system instance where the session resides.
+ * @param filename      The name of the file locked.
+ * @param pid           The id of the process of the session.
+ * @param targets       The pointer to the list where to insert the name of the
+ *                      file unlocked, NULL to not insert it.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int remove_session_lock(struct gnl_simfs_file_system *file_system, const char *filename, unsigned int pid,
+        struct gnl_list_t **targets) {
+    // get the shard of the file
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, -1)
+
+    // acquire the lock
+    GNL_SIMFS_LOCK_ACQUIRE(-1, pid)
+
+    // the file may have been evicted in the meanwhile
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(shard->file_table, filename);
+
+    // if the given pid locked the inode, then unlock it
+    if (inode != NULL && gnl_simfs_inode_is_file_locked(inode) == pid) {
+        int res = gnl_simfs_inode_file_unlock(inode, pid);
+        GNL_SIMFS_MINUS1_CHECK(res, errno, -1, pid)
+
+        gnl_logger_debug(file_system->logger, "Remove session: unlocked file \"%s\" previously locked by pid %d",
+                         inode->name, pid);
+
+        // report the file unlocked
+        if (add_target(targets, inode->name) == -1) {
+            gnl_logger_warn(file_system->logger, "Remove session: file \"%s\" unlocked can not be reported: %s",
+                            inode->name, strerror(errno));
+        }
+    }
 
     // release the lock
     GNL_SIMFS_LOCK_RELEASE(-1, pid)
@@ -1076,7 +1593,68 @@ int gnl_simfs_file_system_remove_session(struct gnl_simfs_file_system *file_syst
     return 0;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_file_system_remove_session(struct gnl_simfs_file_system *file_system, unsigned int pid,
+        struct gnl_list_t **targets) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    gnl_logger_debug(file_system->logger, "Remove session: removing pid %d session from the file system", pid);
+
+    // detach the session, it lists only what the pid is using
+    struct gnl_simfs_session *session = gnl_simfs_session_table_detach(file_system->session_table, pid);
+
+    if (session == NULL) {
+        // if the pid never opened a file there is nothing to do
+        GNL_MINUS1_CHECK(-1 * (errno != 0), errno, -1)
+
+        gnl_logger_debug(file_system->logger, "Remove session: pid %d has no session", pid);
+
+        return 0;
+    }
+
+    // a failure does not stop the removal, the other files of the
+    // session are released anyway and the first error is reported
+    int res = 0;
+    int remove_errno = 0;
+
+    // close the files opened by pid
+    gnl_logger_debug(file_system->logger, "Remove session: closing %d files opened by pid %d",
+                     session->fds_count, pid);
+
+    for (int i=0; i<session->fds_count; i++) {
+        if (remove_session_fd(file_system, session->fds[i], pid, targets) == -1 && res == 0) {
+            res = -1;
+            remove_errno = errno;
+        }
+    }
+
+    // unlock the files locked by pid
+    gnl_logger_debug(file_system->logger, "Remove session: unlocking %d files locked by pid %d",
+                     session->locks_count, pid);
+
+    for (int i=0; i<session->locks_count; i++) {
+        if (remove_session_lock(file_system, session->locks[i], pid, targets) == -1 && res == 0) {
+            res = -1;
+            remove_errno = errno;
+        }
+    }
+
+    // free memory
+    gnl_simfs_session_destroy(session);
+
+    GNL_MINUS1_CHECK(res, remove_errno, -1)
+
+    gnl_logger_debug(file_system->logger, "Remove session: remove session of pid %d succeeded", pid);
+
+    return 0;
+}
+
 #undef GNL_SIMFS_MAX_OPEN_FILES
+#undef GNL_SIMFS_SHARDS_COUNT
+#undef GNL_SIMFS_EVICTED_QUEUE_BOUND
 
 #undef GNL_SIMFS_LOCK_ACQUIRE
 #undef GNL_SIMFS_LOCK_RELEASE
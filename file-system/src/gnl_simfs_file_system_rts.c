@@ -1,16 +1,35 @@
 #include <errno.h>
 #include <string.h>
 #include <gnl_logger.h>
+#include <gnl_queue_t.h>
 #include "../include/gnl_simfs_file_system.h"
 #include "../include/gnl_simfs_file_system_struct.h"
 #include "./gnl_simfs_file_table.c"
+#include "./gnl_simfs_policy_index.c"
 #include "./gnl_simfs_evicted_file.c"
 #include "./gnl_simfs_monitor.c"
 #include "./gnl_simfs_file_descriptor_table.c"
+#include "./gnl_simfs_session_table.c"
 #include <gnl_macro_beg.h>
 
 #define GNL_SIMFS_BYTES_IN_A_MEGABYTE 1048576
 
+/**
+ * Macro to acquire the quota lock.
+ */
+#define GNL_SIMFS_QUOTA_ACQUIRE(return_value) {                                 \
+    int quota_acquire_res = pthread_mutex_lock(&(file_system->quota_mtx));      \
+    GNL_MINUS1_CHECK(quota_acquire_res, errno, return_value)                    \
+}
+
+/**
+ * Macro to release the quota lock.
+ */
+#define GNL_SIMFS_QUOTA_RELEASE(return_value) {                                 \
+    int quota_release_res = pthread_mutex_unlock(&(file_system->quota_mtx));    \
+    GNL_MINUS1_CHECK(quota_release_res, errno, return_value)                    \
+}
+
 /**
  * Convert the given bytes into megabytes.
  *
@@ -35,6 +54,128 @@ static double mb_to_bytes(unsigned long long mb) {
     return mb * GNL_SIMFS_BYTES_IN_A_MEGABYTE;
 }
 
+/**
+ * Get the shard where the given filename resides. The shard is chosen
+ * hashing the filename with the djb2 algorithm.
+ *
+ * @param file_system   The file system instance where the shards reside.
+ * @param filename      The filename of which to get the shard.
+ *
+ * @return              Returns the shard of the given filename on success,
+ *                      NULL otherwise.
+ */
+static struct gnl_simfs_file_system_shard *gnl_simfs_rts_get_shard(struct gnl_simfs_file_system *file_system,
+        const char *filename) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, NULL)
+    GNL_NULL_CHECK(filename, EINVAL, NULL)
+
+    unsigned long hash = 5381;
+    const unsigned char *c = (const unsigned char *)filename;
+
+    while (*c != '\0') {
+        hash = ((hash << 5) + hash) + *c;
+        c++;
+    }
+
+    return file_system->shards + (hash % file_system->shards_count);
+}
+
+/**
+ * Acquire the locks of all the shards of the given file system. The locks
+ * are always acquired in the same order to prevent deadlocks.
+ *
+ * @param file_system   The file system instance where the shards reside.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_lock_shards(struct gnl_simfs_file_system *file_system) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    int res;
+
+    for (size_t i=0; i<file_system->shards_count; i++) {
+        res = pthread_mutex_lock(&(file_system->shards[i].mtx));
+        GNL_MINUS1_CHECK(res, errno, -1)
+    }
+
+    return 0;
+}
+
+/**
+ * Release the locks of all the shards of the given file system.
+ *
+ * @param file_system   The file system instance where the shards reside.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_unlock_shards(struct gnl_simfs_file_system *file_system) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    int res;
+
+    for (size_t i=file_system->shards_count; i>0; i--) {
+        res = pthread_mutex_unlock(&(file_system->shards[i - 1].mtx));
+        GNL_MINUS1_CHECK(res, errno, -1)
+    }
+
+    return 0;
+}
+
+/**
+ * Put a copy of the name of the given inode at the head of the list pointed by arg.
+ * It should be passed to the gnl_simfs_file_table_visit method.
+ *
+ * @param inode The inode visited.
+ * @param arg   The pointer to the list.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_list_inode(struct gnl_simfs_inode *inode, void *arg) {
+    struct gnl_list_t **list = (struct gnl_list_t **)arg;
+
+    // copy the filename
+    char *filename = calloc((strlen(inode->name) + 1), sizeof(char));
+    GNL_NULL_CHECK(filename, ENOMEM, -1)
+
+    strcpy(filename, inode->name);
+
+    // insert the deep copy of the filename into the list
+    int res = gnl_list_insert(list, filename);
+    if (res == -1) {
+        free(filename);
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Insert the filenames of the files present into the given shard into the given list.
+ * The caller must hold the lock of the shard.
+ *
+ * @param shard The shard from where to get the filenames.
+ * @param list  The list where to insert the filenames.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_shard_list(struct gnl_simfs_file_system_shard *shard, struct gnl_list_t **list) {
+    // validate the parameters
+    GNL_NULL_CHECK(shard, EINVAL, -1)
+    GNL_NULL_CHECK(list, EINVAL, -1)
+
+    size_t cursor = gnl_simfs_file_table_count(shard->file_table);
+
+    // copy the filenames of the shard visiting its file table in place
+    int res = gnl_simfs_file_table_visit(shard->file_table, &cursor, 0, gnl_simfs_rts_list_inode, list);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return 0;
+}
+
 /**
  * Get the original inode of the given filename.
  *
@@ -49,8 +190,12 @@ static struct gnl_simfs_inode *gnl_simfs_rts_get_inode(struct gnl_simfs_file_sys
     GNL_NULL_CHECK(file_system, EINVAL, NULL)
     GNL_MINUS1_CHECK(-1 * (strlen(filename) == 0), EINVAL, NULL)
 
+    // get the shard of the filename
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, NULL)
+
     // get the original inode of the filename
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_system->file_table, filename);
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(shard->file_table, filename);
 
     // check getting error
     if (inode == NULL) {
@@ -68,6 +213,56 @@ static struct gnl_simfs_inode *gnl_simfs_rts_get_inode(struct gnl_simfs_file_sys
     return inode;
 }
 
+/**
+ * Track a reference to the given original inode into the policy index of the
+ * given file system. It should be called whenever the file pointed by the
+ * inode is opened.
+ *
+ * @param file_system   The file system instance where the inode resides.
+ * @param inode         The original inode accessed.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_touch_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    int res = gnl_simfs_policy_index_touch(file_system->policy_index, inode);
+    if (res == -1) {
+        gnl_logger_warn(file_system->logger, "Update of the policy index on entry \"%s\" failed: %s", inode->name,
+                        strerror(errno));
+
+        //let the errno bubble
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Track the outcome of a lookup of an existing file into the given file
+ * system, to compute the hit ratio of the replacement policy.
+ *
+ * @param file_system   The file system instance where the lookup occurred.
+ * @param hit           1 if the file was found, 0 otherwise.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_track_lookup(struct gnl_simfs_file_system *file_system, int hit) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    int res = hit ? gnl_simfs_monitor_file_hit(file_system->monitor) : gnl_simfs_monitor_file_missed(file_system->monitor);
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    return res;
+}
+
 /**
  * Create a new file and put it into the given file system.
  *
@@ -84,70 +279,142 @@ static struct gnl_simfs_inode *gnl_simfs_rts_create_inode(struct gnl_simfs_file_
 
     gnl_logger_debug(file_system->logger, "Creating file: \"%s\"", filename);
 
+    // get the shard of the filename
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, filename);
+    GNL_NULL_CHECK(shard, errno, NULL)
+
+    // the limits are global, so check them and create the
+    // file atomically with respect to the other shards
+    GNL_SIMFS_QUOTA_ACQUIRE(NULL)
+
     // check if we can create a new file
-    int count = gnl_simfs_file_table_count(file_system->file_table);
-    GNL_MINUS1_CHECK(count, errno, NULL)
+    int count = file_system->monitor->file_counter;
 
     if (count == file_system->files_limit) {
         gnl_logger_warn(file_system->logger, "Creation of file \"%s\" failed, max number of files reached (%d/%d)",
                          filename, count, file_system->files_limit);
 
+        GNL_SIMFS_QUOTA_RELEASE(NULL)
+
         errno = EDQUOT;
         return NULL;
     }
 
     // check if there is enough memory
-    int size = gnl_simfs_file_table_size(file_system->file_table);
-    GNL_MINUS1_CHECK(size, errno, NULL)
+    unsigned long long size = file_system->monitor->bytes_counter;
 
     if (size == file_system->memory_limit) {
-        gnl_logger_warn(file_system->logger, "Creation of file \"%s\" failed, max heap size reached (%d/%d)",
+        gnl_logger_warn(file_system->logger, "Creation of file \"%s\" failed, max heap size reached (%lld/%lld)",
                          filename, size, file_system->memory_limit);
 
+        GNL_SIMFS_QUOTA_RELEASE(NULL)
+
         errno = EDQUOT;
         return NULL;
     }
 
     // create a new inode
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_create(file_system->file_table, filename);
-    GNL_NULL_CHECK(inode, errno, NULL)
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_create(shard->file_table, filename);
+    if (inode == NULL) {
+        // let the errno bubble
+        GNL_SIMFS_QUOTA_RELEASE(NULL)
 
-    gnl_logger_debug(file_system->logger, "Created file \"%s\"", filename);
+        return NULL;
+    }
 
-    // log the new file table count
-    count = gnl_simfs_file_table_count(file_system->file_table);
-    GNL_MINUS1_CHECK(count, errno, NULL);
+    // index the file in accordance with the replacement policy
+    int res = gnl_simfs_policy_index_insert(file_system->policy_index, inode);
+    if (res == -1) {
+        int insert_errno = errno;
 
-    gnl_logger_debug(file_system->logger, "The file system has now %d files", count);
+        gnl_simfs_file_table_remove(shard->file_table, filename);
+
+        GNL_SIMFS_QUOTA_RELEASE(NULL)
+
+        errno = insert_errno;
+        return NULL;
+    }
+
+    gnl_logger_debug(file_system->logger, "Created file \"%s\", the shard %d has now %d files", filename, shard->id,
+                     gnl_simfs_file_table_count(shard->file_table));
 
     // track the event
-    int res = gnl_simfs_monitor_file_added(file_system->monitor);
+    res = gnl_simfs_monitor_file_added(file_system->monitor);
+
+    // log the new file count
+    count = file_system->monitor->file_counter;
+
+    GNL_SIMFS_QUOTA_RELEASE(NULL)
+
     GNL_MINUS1_CHECK(res, errno, NULL);
 
+    gnl_logger_debug(file_system->logger, "The file system has now %d files", count);
+
     return inode;
 }
 
 /**
- * Update an existing file table entry with the given, more updated, inode.
+ * Copy the status of the given inode into the given buf.
+ *
+ * @param file_system   The file system instance where the inode resides.
+ * @param inode         The inode of which copy the status.
+ * @param buf           The pointer where to copy the status, its name
+ *                      is allocated and it must be freed by the caller.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_stat_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode,
+        struct gnl_simfs_stat *buf) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+    GNL_NULL_CHECK(buf, EINVAL, -1)
+
+    GNL_CALLOC(buf->name, strlen(inode->name) + 1, -1)
+    strcpy(buf->name, inode->name);
+
+    buf->size = inode->size;
+    buf->reference_count = gnl_simfs_inode_reference_count(inode);
+    buf->btime = inode->btime;
+    buf->mtime = inode->mtime;
+    buf->atime = inode->atime;
+    buf->ctime = inode->ctime;
+    buf->access_clock = inode->access_clock;
+
+    // report the aged frequency
+    buf->frequency = gnl_simfs_policy_index_frequency(file_system->policy_index, inode);
+
+    return 0;
+}
+
+/**
+ * Flush the given buffer into the file of the given inode of the file table.
  *
  * @param file_system   The file system instance where the file table resides.
- * @param buffer_entry  The inode to use to fflush.
+ * @param inode         The inode of the file table where to flush the buffer.
+ * @param buffer        The buffer to flush, it is reset.
  *
  * @return              Returns 0 on success, -1 otherwise.
  */
-static int gnl_simfs_rts_fflush_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode) {
+static int gnl_simfs_rts_fflush_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode,
+        struct gnl_simfs_inode_buffer *buffer) {
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, -1)
     GNL_NULL_CHECK(inode, EINVAL, -1)
+    GNL_NULL_CHECK(buffer, EINVAL, -1)
 
     gnl_logger_debug(file_system->logger, "Flushing inode of file entry \"%s\" into the file table", inode->name);
 
-    // get the current inode size to calculate
-    // the bytes that will be added
-    int old_size = inode->size;
+    // get the bytes that will be added, the buffer
+    // contains already compressed chunks
+    int bytes_added = buffer->size;
+
+    // get the shard of the inode
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, inode->name);
+    GNL_NULL_CHECK(shard, errno, -1)
 
-    // update the inode with the new entry
-    int res = gnl_simfs_file_table_fflush(file_system->file_table, inode);
+    // append the buffer to the file
+    int res = gnl_simfs_file_table_fflush(shard->file_table, inode, buffer);
     if (res == -1) {
         gnl_logger_warn(file_system->logger, "File flush on entry \"%s\" failed: %s", inode->name, strerror(errno));
 
@@ -156,54 +423,175 @@ static int gnl_simfs_rts_fflush_inode(struct gnl_simfs_file_system *file_system,
         return -1;
     }
 
+    // the file was used by the open that referenced it, so update its
+    // recency and its size into the policy index
+    res = gnl_simfs_policy_index_update(file_system->policy_index, inode);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
     // track the event calculating the bytes added
-    res = gnl_simfs_monitor_bytes_added(file_system->monitor, inode->size - old_size);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    res = gnl_simfs_monitor_bytes_added(file_system->monitor, bytes_added);
 
-    // log the new file table size
-    int size = gnl_simfs_file_table_size(file_system->file_table);
-    GNL_MINUS1_CHECK(size, errno, -1);
+    // log the new heap size
+    unsigned long long size = file_system->monitor->bytes_counter;
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    GNL_MINUS1_CHECK(res, errno, -1);
 
     gnl_logger_debug(file_system->logger, "File flush on entry \"%s\" succeeded", inode->name);
-    gnl_logger_debug(file_system->logger, "Inode compressed into %d bytes", inode->size);
+    gnl_logger_debug(file_system->logger, "Inode size is now %d bytes (compressed)", inode->size);
     gnl_logger_debug(file_system->logger, "The heap size is now %f MB (%lld bytes)", bytes_to_mb(size), size);
 
     return 0;
 }
 
 /**
- * Read the file within the original node of the given inode_copy.
+ * Read the file within the given inode, the whole file or
+ * a piece of it as described by gnl_simfs_inode_read_chunk.
  *
  * @param file_system   The file system instance where the file table resides.
- * @param inode_copy    The copy of the inode to read.
+ * @param inode         The inode of the file table to read.
+ * @param offset        The offset of the first byte to read, if max > 0.
+ * @param max           The maximum number of bytes of the piece to read,
+ *                      0 to read the whole file.
  * @param buf           The buffer pointer where to write the read data.
  * @param count         The count of bytes read.
  *
  * @return              Returns 0 on success, -1 otherwise.
  */
-static int gnl_simfs_rts_read_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode_copy,
-        void **buf, size_t *count) {
+static int gnl_simfs_rts_read_inode(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode,
+        size_t offset, size_t max, void **buf, size_t *count) {
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, -1)
-    GNL_NULL_CHECK(inode_copy, EINVAL, -1)
-
-    gnl_logger_debug(file_system->logger, "Reading inode of file entry \"%s\" from the file table", inode_copy->name);
-
-    // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_system->file_table, inode_copy->name);
+    GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    // if the key is not present return an error
-    GNL_NULL_CHECK(inode, errno, -1)
+    gnl_logger_debug(file_system->logger, "Reading inode of file entry \"%s\" from the file table", inode->name);
 
     // read the file into the given buf
-    int res = gnl_simfs_inode_read(inode, buf, count);
+    int res;
+    if (max == 0) {
+        res = gnl_simfs_inode_read(inode, buf, count);
+    } else {
+        res = gnl_simfs_inode_read_chunk(inode, offset, max, buf, count);
+    }
+
     GNL_MINUS1_CHECK(res, errno, -1);
 
-    gnl_logger_debug(file_system->logger, "Read on entry \"%s\" succeeded", inode_copy->name);
+    gnl_logger_debug(file_system->logger, "Read on entry \"%s\" succeeded", inode->name);
 
     return 0;
 }
 
+/**
+ * The state of a read of the files of a shard.
+ */
+struct gnl_simfs_rts_read_files {
+
+    // the file system instance where the shard resides
+    struct gnl_simfs_file_system *file_system;
+
+    // the id of the process who is reading
+    unsigned int pid;
+
+    // the maximum number of files to read, if <= 0
+    // all the files are read
+    int max;
+
+    // the number of files read
+    int read_count;
+
+    // the list of the files read
+    struct gnl_list_t **list;
+};
+
+/**
+ * Read the file of the given inode into the list of the read pointed by arg.
+ * It should be passed to the gnl_simfs_file_table_visit method.
+ *
+ * @param inode The inode visited.
+ * @param arg   The gnl_simfs_rts_read_files state of the read.
+ *
+ * @return      Returns 0 to go on reading, 1 if the read is over,
+ *              -1 on error.
+ */
+static int gnl_simfs_rts_read_file(struct gnl_simfs_inode *inode, void *arg) {
+    struct gnl_simfs_rts_read_files *read = (struct gnl_simfs_rts_read_files *)arg;
+
+    // a file locked by another pid can not be read
+    if (inode->locked > 0 && inode->locked != read->pid) {
+        return 0;
+    }
+
+    struct gnl_simfs_evicted_file *file = gnl_simfs_evicted_file_init();
+    GNL_NULL_CHECK(file, errno, -1)
+
+    int res = -1;
+
+    file->name = calloc(strlen(inode->name) + 1, sizeof(char));
+    if (file->name == NULL) {
+        errno = ENOMEM;
+    } else {
+        strcpy(file->name, inode->name);
+        res = gnl_simfs_inode_read(inode, &(file->bytes), &(file->count));
+    }
+
+    if (res == 0) {
+        res = gnl_list_insert(read->list, file);
+    }
+
+    if (res == -1) {
+        gnl_simfs_evicted_file_destroy(file);
+
+        return -1;
+    }
+
+    read->read_count++;
+
+    // track the access to the file
+    res = gnl_simfs_rts_touch_inode(read->file_system, inode);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    res = gnl_simfs_rts_track_lookup(read->file_system, 1);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return read->max > 0 && read->read_count == read->max;
+}
+
+/**
+ * Read the files of the given shard, up to max files, and insert them into the given
+ * list as decoded gnl_simfs_evicted_file elements. The files locked by another pid
+ * are skipped. Every file read is tracked as an access, as an open would do. The
+ * caller must hold the lock of the shard.
+ *
+ * @param file_system   The file system instance where the shard resides.
+ * @param shard         The shard from where to read the files.
+ * @param max           The maximum number of files to read, if <= 0 all the
+ *                      files of the shard are read.
+ * @param pid           The id of the process who is reading.
+ * @param list          The list where to insert the files read.
+ *
+ * @return              Returns the number of files read on success,
+ *                      -1 otherwise.
+ */
+static int gnl_simfs_rts_shard_read_files(struct gnl_simfs_file_system *file_system,
+        struct gnl_simfs_file_system_shard *shard, int max, unsigned int pid, struct gnl_list_t **list) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(shard, EINVAL, -1)
+    GNL_NULL_CHECK(list, EINVAL, -1)
+
+    struct gnl_simfs_rts_read_files read = {file_system, pid, max, 0, list};
+    size_t cursor = gnl_simfs_file_table_count(shard->file_table);
+
+    // read the files visiting the file table in place
+    int res = gnl_simfs_file_table_visit(shard->file_table, &cursor, 0, gnl_simfs_rts_read_file, &read);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return read.read_count;
+}
+
 /**
  * Remove an existing file table entry.
  *
@@ -228,8 +616,16 @@ static int gnl_simfs_rts_remove_inode(struct gnl_simfs_file_system *file_system,
     // get the size of the inode
     int count = inode->size;
 
+    // get the shard of the key
+    struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(file_system, key);
+    GNL_NULL_CHECK(shard, errno, -1)
+
+    // remove the file from the policy index, before its inode is destroyed
+    int res = gnl_simfs_policy_index_remove(file_system->policy_index, inode);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
     // remove the file
-    int res = gnl_simfs_file_table_remove(file_system->file_table, key);
+    res = gnl_simfs_file_table_remove(shard->file_table, key);
     if (res == -1) {
         gnl_logger_warn(file_system->logger, "Remove on entry \"%s\" failed: %s", key, strerror(errno));
 
@@ -238,16 +634,20 @@ static int gnl_simfs_rts_remove_inode(struct gnl_simfs_file_system *file_system,
         return -1;
     }
 
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
     // track the event
     res = gnl_simfs_monitor_bytes_removed(file_system->monitor, count);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    if (res == 0) {
+        res = gnl_simfs_monitor_file_removed(file_system->monitor);
+    }
 
-    res = gnl_simfs_monitor_file_removed(file_system->monitor);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    // get the new heap size for logging
+    unsigned long long size = file_system->monitor->bytes_counter;
 
-    // get the new file table size for logging
-    int size = gnl_simfs_file_table_size(file_system->file_table);
-    GNL_MINUS1_CHECK(size, errno, -1);
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    GNL_MINUS1_CHECK(res, errno, -1);
 
     gnl_logger_debug(file_system->logger, "Remove on entry \"%s\" succeeded, %d bytes freed", key, count);
     gnl_logger_debug(file_system->logger, "The heap size is now %f MB (%lld bytes)", bytes_to_mb(size), size);
@@ -255,16 +655,20 @@ static int gnl_simfs_rts_remove_inode(struct gnl_simfs_file_system *file_system,
 }
 
 /**
- * Check if the file pointed by the given inode is lockable: if not, wait for it.
- * Attention! An invocation to this method may block the process until the file pointed
- * by the given inode returns lockable.
+ * Check if the file pointed by the given inode is lockable by the given pid. The
+ * check never waits: the caller is supposed to try again once the other pids have
+ * closed the file, since it may hold the thread that would handle their requests.
  *
  * @param file_system       The file system instance where the given inode resides.
  * @param inode             The inode pointing to the target file.
+ * @param pid               The current process id.
  *
- * @return                  Returns 0 on success, -1 otherwise.
+ * @return                  Returns 0 if the file is lockable, -1 otherwise,
+ *                          with errno set to EBUSY if the file is opened by
+ *                          other pids.
  */
-static int gnl_simfs_rts_wait_file_to_be_lockable(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode, int pid) {
+static int gnl_simfs_rts_check_file_lockable(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode,
+        int pid) {
 
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, -1)
@@ -281,16 +685,14 @@ static int gnl_simfs_rts_wait_file_to_be_lockable(struct gnl_simfs_file_system *
         return -1;
     }
 
-    int test, res;
-
-    while ((test = (gnl_simfs_inode_has_refs(inode) && gnl_simfs_inode_has_other_pid_refs(inode, pid) == 1)) > 0) {
-        GNL_MINUS1_CHECK(test, errno, -1)
-
+    // if the file is opened by other pids return an error
+    if (gnl_simfs_inode_has_refs(inode) && gnl_simfs_inode_has_other_pid_refs(inode, pid) == 1) {
         gnl_logger_debug(file_system->logger, "The file \"%s\" is opened (but not locked) by one or more pid, "
-                                              "it can not be locked, waiting", inode->name);
+                                              "it can not be locked yet", inode->name);
 
-        res = gnl_simfs_inode_wait_file_lockability(inode, &(file_system->mtx));
-        GNL_MINUS1_CHECK(res, errno, -1)
+        errno = EBUSY;
+
+        return -1;
     }
 
     // if this point is reached, the target file is ready to be used
@@ -301,7 +703,9 @@ static int gnl_simfs_rts_wait_file_to_be_lockable(struct gnl_simfs_file_system *
 }
 
 /**
- * Lock the file pointed by the given inode,
+ * Lock the file pointed by the given inode. If the file is opened by other
+ * pids, the given pid is marked as waiting to lock it, and the call fails
+ * with EBUSY: the lock must be requested again once the file is closed.
  *
  * @param file_system   The file system instance where the given inode resides.
  * @param inode         The inode pointing to the file to lock.
@@ -315,52 +719,59 @@ static int gnl_simfs_rts_lock_inode(struct gnl_simfs_file_system *file_system, s
     GNL_NULL_CHECK(file_system, EINVAL, -1)
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    // check if there are pending locks, since the intention
-    // here is to lock the inode, if the inode is not
-    // locked and there are pending locks, then this check prevents
-    // the occurring of a deadlock
-    int res = gnl_simfs_inode_has_pending_locks(inode);
-    GNL_MINUS1_CHECK(-1 * res, EDEADLK, -1)
-
-    // increase the pending locks count of the inode
-    // to inform that a lock is pending
-    res = gnl_simfs_inode_increase_pending_locks(inode);
+    // mark the pid as waiting to lock the file, if another pid is
+    // already waiting then fail with EDEADLK: the two pids might be
+    // waiting for each other to close the file
+    int res = gnl_simfs_inode_set_pending_lock(inode, pid);
     GNL_MINUS1_CHECK(res, errno, -1)
 
-    // check if the file can be locked: if not, wait for it
-    res = gnl_simfs_rts_wait_file_to_be_lockable(file_system, inode, pid);
-    GNL_MINUS1_CHECK(res, errno, -1)
+    // check if the file can be locked: if not, the pid keeps waiting
+    res = gnl_simfs_rts_check_file_lockable(file_system, inode, pid);
+    if (res == -1) {
+        if (errno != EBUSY) {
+            int lock_errno = errno;
+            gnl_simfs_inode_clear_pending_lock(inode, pid);
+            errno = lock_errno;
+        }
+
+        return -1;
+    }
 
     // lock the file
     res = gnl_simfs_inode_file_lock(inode, pid);
     GNL_MINUS1_CHECK(res, errno, -1)
 
-    // decrease the pending_locks count
-    res = gnl_simfs_inode_decrease_pending_locks(inode);
+    // the pid is not waiting anymore
+    res = gnl_simfs_inode_clear_pending_lock(inode, pid);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // track the lock into the session of the pid
+    res = gnl_simfs_session_table_add_lock(file_system->session_table, pid, inode->name);
     GNL_MINUS1_CHECK(res, errno, -1)
 
     return 0;
 }
 
 /**
- * Return the inode referred by the given fd from the file descriptor table.
+ * Return the file descriptor entry of the given fd from the file descriptor table.
  *
- * @param file_system   The file system instance where the file table resides.
+ * @param file_system   The file system instance where the file descriptor table resides.
  * @param fd            The file descriptor.
  * @param pid           The current process id.
  *
- * @return              Returns the inode referred by fd on success,
+ * @return              Returns the file descriptor entry of fd on success,
  *                      NULL otherwise.
  */
-static struct gnl_simfs_inode *gnl_simfs_rts_get_inode_by_fd(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+static struct gnl_simfs_file_descriptor *gnl_simfs_rts_get_fd(struct gnl_simfs_file_system *file_system, int fd,
+        unsigned int pid) {
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, NULL)
 
     // search the file in the file descriptor table
-    struct gnl_simfs_inode *inode = gnl_simfs_file_descriptor_table_get(file_system->file_descriptor_table, fd, pid);
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(file_system->file_descriptor_table, fd, pid);
 
-    // if the file is not present return an error
-    if (inode == NULL) {
+    // if the file descriptor is not present return an error
+    if (file_descriptor == NULL) {
         gnl_logger_debug(file_system->logger, "File descriptor %d does not exist, returning with error", fd);
 
         //let the errno bubble
@@ -368,11 +779,126 @@ static struct gnl_simfs_inode *gnl_simfs_rts_get_inode_by_fd(struct gnl_simfs_fi
         return NULL;
     }
 
+    return file_descriptor;
+}
+
+/**
+ * Return the inode referred by the given fd, resolving its handle into the
+ * file table. The caller must hold the lock of the shard of the fd.
+ *
+ * @param file_system   The file system instance where the file table resides.
+ * @param fd            The file descriptor.
+ * @param pid           The current process id.
+ *
+ * @return              Returns the inode referred by fd on success, NULL
+ *                      otherwise: if the file was removed the errno is
+ *                      set to ENOENT.
+ */
+static struct gnl_simfs_inode *gnl_simfs_rts_get_inode_by_fd(struct gnl_simfs_file_system *file_system, int fd, unsigned int pid) {
+    // search the file in the file descriptor table
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_rts_get_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(file_descriptor, errno, NULL)
+
+    struct gnl_simfs_file_system_shard *shard = file_system->shards + file_descriptor->handle.shard;
+
+    // resolve the handle of the file
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get_by_handle(shard->file_table, &(file_descriptor->handle));
+
+    // if the file was removed return an error
+    if (inode == NULL) {
+        gnl_logger_debug(file_system->logger, "File descriptor %d is pointing a removed file, returning with error", fd);
+
+        //let the errno bubble
+
+        return NULL;
+    }
+
     gnl_logger_debug(file_system->logger, "File descriptor %d is pointing the file \"%s\"", fd, inode->name);
 
     return inode;
 }
 
+/**
+ * Return the shard of the file referred by the given fd.
+ *
+ * @param file_system   The file system instance where the shards reside.
+ * @param fd            The file descriptor.
+ * @param pid           The current process id.
+ *
+ * @return              Returns the shard of the file referred by fd on success,
+ *                      NULL otherwise.
+ */
+static struct gnl_simfs_file_system_shard *gnl_simfs_rts_get_shard_by_fd(struct gnl_simfs_file_system *file_system,
+        int fd, unsigned int pid) {
+    // search the file in the file descriptor table
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_rts_get_fd(file_system, fd, pid);
+    GNL_NULL_CHECK(file_descriptor, errno, NULL)
+
+    return file_system->shards + file_descriptor->handle.shard;
+}
+
+/**
+ * Check if the file of the given inode can be written by the given pid,
+ * that is if the file is not locked or if the lock is owned by the pid.
+ * The caller must hold the lock of the shard of the inode.
+ *
+ * @param file_system   The file system instance where the file resides.
+ * @param inode         The inode of the file to write.
+ * @param pid           The current process id.
+ *
+ * @return              Returns 0 if the file can be written, -1 otherwise.
+ */
+static int gnl_simfs_rts_check_write_lock(struct gnl_simfs_file_system *file_system, struct gnl_simfs_inode *inode,
+        unsigned int pid) {
+    // get if the file is locked information
+    int file_locked_by_pid = gnl_simfs_inode_is_file_locked(inode);
+    GNL_MINUS1_CHECK(file_locked_by_pid, errno, -1)
+
+    // check if the file is not locked or if we own the lock
+    if (file_locked_by_pid > 0 && file_locked_by_pid != pid) {
+        errno = EBUSY;
+
+        gnl_logger_warn(file_system->logger, "Write failed: file \"%s\" is locked by pid %d and it can not be "
+                                              "accessed", inode->name, file_locked_by_pid);
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Write the given buf into the buffer of the given file descriptor, compressing it.
+ * The file descriptor is owned by the pid, so the caller does not need to hold any
+ * lock: the buffer will be flushed into the file by gnl_simfs_rts_fflush_inode.
+ *
+ * @param file_system       The file system instance where the file resides.
+ * @param file_descriptor   The file descriptor of the file to write.
+ * @param buf               The buffer to write.
+ * @param owned             The pointer to buf, if its ownership can be taken
+ *                          by the buffer, NULL otherwise.
+ * @param count             The count of bytes to write.
+ *
+ * @return                  Returns the compressed size of the buffer of the file
+ *                          descriptor on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_write_buffer(struct gnl_simfs_file_system *file_system,
+        struct gnl_simfs_file_descriptor *file_descriptor, const void *buf, void **owned, size_t count) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(file_descriptor, EINVAL, -1)
+
+    // compress the given buf into the buffer, with the compression
+    // of the file system; the bytes stored as they are are not copied
+    // if owned
+    int nwrite = gnl_simfs_inode_buffer_write(&(file_descriptor->buffer), file_system->compression, buf, owned, count);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    gnl_logger_debug(file_system->logger, "Write: %d bytes written into the buffer of the file descriptor", nwrite);
+
+    return file_descriptor->buffer.size;
+}
+
 /**
  * Get the available bytes left on the heap for the given file system.
  *
@@ -380,155 +906,374 @@ static struct gnl_simfs_inode *gnl_simfs_rts_get_inode_by_fd(struct gnl_simfs_fi
  *                      bytes.
  *
  * @return              The number of available bytes in the file system
- *                      on success, -1 otherwise.
+ *                      on success, -1 otherwise. The returned value
+ *                      may be negative if the heap is overcommitted.
  */
-static int gnl_simfs_rts_available_bytes(struct gnl_simfs_file_system *file_system) {
+static long long gnl_simfs_rts_available_bytes(struct gnl_simfs_file_system *file_system) {
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, -1)
 
-    int size = gnl_simfs_file_table_size(file_system->file_table);
-    GNL_MINUS1_CHECK(size, errno, -1);
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    // the bytes reserved by the writes in progress
+    // are considered as already used
+    long long available_bytes = (long long)file_system->memory_limit - (long long)file_system->monitor->bytes_counter
+            - (long long)file_system->reserved_bytes;
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
 
-    return file_system->memory_limit - size;
+    return available_bytes;
 }
 
 /**
- * Build a min heap of victims in accordance with the given replacement policy.
+ * Evict files from the file system in accordance with the replacement policy
+ * until at least the given count of bytes is freed, choosing the whole victim
+ * set in one pass. The victims are chosen among the files of all the shards,
+ * so the caller must hold the locks of all the shards. The compressed chunks
+ * of the victims are detached as they are stored and handed over into the
+ * evicted list, so they are decoded by the receiver of the list, outside the
+ * locks of the file system, with gnl_simfs_evicted_file_decode.
  *
- * @param file_system   The file system instance to use to build a min heap of victims.
- * @param list          The list of filename present into the file system.
+ * @param file_system   The file system instance to use to evict.
+ * @param bytes         The count of bytes to free.
+ * @param evicted_list  The list where to put the evicted files.
  *
- * @return              Return the min heap of victims created on success,
- *                      NULL otherwise.
+ * @return              Returns the count of bytes freed on success, it may
+ *                      be less than the given one if there are no more files
+ *                      to evict, -1 otherwise.
  */
-static struct gnl_min_heap_t *gnl_simfs_rts_build_victim_heap(struct gnl_simfs_file_system *file_system, struct gnl_list_t *list) {
+static long long gnl_simfs_rts_evict(struct gnl_simfs_file_system *file_system, long long bytes,
+        struct gnl_list_t **evicted_list) {
     // validate the parameters
-    GNL_NULL_CHECK(file_system, EINVAL, NULL)
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(evicted_list, EINVAL, -1)
 
-    gnl_logger_debug(file_system->logger, "Building the min heap of victims");
+    gnl_logger_debug(file_system->logger, "Start eviction of %lld bytes", bytes);
 
-    struct gnl_list_t *current = list;
+    struct gnl_simfs_inode *victim_inode;
+    struct gnl_simfs_evicted_file *evicted_file;
+    struct gnl_simfs_inode_chunk *chunk;
+    long long freed = 0;
+    int res;
 
-    // initialize the min heap
-    struct gnl_min_heap_t *min_heap = gnl_min_heap_init();
-    GNL_NULL_CHECK(min_heap, errno, NULL)
+    while (freed < bytes) {
+        // get the victim inode
+        victim_inode = gnl_simfs_policy_index_victim(file_system->policy_index);
 
-    int res;
+        // if there are no files, there is nothing more to evict
+        if (victim_inode == NULL) {
+            if (freed > 0) {
+                break;
+            }
 
-    // scan the list
-    while (current != NULL) {
-        char *filename = (char *)current->el;
+            if (errno == ENOENT) {
+                errno = EDQUOT;
+            }
 
-        // get the original inode of the filename
-        struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(file_system, filename);
-        GNL_NULL_CHECK(inode, errno, NULL)
+            return -1;
+        }
 
-        int key;
+        gnl_logger_debug(file_system->logger, "Victim selected among %d files: \"%s\", %d bytes",
+                         gnl_simfs_policy_index_count(file_system->policy_index), victim_inode->name,
+                         victim_inode->size);
 
-        // get the right key in accordance with the replacement policy
-        switch (file_system->replacement_policy) {
-            case GNL_SIMFS_RP_FIFO:
-                key = inode->btime;
-                break;
-            case GNL_SIMFS_RP_LIFO:
-                key = (-1 * inode->btime);
-                break;
-            case GNL_SIMFS_RP_LRU:
-                key = inode->ctime;
-                break;
-            case GNL_SIMFS_RP_MRU:
-                key = (-1 * inode->ctime);
-                break;
-            case GNL_SIMFS_RP_LFU:
-                key = inode->reference_count;
-                break;
-            default:
-                errno = EINVAL;
-                return NULL;
-                /* UNREACHED */
+        GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+        // track the event
+        res = gnl_simfs_monitor_eviction_started(file_system->monitor);
+
+        GNL_SIMFS_QUOTA_RELEASE(-1)
+
+        GNL_MINUS1_CHECK(res, errno, -1);
+
+        // create an evicted file element
+        evicted_file = gnl_simfs_evicted_file_init();
+        GNL_NULL_CHECK(evicted_file, errno, -1)
+
+        evicted_file->name = calloc(strlen(victim_inode->name) + 1, sizeof(char));
+        if (evicted_file->name == NULL) {
+            gnl_simfs_evicted_file_destroy(evicted_file);
+
+            errno = ENOMEM;
+            return -1;
         }
 
-        // insert the element into the min heap
-        res = gnl_min_heap_insert(min_heap, inode, key);
-        GNL_MINUS1_CHECK(res, errno, NULL)
+        strcpy(evicted_file->name, victim_inode->name);
 
-        current = current->next;
+        // add the evicted file into the list
+        res = gnl_list_insert(evicted_list, evicted_file);
+        if (res == -1) {
+            gnl_simfs_evicted_file_destroy(evicted_file);
+
+            // let the errno bubble
+            return -1;
+        }
+
+        // detach the compressed chunks of the victim, they
+        // are not decoded nor destroyed with the inode
+        evicted_file->chunks = victim_inode->direct_ptr;
+        for (chunk = evicted_file->chunks; chunk != NULL; chunk = chunk->next) {
+            evicted_file->count += chunk->count;
+        }
+
+        victim_inode->direct_ptr = NULL;
+        victim_inode->last_chunk = NULL;
+
+        freed += victim_inode->size;
+
+        // take the victim out of the policy index, keeping its history
+        res = gnl_simfs_policy_index_evict(file_system->policy_index, victim_inode);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        // remove the file
+        res = gnl_simfs_rts_remove_inode(file_system, evicted_file->name);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        gnl_logger_debug(file_system->logger, "Victim detached into the evicted list");
     }
 
-    gnl_logger_debug(file_system->logger, "Min heap of victims built");
+    gnl_logger_debug(file_system->logger, "Eviction ended with success, %lld bytes freed", freed);
 
-    return min_heap;
+    return freed;
 }
 
 /**
- * Evict a file from the file system within the given replacement policy struct.
+ * Reserve the given count of bytes into the given file system for a write,
+ * evicting files in accordance with the replacement policy if there is no
+ * space left. The reserved bytes are considered as used until they are
+ * released with gnl_simfs_rts_release_bytes. The caller must not hold
+ * any shard lock.
  *
- * @param file_system   The file system instance to use to evict.
- * @param buf           The buffer pointer where to write the evicted data.
- * @param count         The count of bytes evicted.
+ * @param file_system   The file system instance where to reserve the bytes.
+ * @param count         The count of bytes to reserve.
+ * @param evicted_list  The list where to put the eventual evicted files.
+ * @param pid           The current process id.
  *
- * @return              Return 0 on success, -1 otherwise.
+ * @return              Returns 0 on success, -1 otherwise.
  */
-int gnl_simfs_rts_evict(struct gnl_simfs_file_system *file_system, struct gnl_list_t **evicted_list) {
+static int gnl_simfs_rts_reserve_bytes(struct gnl_simfs_file_system *file_system, int count,
+        struct gnl_list_t **evicted_list, unsigned int pid) {
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, -1)
-    GNL_NULL_CHECK(evicted_list, EINVAL, -1)
 
-    gnl_logger_debug(file_system->logger, "Start eviction");
+    // acquire the eviction lock
+    int res = pthread_mutex_lock(&(file_system->mtx));
+    GNL_MINUS1_CHECK(res, errno, -1)
 
-    // track the event
-    int res = gnl_simfs_monitor_eviction_started(file_system->monitor);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    gnl_logger_debug(file_system->logger, "Pid %d acquired the eviction lock", pid);
 
-    gnl_logger_debug(file_system->logger, "Listing all the files in the filesystem");
+    int eviction_errno = 0;
 
-    // get a list of files present into the file system
-    struct gnl_list_t *list = gnl_simfs_file_table_list(file_system->file_table);
-    GNL_NULL_CHECK(list, errno, -1)
+    // check if there is enough space left to write the file
+    long long available_bytes;
+    while (count > (available_bytes = gnl_simfs_rts_available_bytes(file_system))) {
 
-    // build the replacement_policy
-    struct gnl_min_heap_t *min_heap = gnl_simfs_rts_build_victim_heap(file_system, list);
-    GNL_NULL_CHECK(min_heap, errno, -1)
+        // if this point is reached, then there is no space left
+        // into the file system to write count bytes
 
-    // free memory
-    gnl_list_destroy(&list, free);
+        // if there is no replacement policy, then fail (with honor)
+        if (file_system->replacement_policy == GNL_SIMFS_RP_NONE) {
+            gnl_logger_warn(file_system->logger, "Reservation of %d bytes failed, max heap size reached. "
+                                                 "Memory limit: %f MB, prevented heap size overflowing by %lld bytes",
+                                                 count, bytes_to_mb(file_system->memory_limit),
+                                                 count - available_bytes);
 
-    // get the victim inode
-    struct gnl_simfs_inode *victim_inode = gnl_min_heap_extract_min(min_heap);
-    GNL_NULL_CHECK(victim_inode, errno, -1)
+            eviction_errno = EDQUOT;
+            break;
+        }
 
-    gnl_logger_debug(file_system->logger, "Victim selected: \"%s\", %d bytes", victim_inode->name, victim_inode->size);
+        gnl_logger_debug(file_system->logger, "No space available to write %d bytes, evicting some files", count);
 
-    // free memory
-    gnl_min_heap_destroy(min_heap, NULL);
+        // the victims can be any file of the file system,
+        // so all the shards must be locked
+        res = gnl_simfs_rts_lock_shards(file_system);
+        if (res == -1) {
+            eviction_errno = errno;
+            break;
+        }
 
-    // create an evicted file element
-    struct gnl_simfs_evicted_file *evicted_file = gnl_simfs_evicted_file_init();
-    GNL_NULL_CHECK(evicted_file, errno, -1)
+        // evict the files needed to free the missing bytes at once,
+        // the available bytes can only grow while the eviction
+        // lock is held, so a single pass is usually enough
+        long long freed = gnl_simfs_rts_evict(file_system, count - available_bytes, evicted_list);
+        eviction_errno = errno;
 
-    GNL_CALLOC(evicted_file->name, strlen(victim_inode->name) + 1, -1)
-    strncpy(evicted_file->name, victim_inode->name, strlen(victim_inode->name));
+        gnl_simfs_rts_unlock_shards(file_system);
 
-    // read the file into the evicted element
-    res = gnl_simfs_rts_read_inode(file_system, victim_inode, &(evicted_file->bytes), &(evicted_file->count));
-    GNL_MINUS1_CHECK(res, errno, -1)
+        if (freed == -1) {
+            break;
+        }
 
-    // add the evicted file into the list
-    res = gnl_list_insert(evicted_list, evicted_file);
-    GNL_MINUS1_CHECK(res, errno, -1)
+        eviction_errno = 0;
+    }
 
-    gnl_logger_debug(file_system->logger, "Victim inserted into the evicted list");
+    // if there is enough space, then reserve it
+    if (eviction_errno == 0) {
+        res = pthread_mutex_lock(&(file_system->quota_mtx));
 
-    // remove the file
-    res = gnl_simfs_rts_remove_inode(file_system, evicted_file->name);
+        if (res == 0) {
+            file_system->reserved_bytes += count;
+            pthread_mutex_unlock(&(file_system->quota_mtx));
+        } else {
+            eviction_errno = res;
+        }
+    }
+
+    // release the eviction lock
+    res = pthread_mutex_unlock(&(file_system->mtx));
     GNL_MINUS1_CHECK(res, errno, -1)
 
-    gnl_logger_debug(file_system->logger, "Victim destroyed");
-    gnl_logger_debug(file_system->logger, "Eviction ended with success");
+    gnl_logger_debug(file_system->logger, "Pid %d released the eviction lock", pid);
+
+    if (eviction_errno != 0) {
+        errno = eviction_errno;
+
+        return -1;
+    }
 
     return 0;
 }
 
+/**
+ * Release the given count of bytes previously reserved with gnl_simfs_rts_reserve_bytes.
+ *
+ * @param file_system   The file system instance where the bytes were reserved.
+ * @param count         The count of bytes to release.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_release_bytes(struct gnl_simfs_file_system *file_system, int count) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    file_system->reserved_bytes -= count;
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    return 0;
+}
+
+/**
+ * Destroy a gnl_simfs_evicted_file struct element.
+ *
+ * @param ptr   The ptr to the element to destroy passed
+ *              by the list or the queue implementation.
+ */
+static void gnl_simfs_rts_destroy_evicted_file(void *ptr) {
+    gnl_simfs_evicted_file_destroy(ptr);
+}
+
+/**
+ * Park the evicted files of the given list into the evicted queue of the given
+ * file system, where they wait to be drained by a write. The list is emptied,
+ * its elements are owned by the queue.
+ *
+ * @param file_system   The file system instance where to park the files.
+ * @param evicted_list  The list of the evicted files to park.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int gnl_simfs_rts_park_evicted(struct gnl_simfs_file_system *file_system, struct gnl_list_t **evicted_list) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(evicted_list, EINVAL, -1)
+
+    int res = 0;
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    struct gnl_list_t *current = *evicted_list;
+    while (current != NULL) {
+        res = gnl_queue_enqueue(file_system->evicted_queue, current->el);
+        if (res == -1) {
+            break;
+        }
+
+        // the element is owned by the queue now
+        current->el = NULL;
+        current = current->next;
+    }
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    // destroy the list, the elements not parked are lost
+    int park_errno = errno;
+    gnl_list_destroy(evicted_list, gnl_simfs_rts_destroy_evicted_file);
+
+    if (res == -1) {
+        errno = park_errno;
+
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Count the files parked into the evicted queue of the given file system.
+ *
+ * @param file_system   The file system instance where the files are parked.
+ *
+ * @return              Returns the number of parked files on success,
+ *                      -1 otherwise.
+ */
+static long gnl_simfs_rts_count_evicted(struct gnl_simfs_file_system *file_system) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    long parked = gnl_queue_size(file_system->evicted_queue);
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    return parked;
+}
+
+/**
+ * Move the files parked into the evicted queue of the given file system
+ * into the given evicted list.
+ *
+ * @param file_system   The file system instance where the files are parked.
+ * @param evicted_list  The list where to put the parked files.
+ *
+ * @return              Returns the number of drained files on success,
+ *                      -1 otherwise.
+ */
+static int gnl_simfs_rts_drain_evicted(struct gnl_simfs_file_system *file_system, struct gnl_list_t **evicted_list) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_system, EINVAL, -1)
+    GNL_NULL_CHECK(evicted_list, EINVAL, -1)
+
+    int drained = 0;
+    int res;
+    struct gnl_simfs_evicted_file *evicted_file;
+
+    GNL_SIMFS_QUOTA_ACQUIRE(-1)
+
+    while ((evicted_file = gnl_queue_dequeue(file_system->evicted_queue)) != NULL) {
+        res = gnl_list_insert(evicted_list, evicted_file);
+        if (res == -1) {
+            gnl_simfs_evicted_file_destroy(evicted_file);
+
+            GNL_SIMFS_QUOTA_RELEASE(-1)
+
+            // let the errno bubble
+            return -1;
+        }
+
+        drained++;
+    }
+
+    GNL_SIMFS_QUOTA_RELEASE(-1)
+
+    return drained;
+}
+
 #undef GNL_SIMFS_BYTES_IN_A_MEGABYTE
+#undef GNL_SIMFS_QUOTA_ACQUIRE
+#undef GNL_SIMFS_QUOTA_RELEASE
 
 #include <gnl_macro_end.h>
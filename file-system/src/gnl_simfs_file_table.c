@@ -1,60 +1,220 @@
 #include <errno.h>
 #include <string.h>
-#include <gnl_ternary_search_tree_t.h>
 #include "../include/gnl_simfs_file_table.h"
 #include "./gnl_simfs_inode.c"
 #include <gnl_macro_beg.h>
 
+// the initial number of slots of the index of a file table,
+// it must be a power of two
+#define GNL_SIMFS_FILE_TABLE_INITIAL_CAPACITY 16
+
+/**
+ * An entry of the file table. The entries are kept contiguous, so the
+ * files are iterated without chasing pointers.
+ */
+struct gnl_simfs_file_table_entry {
+
+    // the hash of the filename
+    unsigned int hash;
+
+    // the inode of the file, its name is
+    // the key of the entry
+    struct gnl_simfs_inode *inode;
+};
+
+/**
+ * A slot of the open addressing index of the file table.
+ */
+struct gnl_simfs_file_table_slot {
+
+    // the hash of the filename, kept into the slot to compare
+    // the filenames only on a full hash match
+    unsigned int hash;
+
+    // the position + 1 of the entry into the entries array,
+    // 0 if the slot is empty
+    int entry;
+};
+
 /**
  * {@inheritDoc}
  */
 struct gnl_simfs_file_table {
 
-    // the file table data structure, contains all the
-    // inodes of the files present into it
-    struct gnl_ternary_search_tree_t *table;
+    // the open addressing index of the file table, the collisions
+    // are resolved with the Robin Hood linear probing
+    struct gnl_simfs_file_table_slot *slots;
+
+    // the number of the slots of the index, a power of two
+    size_t capacity;
 
-    // the list of the filename present into the
-    // file table
-    struct gnl_list_t *presence_list;
+    // the contiguous array of the entries, it contains all
+    // the inodes of the files present into the file table
+    struct gnl_simfs_file_table_entry *entries;
+
+    // the number of the entries allocated
+    size_t entries_capacity;
 
     // the memory in bytes allocated by the file table
     unsigned long long size;
 
     // the counter of the files present in the file table
     int count;
+
+    // the generation of the last file created into the file table
+    unsigned long generation;
 };
 
 /**
- * Destroy an inode. It should be passed to the gnl_ternary_search_tree_destroy
- * method of the gnl_ternary_search_tree data structure.
+ * Hash the given filename with the FNV-1a algorithm.
  *
- * @param ptr   The void pointer value of the gnl_ternary_search_tree data structure.
+ * @param filename  The filename to hash.
+ *
+ * @return          Returns the hash of the filename.
  */
-static void destroy_file_table_inode(void *ptr) {
-    if (ptr == NULL) {
-        return;
+static unsigned int hash_filename(const char *filename) {
+    unsigned int hash = 2166136261U;
+
+    for (const char *c = filename; *c != '\0'; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 16777619U;
     }
 
-    // implicitly cast the value
-    struct gnl_simfs_inode *inode = ptr;
+    return hash;
+}
 
-    // destroy the obtained inode
-    gnl_simfs_inode_destroy(inode);
+/**
+ * Get the distance of the given slot from the slot where
+ * its hash would have been placed without collisions.
+ *
+ * @param file_table    The file table instance.
+ * @param pos           The position of the slot.
+ *
+ * @return              Returns the probe distance of the slot.
+ */
+static size_t probe_distance(struct gnl_simfs_file_table *file_table, size_t pos) {
+    size_t mask = file_table->capacity - 1;
+
+    return (pos - (file_table->slots[pos].hash & mask)) & mask;
 }
 
 /**
- * Compare two string elements.
+ * Put the given entry position into the index of the given file table,
+ * the index must have at least an empty slot.
  *
- * @param a The actual string element.
- * @param b The expected string element.
+ * @param file_table    The file table instance.
+ * @param hash          The hash of the filename of the entry.
+ * @param entry         The position of the entry into the entries array.
+ */
+static void index_put(struct gnl_simfs_file_table *file_table, unsigned int hash, int entry) {
+    size_t mask = file_table->capacity - 1;
+    size_t pos = hash & mask;
+    size_t distance = 0;
+
+    struct gnl_simfs_file_table_slot current = {hash, entry + 1};
+    struct gnl_simfs_file_table_slot tmp;
+
+    while (file_table->slots[pos].entry != 0) {
+        size_t slot_distance = probe_distance(file_table, pos);
+
+        // the slot closer to its home position gives its
+        // place to the slot being inserted, that goes on
+        // to place the evicted one
+        if (slot_distance < distance) {
+            tmp = file_table->slots[pos];
+            file_table->slots[pos] = current;
+            current = tmp;
+            distance = slot_distance;
+        }
+
+        pos = (pos + 1) & mask;
+        distance++;
+    }
+
+    file_table->slots[pos] = current;
+}
+
+/**
+ * Find the slot of the given filename into the index of the given file table.
+ *
+ * @param file_table    The file table instance.
+ * @param filename      The filename to search.
+ * @param hash          The hash of the filename.
  *
- * @return  Returns 0 if a==b, if a > b returns a value
- *          greater than zero, if a < b returns a value
- *          less than 0.
+ * @return              Returns the position of the slot on success,
+ *                      -1 if the filename is not present.
  */
-static int compare_string(const void *a, const void *b) {
-    return strcmp(a, b);
+static long index_find(struct gnl_simfs_file_table *file_table, const char *filename, unsigned int hash) {
+    if (file_table->capacity == 0) {
+        return -1;
+    }
+
+    size_t mask = file_table->capacity - 1;
+    size_t pos = hash & mask;
+    size_t distance = 0;
+
+    struct gnl_simfs_file_table_slot *slot;
+
+    while (1) {
+        slot = file_table->slots + pos;
+
+        // a filename can not be placed farther than a
+        // slot closer to its home position
+        if (slot->entry == 0 || probe_distance(file_table, pos) < distance) {
+            return -1;
+        }
+
+        if (slot->hash == hash && strcmp(file_table->entries[slot->entry - 1].inode->name, filename) == 0) {
+            return pos;
+        }
+
+        pos = (pos + 1) & mask;
+        distance++;
+    }
+}
+
+/**
+ * Make room into the given file table for a new entry, growing the
+ * index and the entries array if needed.
+ *
+ * @param file_table    The file table instance.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int reserve_entry(struct gnl_simfs_file_table *file_table) {
+    // grow the entries array
+    if (file_table->count == file_table->entries_capacity) {
+        size_t entries_capacity = file_table->entries_capacity == 0
+                ? GNL_SIMFS_FILE_TABLE_INITIAL_CAPACITY : file_table->entries_capacity * 2;
+
+        struct gnl_simfs_file_table_entry *entries = realloc(file_table->entries,
+                                                             entries_capacity * sizeof(struct gnl_simfs_file_table_entry));
+        GNL_NULL_CHECK(entries, ENOMEM, -1)
+
+        file_table->entries = entries;
+        file_table->entries_capacity = entries_capacity;
+    }
+
+    // keep the load factor of the index under 7/8
+    if ((file_table->count + 1) * 8 <= file_table->capacity * 7) {
+        return 0;
+    }
+
+    size_t capacity = file_table->capacity == 0 ? GNL_SIMFS_FILE_TABLE_INITIAL_CAPACITY : file_table->capacity * 2;
+
+    struct gnl_simfs_file_table_slot *slots = calloc(capacity, sizeof(struct gnl_simfs_file_table_slot));
+    GNL_NULL_CHECK(slots, ENOMEM, -1)
+
+    free(file_table->slots);
+    file_table->slots = slots;
+    file_table->capacity = capacity;
+
+    // rebuild the index from the entries, they are already unique
+    for (int i=0; i<file_table->count; i++) {
+        index_put(file_table, file_table->entries[i].hash, i);
+    }
+
+    return 0;
 }
 
 /**
@@ -66,8 +226,10 @@ struct gnl_simfs_file_table *gnl_simfs_file_table_init() {
 
     // instantiate the table to NULL, the table
     // space will be allocated on demand
-    t->table = NULL;
-    t->presence_list = NULL;
+    t->slots = NULL;
+    t->capacity = 0;
+    t->entries = NULL;
+    t->entries_capacity = 0;
 
     // initialize the size
     t->size = 0;
@@ -75,6 +237,9 @@ struct gnl_simfs_file_table *gnl_simfs_file_table_init() {
     // initialize the count
     t->count = 0;
 
+    // initialize the generation
+    t->generation = 0;
+
     return t;
 }
 
@@ -86,11 +251,14 @@ void gnl_simfs_file_table_destroy(struct gnl_simfs_file_table *table) {
         return;
     }
 
-    // destroy the presence_list
-    gnl_list_destroy(&(table->presence_list), free);
+    // destroy the inodes
+    for (int i=0; i<table->count; i++) {
+        gnl_simfs_inode_destroy(table->entries[i].inode);
+    }
 
-    // destroy the ternary search tree
-    gnl_ternary_search_tree_destroy(&(table->table), destroy_file_table_inode);
+    // destroy the index and the entries
+    free(table->slots);
+    free(table->entries);
 
     // destroy the table
     free(table);
@@ -119,39 +287,38 @@ static int gnl_simfs_file_table_count(struct gnl_simfs_file_table *file_table) {
 /**
  * {@inheritDoc}
  */
-static struct gnl_list_t *gnl_simfs_file_table_list(struct gnl_simfs_file_table *file_table) {
+static int gnl_simfs_file_table_visit(struct gnl_simfs_file_table *file_table, size_t *cursor, int max,
+                                      int (*visit)(struct gnl_simfs_inode *inode, void *arg), void *arg) {
     // validate the parameters
-    GNL_NULL_CHECK(file_table, EINVAL, NULL)
+    GNL_NULL_CHECK(file_table, EINVAL, -1)
+    GNL_NULL_CHECK(cursor, EINVAL, -1)
+    GNL_NULL_CHECK(visit, EINVAL, -1)
 
-    // create a deep copy of the file list
-    if (file_table->presence_list == NULL) {
-        return NULL;
+    // the entries removed since the last page
+    // can not be visited anymore
+    if (*cursor > file_table->count) {
+        *cursor = file_table->count;
     }
 
-    struct gnl_list_t *current = file_table->presence_list;
-    struct gnl_list_t *presence_list_copy = NULL;
-    char *filename_copy;
+    int visited = 0;
     int res;
 
-    // for each element of the list...
-    while (current != NULL) {
-        filename_copy = (char *)current->el;
-
-        // copy the filename
-        char *filename = calloc((strlen(filename_copy) + 1), sizeof(char));
-        GNL_NULL_CHECK(filename, ENOMEM, NULL)
+    // walk backwards: a remove moves the last entry, already visited
+    // or added after the visit began, so no file present for the
+    // whole visit is skipped
+    while (*cursor > 0 && (max <= 0 || visited < max)) {
+        (*cursor)--;
+        visited++;
 
-        strncpy(filename, filename_copy, strlen(filename_copy));
-
-        // insert the deep copy of the filename into the new list
-        res = gnl_list_append(&presence_list_copy, filename);
-        GNL_MINUS1_CHECK(res, errno, NULL)
+        res = visit(file_table->entries[*cursor].inode, arg);
+        GNL_MINUS1_CHECK(res, errno, -1)
 
-        // move on to the next element
-        current = current->next;
+        if (res == 1) {
+            break;
+        }
     }
 
-    return presence_list_copy;
+    return visited;
 }
 
 /**
@@ -162,18 +329,66 @@ static struct gnl_simfs_inode *gnl_simfs_file_table_get(struct gnl_simfs_file_ta
     GNL_NULL_CHECK(file_table, EINVAL, NULL)
     GNL_NULL_CHECK(filename, EINVAL, NULL)
 
-    struct gnl_simfs_inode *inode;
-
     // search the key in the file table
-    void *raw_inode = gnl_ternary_search_tree_get(file_table->table, filename);
+    long pos = index_find(file_table, filename, hash_filename(filename));
 
     // if the key is not present return an error
-    GNL_NULL_CHECK(raw_inode, ENOENT, NULL)
+    GNL_MINUS1_CHECK(pos, ENOENT, NULL)
 
-    // else cast the raw_inode
-    inode = (struct gnl_simfs_inode *)raw_inode;
+    return file_table->entries[file_table->slots[pos].entry - 1].inode;
+}
 
-    return inode;
+/**
+ * {@inheritDoc}
+ */
+static struct gnl_simfs_inode *gnl_simfs_file_table_get_by_handle(struct gnl_simfs_file_table *file_table,
+                                                                  const struct gnl_simfs_inode_handle *handle) {
+    // validate the parameters
+    GNL_NULL_CHECK(file_table, EINVAL, NULL)
+    GNL_NULL_CHECK(handle, EINVAL, NULL)
+
+    // the handle can not be resolved
+    errno = ENOENT;
+
+    if (file_table->capacity == 0) {
+        return NULL;
+    }
+
+    size_t mask = file_table->capacity - 1;
+    size_t pos = handle->hash & mask;
+    size_t distance = 0;
+
+    struct gnl_simfs_file_table_slot *slot;
+    struct gnl_simfs_inode *inode;
+
+    // probe as index_find does, the generation
+    // replaces the comparison of the filenames
+    while (1) {
+        slot = file_table->slots + pos;
+
+        if (slot->entry == 0 || probe_distance(file_table, pos) < distance) {
+            return NULL;
+        }
+
+        if (slot->hash == handle->hash) {
+            inode = file_table->entries[slot->entry - 1].inode;
+
+            if (inode->generation == handle->generation) {
+                return inode;
+            }
+        }
+
+        pos = (pos + 1) & mask;
+        distance++;
+    }
+}
+
+/**
+ * {@inheritDoc}
+ */
+static void gnl_simfs_file_table_handle(const struct gnl_simfs_inode *inode, struct gnl_simfs_inode_handle *handle) {
+    handle->hash = hash_filename(inode->name);
+    handle->generation = inode->generation;
 }
 
 /**
@@ -184,28 +399,28 @@ static struct gnl_simfs_inode *gnl_simfs_file_table_create(struct gnl_simfs_file
     GNL_NULL_CHECK(file_table, EINVAL, NULL)
     GNL_NULL_CHECK(filename, EINVAL, NULL)
 
-    // search the filename key in the file table
-    struct gnl_simfs_inode *tmp = gnl_simfs_file_table_get(file_table, filename);
+    unsigned int hash = hash_filename(filename);
 
     // if the key is present return an error
-    GNL_MINUS1_CHECK(-1 * (tmp != NULL), EEXIST, NULL)
+    GNL_MINUS1_CHECK(-1 * (index_find(file_table, filename, hash) != -1), EEXIST, NULL)
+
+    // make room for the new entry
+    int res = reserve_entry(file_table);
+    GNL_MINUS1_CHECK(res, errno, NULL)
 
-    // create a new inode
+    // create a new inode, it owns the only copy of the filename
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init(filename);
     GNL_NULL_CHECK(inode, errno, NULL)
 
-    // put the filename into the list
-    char *filename_copy = calloc(sizeof(char), (strlen(filename) + 1));
-    GNL_NULL_CHECK(filename_copy, ENOMEM, NULL)
-
-    strncpy(filename_copy, filename, strlen(filename));
-
-    int res = gnl_list_append(&(file_table->presence_list), filename_copy);
-    GNL_MINUS1_CHECK(res, errno, NULL)
+    // a new generation tells the inode apart from the
+    // removed inodes with the same filename
+    inode->generation = ++file_table->generation;
 
     // put the inode into the file table
-    res = gnl_ternary_search_tree_put(&(file_table->table), filename, inode);
-    GNL_MINUS1_CHECK(res, errno, NULL)
+    file_table->entries[file_table->count].hash = hash;
+    file_table->entries[file_table->count].inode = inode;
+
+    index_put(file_table, hash, file_table->count);
 
     // increment the files counter
     file_table->count++;
@@ -216,52 +431,35 @@ static struct gnl_simfs_inode *gnl_simfs_file_table_create(struct gnl_simfs_file
 /**
  * {@inheritDoc}
  */
-static int gnl_simfs_file_table_fflush(struct gnl_simfs_file_table *file_table, struct gnl_simfs_inode *new_inode) {
+static int gnl_simfs_file_table_fflush(struct gnl_simfs_file_table *file_table, struct gnl_simfs_inode *inode,
+                                       struct gnl_simfs_inode_buffer *buffer) {
     // validate the parameters
     GNL_NULL_CHECK(file_table, EINVAL, -1)
-    GNL_NULL_CHECK(new_inode, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+    GNL_NULL_CHECK(buffer, EINVAL, -1)
 
-    // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_table, new_inode->name);
-
-    // if the key is not present return an error
-    GNL_NULL_CHECK(inode, errno, -1)
-
-    // check if the buffer_entry is not the original inode
-    if (inode == new_inode) {
-        errno = EINVAL;
+    // check that the inode is into the file table
+    if (gnl_simfs_file_table_get(file_table, inode->name) != inode) {
+        errno = ENOENT;
 
         return -1;
     }
 
     // if bytes were added, write it and clear the buffer
-    if (new_inode->buffer_size > 0) {
+    if (buffer->size > 0) {
 
-        // get the current size of the inode
-        int inode_old_size = new_inode->size;
+        // get the bytes that will be added by the fflush
+        int bytes_added = buffer->size;
 
-        // fflush the inode
-        int res = gnl_simfs_inode_fflush(new_inode);
+        // append the buffered chunks to the file, they are already
+        // compressed so the inode takes their ownership as they are
+        int res = gnl_simfs_inode_fflush_buffer(inode, buffer);
         GNL_MINUS1_CHECK(res, errno, -1)
 
-        // update the inode with the flushed one
-        inode->direct_ptr = new_inode->direct_ptr;
-
-        // calculate the bytes added into the heap by the fflush
-        int bytes_added = new_inode->size - inode_old_size;
-
-        // update the size
-        inode->size += bytes_added;
-
         // update the file table size
         file_table->size += bytes_added;
     }
 
-    // update time
-    inode->atime = new_inode->atime;
-    inode->mtime = new_inode->mtime;
-
-
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
 
@@ -277,29 +475,52 @@ static int gnl_simfs_file_table_remove(struct gnl_simfs_file_table *file_table,
     GNL_NULL_CHECK(key, EINVAL, -1)
 
     // search the key in the file table
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_table, key);
+    long pos = index_find(file_table, key, hash_filename(key));
 
     // if the key is not present return an error
-    GNL_NULL_CHECK(inode, errno, -1)
+    GNL_MINUS1_CHECK(pos, ENOENT, -1)
+
+    size_t mask = file_table->capacity - 1;
+    int entry = file_table->slots[pos].entry - 1;
+    struct gnl_simfs_inode *inode = file_table->entries[entry].inode;
+
+    // remove the slot, shifting back the following slots
+    // until one is empty or at its home position
+    size_t next = (pos + 1) & mask;
+    while (file_table->slots[next].entry != 0 && probe_distance(file_table, next) > 0) {
+        file_table->slots[pos] = file_table->slots[next];
+        pos = next;
+        next = (next + 1) & mask;
+    }
 
-    // get the size of the inode
-    int count = inode->size;
+    file_table->slots[pos].entry = 0;
 
-    // remove the filename
-    int res = gnl_list_delete(&(file_table->presence_list), key, compare_string, free);
-    GNL_MINUS1_CHECK(res, errno, -1)
+    // keep the entries contiguous moving the last
+    // entry into the place of the removed one
+    int last = file_table->count - 1;
+    if (entry != last) {
+        file_table->entries[entry] = file_table->entries[last];
 
-    // remove the file
-    res = gnl_ternary_search_tree_remove(file_table->table, key, destroy_file_table_inode);
-    GNL_MINUS1_CHECK(res, errno, -1)
+        pos = file_table->entries[entry].hash & mask;
+        while (file_table->slots[pos].entry != last + 1) {
+            pos = (pos + 1) & mask;
+        }
+
+        file_table->slots[pos].entry = entry + 1;
+    }
 
     // update the file table size
-    file_table->size -= count;
+    file_table->size -= inode->size;
 
     // update the file table count
     file_table->count--;
 
+    // remove the file
+    gnl_simfs_inode_destroy(inode);
+
     return 0;
 }
 
-#include <gnl_macro_end.h>
+#undef GNL_SIMFS_FILE_TABLE_INITIAL_CAPACITY
+
+#include <gnl_macro_end.h>
\ No newline at end of file
@@ -2,167 +2,154 @@
 #include <errno.h>
 #include <time.h>
 #include <string.h>
-#include <gnl_huffman_tree.h>
+#include <limits.h>
 #include "../include/gnl_simfs_inode.h"
+#include "./gnl_simfs_codec.c"
 #include <gnl_macro_beg.h>
 
 /**
- * Compare function for the gnl_list_search method. It checks
- * if the pid is equal to the given element.
+ * Get the reference owners of the given inode, they are stored
+ * within the inode or, if they are too many, into its spill array.
  *
- * @param el    The element of the list.
- * @param pid   The element to use to compare.
+ * @param inode The inode instance.
  *
- * @return      Returns 0 if the given pid is equal to the given
- *              element, -1 otherwise.
+ * @return      Returns the array of the reference owners.
  */
-static int has_pid(const void *el, const void *pid) {
-    if (*(unsigned int *)el == *(unsigned int *)pid) {
-        return 0;
-    }
-
-    return -1;
+static struct gnl_simfs_inode_ref *get_refs(struct gnl_simfs_inode *inode) {
+    return inode->refs_spill != NULL ? inode->refs_spill : inode->refs;
 }
 
 /**
- * Compare function for the gnl_list_search method. It checks
- * if the pid is not equal to the given element.
+ * Search the given pid among the reference owners of the given inode.
  *
- * @param el    The element of the list.
- * @param pid   The element to use to compare.
+ * @param inode The inode instance where to search.
+ * @param pid   The pid to search.
  *
- * @return      Returns 0 if the given pid is not equal to the given
- *              element, -1 otherwise.
+ * @return      Returns the position of the pid into the reference
+ *              owners if it is found, -1 otherwise.
  */
-static int has_different_pid(const void *el, const void *pid) {
-    if (*(unsigned int *)el != *(unsigned int *)pid) {
-        return 0;
+static int search_ref(struct gnl_simfs_inode *inode, unsigned int pid) {
+    struct gnl_simfs_inode_ref *refs = get_refs(inode);
+
+    for (int i=0; i<inode->refs_size; i++) {
+        if (refs[i].pid == pid) {
+            return i;
+        }
     }
 
     return -1;
 }
 
 /**
- * Compress the given inode. This invocation will rewrite every
- * bytes within the given inode, and will change the size of
- * the inode.
+ * Add a new reference owner to the given inode. If the owners do
+ * not fit anymore into their array, they are moved into a new
+ * spill array twice as big.
  *
- * Make sure to work on the original inode here, because of the compress and decompress
- * implementation of the inode. The implementation will change the inode->direct_ptr
- * address, so we want to change always the original inode instead of his copy
- * to avoid troubles along compressing and decompressing. Without this, if you read
- * on a copy, then you will decompress and free the original inode->direct_ptr, and
- * set a new address for inode->direct_ptr. At the time of compressing, you will
- * work on the new address of inode->direct_ptr of the copy. So, another subsequent
- * read on a different copy will try to decompress the original inode->direct_ptr
- * that it was freed by the precedent read, resulting in an undefined behaviour!
- *
- * @param inode The inode to compress.
+ * @param inode The inode instance where to add the owner.
+ * @param pid   The pid of the new owner.
  *
  * @return      Returns 0 on success, -1 otherwise.
  */
-static int compress(struct gnl_simfs_inode *inode) {
-    GNL_NULL_CHECK(inode, EINVAL, -1)
+static int add_ref(struct gnl_simfs_inode *inode, unsigned int pid) {
+    int capacity = inode->refs_spill != NULL ? inode->refs_capacity : GNL_SIMFS_INODE_INLINE_REFS;
+
+    // grow the owners array if it is full
+    if (inode->refs_size == capacity) {
+        if (2 * capacity > USHRT_MAX) {
+            errno = ENOMEM;
 
-    // compress
-    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(inode->direct_ptr, inode->size);
-    GNL_NULL_CHECK(artifact, errno, -1)
+            return -1;
+        }
 
-    // rewrite the inode
-    free(inode->direct_ptr);
+        struct gnl_simfs_inode_ref *refs = realloc(inode->refs_spill, 2 * capacity * sizeof(struct gnl_simfs_inode_ref));
+        GNL_NULL_CHECK(refs, ENOMEM, -1)
 
-    // assign the new compressed size to the inode
-    inode->size = gnl_huffman_tree_size(artifact);
-    GNL_MINUS1_CHECK(inode->size, errno, -1)
+        // the owners are moved out of the inode the first time
+        if (inode->refs_spill == NULL) {
+            memcpy(refs, inode->refs, sizeof(inode->refs));
+        }
+
+        inode->refs_spill = refs;
+        inode->refs_capacity = 2 * capacity;
+    }
 
-    // rewrite the direct pointer with the compressed object
-    inode->direct_ptr = artifact;
+    struct gnl_simfs_inode_ref *ref = get_refs(inode) + inode->refs_size;
+
+    ref->pid = pid;
+    ref->count = 1;
+
+    inode->refs_size++;
 
     return 0;
 }
 
 /**
- * Decompress the given inode.
- *
- * Make sure to work on the original inode here, because of the compress and decompress
- * implementation of the inode. The implementation will change the inode->direct_ptr
- * address, so we want to change always the original inode instead of his copy
- * to avoid troubles along compressing and decompressing. Without this, if you read
- * on a copy, then you will decompress and free the original inode->direct_ptr, and
- * set a new address for inode->direct_ptr. At the time of compressing, you will
- * work on the new address of inode->direct_ptr of the copy. So, another subsequent
- * read on a different copy will try to decompress the original inode->direct_ptr
- * that it was freed by the precedent read, resulting in an undefined behaviour!
+ * Remove the reference owner at the given position from the given
+ * inode. The last owner takes its position, and the spill array is
+ * released once there are no owners left.
  *
- * @param inode The inode to decompress.
- *
- * @return      Returns 0 on success, -1 otherwise.
+ * @param inode     The inode instance from where to remove the owner.
+ * @param position  The position of the owner to remove.
  */
-static int decompress(struct gnl_simfs_inode *inode) {
-    GNL_NULL_CHECK(inode, EINVAL, -1)
-
-    // get the artifact
-    struct gnl_huffman_tree_artifact *artifact = inode->direct_ptr;
-
-    void *bytes;
-    size_t count;
-    // decompress
-    int res = gnl_huffman_tree_decode(artifact, &bytes, &count);
-    GNL_MINUS1_CHECK(res, errno, -1)
+static void remove_ref(struct gnl_simfs_inode *inode, int position) {
+    struct gnl_simfs_inode_ref *refs = get_refs(inode);
 
-    // rewrite the inode with the actual
-    // decompressed values
-    inode->size = count;
-    inode->direct_ptr = bytes;
+    inode->refs_size--;
+    refs[position] = refs[inode->refs_size];
 
-    return 0;
+    if (inode->refs_size == 0) {
+        free(inode->refs_spill);
+        inode->refs_spill = NULL;
+        inode->refs_capacity = 0;
+    }
 }
 
 /**
- * Destroy the given inode. This method it supposed to be called with with_pointed_file=1
- * when the intention is to destroy the inode, with with_pointed_file=0 if the intention
- * is to destroy its copy. This difference it is necessary because the copy of the inode
- * contains a direct pointer to the original file within the inode from which the copy was
- * made, so it prevents accidental deletions.
+ * Destroy the given list of chunks, and the compressed
+ * bytes within them.
  *
- * @param inode             The inode instance to destroy.
- * @param with_pointed_file If > 0, an invocation to this method will delete
- *                          also the file pointed by the given inode, If <= 0
- *                          the pointed file will be preserved.
+ * @param chunk The first chunk of the list to destroy.
  */
-static void destroy_inode(struct gnl_simfs_inode *inode, int with_pointed_file) {
-    if (inode == NULL) {
-        return;
-    }
+static void destroy_chunks(struct gnl_simfs_inode_chunk *chunk) {
+    struct gnl_simfs_inode_chunk *next;
 
-    // destroy the name
-    free(inode->name);
+    while (chunk != NULL) {
+        next = chunk->next;
 
-    // destroy the file pointer
-    if (with_pointed_file > 0) {
-        gnl_huffman_tree_destroy_artifact(inode->direct_ptr);
-        inode->direct_ptr = NULL;
-    }
+        gnl_simfs_codec_destroy(chunk->codec, chunk->data);
+        free(chunk);
 
-    // destroy the reference list
-    gnl_list_destroy(&(inode->reference_list), free);
-    inode->reference_list = NULL;
+        chunk = next;
+    }
+}
 
-    // destroy the buffer
-    free(inode->buffer);
-    inode->buffer = NULL;
+/**
+ * Decompress the given chunk into the given buffer. The buffer
+ * must be at least chunk->count bytes long.
+ *
+ * The compressed bytes of the chunk are decoded in place and never
+ * modified, so a read does not change the stored file.
+ *
+ * @param chunk The chunk to decompress.
+ * @param dest  The buffer where to write the decompressed bytes.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int read_chunk(const struct gnl_simfs_inode_chunk *chunk, void *dest) {
+    GNL_NULL_CHECK(chunk, EINVAL, -1)
 
-    // clear the waiting queue
-//    pthread_cond_broadcast(&(inode->file_is_lockable));
+    // decompress
+    int res = gnl_simfs_codec_decode(chunk->codec, chunk->data, chunk->size, dest, chunk->count);
+    GNL_MINUS1_CHECK(res, errno, -1)
 
-    // destroy the condition variables
-    pthread_cond_destroy(&(inode->file_is_lockable));
+    // the chunk must be decoded entirely
+    if (res != chunk->count) {
+        errno = EINVAL;
 
-    // useless, but consistent until the end :)
-    inode->ctime = time(NULL);
+        return -1;
+    }
 
-    // destroy the inode
-    free(inode);
+    return 0;
 }
 
 /**
@@ -175,10 +162,6 @@ struct gnl_simfs_inode *gnl_simfs_inode_init(const char *name) {
     // set the creation time of the file
     inode->btime = time(NULL);
 
-    // initialize condition variables
-    int res = pthread_cond_init(&(inode->file_is_lockable), NULL);
-    GNL_MINUS1_CHECK(res, errno, NULL)
-
     // set the name
     GNL_CALLOC(inode->name, strlen(name) + 1, NULL)
     strncpy(inode->name, name, strlen(name));
@@ -187,13 +170,23 @@ struct gnl_simfs_inode *gnl_simfs_inode_init(const char *name) {
     inode->mtime = 0;
     inode->atime = 0;
     inode->size = 0;
+    inode->generation = 0;
     inode->locked = 0;
     inode->direct_ptr = NULL;
-    inode->pending_locks = 0;
-    inode->reference_count = 0;
-    inode->reference_list = NULL;
-    inode->buffer = NULL;
-    inode->buffer_size = 0;
+    inode->last_chunk = NULL;
+    inode->pending_lock = 0;
+    inode->refs_spill = NULL;
+    inode->refs_size = 0;
+    inode->refs_capacity = 0;
+    inode->policy_prev = NULL;
+    inode->policy_next = NULL;
+    inode->policy_bucket = NULL;
+    inode->policy_queue = -1;
+    inode->policy_position = 0;
+    inode->policy_priority = 0;
+    inode->access_clock = 0;
+    inode->frequency = 0;
+    inode->frequency_epoch = 0;
 
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
@@ -205,14 +198,27 @@ struct gnl_simfs_inode *gnl_simfs_inode_init(const char *name) {
  * {@inheritDoc}
  */
 void gnl_simfs_inode_destroy(struct gnl_simfs_inode *inode) {
-    destroy_inode(inode, 1);
-}
+    if (inode == NULL) {
+        return;
+    }
 
-/**
- * {@inheritDoc}
- */
-void gnl_simfs_inode_copy_destroy(struct gnl_simfs_inode *inode) {
-    destroy_inode(inode, 0);
+    // destroy the name
+    free(inode->name);
+
+    // destroy the file pointer
+    destroy_chunks(inode->direct_ptr);
+    inode->direct_ptr = NULL;
+    inode->last_chunk = NULL;
+
+    // destroy the reference owners
+    free(inode->refs_spill);
+    inode->refs_spill = NULL;
+
+    // useless, but consistent until the end :)
+    inode->ctime = time(NULL);
+
+    // destroy the inode
+    free(inode);
 }
 
 /**
@@ -224,31 +230,20 @@ int gnl_simfs_inode_is_file_locked(struct gnl_simfs_inode *inode) {
     return inode->locked;
 }
 
-/**
- * {@inheritDoc}
- */
-int gnl_simfs_inode_wait_file_lockability(struct gnl_simfs_inode *inode, pthread_mutex_t *mtx) {
-    return pthread_cond_wait(&(inode->file_is_lockable), mtx);
-}
-
 /**
  * {@inheritDoc}
  */
 int gnl_simfs_inode_increase_refs(struct gnl_simfs_inode *inode, unsigned int pid) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    // copy the pid
-    unsigned int *pid_copy = malloc(sizeof(unsigned int));
-    GNL_NULL_CHECK(pid_copy, ENOMEM, -1)
-
-    *pid_copy = pid;
-
-    // add the pid to the reference list
-    int res = gnl_list_insert(&(inode->reference_list), pid_copy);
-    GNL_MINUS1_CHECK(res, errno, -1);
-
-    // increase the reference count
-    inode->reference_count++;
+    // count the reference to its owner
+    int position = search_ref(inode, pid);
+    if (position == -1) {
+        int res = add_ref(inode, pid);
+        GNL_MINUS1_CHECK(res, errno, -1);
+    } else {
+        get_refs(inode)[position].count++;
+    }
 
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
@@ -262,32 +257,24 @@ int gnl_simfs_inode_increase_refs(struct gnl_simfs_inode *inode, unsigned int pi
 int gnl_simfs_inode_decrease_refs(struct gnl_simfs_inode *inode, unsigned int pid) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    if (inode->reference_count == 0) {
-        errno = EPERM;
-        return -1;
-    }
-
     // check if the pid is allowed to decrease the refs
-    if (gnl_list_search(inode->reference_list, &pid, has_pid) == 0) {
+    int position = search_ref(inode, pid);
+    if (position == -1) {
         errno = EPERM;
         return -1;
     }
 
-    // remove the pid from the reference list
-    int res = gnl_list_delete(&(inode->reference_list), &pid, has_pid, free);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    // remove the reference from its owner
+    struct gnl_simfs_inode_ref *ref = get_refs(inode) + position;
 
-    // decrease the reference count
-    inode->reference_count--;
+    ref->count--;
+    if (ref->count == 0) {
+        remove_ref(inode, position);
+    }
 
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
 
-    // wake up eventually waiting threads
-    if (inode->reference_count == 0 || gnl_list_search(inode->reference_list, &pid, has_different_pid) == 1) {
-        return pthread_cond_signal(&(inode->file_is_lockable));
-    }
-
     return 0;
 }
 
@@ -297,7 +284,24 @@ int gnl_simfs_inode_decrease_refs(struct gnl_simfs_inode *inode, unsigned int pi
 int gnl_simfs_inode_has_refs(struct gnl_simfs_inode *inode) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    return inode->reference_count > 0;
+    // every owner holds at least a reference
+    return inode->refs_size > 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_inode_reference_count(struct gnl_simfs_inode *inode) {
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    struct gnl_simfs_inode_ref *refs = get_refs(inode);
+    int reference_count = 0;
+
+    for (int i = 0; i < inode->refs_size; i++) {
+        reference_count += refs[i].count;
+    }
+
+    return reference_count;
 }
 
 /**
@@ -307,12 +311,13 @@ int gnl_simfs_inode_has_other_pid_refs(struct gnl_simfs_inode *inode, unsigned i
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
     // check if the pid is allowed to check the refs
-    if (gnl_list_search(inode->reference_list, &pid, has_pid) == 0) {
+    if (search_ref(inode, pid) == -1) {
         errno = EPERM;
         return -1;
     }
 
-    return gnl_list_search(inode->reference_list, &pid, has_different_pid);
+    // every owner is stored once
+    return inode->refs_size > 1;
 }
 
 /**
@@ -374,10 +379,16 @@ int gnl_simfs_inode_file_unlock(struct gnl_simfs_inode *inode, unsigned int pid)
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_inode_increase_pending_locks(struct gnl_simfs_inode *inode) {
+int gnl_simfs_inode_set_pending_lock(struct gnl_simfs_inode *inode, unsigned int pid) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    inode->pending_locks++;
+    // if another pid is waiting return an error
+    if (inode->pending_lock != 0 && inode->pending_lock != pid) {
+        errno = EDEADLK;
+        return -1;
+    }
+
+    inode->pending_lock = pid;
 
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
@@ -388,18 +399,15 @@ int gnl_simfs_inode_increase_pending_locks(struct gnl_simfs_inode *inode) {
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_inode_decrease_pending_locks(struct gnl_simfs_inode *inode) {
+int gnl_simfs_inode_clear_pending_lock(struct gnl_simfs_inode *inode, unsigned int pid) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    if (inode->pending_locks == 0) {
-        errno = EPERM;
-        return -1;
-    }
-
-    inode->pending_locks--;
+    if (inode->pending_lock == pid) {
+        inode->pending_lock = 0;
 
-    // set the last status change timestamp of the inode
-    inode->ctime = time(NULL);
+        // set the last status change timestamp of the inode
+        inode->ctime = time(NULL);
+    }
 
     return 0;
 }
@@ -410,42 +418,65 @@ int gnl_simfs_inode_decrease_pending_locks(struct gnl_simfs_inode *inode) {
 int gnl_simfs_inode_has_pending_locks(struct gnl_simfs_inode *inode) {
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    return inode->pending_locks > 0;
+    return inode->pending_lock;
 }
 
 /**
- * {@inheritDoc}
+ * Write up to count bytes from the buffer starting at buf to a new chunk
+ * appended to the given list of chunks.
+ *
+ * @param compression   The compression to use for the new chunk.
+ * @param buffer        The pointer to the first chunk of the list.
+ * @param buffer_size   The pointer to the size of the list, it is
+ *                      increased by the size of the new chunk.
+ * @param buf           The buffer pointer containing the data to write.
+ * @param count         The count of bytes to write.
+ * @param owned         The pointer to buf, if its ownership can be taken by
+ *                      the new chunk, NULL otherwise.
+ *
+ * @return              Returns the number of bytes wrote into the list on
+ *                      success, -1 otherwise.
  */
-int gnl_simfs_inode_write(struct gnl_simfs_inode *inode, const void *buf, size_t count) {
+static int write_chunk(enum gnl_simfs_compression compression, struct gnl_simfs_inode_chunk **buffer,
+        int *buffer_size, const void *buf, size_t count, void **owned) {
     //validate the parameters
-    GNL_NULL_CHECK(inode, EINVAL, -1)
     GNL_NULL_CHECK(buf, EINVAL, -1)
 
     // if we do not have to write data, return with an error
     GNL_MINUS1_CHECK(-1 * (count <= 0), EINVAL, -1)
 
-    // calculate the new size
-    int new_size = inode->buffer_size + count;
+    // create a new chunk
+    struct gnl_simfs_inode_chunk *chunk = (struct gnl_simfs_inode_chunk *)malloc(sizeof(struct gnl_simfs_inode_chunk));
+    GNL_NULL_CHECK(chunk, ENOMEM, -1)
 
-    // realloc the memory onto the buffer for the writing
-    void *temp = realloc(inode->buffer, new_size);
+    // compress the data, this is the only time
+    // the given bytes are compressed
+    if (owned == NULL) {
+        chunk->data = gnl_simfs_codec_encode(compression, buf, count, &(chunk->codec), &(chunk->size));
+    } else {
+        chunk->data = gnl_simfs_codec_encode_buffer(compression, owned, count, &(chunk->codec), &(chunk->size));
+    }
 
-    // do not handle errors but bubble it, if an
-    // update fails we are ok with the fact that
-    // realloc does not free the original pointer
-    GNL_NULL_CHECK(temp, errno, -1)
+    if (chunk->data == NULL) {
+        free(chunk);
 
-    // update the original pointer if it has changed (or not)
-    inode->buffer = temp;
+        // let the errno bubble
+        return -1;
+    }
 
-    // write the data
-    memcpy((char *)inode->buffer + inode->buffer_size, buf, count);
+    chunk->count = count;
+    chunk->next = NULL;
 
-    // update the size of the buffer
-    inode->buffer_size = new_size;
+    // append the chunk to the list
+    struct gnl_simfs_inode_chunk **tail = buffer;
+    while (*tail != NULL) {
+        tail = &((*tail)->next);
+    }
 
-    // set the last status change timestamp of the inode
-    inode->ctime = time(NULL);
+    *tail = chunk;
+
+    // update the size of the list
+    *buffer_size += chunk->size;
 
     return count;
 }
@@ -457,19 +488,37 @@ int gnl_simfs_inode_read(struct gnl_simfs_inode *inode, void **buf, size_t *coun
     //validate the parameters
     GNL_NULL_CHECK(inode, EINVAL, -1)
 
-    // decompress the inode
-    int res = decompress(inode);
-    GNL_MINUS1_CHECK(res, errno, -1);
+    struct gnl_simfs_inode_chunk *chunk;
+    size_t size = 0;
 
-    // alloc the memory onto the buffer for the reading
-    *buf = calloc(inode->size, 1);
+    // calculate the size of the decompressed file
+    for (chunk = inode->direct_ptr; chunk != NULL; chunk = chunk->next) {
+        size += chunk->count;
+    }
+
+    // alloc the memory onto the buffer for the reading,
+    // an empty file is read as a 1 byte zeroed buffer
+    *buf = calloc(size > 0 ? size : 1, 1);
     GNL_NULL_CHECK(*buf, ENOMEM, -1)
 
-    // read the data
-    memcpy(*buf, inode->direct_ptr, inode->size);
+    // read the data chunk by chunk
+    size_t offset = 0;
+    int res;
+    for (chunk = inode->direct_ptr; chunk != NULL; chunk = chunk->next) {
+        res = read_chunk(chunk, (char *)*buf + offset);
+        if (res == -1) {
+            free(*buf);
+            *buf = NULL;
+
+            // let the errno bubble
+            return -1;
+        }
+
+        offset += chunk->count;
+    }
 
     // set the count
-    *count = inode->size;
+    *count = size;
 
     // set the access timestamp of the inode
     inode->atime = time(NULL);
@@ -477,92 +526,172 @@ int gnl_simfs_inode_read(struct gnl_simfs_inode *inode, void **buf, size_t *coun
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
 
-    // compress the inode
-    res = compress(inode);
-    GNL_MINUS1_CHECK(res, errno, -1);
-
     return 0;
 }
 
 /**
  * {@inheritDoc}
  */
-struct gnl_simfs_inode *gnl_simfs_inode_copy(const struct gnl_simfs_inode *inode) {
-    GNL_NULL_CHECK(inode, EINVAL, NULL)
+int gnl_simfs_inode_read_chunk(struct gnl_simfs_inode *inode, size_t offset, size_t max, void **buf, size_t *count) {
+    //validate the parameters
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+    GNL_NULL_CHECK(buf, EINVAL, -1)
+    GNL_NULL_CHECK(count, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (max <= 0), EINVAL, -1)
+
+    struct gnl_simfs_inode_chunk *chunk;
+    size_t start = 0;
 
-    // allocate space for the new inode
-    struct gnl_simfs_inode *inode_copy = (struct gnl_simfs_inode *)malloc(sizeof(struct gnl_simfs_inode));
-    GNL_NULL_CHECK(inode_copy, ENOMEM, NULL)
+    // search the chunk holding the byte at the given offset
+    for (chunk = inode->direct_ptr; chunk != NULL; chunk = chunk->next) {
+        if (offset < start + chunk->count) {
+            break;
+        }
+
+        start += chunk->count;
+    }
 
-    // create a deep copy of the given inode
-    inode_copy->btime = inode->btime;
-    inode_copy->mtime = inode->mtime;
-    inode_copy->atime = inode->atime;
-    inode_copy->size = inode->size;
+    *buf = NULL;
+    *count = 0;
 
-    GNL_CALLOC(inode_copy->name, strlen(inode->name) + 1, NULL)
-    strcpy(inode_copy->name, inode->name);
+    // the offset is past the end of the file
+    if (chunk == NULL) {
+        return 0;
+    }
 
-    inode_copy->direct_ptr = inode->direct_ptr;
-    inode_copy->locked = inode->locked;
-    inode_copy->reference_count = inode->reference_count;
-    inode_copy->reference_list = NULL;
-    inode_copy->pending_locks = inode->pending_locks;
+    size_t skip = offset - start;
+    size_t n = chunk->count - skip;
 
-    // do not preserve the buffer
-    inode_copy->buffer = NULL;
-    inode_copy->buffer_size = 0;
+    if (n > max) {
+        n = max;
+    }
 
-    // initialize condition variables
-    int res = pthread_cond_init(&(inode_copy->file_is_lockable), NULL);
-    GNL_MINUS1_CHECK(res, errno, NULL)
+    if (chunk->codec == GNL_SIMFS_COMPRESSION_NONE) {
+        // the raw bytes are read straight from the chunk
+        *buf = malloc(n);
+        GNL_NULL_CHECK(*buf, ENOMEM, -1)
+
+        memcpy(*buf, (char *)chunk->data + skip, n);
+    } else {
+        // a compressed chunk is decoded only as a whole
+        *buf = malloc(chunk->count);
+        GNL_NULL_CHECK(*buf, ENOMEM, -1)
+
+        int res = read_chunk(chunk, *buf);
+        if (res == -1) {
+            free(*buf);
+            *buf = NULL;
+
+            // let the errno bubble
+            return -1;
+        }
+
+        if (skip > 0) {
+            memmove(*buf, (char *)*buf + skip, n);
+        }
+    }
 
-    // set the last status change timestamp of the inode
-    inode_copy->ctime = time(NULL);
+    *count = n;
 
-    return inode_copy;
+    // set the access timestamp of the inode
+    inode->atime = time(NULL);
+
+    return 0;
 }
 
 /**
  * {@inheritDoc}
  */
-int gnl_simfs_inode_fflush(struct gnl_simfs_inode *inode) {
-    GNL_NULL_CHECK(inode, EINVAL, -1)
+int gnl_simfs_inode_buffer_write(struct gnl_simfs_inode_buffer *buffer, enum gnl_simfs_compression compression,
+        const void *buf, void **owned, size_t count) {
+    GNL_NULL_CHECK(buffer, EINVAL, -1)
 
+    if (count <= GNL_SIMFS_INODE_CHUNK_MAX_COUNT) {
+        return write_chunk(compression, &(buffer->chunks), &(buffer->size), buf, count, owned);
+    }
+
+    GNL_NULL_CHECK(buf, EINVAL, -1)
+
+    // split the bytes into bounded chunks, they are appended
+    // to the buffer only if all of them are written
+    struct gnl_simfs_inode_chunk *chunks = NULL;
+    int size = 0;
+    size_t written = 0;
     int res;
 
-    // decompress the inode
-    if (inode->direct_ptr != NULL) {
-        res = decompress(inode);
-        GNL_MINUS1_CHECK(res, errno, -1);
+    while (written < count) {
+        size_t n = count - written;
+        if (n > GNL_SIMFS_INODE_CHUNK_MAX_COUNT) {
+            n = GNL_SIMFS_INODE_CHUNK_MAX_COUNT;
+        }
+
+        res = write_chunk(compression, &chunks, &size, (const char *)buf + written, n, NULL);
+        if (res == -1) {
+            int write_errno = errno;
+            destroy_chunks(chunks);
+            errno = write_errno;
+
+            return -1;
+        }
+
+        written += n;
+    }
+
+    struct gnl_simfs_inode_chunk **tail = &(buffer->chunks);
+    while (*tail != NULL) {
+        tail = &((*tail)->next);
     }
 
-    // calculate the new size
-    int new_size = inode->size + inode->buffer_size;
+    *tail = chunks;
+    buffer->size += size;
 
-    // re-alloc the memory onto the direct pointer for the writing
-    void *temp = realloc(inode->direct_ptr, new_size);
+    return count;
+}
 
-    // do not handle errors but bubble it, if an
-    // update fails we are ok with the fact that
-    // realloc does not free the original pointer
-    GNL_NULL_CHECK(temp, ENOMEM, -1)
+/**
+ * {@inheritDoc}
+ */
+void gnl_simfs_inode_buffer_clear(struct gnl_simfs_inode_buffer *buffer) {
+    if (buffer == NULL) {
+        return;
+    }
 
-    // update the original pointer if it has changed (or not)
-    inode->direct_ptr = temp;
+    destroy_chunks(buffer->chunks);
+    buffer->chunks = NULL;
+    buffer->size = 0;
+}
 
-    // write the data
-    memcpy((char *)inode->direct_ptr + inode->size, inode->buffer, inode->buffer_size);
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_inode_fflush_buffer(struct gnl_simfs_inode *inode, struct gnl_simfs_inode_buffer *buffer) {
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+    GNL_NULL_CHECK(buffer, EINVAL, -1)
+
+    // append the chunks of the given buffer to the file, they are already
+    // compressed so the inode takes their ownership as they are
+    if (buffer->chunks != NULL) {
+        if (inode->last_chunk == NULL) {
+            inode->direct_ptr = buffer->chunks;
+        } else {
+            inode->last_chunk->next = buffer->chunks;
+        }
+
+        // move the last chunk pointer to the end of the file
+        struct gnl_simfs_inode_chunk *last_chunk = buffer->chunks;
+        while (last_chunk->next != NULL) {
+            last_chunk = last_chunk->next;
+        }
+
+        inode->last_chunk = last_chunk;
+    }
 
     // update the size of the file within the inode
-    inode->size = new_size;
+    inode->size += buffer->size;
 
-    // free the buffer
-    free(inode->buffer);
-    inode->buffer = NULL;
-
-    // reset the buffer size
-    inode->buffer_size = 0;
+    // the chunks are now owned by the file
+    buffer->chunks = NULL;
+    buffer->size = 0;
 
     // update the last modification timestamp of the file
     // within the inode
@@ -571,10 +700,6 @@ int gnl_simfs_inode_fflush(struct gnl_simfs_inode *inode) {
     // set the last status change timestamp of the inode
     inode->ctime = time(NULL);
 
-    // compress the inode
-    res = compress(inode);
-    GNL_MINUS1_CHECK(res, errno, -1);
-
     return 0;
 }
 
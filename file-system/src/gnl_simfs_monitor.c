@@ -25,6 +25,11 @@ struct gnl_simfs_monitor {
     // the number of bytes written into
     // the file system
     unsigned long long bytes_counter;
+
+    // the number of lookups of existing
+    // files found and not found
+    int file_hits;
+    int file_misses;
 };
 
 /**
@@ -39,6 +44,8 @@ struct gnl_simfs_monitor *gnl_simfs_monitor_init() {
     monitor->file_evictions = 0;
     monitor->file_counter = 0;
     monitor->bytes_counter = 0;
+    monitor->file_hits = 0;
+    monitor->file_misses = 0;
 
     return monitor;
 }
@@ -132,4 +139,28 @@ int gnl_simfs_monitor_eviction_started(struct gnl_simfs_monitor *monitor) {
     return 0;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_monitor_file_hit(struct gnl_simfs_monitor *monitor) {
+    // validate the parameters
+    GNL_NULL_CHECK(monitor, EINVAL, -1)
+
+    monitor->file_hits++;
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_monitor_file_missed(struct gnl_simfs_monitor *monitor) {
+    // validate the parameters
+    GNL_NULL_CHECK(monitor, EINVAL, -1)
+
+    monitor->file_misses++;
+
+    return 0;
+}
+
 #include <gnl_macro_end.h>
\ No newline at end of file
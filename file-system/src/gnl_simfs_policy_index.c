@@ -0,0 +1,1386 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <gnl_ternary_search_tree_t.h>
+#include "../include/gnl_simfs_policy_index.h"
+#include <gnl_macro_beg.h>
+
+/**
+ * The queues of the policy index. The policies with a single list use
+ * only the recent queue, the others move the inodes among them:
+ * - ARC:       the recent queue is T1, the frequent queue is T2;
+ * - 2Q:        the recent queue is A1in, the frequent queue is Am;
+ * - W-TinyLFU: the recent queue is the window, the frequent queue is
+ *              the probation segment, the protected queue is the
+ *              protected segment and the candidate queue holds the
+ *              inodes moved out of the window, waiting for their
+ *              admission into the probation segment.
+ */
+#define GNL_SIMFS_QUEUE_RECENT 0
+#define GNL_SIMFS_QUEUE_FREQUENT 1
+#define GNL_SIMFS_QUEUE_PROTECTED 2
+#define GNL_SIMFS_QUEUE_CANDIDATE 3
+#define GNL_SIMFS_QUEUES 4
+
+/**
+ * The count-min sketch of the W-TinyLFU policy: the number of rows,
+ * the number of counters per row (a power of 2) and the max value of
+ * a counter. The counters are halved every GNL_SIMFS_SKETCH_SAMPLE
+ * additions, so the sketch forgets the old accesses.
+ */
+#define GNL_SIMFS_SKETCH_DEPTH 4
+#define GNL_SIMFS_SKETCH_WIDTH 4096
+#define GNL_SIMFS_SKETCH_MAX 15
+#define GNL_SIMFS_SKETCH_SAMPLE (10 * GNL_SIMFS_SKETCH_WIDTH)
+
+/**
+ * Macro to acquire the lock of the policy index.
+ */
+#define GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, return_value) {            \
+    int policy_lock_acquire_res = pthread_mutex_lock(&((index)->mtx));  \
+    GNL_MINUS1_CHECK(policy_lock_acquire_res, errno, return_value)      \
+}
+
+/**
+ * Macro to release the lock of the policy index.
+ */
+#define GNL_SIMFS_POLICY_LOCK_RELEASE(index, return_value) {                \
+    int policy_lock_release_res = pthread_mutex_unlock(&((index)->mtx));    \
+    GNL_MINUS1_CHECK(policy_lock_release_res, errno, return_value)          \
+}
+
+/**
+ * A frequency bucket of the LFU replacement policy, it contains
+ * all the inodes with the same frequency, the least recently
+ * touched first.
+ */
+struct gnl_simfs_policy_bucket {
+
+    // the frequency of the inodes of the bucket
+    unsigned long frequency;
+
+    // the first and the last inode of the bucket
+    struct gnl_simfs_inode *head;
+    struct gnl_simfs_inode *tail;
+
+    // the buckets with the previous and the next frequency
+    struct gnl_simfs_policy_bucket *prev;
+    struct gnl_simfs_policy_bucket *next;
+};
+
+/**
+ * A queue of inodes, the oldest first.
+ */
+struct gnl_simfs_policy_queue {
+
+    // the first and the last inode of the queue
+    struct gnl_simfs_inode *head;
+    struct gnl_simfs_inode *tail;
+
+    // the count of the inodes of the queue
+    int count;
+};
+
+/**
+ * A ghost entry of the ARC and 2Q policies: the name of an evicted
+ * file, kept to recognize the files re-created soon after their eviction.
+ */
+struct gnl_simfs_policy_ghost {
+
+    // the name of the evicted file
+    char *name;
+
+    // the ghost queue where the entry resides
+    int queue;
+
+    // the previous and the next entry of the ghost queue
+    struct gnl_simfs_policy_ghost *prev;
+    struct gnl_simfs_policy_ghost *next;
+};
+
+/**
+ * A queue of ghost entries, the oldest first.
+ */
+struct gnl_simfs_policy_ghost_queue {
+
+    // the first and the last entry of the queue
+    struct gnl_simfs_policy_ghost *head;
+    struct gnl_simfs_policy_ghost *tail;
+
+    // the count of the entries of the queue
+    int count;
+};
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_simfs_policy_index {
+
+    // the replacement policy that orders the index
+    enum gnl_simfs_replacement_policy policy;
+
+    // the queues of the inodes, ordered by creation time for the
+    // FIFO and LIFO policies and by access time for the others
+    struct gnl_simfs_policy_queue queues[GNL_SIMFS_QUEUES];
+
+    // the frequency buckets of the LFU policy, ordered
+    // by frequency, the empty buckets are removed
+    struct gnl_simfs_policy_bucket *buckets;
+
+    // the ghost queues of the ARC (B1 and B2) and 2Q (A1out)
+    // policies, indexed by name into the ghost table
+    struct gnl_simfs_policy_ghost_queue ghosts[2];
+    struct gnl_ternary_search_tree_t *ghost_table;
+
+    // the target size of the recent queue of the ARC policy,
+    // it adapts on the hits of the ghost queues
+    int target;
+
+    // the count-min sketch of the W-TinyLFU policy, it
+    // estimates the access frequencies of any file name
+    unsigned char *sketch;
+    unsigned int sketch_additions;
+
+    // the min heap of the GDSF policy, ordered by priority
+    struct gnl_simfs_inode **heap;
+    size_t heap_size;
+    size_t heap_capacity;
+
+    // the inflation of the GDSF policy, it is the priority
+    // of the last victim and it is added to the priorities
+    // of the accessed files, so the old ones age
+    double inflation;
+
+    // the count of the indexed inodes
+    int count;
+
+    // the logical clock of the accesses, it is incremented
+    // on every access and never goes back
+    unsigned long long clock;
+
+    // the number of accesses after which the frequencies
+    // are halved, if 0 the frequencies never age
+    unsigned int aging;
+
+    // the accesses since the last aging
+    unsigned int accesses;
+
+    // the count of the agings occurred
+    unsigned int epoch;
+
+    // the lock of the index, it is touched by
+    // the operations on different shards
+    pthread_mutex_t mtx;
+};
+
+/**
+ * Append the given inode to the tail of the given list.
+ *
+ * @param head  The head of the list.
+ * @param tail  The tail of the list.
+ * @param inode The inode to append.
+ */
+static void list_append(struct gnl_simfs_inode **head, struct gnl_simfs_inode **tail, struct gnl_simfs_inode *inode) {
+    inode->policy_prev = *tail;
+    inode->policy_next = NULL;
+
+    if (*tail == NULL) {
+        *head = inode;
+    } else {
+        (*tail)->policy_next = inode;
+    }
+
+    *tail = inode;
+}
+
+/**
+ * Unlink the given inode from the given list.
+ *
+ * @param head  The head of the list.
+ * @param tail  The tail of the list.
+ * @param inode The inode to unlink.
+ */
+static void list_unlink(struct gnl_simfs_inode **head, struct gnl_simfs_inode **tail, struct gnl_simfs_inode *inode) {
+    if (inode->policy_prev == NULL) {
+        *head = inode->policy_next;
+    } else {
+        inode->policy_prev->policy_next = inode->policy_next;
+    }
+
+    if (inode->policy_next == NULL) {
+        *tail = inode->policy_prev;
+    } else {
+        inode->policy_next->policy_prev = inode->policy_prev;
+    }
+
+    inode->policy_prev = NULL;
+    inode->policy_next = NULL;
+}
+
+/**
+ * Get the frequency of the given inode, applying the agings occurred since
+ * its last update: every aging halves the frequency.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The inode from where to get the frequency.
+ *
+ * @return      Returns the aged frequency of the given inode.
+ */
+static unsigned long inode_frequency(const struct gnl_simfs_policy_index *index, const struct gnl_simfs_inode *inode) {
+    unsigned int shift = index->epoch - inode->frequency_epoch;
+
+    if (shift >= sizeof(unsigned long) * 8) {
+        return 0;
+    }
+
+    return inode->frequency >> shift;
+}
+
+/**
+ * Get the bucket of the given frequency, creating it if it does not exist.
+ * The search starts from the given bucket, so the cost is constant when
+ * the frequency is next to the frequency of the given bucket.
+ *
+ * @param index     The policy index instance where the buckets reside.
+ * @param from      The bucket from where to start the search, if NULL
+ *                  the search starts from the first bucket.
+ * @param frequency The frequency of the bucket to get.
+ *
+ * @return          Returns the bucket of the given frequency on success,
+ *                  NULL otherwise.
+ */
+static struct gnl_simfs_policy_bucket *get_bucket(struct gnl_simfs_policy_index *index,
+        struct gnl_simfs_policy_bucket *from, unsigned long frequency) {
+    struct gnl_simfs_policy_bucket *current = from == NULL ? index->buckets : from;
+    struct gnl_simfs_policy_bucket *prev = from == NULL ? NULL : from->prev;
+
+    // move back while the previous bucket has a frequency not less than the given one
+    while (prev != NULL && prev->frequency >= frequency) {
+        current = prev;
+        prev = prev->prev;
+    }
+
+    // move on while the current bucket has a frequency less than the given one
+    while (current != NULL && current->frequency < frequency) {
+        prev = current;
+        current = current->next;
+    }
+
+    if (current != NULL && current->frequency == frequency) {
+        return current;
+    }
+
+    // the bucket does not exist, create it between prev and current
+    struct gnl_simfs_policy_bucket *bucket = (struct gnl_simfs_policy_bucket *)malloc(sizeof(struct gnl_simfs_policy_bucket));
+    GNL_NULL_CHECK(bucket, ENOMEM, NULL)
+
+    bucket->frequency = frequency;
+    bucket->head = NULL;
+    bucket->tail = NULL;
+    bucket->prev = prev;
+    bucket->next = current;
+
+    if (prev == NULL) {
+        index->buckets = bucket;
+    } else {
+        prev->next = bucket;
+    }
+
+    if (current != NULL) {
+        current->prev = bucket;
+    }
+
+    return bucket;
+}
+
+/**
+ * Unlink the given inode from its bucket, destroying the bucket if it gets empty.
+ *
+ * @param index The policy index instance where the bucket resides.
+ * @param inode The inode to unlink.
+ */
+static void bucket_unlink(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    struct gnl_simfs_policy_bucket *bucket = inode->policy_bucket;
+
+    list_unlink(&(bucket->head), &(bucket->tail), inode);
+    inode->policy_bucket = NULL;
+
+    if (bucket->head != NULL) {
+        return;
+    }
+
+    if (bucket->prev == NULL) {
+        index->buckets = bucket->next;
+    } else {
+        bucket->prev->next = bucket->next;
+    }
+
+    if (bucket->next != NULL) {
+        bucket->next->prev = bucket->prev;
+    }
+
+    free(bucket);
+}
+
+/**
+ * Age the frequencies of the given policy index halving them. The frequencies
+ * of the inodes are updated lazily, the frequencies of the LFU buckets are
+ * updated here, merging the buckets that end up with the same frequency
+ * in access clock order.
+ *
+ * @param index The policy index instance to age.
+ */
+static void age_frequencies(struct gnl_simfs_policy_index *index) {
+    index->epoch++;
+    index->accesses = 0;
+
+    struct gnl_simfs_policy_bucket *bucket = index->buckets;
+    struct gnl_simfs_policy_bucket *next;
+    struct gnl_simfs_policy_bucket *prev;
+    struct gnl_simfs_inode *inode;
+    struct gnl_simfs_inode *left;
+    struct gnl_simfs_inode *right;
+
+    while (bucket != NULL) {
+        next = bucket->next;
+        prev = bucket->prev;
+
+        bucket->frequency >>= 1;
+
+        // the buckets are ordered, so only the previous
+        // bucket can have the same frequency
+        if (prev != NULL && prev->frequency == bucket->frequency) {
+
+            // merge the inodes into the previous bucket; both the
+            // buckets are ordered by access clock, so the merge keeps
+            // the least recently touched inodes first
+            left = prev->head;
+            right = bucket->head;
+
+            prev->head = NULL;
+            prev->tail = NULL;
+
+            while (left != NULL || right != NULL) {
+                if (right == NULL || (left != NULL && left->access_clock <= right->access_clock)) {
+                    inode = left;
+                    left = left->policy_next;
+                } else {
+                    inode = right;
+                    right = right->policy_next;
+                }
+
+                list_append(&(prev->head), &(prev->tail), inode);
+                inode->policy_bucket = prev;
+            }
+
+            // destroy the bucket
+            prev->next = next;
+            if (next != NULL) {
+                next->prev = prev;
+            }
+
+            free(bucket);
+        }
+
+        bucket = next;
+    }
+}
+
+/**
+ * Append the given inode to the tail of the given queue.
+ *
+ * @param index The policy index instance where the queue resides.
+ * @param queue The queue where to append the inode.
+ * @param inode The inode to append.
+ */
+static void queue_append(struct gnl_simfs_policy_index *index, int queue, struct gnl_simfs_inode *inode) {
+    struct gnl_simfs_policy_queue *q = index->queues + queue;
+
+    list_append(&(q->head), &(q->tail), inode);
+    q->count++;
+    inode->policy_queue = queue;
+}
+
+/**
+ * Unlink the given inode from its queue.
+ *
+ * @param index The policy index instance where the queue resides.
+ * @param inode The inode to unlink.
+ */
+static void queue_unlink(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    struct gnl_simfs_policy_queue *q = index->queues + inode->policy_queue;
+
+    list_unlink(&(q->head), &(q->tail), inode);
+    q->count--;
+    inode->policy_queue = -1;
+}
+
+/**
+ * Move the given inode to the tail of the given queue.
+ *
+ * @param index The policy index instance where the queues reside.
+ * @param queue The queue where to move the inode.
+ * @param inode The inode to move.
+ */
+static void queue_move(struct gnl_simfs_policy_index *index, int queue, struct gnl_simfs_inode *inode) {
+    queue_unlink(index, inode);
+    queue_append(index, queue, inode);
+}
+
+/**
+ * Get the ghost entry of the given name.
+ *
+ * @param index The policy index instance where the ghosts reside.
+ * @param name  The name of the file.
+ *
+ * @return      Returns the ghost entry of the given name if present,
+ *              NULL otherwise.
+ */
+static struct gnl_simfs_policy_ghost *ghost_get(struct gnl_simfs_policy_index *index, const char *name) {
+    if (index->ghost_table == NULL) {
+        return NULL;
+    }
+
+    return gnl_ternary_search_tree_get(index->ghost_table, name);
+}
+
+/**
+ * Append a ghost entry of the given name to the tail of the given ghost queue.
+ *
+ * @param index The policy index instance where the ghosts reside.
+ * @param queue The ghost queue where to append the entry.
+ * @param name  The name of the evicted file.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int ghost_append(struct gnl_simfs_policy_index *index, int queue, const char *name) {
+    struct gnl_simfs_policy_ghost *ghost = (struct gnl_simfs_policy_ghost *)malloc(sizeof(struct gnl_simfs_policy_ghost));
+    GNL_NULL_CHECK(ghost, ENOMEM, -1)
+
+    ghost->name = (char *)malloc((strlen(name) + 1) * sizeof(char));
+    if (ghost->name == NULL) {
+        free(ghost);
+
+        errno = ENOMEM;
+        return -1;
+    }
+
+    strcpy(ghost->name, name);
+
+    int res = gnl_ternary_search_tree_put(&(index->ghost_table), name, ghost);
+    if (res == -1) {
+        free(ghost->name);
+        free(ghost);
+
+        // let the errno bubble
+        return -1;
+    }
+
+    struct gnl_simfs_policy_ghost_queue *q = index->ghosts + queue;
+
+    ghost->queue = queue;
+    ghost->prev = q->tail;
+    ghost->next = NULL;
+
+    if (q->tail == NULL) {
+        q->head = ghost;
+    } else {
+        q->tail->next = ghost;
+    }
+
+    q->tail = ghost;
+    q->count++;
+
+    return 0;
+}
+
+/**
+ * Drop the given ghost entry, destroying it.
+ *
+ * @param index The policy index instance where the ghost resides.
+ * @param ghost The ghost entry to drop.
+ */
+static void ghost_drop(struct gnl_simfs_policy_index *index, struct gnl_simfs_policy_ghost *ghost) {
+    struct gnl_simfs_policy_ghost_queue *q = index->ghosts + ghost->queue;
+
+    if (ghost->prev == NULL) {
+        q->head = ghost->next;
+    } else {
+        ghost->prev->next = ghost->next;
+    }
+
+    if (ghost->next == NULL) {
+        q->tail = ghost->prev;
+    } else {
+        ghost->next->prev = ghost->prev;
+    }
+
+    q->count--;
+
+    gnl_ternary_search_tree_remove(index->ghost_table, ghost->name, NULL);
+
+    free(ghost->name);
+    free(ghost);
+}
+
+/**
+ * Get the counters of the given name into the count-min sketch, one per row.
+ *
+ * @param name      The name of the file.
+ * @param counters  The array where to write the positions of the counters.
+ */
+static void sketch_counters(const char *name, size_t *counters) {
+    // FNV-1a hash of the name
+    unsigned long long hash = 14695981039346656037ULL;
+
+    for (const char *c = name; *c != '\0'; c++) {
+        hash ^= (unsigned char)*c;
+        hash *= 1099511628211ULL;
+    }
+
+    // derive a hash per row from the two halves of the hash
+    unsigned int low = (unsigned int)hash;
+    unsigned int high = (unsigned int)(hash >> 32) | 1;
+
+    for (size_t i=0; i<GNL_SIMFS_SKETCH_DEPTH; i++) {
+        counters[i] = i * GNL_SIMFS_SKETCH_WIDTH + ((low + i * high) & (GNL_SIMFS_SKETCH_WIDTH - 1));
+    }
+}
+
+/**
+ * Track an access to the given name into the count-min sketch
+ * of the given policy index.
+ *
+ * @param index The policy index instance where the sketch resides.
+ * @param name  The name of the accessed file.
+ */
+static void sketch_increment(struct gnl_simfs_policy_index *index, const char *name) {
+    size_t counters[GNL_SIMFS_SKETCH_DEPTH];
+    sketch_counters(name, counters);
+
+    for (size_t i=0; i<GNL_SIMFS_SKETCH_DEPTH; i++) {
+        if (index->sketch[counters[i]] < GNL_SIMFS_SKETCH_MAX) {
+            index->sketch[counters[i]]++;
+        }
+    }
+
+    // halve all the counters periodically
+    if (++index->sketch_additions >= GNL_SIMFS_SKETCH_SAMPLE) {
+        for (size_t i=0; i<GNL_SIMFS_SKETCH_DEPTH * GNL_SIMFS_SKETCH_WIDTH; i++) {
+            index->sketch[i] >>= 1;
+        }
+
+        index->sketch_additions = 0;
+    }
+}
+
+/**
+ * Estimate the access frequency of the given name from the count-min
+ * sketch of the given policy index.
+ *
+ * @param index The policy index instance where the sketch resides.
+ * @param name  The name of the file.
+ *
+ * @return      Returns the estimated frequency, never less than the real one.
+ */
+static unsigned int sketch_estimate(const struct gnl_simfs_policy_index *index, const char *name) {
+    size_t counters[GNL_SIMFS_SKETCH_DEPTH];
+    sketch_counters(name, counters);
+
+    unsigned int estimate = GNL_SIMFS_SKETCH_MAX;
+
+    for (size_t i=0; i<GNL_SIMFS_SKETCH_DEPTH; i++) {
+        if (index->sketch[counters[i]] < estimate) {
+            estimate = index->sketch[counters[i]];
+        }
+    }
+
+    return estimate;
+}
+
+/**
+ * Get the GDSF priority of the given inode: the inflation of the given
+ * policy index plus the access frequency of the inode per byte, so the
+ * big files are evicted before the small ones with the same popularity.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The inode from where to get the priority.
+ *
+ * @return      Returns the priority of the given inode.
+ */
+static double inode_priority(const struct gnl_simfs_policy_index *index, const struct gnl_simfs_inode *inode) {
+    double size = inode->size > 0 ? (double)inode->size : 1;
+
+    return index->inflation + (double)inode_frequency(index, inode) / size;
+}
+
+/**
+ * Swap the given positions of the heap of the given policy index.
+ *
+ * @param index The policy index instance where the heap resides.
+ * @param i     The first position.
+ * @param j     The second position.
+ */
+static void heap_swap(struct gnl_simfs_policy_index *index, size_t i, size_t j) {
+    struct gnl_simfs_inode *tmp = index->heap[i];
+
+    index->heap[i] = index->heap[j];
+    index->heap[j] = tmp;
+
+    index->heap[i]->policy_position = i;
+    index->heap[j]->policy_position = j;
+}
+
+/**
+ * Move the given inode up into the heap of the given policy index
+ * until its parent has a lower priority.
+ *
+ * @param index The policy index instance where the heap resides.
+ * @param inode The inode to move.
+ */
+static void heap_sift_up(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    size_t i = inode->policy_position;
+    size_t parent;
+
+    while (i > 0) {
+        parent = (i - 1) / 2;
+
+        if (index->heap[parent]->policy_priority <= inode->policy_priority) {
+            break;
+        }
+
+        heap_swap(index, i, parent);
+        i = parent;
+    }
+}
+
+/**
+ * Move the given inode down into the heap of the given policy index
+ * until its children have a higher priority.
+ *
+ * @param index The policy index instance where the heap resides.
+ * @param inode The inode to move.
+ */
+static void heap_sift_down(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    size_t i = inode->policy_position;
+    size_t child;
+
+    while ((child = 2 * i + 1) < index->heap_size) {
+
+        // pick the child with the lowest priority
+        if (child + 1 < index->heap_size
+            && index->heap[child + 1]->policy_priority < index->heap[child]->policy_priority) {
+            child++;
+        }
+
+        if (inode->policy_priority <= index->heap[child]->policy_priority) {
+            break;
+        }
+
+        heap_swap(index, i, child);
+        i = child;
+    }
+}
+
+/**
+ * Push the given inode into the heap of the given policy index.
+ *
+ * @param index The policy index instance where the heap resides.
+ * @param inode The inode to push.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int heap_push(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // grow the heap if it is full
+    if (index->heap_size == index->heap_capacity) {
+        size_t capacity = index->heap_capacity == 0 ? 16 : index->heap_capacity * 2;
+
+        struct gnl_simfs_inode **heap = (struct gnl_simfs_inode **)realloc(index->heap,
+                capacity * sizeof(struct gnl_simfs_inode *));
+        GNL_NULL_CHECK(heap, ENOMEM, -1)
+
+        index->heap = heap;
+        index->heap_capacity = capacity;
+    }
+
+    inode->policy_position = index->heap_size;
+    index->heap[index->heap_size++] = inode;
+
+    heap_sift_up(index, inode);
+
+    return 0;
+}
+
+/**
+ * Unlink the given inode from the heap of the given policy index.
+ *
+ * @param index The policy index instance where the heap resides.
+ * @param inode The inode to unlink.
+ */
+static void heap_unlink(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    size_t i = inode->policy_position;
+    struct gnl_simfs_inode *last = index->heap[--index->heap_size];
+
+    // put the last inode in place of the unlinked one
+    if (i < index->heap_size) {
+        index->heap[i] = last;
+        last->policy_position = i;
+
+        heap_sift_down(index, last);
+        heap_sift_up(index, last);
+    }
+
+    inode->policy_position = 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_simfs_policy_index *gnl_simfs_policy_index_init(enum gnl_simfs_replacement_policy policy, unsigned int aging) {
+    struct gnl_simfs_policy_index *index = (struct gnl_simfs_policy_index *)malloc(sizeof(struct gnl_simfs_policy_index));
+    GNL_NULL_CHECK(index, ENOMEM, NULL)
+
+    index->policy = policy;
+
+    for (size_t i=0; i<GNL_SIMFS_QUEUES; i++) {
+        index->queues[i].head = NULL;
+        index->queues[i].tail = NULL;
+        index->queues[i].count = 0;
+    }
+
+    for (size_t i=0; i<2; i++) {
+        index->ghosts[i].head = NULL;
+        index->ghosts[i].tail = NULL;
+        index->ghosts[i].count = 0;
+    }
+
+    index->buckets = NULL;
+    index->ghost_table = NULL;
+    index->target = 0;
+    index->sketch = NULL;
+    index->sketch_additions = 0;
+    index->heap = NULL;
+    index->heap_size = 0;
+    index->heap_capacity = 0;
+    index->inflation = 0;
+    index->count = 0;
+    index->clock = 0;
+    index->aging = aging;
+    index->accesses = 0;
+    index->epoch = 0;
+
+    // the sketch is needed only by the W-TinyLFU policy
+    if (policy == GNL_SIMFS_RP_WTINYLFU) {
+        index->sketch = (unsigned char *)calloc(GNL_SIMFS_SKETCH_DEPTH * GNL_SIMFS_SKETCH_WIDTH, sizeof(unsigned char));
+        if (index->sketch == NULL) {
+            free(index);
+
+            errno = ENOMEM;
+            return NULL;
+        }
+    }
+
+    int res = pthread_mutex_init(&(index->mtx), NULL);
+    GNL_MINUS1_CHECK(res, errno, NULL)
+
+    return index;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_simfs_policy_index_destroy(struct gnl_simfs_policy_index *index) {
+    if (index == NULL) {
+        return;
+    }
+
+    // destroy the buckets, the inodes are owned by the file tables
+    struct gnl_simfs_policy_bucket *bucket = index->buckets;
+    struct gnl_simfs_policy_bucket *next;
+
+    while (bucket != NULL) {
+        next = bucket->next;
+        free(bucket);
+        bucket = next;
+    }
+
+    // destroy the ghosts
+    for (size_t i=0; i<2; i++) {
+        while (index->ghosts[i].head != NULL) {
+            ghost_drop(index, index->ghosts[i].head);
+        }
+    }
+
+    gnl_ternary_search_tree_destroy(&(index->ghost_table), NULL);
+
+    free(index->sketch);
+    free(index->heap);
+
+    pthread_mutex_destroy(&(index->mtx));
+
+    free(index);
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_insert(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    // a new file has not been accessed yet
+    inode->access_clock = ++index->clock;
+    inode->frequency = 0;
+    inode->frequency_epoch = index->epoch;
+
+    struct gnl_simfs_policy_bucket *bucket;
+    struct gnl_simfs_policy_ghost *ghost;
+    int delta;
+    int res = 0;
+
+    switch (index->policy) {
+        case GNL_SIMFS_RP_NONE:
+            GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+            return 0;
+            /* UNREACHED */
+
+        case GNL_SIMFS_RP_FIFO:
+        case GNL_SIMFS_RP_LIFO:
+        case GNL_SIMFS_RP_LRU:
+        case GNL_SIMFS_RP_MRU:
+            queue_append(index, GNL_SIMFS_QUEUE_RECENT, inode);
+            break;
+
+        case GNL_SIMFS_RP_LFU:
+            bucket = get_bucket(index, NULL, inode->frequency);
+            if (bucket == NULL) {
+                res = -1;
+                break;
+            }
+
+            list_append(&(bucket->head), &(bucket->tail), inode);
+            inode->policy_bucket = bucket;
+            inode->policy_queue = GNL_SIMFS_QUEUE_RECENT;
+            break;
+
+        // a file re-created after its eviction from T1 (B1 hit) means that
+        // T1 is too small, from T2 (B2 hit) that T2 is too small: adapt the
+        // target size of T1 and consider the file as frequently used
+        case GNL_SIMFS_RP_ARC:
+            ghost = ghost_get(index, inode->name);
+
+            if (ghost == NULL) {
+                queue_append(index, GNL_SIMFS_QUEUE_RECENT, inode);
+                break;
+            }
+
+            if (ghost->queue == 0) {
+                delta = index->ghosts[0].count >= index->ghosts[1].count ? 1 : index->ghosts[1].count / index->ghosts[0].count;
+                index->target = index->target + delta > index->count + 1 ? index->count + 1 : index->target + delta;
+            } else {
+                delta = index->ghosts[1].count >= index->ghosts[0].count ? 1 : index->ghosts[0].count / index->ghosts[1].count;
+                index->target = index->target - delta < 0 ? 0 : index->target - delta;
+            }
+
+            ghost_drop(index, ghost);
+            queue_append(index, GNL_SIMFS_QUEUE_FREQUENT, inode);
+            break;
+
+        // a file re-created after its eviction from A1in (A1out hit) is
+        // frequently used, the others pass through the A1in queue
+        case GNL_SIMFS_RP_2Q:
+            ghost = ghost_get(index, inode->name);
+
+            if (ghost == NULL) {
+                queue_append(index, GNL_SIMFS_QUEUE_RECENT, inode);
+                break;
+            }
+
+            ghost_drop(index, ghost);
+            queue_append(index, GNL_SIMFS_QUEUE_FREQUENT, inode);
+            break;
+
+        // the new files enter the window, which holds 1% of the files: when
+        // it overflows, its least recently used inode is queued as a candidate
+        // to the admission into the probation segment
+        case GNL_SIMFS_RP_WTINYLFU:
+            sketch_increment(index, inode->name);
+            queue_append(index, GNL_SIMFS_QUEUE_RECENT, inode);
+
+            if (index->queues[GNL_SIMFS_QUEUE_RECENT].count > (index->count + 1) / 100
+                && index->queues[GNL_SIMFS_QUEUE_RECENT].count > 1) {
+                queue_move(index, GNL_SIMFS_QUEUE_CANDIDATE, index->queues[GNL_SIMFS_QUEUE_RECENT].head);
+            }
+            break;
+
+        case GNL_SIMFS_RP_GDSF:
+            inode->policy_priority = inode_priority(index, inode);
+            res = heap_push(index, inode);
+            if (res == 0) {
+                inode->policy_queue = GNL_SIMFS_QUEUE_RECENT;
+            }
+            break;
+
+        default:
+            errno = EINVAL;
+            res = -1;
+            break;
+    }
+
+    if (res == 0) {
+        index->count++;
+    }
+
+    int insert_errno = errno;
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    if (res == -1) {
+        errno = insert_errno;
+    }
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_touch(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    // track the access
+    inode->access_clock = ++index->clock;
+    inode->frequency = inode_frequency(index, inode) + 1;
+    inode->frequency_epoch = index->epoch;
+
+    struct gnl_simfs_policy_bucket *bucket;
+    struct gnl_simfs_policy_queue *protected;
+    int main_size;
+
+    switch (index->policy) {
+
+        // the order of the creation does not change on access
+        case GNL_SIMFS_RP_NONE:
+        case GNL_SIMFS_RP_FIFO:
+        case GNL_SIMFS_RP_LIFO:
+            break;
+
+        // move the inode to the most recently used position
+        case GNL_SIMFS_RP_LRU:
+        case GNL_SIMFS_RP_MRU:
+            queue_move(index, GNL_SIMFS_QUEUE_RECENT, inode);
+            break;
+
+        // move the inode to the bucket of its frequency, the
+        // frequency grows by one, so the bucket is a neighbour
+        case GNL_SIMFS_RP_LFU:
+            bucket = get_bucket(index, inode->policy_bucket, inode->frequency);
+            if (bucket == NULL) {
+                GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+                errno = ENOMEM;
+                return -1;
+            }
+
+            // the current bucket can not be destroyed by the unlink
+            // if it is the target one, since the inode is put back
+            if (bucket == inode->policy_bucket) {
+                list_unlink(&(bucket->head), &(bucket->tail), inode);
+            } else {
+                bucket_unlink(index, inode);
+            }
+
+            list_append(&(bucket->head), &(bucket->tail), inode);
+            inode->policy_bucket = bucket;
+            break;
+
+        // a second access promotes the inode to T2
+        case GNL_SIMFS_RP_ARC:
+            queue_move(index, GNL_SIMFS_QUEUE_FREQUENT, inode);
+            break;
+
+        // the accesses to the inodes of A1in are ignored, so a
+        // scan does not pollute Am, which is an LRU queue
+        case GNL_SIMFS_RP_2Q:
+            if (inode->policy_queue == GNL_SIMFS_QUEUE_FREQUENT) {
+                queue_move(index, GNL_SIMFS_QUEUE_FREQUENT, inode);
+            }
+            break;
+
+        // the window and the protected segment are LRU queues, an access
+        // to the probation segment or to a candidate promotes the inode to
+        // the protected one, which demotes its least recently used inode
+        // if it overflows
+        case GNL_SIMFS_RP_WTINYLFU:
+            sketch_increment(index, inode->name);
+
+            if (inode->policy_queue == GNL_SIMFS_QUEUE_RECENT) {
+                queue_move(index, GNL_SIMFS_QUEUE_RECENT, inode);
+                break;
+            }
+
+            queue_move(index, GNL_SIMFS_QUEUE_PROTECTED, inode);
+
+            protected = index->queues + GNL_SIMFS_QUEUE_PROTECTED;
+            main_size = index->queues[GNL_SIMFS_QUEUE_FREQUENT].count + protected->count;
+
+            if (protected->count > 1 && protected->count > main_size * 4 / 5) {
+                queue_move(index, GNL_SIMFS_QUEUE_FREQUENT, protected->head);
+            }
+            break;
+
+        // the priority grows with the frequency
+        case GNL_SIMFS_RP_GDSF:
+            inode->policy_priority = inode_priority(index, inode);
+            heap_sift_down(index, inode);
+            heap_sift_up(index, inode);
+            break;
+
+        default:
+            GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+            errno = EINVAL;
+            return -1;
+            /* UNREACHED */
+    }
+
+    // age the frequencies if it is time to
+    if (index->aging > 0 && ++index->accesses >= index->aging) {
+        age_frequencies(index);
+    }
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_update(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    // the use is recent, but it is not a new reference
+    inode->access_clock = ++index->clock;
+
+    struct gnl_simfs_policy_bucket *bucket;
+
+    switch (index->policy) {
+
+        // the order of the creation does not change on use
+        case GNL_SIMFS_RP_NONE:
+        case GNL_SIMFS_RP_FIFO:
+        case GNL_SIMFS_RP_LIFO:
+            break;
+
+        // move the inode to the most recently used position of its bucket
+        case GNL_SIMFS_RP_LFU:
+            bucket = inode->policy_bucket;
+            list_unlink(&(bucket->head), &(bucket->tail), inode);
+            list_append(&(bucket->head), &(bucket->tail), inode);
+            break;
+
+        // the accesses to the inodes of A1in are ignored
+        case GNL_SIMFS_RP_2Q:
+            if (inode->policy_queue == GNL_SIMFS_QUEUE_FREQUENT) {
+                queue_move(index, GNL_SIMFS_QUEUE_FREQUENT, inode);
+            }
+            break;
+
+        // the size may have changed
+        case GNL_SIMFS_RP_GDSF:
+            inode->policy_priority = inode_priority(index, inode);
+            heap_sift_down(index, inode);
+            heap_sift_up(index, inode);
+            break;
+
+        // move the inode to the most recently used position of its queue
+        default:
+            queue_move(index, inode->policy_queue, inode);
+            break;
+    }
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    return 0;
+}
+
+/**
+ * Unlink the given inode from the given policy index.
+ *
+ * @param index The policy index instance where the inode resides.
+ * @param inode The inode to unlink.
+ */
+static void policy_unlink(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    switch (index->policy) {
+        case GNL_SIMFS_RP_LFU:
+            bucket_unlink(index, inode);
+            inode->policy_queue = -1;
+            break;
+
+        case GNL_SIMFS_RP_GDSF:
+            heap_unlink(index, inode);
+            inode->policy_queue = -1;
+            break;
+
+        default:
+            queue_unlink(index, inode);
+            break;
+    }
+
+    index->count--;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_remove(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    // an evicted inode is not indexed anymore
+    if (inode->policy_queue != -1) {
+        policy_unlink(index, inode);
+    }
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_evict(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    if (inode->policy_queue == -1) {
+        GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+        errno = ENOENT;
+        return -1;
+    }
+
+    // the count of the files before the eviction
+    int capacity = index->count;
+    int queue = inode->policy_queue;
+    int res = 0;
+
+    switch (index->policy) {
+
+        // remember the victim into B1 or B2, then keep T1 + B1 and
+        // B1 + B2 within the count of the files
+        case GNL_SIMFS_RP_ARC:
+            res = ghost_append(index, queue == GNL_SIMFS_QUEUE_RECENT ? 0 : 1, inode->name);
+
+            while (index->ghosts[0].count > 0
+                   && index->queues[GNL_SIMFS_QUEUE_RECENT].count + index->ghosts[0].count > capacity) {
+                ghost_drop(index, index->ghosts[0].head);
+            }
+
+            while (index->ghosts[0].count + index->ghosts[1].count > capacity) {
+                ghost_drop(index, index->ghosts[1].count > 0 ? index->ghosts[1].head : index->ghosts[0].head);
+            }
+            break;
+
+        // remember the victims of A1in into A1out, which holds
+        // at most half of the count of the files
+        case GNL_SIMFS_RP_2Q:
+            if (queue != GNL_SIMFS_QUEUE_RECENT) {
+                break;
+            }
+
+            res = ghost_append(index, 0, inode->name);
+
+            while (index->ghosts[0].count > 1 && index->ghosts[0].count > capacity / 2) {
+                ghost_drop(index, index->ghosts[0].head);
+            }
+            break;
+
+        // the priority of the victim is the new inflation
+        case GNL_SIMFS_RP_GDSF:
+            index->inflation = inode->policy_priority;
+            break;
+
+        default:
+            break;
+    }
+
+    policy_unlink(index, inode);
+
+    int evict_errno = errno;
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    if (res == -1) {
+        errno = evict_errno;
+    }
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static struct gnl_simfs_inode *gnl_simfs_policy_index_victim(struct gnl_simfs_policy_index *index) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, NULL)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, NULL)
+
+    struct gnl_simfs_policy_queue *recent = index->queues + GNL_SIMFS_QUEUE_RECENT;
+    struct gnl_simfs_policy_queue *frequent = index->queues + GNL_SIMFS_QUEUE_FREQUENT;
+    struct gnl_simfs_policy_queue *protected = index->queues + GNL_SIMFS_QUEUE_PROTECTED;
+    struct gnl_simfs_policy_queue *candidates = index->queues + GNL_SIMFS_QUEUE_CANDIDATE;
+    struct gnl_simfs_inode *victim;
+    struct gnl_simfs_inode *candidate;
+    struct gnl_simfs_inode *main_victim;
+
+    switch (index->policy) {
+        case GNL_SIMFS_RP_FIFO:
+        case GNL_SIMFS_RP_LRU:
+            victim = recent->head;
+            break;
+
+        case GNL_SIMFS_RP_LIFO:
+        case GNL_SIMFS_RP_MRU:
+            victim = recent->tail;
+            break;
+
+        // the first bucket is never empty
+        case GNL_SIMFS_RP_LFU:
+            victim = index->buckets == NULL ? NULL : index->buckets->head;
+            break;
+
+        // evict from T1 while it is bigger than its target size
+        case GNL_SIMFS_RP_ARC:
+            if (recent->count > 0 && (recent->count > index->target || frequent->count == 0)) {
+                victim = recent->head;
+            } else {
+                victim = frequent->head;
+            }
+            break;
+
+        // evict from A1in while it holds more than a quarter of the files
+        case GNL_SIMFS_RP_2Q:
+            if (recent->count > 0 && (recent->count > index->count / 4 || frequent->count == 0)) {
+                victim = recent->head;
+            } else {
+                victim = frequent->head;
+            }
+            break;
+
+        // the oldest candidate duels the victim of the main segments: it is
+        // the victim unless the sketch estimates it more frequent, otherwise
+        // it is admitted into the probation segment and the main victim is
+        // evicted; the candidates are admitted freely while the main
+        // segments are empty
+        case GNL_SIMFS_RP_WTINYLFU:
+            victim = NULL;
+
+            while (victim == NULL && candidates->head != NULL) {
+                candidate = candidates->head;
+                main_victim = frequent->head != NULL ? frequent->head : protected->head;
+
+                if (main_victim != NULL
+                    && sketch_estimate(index, candidate->name) <= sketch_estimate(index, main_victim->name)) {
+                    victim = candidate;
+                    continue;
+                }
+
+                queue_move(index, GNL_SIMFS_QUEUE_FREQUENT, candidate);
+                victim = main_victim;
+            }
+
+            if (victim == NULL) {
+                victim = frequent->head != NULL ? frequent->head : protected->head;
+            }
+
+            if (victim == NULL) {
+                victim = recent->head;
+            }
+            break;
+
+        // the lowest priority is at the top of the heap
+        case GNL_SIMFS_RP_GDSF:
+            victim = index->heap_size == 0 ? NULL : index->heap[0];
+            break;
+
+        default:
+            victim = NULL;
+            break;
+    }
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, NULL)
+
+    GNL_NULL_CHECK(victim, ENOENT, NULL)
+
+    return victim;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static long gnl_simfs_policy_index_frequency(struct gnl_simfs_policy_index *index, const struct gnl_simfs_inode *inode) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+    GNL_NULL_CHECK(inode, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    long frequency = inode_frequency(index, inode);
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    return frequency;
+}
+
+/**
+ * {@inheritDoc}
+ */
+static int gnl_simfs_policy_index_count(struct gnl_simfs_policy_index *index) {
+    // validate the parameters
+    GNL_NULL_CHECK(index, EINVAL, -1)
+
+    GNL_SIMFS_POLICY_LOCK_ACQUIRE(index, -1)
+
+    int count = index->count;
+
+    GNL_SIMFS_POLICY_LOCK_RELEASE(index, -1)
+
+    return count;
+}
+
+#undef GNL_SIMFS_QUEUE_RECENT
+#undef GNL_SIMFS_QUEUE_FREQUENT
+#undef GNL_SIMFS_QUEUE_PROTECTED
+#undef GNL_SIMFS_QUEUE_CANDIDATE
+#undef GNL_SIMFS_QUEUES
+#undef GNL_SIMFS_SKETCH_DEPTH
+#undef GNL_SIMFS_SKETCH_WIDTH
+#undef GNL_SIMFS_SKETCH_MAX
+#undef GNL_SIMFS_SKETCH_SAMPLE
+#undef GNL_SIMFS_POLICY_LOCK_ACQUIRE
+#undef GNL_SIMFS_POLICY_LOCK_RELEASE
+
+#include <gnl_macro_end.h>
@@ -0,0 +1,420 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include "../include/gnl_simfs_session_table.h"
+#include <gnl_macro_beg.h>
+
+// the initial number of buckets of the session table,
+// it must be a power of two
+#define GNL_SIMFS_SESSION_TABLE_INITIAL_BUCKETS 64
+
+/**
+ * Macro to acquire the lock of the session table.
+ */
+#define GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, return_value) {               \
+    int session_lock_acquire_res = pthread_mutex_lock(&((table)->mtx));     \
+    GNL_MINUS1_CHECK(session_lock_acquire_res, errno, return_value)         \
+}
+
+/**
+ * Macro to release the lock of the session table.
+ */
+#define GNL_SIMFS_SESSION_LOCK_RELEASE(table, return_value) {               \
+    int session_lock_release_res = pthread_mutex_unlock(&((table)->mtx));   \
+    GNL_MINUS1_CHECK(session_lock_release_res, errno, return_value)         \
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_simfs_session_table {
+
+    // the buckets of the sessions, every bucket is
+    // the list of the sessions whose pid falls into it
+    struct gnl_simfs_session **buckets;
+
+    // the number of buckets, a power of two
+    size_t buckets_count;
+
+    // the number of sessions present into the table
+    size_t count;
+
+    // the lock of the session table, the table is shared
+    // among all the shards of the file system, so every access
+    // to it must be serialized
+    pthread_mutex_t mtx;
+};
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_simfs_session_table *gnl_simfs_session_table_init() {
+    struct gnl_simfs_session_table *t = (struct gnl_simfs_session_table *)malloc(sizeof(struct gnl_simfs_session_table));
+    GNL_NULL_CHECK(t, ENOMEM, NULL)
+
+    t->buckets = calloc(GNL_SIMFS_SESSION_TABLE_INITIAL_BUCKETS, sizeof(struct gnl_simfs_session *));
+    if (t->buckets == NULL) {
+        free(t);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    t->buckets_count = GNL_SIMFS_SESSION_TABLE_INITIAL_BUCKETS;
+    t->count = 0;
+
+    // initialize the lock
+    int res = pthread_mutex_init(&(t->mtx), NULL);
+    GNL_MINUS1_CHECK(res, errno, NULL)
+
+    return t;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_simfs_session_destroy(struct gnl_simfs_session *session) {
+    if (session == NULL) {
+        return;
+    }
+
+    for (int i=0; i<session->locks_count; i++) {
+        free(session->locks[i]);
+    }
+
+    free(session->locks);
+    free(session->fds);
+    free(session);
+}
+
+/**
+ * {@inheritDoc}
+ */
+void gnl_simfs_session_table_destroy(struct gnl_simfs_session_table *table) {
+    if (table == NULL) {
+        return;
+    }
+
+    struct gnl_simfs_session *session;
+    struct gnl_simfs_session *next;
+
+    // destroy the sessions still present
+    for (size_t i=0; i<table->buckets_count; i++) {
+        session = table->buckets[i];
+
+        while (session != NULL) {
+            next = session->next;
+            gnl_simfs_session_destroy(session);
+            session = next;
+        }
+    }
+
+    free(table->buckets);
+
+    // destroy the lock, proceed on error
+    pthread_mutex_destroy(&(table->mtx));
+
+    free(table);
+}
+
+/**
+ * Get the bucket of the given pid.
+ *
+ * @param table The session table instance.
+ * @param pid   The pid.
+ *
+ * @return      Returns the pointer to the head of the bucket of the pid.
+ */
+static struct gnl_simfs_session **get_session_bucket(struct gnl_simfs_session_table *table, unsigned int pid) {
+    // spread the pids, they are usually consecutive
+    unsigned int hash = pid * 2654435761U;
+
+    return table->buckets + (hash & (table->buckets_count - 1));
+}
+
+/**
+ * Double the buckets of the given session table. On failure the
+ * table is left as it is.
+ *
+ * @param table The session table instance.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int grow_session_buckets(struct gnl_simfs_session_table *table) {
+    struct gnl_simfs_session **old_buckets = table->buckets;
+    size_t old_buckets_count = table->buckets_count;
+
+    struct gnl_simfs_session **buckets = calloc(old_buckets_count * 2, sizeof(struct gnl_simfs_session *));
+    GNL_NULL_CHECK(buckets, ENOMEM, -1)
+
+    table->buckets = buckets;
+    table->buckets_count = old_buckets_count * 2;
+
+    struct gnl_simfs_session *session;
+    struct gnl_simfs_session *next;
+    struct gnl_simfs_session **bucket;
+
+    // move the sessions into the new buckets
+    for (size_t i=0; i<old_buckets_count; i++) {
+        session = old_buckets[i];
+
+        while (session != NULL) {
+            next = session->next;
+
+            bucket = get_session_bucket(table, session->pid);
+            session->next = *bucket;
+            *bucket = session;
+
+            session = next;
+        }
+    }
+
+    free(old_buckets);
+
+    return 0;
+}
+
+/**
+ * Get the session of the given pid, creating it if it does not exist.
+ * The caller must hold the lock of the table.
+ *
+ * @param table     The session table instance.
+ * @param pid       The pid of the session.
+ * @param create    If not 0 the session is created if it does not exist.
+ *
+ * @return          Returns the session of the given pid on success,
+ *                  NULL otherwise.
+ */
+static struct gnl_simfs_session *get_session(struct gnl_simfs_session_table *table, unsigned int pid, int create) {
+    struct gnl_simfs_session **bucket = get_session_bucket(table, pid);
+
+    for (struct gnl_simfs_session *session = *bucket; session != NULL; session = session->next) {
+        if (session->pid == pid) {
+            return session;
+        }
+    }
+
+    if (!create) {
+        errno = ENOENT;
+
+        return NULL;
+    }
+
+    // keep the buckets short, a failed grow
+    // only makes them longer
+    if (table->count >= table->buckets_count * 2 && grow_session_buckets(table) == 0) {
+        bucket = get_session_bucket(table, pid);
+    }
+
+    struct gnl_simfs_session *session = calloc(1, sizeof(struct gnl_simfs_session));
+    GNL_NULL_CHECK(session, ENOMEM, NULL)
+
+    session->pid = pid;
+    session->next = *bucket;
+    *bucket = session;
+
+    table->count++;
+
+    return session;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_session_table_add_fd(struct gnl_simfs_session_table *table, unsigned int pid, int fd) {
+    GNL_NULL_CHECK(table, EINVAL, -1)
+
+    GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, -1)
+
+    int res = -1;
+    struct gnl_simfs_session *session = get_session(table, pid, 1);
+
+    if (session != NULL) {
+        res = 0;
+
+        // grow the file descriptors array
+        if (session->fds_count == session->fds_capacity) {
+            int capacity = session->fds_capacity == 0 ? 4 : session->fds_capacity * 2;
+            int *fds = realloc(session->fds, capacity * sizeof(int));
+
+            if (fds == NULL) {
+                errno = ENOMEM;
+                res = -1;
+            } else {
+                session->fds = fds;
+                session->fds_capacity = capacity;
+            }
+        }
+
+        if (res == 0) {
+            session->fds[session->fds_count++] = fd;
+        }
+    }
+
+    GNL_SIMFS_SESSION_LOCK_RELEASE(table, -1)
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_session_table_remove_fd(struct gnl_simfs_session_table *table, unsigned int pid, int fd) {
+    GNL_NULL_CHECK(table, EINVAL, -1)
+
+    GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, -1)
+
+    int res = -1;
+    struct gnl_simfs_session *session = get_session(table, pid, 0);
+
+    if (session != NULL) {
+        errno = EBADF;
+
+        // the order of the file descriptors does not matter,
+        // so the last one takes the place of the removed one
+        for (int i=0; i<session->fds_count; i++) {
+            if (session->fds[i] == fd) {
+                session->fds[i] = session->fds[--session->fds_count];
+                res = 0;
+
+                break;
+            }
+        }
+    }
+
+    GNL_SIMFS_SESSION_LOCK_RELEASE(table, -1)
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_session_table_add_lock(struct gnl_simfs_session_table *table, unsigned int pid,
+        const char *filename) {
+    GNL_NULL_CHECK(table, EINVAL, -1)
+    GNL_NULL_CHECK(filename, EINVAL, -1)
+
+    GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, -1)
+
+    int res = -1;
+    struct gnl_simfs_session *session = get_session(table, pid, 1);
+
+    if (session != NULL) {
+        res = 0;
+
+        // a file already tracked is not tracked twice
+        for (int i=0; i<session->locks_count; i++) {
+            if (strcmp(session->locks[i], filename) == 0) {
+                GNL_SIMFS_SESSION_LOCK_RELEASE(table, -1)
+
+                return 0;
+            }
+        }
+
+        // grow the file names array
+        if (session->locks_count == session->locks_capacity) {
+            int capacity = session->locks_capacity == 0 ? 4 : session->locks_capacity * 2;
+            char **locks = realloc(session->locks, capacity * sizeof(char *));
+
+            if (locks == NULL) {
+                res = -1;
+            } else {
+                session->locks = locks;
+                session->locks_capacity = capacity;
+            }
+        }
+
+        char *filename_copy = NULL;
+        if (res == 0) {
+            filename_copy = calloc(strlen(filename) + 1, sizeof(char));
+        }
+
+        if (filename_copy == NULL) {
+            errno = ENOMEM;
+            res = -1;
+        } else {
+            strcpy(filename_copy, filename);
+            session->locks[session->locks_count++] = filename_copy;
+        }
+    }
+
+    GNL_SIMFS_SESSION_LOCK_RELEASE(table, -1)
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_simfs_session_table_remove_lock(struct gnl_simfs_session_table *table, unsigned int pid,
+        const char *filename) {
+    GNL_NULL_CHECK(table, EINVAL, -1)
+    GNL_NULL_CHECK(filename, EINVAL, -1)
+
+    GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, -1)
+
+    int res = -1;
+    struct gnl_simfs_session *session = get_session(table, pid, 0);
+
+    if (session != NULL) {
+        errno = ENOENT;
+
+        // the order of the file names does not matter,
+        // so the last one takes the place of the removed one
+        for (int i=0; i<session->locks_count; i++) {
+            if (strcmp(session->locks[i], filename) == 0) {
+                free(session->locks[i]);
+                session->locks[i] = session->locks[--session->locks_count];
+                res = 0;
+
+                break;
+            }
+        }
+    }
+
+    GNL_SIMFS_SESSION_LOCK_RELEASE(table, -1)
+
+    return res;
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_simfs_session *gnl_simfs_session_table_detach(struct gnl_simfs_session_table *table, unsigned int pid) {
+    GNL_NULL_CHECK(table, EINVAL, NULL)
+
+    GNL_SIMFS_SESSION_LOCK_ACQUIRE(table, NULL)
+
+    struct gnl_simfs_session **current = get_session_bucket(table, pid);
+
+    // unlink the session from its bucket
+    while (*current != NULL && (*current)->pid != pid) {
+        current = &((*current)->next);
+    }
+
+    struct gnl_simfs_session *session = *current;
+
+    if (session != NULL) {
+        *current = session->next;
+        session->next = NULL;
+
+        table->count--;
+    }
+
+    GNL_SIMFS_SESSION_LOCK_RELEASE(table, NULL)
+
+    // the pid has no session
+    if (session == NULL) {
+        errno = 0;
+    }
+
+    return session;
+}
+
+#undef GNL_SIMFS_SESSION_TABLE_INITIAL_BUCKETS
+#undef GNL_SIMFS_SESSION_LOCK_ACQUIRE
+#undef GNL_SIMFS_SESSION_LOCK_RELEASE
+
+#include <gnl_macro_end.h>
@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <string.h>
+#include <gnl_colorshell.h>
+#include <gnl_assert.h>
+#include <gnl_file_to_pointer.h>
+#include "../src/gnl_simfs_codec.c"
+
+/**
+ * Encode the given bytes with the given compression, then decode
+ * them and check that the decoded bytes are equal to the given ones.
+ *
+ * @param compression   The compression to use.
+ * @param bytes         The bytes to encode.
+ * @param count         The number of bytes.
+ * @param codec         The destination where to write the codec used.
+ * @param size          The destination where to write the encoded size.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int round_trip(enum gnl_simfs_compression compression, const void *bytes, size_t count,
+        enum gnl_simfs_compression *codec, size_t *size) {
+    void *data = gnl_simfs_codec_encode(compression, bytes, count, codec, size);
+    if (data == NULL) {
+        return -1;
+    }
+
+    void *decoded = malloc(count);
+    if (decoded == NULL) {
+        return -1;
+    }
+
+    // decode twice, the data must not be modified
+    for (size_t i=0; i<2; i++) {
+        int res = gnl_simfs_codec_decode(*codec, data, *size, decoded, count);
+        if (res != count) {
+            return -1;
+        }
+
+        if (memcmp(decoded, bytes, count) != 0) {
+            return -1;
+        }
+    }
+
+    free(decoded);
+    gnl_simfs_codec_destroy(*codec, data);
+
+    return 0;
+}
+
+int can_encode_none() {
+    enum gnl_simfs_compression codec;
+    size_t size;
+
+    int res = round_trip(GNL_SIMFS_COMPRESSION_NONE, "string", 6, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_NONE || size != 6) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_encode_huffman() {
+    long count;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    enum gnl_simfs_compression codec;
+    size_t size;
+
+    res = round_trip(GNL_SIMFS_COMPRESSION_HUFFMAN, content, count, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_HUFFMAN || size >= count) {
+        return -1;
+    }
+
+    free(content);
+
+    return 0;
+}
+
+int can_encode_lz() {
+    long count;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    enum gnl_simfs_compression codec;
+    size_t size;
+
+    res = round_trip(GNL_SIMFS_COMPRESSION_LZ, content, count, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_LZ || size >= count) {
+        return -1;
+    }
+
+    free(content);
+
+    // long and overlapping matches
+    char repeated[1000];
+    memset(repeated, 'a', 1000);
+    memcpy(repeated + 500, "abcabcabc", 9);
+
+    res = round_trip(GNL_SIMFS_COMPRESSION_LZ, repeated, 1000, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (size >= 100) {
+        return -1;
+    }
+
+    // too short to contain a match
+    res = round_trip(GNL_SIMFS_COMPRESSION_LZ, "abc", 3, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_encode_auto() {
+    long count;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    enum gnl_simfs_compression codec;
+    size_t size;
+
+    // the text is compressed
+    res = round_trip(GNL_SIMFS_COMPRESSION_AUTO, content, count, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_HUFFMAN) {
+        return -1;
+    }
+
+    // the random bytes are stored as they are
+    srand(1);
+    for (size_t i=0; i<count; i++) {
+        content[i] = rand() & 0xFF;
+    }
+
+    res = round_trip(GNL_SIMFS_COMPRESSION_AUTO, content, count, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_NONE || size != count) {
+        return -1;
+    }
+
+    free(content);
+
+    return 0;
+}
+
+int can_encode_auto_small() {
+    enum gnl_simfs_compression codec;
+    size_t size;
+    char content[1000];
+    int res;
+
+    // few random bytes look compressible to the entropy
+    // estimate, but they must be stored as they are
+    srand(1);
+    for (size_t count=16; count<=512; count*=2) {
+        for (size_t i=0; i<count; i++) {
+            content[i] = rand() & 0xFF;
+        }
+
+        res = round_trip(GNL_SIMFS_COMPRESSION_AUTO, content, count, &codec, &size);
+        if (res != 0) {
+            return -1;
+        }
+
+        if (codec != GNL_SIMFS_COMPRESSION_NONE || size != count) {
+            return -1;
+        }
+    }
+
+    // a short text can not pay for the code lengths table
+    res = round_trip(GNL_SIMFS_COMPRESSION_AUTO, "stringstringstringstringstringstring", 36, &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_NONE || size != 36) {
+        return -1;
+    }
+
+    // a longer text does, even if not sampled
+    for (size_t i=0; i<sizeof(content); i++) {
+        content[i] = "string"[i % 6];
+    }
+
+    res = round_trip(GNL_SIMFS_COMPRESSION_AUTO, content, sizeof(content), &codec, &size);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_HUFFMAN || size >= sizeof(content)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_encode_buffer() {
+    long count;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    enum gnl_simfs_compression codec;
+    size_t size;
+    void *bytes = content;
+
+    // the bytes stored as they are must be adopted, not copied
+    void *data = gnl_simfs_codec_encode_buffer(GNL_SIMFS_COMPRESSION_NONE, &bytes, count, &codec, &size);
+    if (data != content || bytes != NULL) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_NONE || size != count) {
+        return -1;
+    }
+
+    // the buffer is not adopted by the compressing codecs
+    res = gnl_file_to_pointer("./testfile.txt", &content, &count);
+    if (res == -1) {
+        return -1;
+    }
+
+    bytes = content;
+
+    void *compressed = gnl_simfs_codec_encode_buffer(GNL_SIMFS_COMPRESSION_HUFFMAN, &bytes, count, &codec, &size);
+    if (compressed == NULL || bytes != content) {
+        return -1;
+    }
+
+    if (codec != GNL_SIMFS_COMPRESSION_HUFFMAN) {
+        return -1;
+    }
+
+    free(content);
+    gnl_simfs_codec_destroy(GNL_SIMFS_COMPRESSION_NONE, data);
+    gnl_simfs_codec_destroy(GNL_SIMFS_COMPRESSION_HUFFMAN, compressed);
+
+    return 0;
+}
+
+int can_not_decode_invalid() {
+    enum gnl_simfs_compression codec;
+    size_t size;
+
+    unsigned char *data = gnl_simfs_codec_encode(GNL_SIMFS_COMPRESSION_LZ, "stringstringstring", 18, &codec, &size);
+    if (data == NULL) {
+        return -1;
+    }
+
+    char decoded[18];
+
+    // the data is truncated
+    int res = gnl_simfs_codec_decode(codec, data, size - 1, decoded, 18);
+    if (res == 18) {
+        return -1;
+    }
+
+    // the destination is too small
+    res = gnl_simfs_codec_decode(codec, data, size, decoded, 10);
+    if (res != -1 || errno != EINVAL) {
+        return -1;
+    }
+
+    gnl_simfs_codec_destroy(codec, data);
+
+    data = gnl_simfs_codec_encode(GNL_SIMFS_COMPRESSION_AUTO, "string", 6, &codec, &size);
+    if (data == NULL) {
+        return -1;
+    }
+
+    // the auto compression is not a codec
+    res = gnl_simfs_codec_decode(GNL_SIMFS_COMPRESSION_AUTO, data, size, decoded, 6);
+    if (res != -1 || errno != EINVAL) {
+        return -1;
+    }
+
+    gnl_simfs_codec_destroy(codec, data);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_simfs_codec test:\n\n");
+
+    gnl_assert(can_encode_none, "can store bytes as they are.");
+    gnl_assert(can_encode_huffman, "can encode bytes with the huffman codec.");
+    gnl_assert(can_encode_lz, "can encode bytes with the lz codec.");
+    gnl_assert(can_encode_auto, "can choose the codec with the auto compression.");
+    gnl_assert(can_encode_auto_small, "can store few bytes as they are with the auto compression.");
+    gnl_assert(can_encode_buffer, "can adopt the buffer of the bytes stored as they are.");
+    gnl_assert(can_not_decode_invalid, "can not decode invalid data.");
+
+    // the gnl_simfs_codec_destroy method is implicitly tested in every assertion
+
+    printf("\n");
+}
@@ -31,9 +31,9 @@ int can_not_put() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_handle handle = {0, 1, 1};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle, 1);
 
     if (res != -1) {
         return -1;
@@ -43,7 +43,6 @@ int can_not_put() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -60,11 +59,11 @@ int can_put() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
@@ -74,7 +73,7 @@ int can_put() {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (res == -1) {
         return -1;
@@ -84,7 +83,7 @@ int can_put() {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (res == -1) {
         return -1;
@@ -94,10 +93,6 @@ int can_put() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
-
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -110,9 +105,9 @@ int can_not_get_empty() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_file_descriptor_table_get(table, 0, 1);
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(table, 0, 1);
 
-    if (inode != NULL) {
+    if (file_descriptor != NULL) {
         return -1;
     }
 
@@ -132,23 +127,23 @@ int can_not_get_not_existing() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (res == -1) {
         return -1;
@@ -158,9 +153,9 @@ int can_not_get_not_existing() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_file_descriptor_table_get(table, 4, 1);
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(table, 4, 1);
 
-    if (inode != NULL) {
+    if (file_descriptor != NULL) {
         return -1;
     }
 
@@ -168,9 +163,6 @@ int can_not_get_not_existing() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -183,23 +175,23 @@ int can_not_get_removed() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (res == -1) {
         return -1;
@@ -209,9 +201,9 @@ int can_not_get_removed() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_ok = gnl_simfs_file_descriptor_table_get(table, 0, 1);
+    struct gnl_simfs_file_descriptor *file_descriptor_ok = gnl_simfs_file_descriptor_table_get(table, 0, 1);
 
-    if (inode_ok == NULL) {
+    if (file_descriptor_ok == NULL) {
         return -1;
     }
 
@@ -225,9 +217,9 @@ int can_not_get_removed() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_null = gnl_simfs_file_descriptor_table_get(table, 0, 1);
+    struct gnl_simfs_file_descriptor *file_descriptor_null = gnl_simfs_file_descriptor_table_get(table, 0, 1);
 
-    if (inode_null != NULL) {
+    if (file_descriptor_null != NULL) {
         return -1;
     }
 
@@ -235,9 +227,6 @@ int can_not_get_removed() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -250,17 +239,17 @@ int can_not_get_perm() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_file_descriptor_table_get(table, 0, 2);
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(table, 0, 2);
 
-    if (inode != NULL) {
+    if (file_descriptor != NULL) {
         return -1;
     }
 
@@ -268,7 +257,6 @@ int can_not_get_perm() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -303,9 +291,9 @@ int can_not_remove_perm() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
@@ -321,7 +309,6 @@ int can_not_remove_perm() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -334,23 +321,23 @@ int can_get() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int res = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int res = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    res = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (res == -1) {
         return -1;
@@ -360,27 +347,29 @@ int can_get() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_file_descriptor_table_get(table, 0, 1);
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(table, 0, 1);
 
-    if (inode == NULL) {
+    if (file_descriptor == NULL) {
         return -1;
     }
 
-    inode = gnl_simfs_file_descriptor_table_get(table, 1, 1);
+    file_descriptor = gnl_simfs_file_descriptor_table_get(table, 1, 1);
 
-    if (inode == NULL) {
+    if (file_descriptor == NULL) {
         return -1;
     }
 
-    inode = gnl_simfs_file_descriptor_table_get(table, 2, 1);
+    file_descriptor = gnl_simfs_file_descriptor_table_get(table, 2, 1);
+
+    if (file_descriptor == NULL) {
+        return -1;
+    }
 
-    if (inode == NULL) {
+    // the file descriptor refers the inode by its handle
+    if (file_descriptor->handle.hash != 3 || file_descriptor->handle.generation != 3) {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -397,11 +386,11 @@ int can_remove() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int fd_1 = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int fd_1 = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (fd_1 == -1) {
         return -1;
@@ -411,7 +400,7 @@ int can_remove() {
         return -1;
     }
 
-    int fd_2 = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    int fd_2 = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (fd_2 == -1) {
         return -1;
@@ -421,7 +410,7 @@ int can_remove() {
         return -1;
     }
 
-    int fd_3 = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    int fd_3 = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (fd_3 == -1) {
         return -1;
@@ -441,10 +430,6 @@ int can_remove() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
-
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -461,12 +446,12 @@ int can_put_after_remove() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
-    struct gnl_simfs_inode *inode_4 = gnl_simfs_inode_init("test4");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
+    struct gnl_simfs_inode_handle handle_4 = {0, 4, 4};
 
-    int fd_1 = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int fd_1 = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (fd_1 == -1) {
         return -1;
@@ -476,7 +461,7 @@ int can_put_after_remove() {
         return -1;
     }
 
-    int fd_2 = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    int fd_2 = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (fd_2 == -1) {
         return -1;
@@ -486,7 +471,7 @@ int can_put_after_remove() {
         return -1;
     }
 
-    int fd_3 = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    int fd_3 = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (fd_3 == -1) {
         return -1;
@@ -506,7 +491,7 @@ int can_put_after_remove() {
         return -1;
     }
 
-    int fd_4 = gnl_simfs_file_descriptor_table_put(table, inode_4, 1);
+    int fd_4 = gnl_simfs_file_descriptor_table_put(table, &handle_4, 1);
 
     if (fd_4 == -1) {
         return -1;
@@ -516,11 +501,6 @@ int can_put_after_remove() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
-    gnl_simfs_inode_destroy(inode_4);
-
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -537,11 +517,11 @@ int can_remove_all() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
 
-    int fd_1 = gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
+    int fd_1 = gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
 
     if (fd_1 == -1) {
         return -1;
@@ -551,7 +531,7 @@ int can_remove_all() {
         return -1;
     }
 
-    int fd_2 = gnl_simfs_file_descriptor_table_put(table, inode_2, 1);
+    int fd_2 = gnl_simfs_file_descriptor_table_put(table, &handle_2, 1);
 
     if (fd_2 == -1) {
         return -1;
@@ -561,7 +541,7 @@ int can_remove_all() {
         return -1;
     }
 
-    int fd_3 = gnl_simfs_file_descriptor_table_put(table, inode_3, 1);
+    int fd_3 = gnl_simfs_file_descriptor_table_put(table, &handle_3, 1);
 
     if (fd_3 == -1) {
         return -1;
@@ -601,10 +581,6 @@ int can_remove_all() {
         return -1;
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
-
     gnl_simfs_file_descriptor_table_destroy(table);
 
     return 0;
@@ -621,25 +597,25 @@ int can_remove_pid_all() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_1 = gnl_simfs_inode_init("test1");
-    struct gnl_simfs_inode *inode_2 = gnl_simfs_inode_init("test2");
-    struct gnl_simfs_inode *inode_3 = gnl_simfs_inode_init("test3");
-    struct gnl_simfs_inode *inode_4 = gnl_simfs_inode_init("test4");
-    struct gnl_simfs_inode *inode_5 = gnl_simfs_inode_init("test5");
-    struct gnl_simfs_inode *inode_6 = gnl_simfs_inode_init("test6");
-    struct gnl_simfs_inode *inode_7 = gnl_simfs_inode_init("test7");
-    struct gnl_simfs_inode *inode_8 = gnl_simfs_inode_init("test8");
-    struct gnl_simfs_inode *inode_9 = gnl_simfs_inode_init("test9");
+    struct gnl_simfs_inode_handle handle_1 = {0, 1, 1};
+    struct gnl_simfs_inode_handle handle_2 = {0, 2, 2};
+    struct gnl_simfs_inode_handle handle_3 = {0, 3, 3};
+    struct gnl_simfs_inode_handle handle_4 = {0, 4, 4};
+    struct gnl_simfs_inode_handle handle_5 = {0, 5, 5};
+    struct gnl_simfs_inode_handle handle_6 = {0, 6, 6};
+    struct gnl_simfs_inode_handle handle_7 = {0, 7, 7};
+    struct gnl_simfs_inode_handle handle_8 = {0, 8, 8};
+    struct gnl_simfs_inode_handle handle_9 = {0, 9, 9};
 
-    gnl_simfs_file_descriptor_table_put(table, inode_1, 1);
-    gnl_simfs_file_descriptor_table_put(table, inode_2, 2);
-    gnl_simfs_file_descriptor_table_put(table, inode_3, 3);
-    gnl_simfs_file_descriptor_table_put(table, inode_4, 1);
-    gnl_simfs_file_descriptor_table_put(table, inode_5, 1);
-    gnl_simfs_file_descriptor_table_put(table, inode_6, 4);
-    gnl_simfs_file_descriptor_table_put(table, inode_7, 1);
-    gnl_simfs_file_descriptor_table_put(table, inode_8, 5);
-    gnl_simfs_file_descriptor_table_put(table, inode_9, 1);
+    gnl_simfs_file_descriptor_table_put(table, &handle_1, 1);
+    gnl_simfs_file_descriptor_table_put(table, &handle_2, 2);
+    gnl_simfs_file_descriptor_table_put(table, &handle_3, 3);
+    gnl_simfs_file_descriptor_table_put(table, &handle_4, 1);
+    gnl_simfs_file_descriptor_table_put(table, &handle_5, 1);
+    gnl_simfs_file_descriptor_table_put(table, &handle_6, 4);
+    gnl_simfs_file_descriptor_table_put(table, &handle_7, 1);
+    gnl_simfs_file_descriptor_table_put(table, &handle_8, 5);
+    gnl_simfs_file_descriptor_table_put(table, &handle_9, 1);
 
     if (table->size != 9) {
         return -1;
@@ -655,25 +631,87 @@ int can_remove_pid_all() {
         return -1;
     }
 
-    for (size_t i=0; i<=table->max_fd; i++) {
-        if (table->table[i] == NULL) {
+    for (size_t i=0; i<table->used; i++) {
+        if (!table->slab[i].open) {
             continue;
         }
 
-        if (table->table[i]->owner == 1) {
+        if (table->slab[i].fd.owner == 1) {
+            return -1;
+        }
+    }
+
+    gnl_simfs_file_descriptor_table_destroy(table);
+
+    return 0;
+}
+
+int can_reuse_removed() {
+    struct gnl_simfs_file_descriptor_table *table = gnl_simfs_file_descriptor_table_init(3);
+
+    if (table == NULL) {
+        return -1;
+    }
+
+    struct gnl_simfs_inode_handle handle = {0, 1, 1};
+
+    for (int i=0; i<3; i++) {
+        if (gnl_simfs_file_descriptor_table_put(table, &handle, 1) != i) {
             return -1;
         }
     }
 
-    gnl_simfs_inode_destroy(inode_1);
-    gnl_simfs_inode_destroy(inode_2);
-    gnl_simfs_inode_destroy(inode_3);
-    gnl_simfs_inode_destroy(inode_4);
-    gnl_simfs_inode_destroy(inode_5);
-    gnl_simfs_inode_destroy(inode_6);
-    gnl_simfs_inode_destroy(inode_7);
-    gnl_simfs_inode_destroy(inode_8);
-    gnl_simfs_inode_destroy(inode_9);
+    // leave some writes not flushed, the remove discards them
+    struct gnl_simfs_file_descriptor *file_descriptor = gnl_simfs_file_descriptor_table_get(table, 1, 1);
+    if (file_descriptor == NULL) {
+        return -1;
+    }
+
+    int res = gnl_simfs_inode_buffer_write(&(file_descriptor->buffer), GNL_SIMFS_COMPRESSION_NONE, "string", NULL, 6);
+    if (res != 6) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_remove(table, 1, 1) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_remove(table, 0, 1) != 0) {
+        return -1;
+    }
+
+    // the last file descriptor removed is the first reused
+    handle.generation = 2;
+
+    if (gnl_simfs_file_descriptor_table_put(table, &handle, 2) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_put(table, &handle, 2) != 1) {
+        return -1;
+    }
+
+    // the reused file descriptor is a new one
+    file_descriptor = gnl_simfs_file_descriptor_table_get(table, 1, 2);
+    if (file_descriptor == NULL || file_descriptor->handle.generation != 2 || file_descriptor->buffer.chunks != NULL
+        || file_descriptor->buffer.size != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_get(table, 1, 1) != NULL || errno != EPERM) {
+        return -1;
+    }
+
+    // the slab is full
+    if (gnl_simfs_file_descriptor_table_put(table, &handle, 2) != -1 || errno != EMFILE) {
+        return -1;
+    }
+
+    // the writes not flushed of the open file descriptors are discarded with the table
+    res = gnl_simfs_inode_buffer_write(&(file_descriptor->buffer), GNL_SIMFS_COMPRESSION_NONE, "string", NULL, 6);
+    if (res != 6) {
+        return -1;
+    }
 
     gnl_simfs_file_descriptor_table_destroy(table);
 
@@ -699,6 +737,7 @@ int main() {
     gnl_assert(can_remove, "can remove an element from a file descriptor table.");
 
     gnl_assert(can_put_after_remove, "can put an element into a file descriptor table after a remove.");
+    gnl_assert(can_reuse_removed, "can reuse the last element removed from a file descriptor table.");
     gnl_assert(can_remove_all, "can remove all the elements from a file descriptor table.");
     gnl_assert(can_remove_pid_all, "can remove all the elements of a pid from a file descriptor table.");
 
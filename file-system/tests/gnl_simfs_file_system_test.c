@@ -6,7 +6,7 @@
 #include "../src/gnl_simfs_file_system.c"
 
 int can_init_a_filesystem() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -27,7 +27,7 @@ int can_init_a_filesystem() {
 }
 
 int can_open_o_create() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -49,7 +49,7 @@ int can_open_o_create() {
 }
 
 int can_not_open_o_create() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -75,7 +75,7 @@ int can_not_open_o_create() {
 }
 
 int can_not_open_files_limit() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 2, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 2, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -106,7 +106,7 @@ int can_not_open_files_limit() {
 }
 
 int can_not_open_max_files() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 2, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 2, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -139,7 +139,7 @@ int can_not_open_max_files() {
 }
 
 int can_not_open() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -160,7 +160,7 @@ int can_not_open() {
 }
 
 int can_not_open_lock() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -186,7 +186,7 @@ int can_not_open_lock() {
 }
 
 int can_open() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -207,8 +207,58 @@ int can_open() {
     return 0;
 }
 
+int can_fstat() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_LFU, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    int res = gnl_simfs_file_system_open(fs, "/test/file", GNL_SIMFS_O_CREATE, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    int fd = gnl_simfs_file_system_open(fs, "/test/file", 0, 2);
+    if (fd == -1) {
+        return -1;
+    }
+
+    // the file is referenced again after the open of pid 2
+    for (int pid=3; pid<6; pid++) {
+        res = gnl_simfs_file_system_open(fs, "/test/file", 0, pid);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    struct gnl_simfs_stat by_name;
+    struct gnl_simfs_stat by_fd;
+
+    res = gnl_simfs_file_system_stat(fs, "/test/file", &by_name, 2);
+    if (res == -1) {
+        return -1;
+    }
+
+    res = gnl_simfs_file_system_fstat(fs, fd, &by_fd, 2);
+    if (res == -1) {
+        return -1;
+    }
+
+    // the frequency is the current one, not the one of the open
+    if (by_fd.frequency != by_name.frequency || by_fd.frequency != 4) {
+        return -1;
+    }
+
+    free(by_name.name);
+    free(by_fd.name);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
 int can_write() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
@@ -255,103 +305,1166 @@ int can_write() {
     return 0;
 }
 
-int can_not_write_memory_limit() {
+int can_write_buffer() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    int fd = gnl_simfs_file_system_open(fs, "/test/file", GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
+
     long size;
     char *content = NULL;
+    char *expected = NULL;
 
-    int res = gnl_file_to_pointer("./very_big_testfile.txt", &content, &size);
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &size);
     if (res == -1) {
         return -1;
     }
 
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 1, NULL, NULL, GNL_SIMFS_RP_NONE);
+    res = gnl_file_to_pointer("./testfile.txt", &expected, &size);
+    if (res == -1) {
+        return -1;
+    }
 
-    if (fs == NULL) {
+    void *bytes = content;
+
+    res = gnl_simfs_file_system_write_buffer(fs, fd, &bytes, size, 1, NULL);
+    if (res == -1) {
         return -1;
     }
 
-    int fd = gnl_simfs_file_system_open(fs, "/test/file_1", GNL_SIMFS_O_CREATE, 1);
-    if (fd != 0) {
+    // the buffer must be owned by the file system, without copies
+    if (bytes != NULL) {
         return -1;
     }
 
-    res = gnl_simfs_file_system_write(fs, fd, content, size, 1, NULL);
-    if (res != -1) {
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(fs, "/test/file");
+    if (inode->direct_ptr->data != content) {
         return -1;
     }
 
-    if (errno != E2BIG) {
+    void *buf;
+    size_t count;
+
+    res = gnl_simfs_file_system_read(fs, fd, &buf, &count, 1);
+    if (res == -1) {
         return -1;
     }
 
-    free(content);
+    if (size != count) {
+        return -1;
+    }
+
+    if (memcmp(expected, buf, size) != 0) {
+        return -1;
+    }
+
+    free(expected);
+    free(buf);
     gnl_simfs_file_system_destroy(fs);
 
     return 0;
 }
 
-int can_remove_session() {
-    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE);
+int can_write_in_chunks() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
     if (fs == NULL) {
         return -1;
     }
 
-    char *files[13] = {"/test/file_1", "/test/file_2", "/test/file_3"};
+    int fd = gnl_simfs_file_system_open(fs, "/test/file", GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
 
-    int res;
-    for (size_t i=0; i<3; i++) {
-        res = gnl_simfs_file_system_open(fs, files[i], GNL_SIMFS_O_CREATE | GNL_SIMFS_O_LOCK, 1);
-        if (res != i) {
-            return -1;
-        }
+    long size;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
     }
 
-    for (size_t i=0; i<3; i++) {
-        if (gnl_list_search(fs->file_table->presence_list, files[i], compare_string) == 0) {
+    res = gnl_simfs_file_system_write_begin(fs, fd, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    // write the file in three chunks
+    size_t offset = 0;
+    size_t chunk_size = size / 3 + 1;
+
+    while (offset < size) {
+        size_t count = size - offset < chunk_size ? size - offset : chunk_size;
+
+        void *chunk = malloc(count);
+        if (chunk == NULL) {
             return -1;
         }
 
-        struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(fs->file_table, files[i]);
-        if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) == 0) {
+        memcpy(chunk, content + offset, count);
+
+        res = gnl_simfs_file_system_write_chunk(fs, fd, &chunk, count, 1);
+        if (res == -1) {
             return -1;
         }
+
+        free(chunk);
+        offset += count;
     }
 
-    gnl_simfs_file_system_remove_session(fs, 1);
+    // nothing is appended to the file before the end of the write
+    if (fs->monitor->bytes_counter != 0) {
+        return -1;
+    }
 
-    for (size_t i=0; i<3; i++) {
-        struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(fs->file_table, files[i]);
-        if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) > 0) {
+    res = gnl_simfs_file_system_write_end(fs, fd, 1, NULL);
+    if (res == -1) {
+        return -1;
+    }
+
+    void *buf;
+    size_t count;
+
+    res = gnl_simfs_file_system_read(fs, fd, &buf, &count, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    if (size != count || memcmp(content, buf, size) != 0) {
+        return -1;
+    }
+
+    free(buf);
+
+    // read it back in pieces, one per chunk
+    offset = 0;
+    int pieces = 0;
+
+    while (offset < size) {
+        res = gnl_simfs_file_system_read_chunk(fs, fd, offset, chunk_size, &buf, &count, 1);
+        if (res == -1 || count == 0) {
             return -1;
         }
 
-        if (gnl_simfs_file_descriptor_table_get(fs->file_descriptor_table, i, 1) != NULL) {
+        if (memcmp(content + offset, buf, count) != 0) {
             return -1;
         }
+
+        offset += count;
+        pieces++;
+        free(buf);
+    }
+
+    if (pieces != 3) {
+        return -1;
     }
 
+    free(content);
     gnl_simfs_file_system_destroy(fs);
 
     return 0;
 }
 
-int main() {
-    gnl_printf_yellow("> gnl_simfs_file_system test:\n\n");
+int can_discard_a_chunked_write_not_ended() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
 
-    gnl_assert(can_init_a_filesystem, "can init a file system.");
+    if (fs == NULL) {
+        return -1;
+    }
 
-    gnl_assert(can_open_o_create, "can open a new file with GNL_SIMFS_O_CREATE flag.");
-    gnl_assert(can_not_open_o_create, "can not open an existing file with GNL_SIMFS_O_CREATE flag.");
+    int fd = gnl_simfs_file_system_open(fs, "/test/file", GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
 
-    gnl_assert(can_not_open_files_limit, "can not open a new file if the volume is full.");
-    gnl_assert(can_not_open_max_files, "can not open a new file if there are too many open files.");
-    gnl_assert(can_not_open, "can not open a file that does not exists.");
-    gnl_assert(can_not_open_lock, "can not open a file that is locked.");
-    gnl_assert(can_open, "can open a file that exists.");
+    void *chunk = malloc(6);
+    if (chunk == NULL) {
+        return -1;
+    }
 
-    gnl_assert(can_write, "can write (and read) a file."); // this method tests also the read method
-    gnl_assert(can_remove_session, "can remove a session of a pid."); // this method tests also the read method
+    memcpy(chunk, "string", 6);
+
+    int res = gnl_simfs_file_system_write_begin(fs, fd, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    res = gnl_simfs_file_system_write_chunk(fs, fd, &chunk, 6, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    free(chunk);
+
+    // begin again, the previous chunk must be discarded
+    res = gnl_simfs_file_system_write_begin(fs, fd, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    chunk = malloc(5);
+    if (chunk == NULL) {
+        return -1;
+    }
+
+    memcpy(chunk, "bytes", 5);
+
+    res = gnl_simfs_file_system_write_chunk(fs, fd, &chunk, 5, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    free(chunk);
+
+    res = gnl_simfs_file_system_write_end(fs, fd, 1, NULL);
+    if (res == -1) {
+        return -1;
+    }
+
+    void *buf;
+    size_t count;
+
+    res = gnl_simfs_file_system_read(fs, fd, &buf, &count, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    if (count != 5 || memcmp(buf, "bytes", 5) != 0) {
+        return -1;
+    }
+
+    free(buf);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_write_auto_compression() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_AUTO, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    int fd = gnl_simfs_file_system_open(fs, "/test/file", GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
+
+    // random bytes are not compressible, they must be stored as they are
+    char content[4096 + 4096];
+    srand(42);
+    for (size_t i = 0; i < 4096; i++) {
+        content[i] = (char)(rand() % 256);
+    }
+
+    int res = gnl_simfs_file_system_write(fs, fd, content, 4096, 1, NULL);
+    if (res == -1) {
+        return -1;
+    }
+
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(fs, "/test/file");
+    if (inode->direct_ptr->codec != GNL_SIMFS_COMPRESSION_NONE) {
+        return -1;
+    }
+
+    if (fs->monitor->bytes_counter != 4096) {
+        return -1;
+    }
+
+    // a text big enough to pay for the code lengths table must be compressed
+    for (size_t i = 0; i < 4096; i++) {
+        content[4096 + i] = "string"[i % 6];
+    }
+
+    res = gnl_simfs_file_system_write(fs, fd, content + 4096, 4096, 1, NULL);
+    if (res == -1) {
+        return -1;
+    }
+
+    if (inode->last_chunk->codec != GNL_SIMFS_COMPRESSION_HUFFMAN) {
+        return -1;
+    }
+
+    if (fs->monitor->bytes_counter != 4096 + inode->last_chunk->size) {
+        return -1;
+    }
+
+    void *buf;
+    size_t count;
+
+    res = gnl_simfs_file_system_read(fs, fd, &buf, &count, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    if (count != 4096 + 4096) {
+        return -1;
+    }
+
+    if (memcmp(content, buf, count) != 0) {
+        return -1;
+    }
+
+    free(buf);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+static void destroy_evicted_file(void *ptr) {
+    gnl_simfs_evicted_file_destroy(ptr);
+}
+
+int can_evict_lru() {
+    // 1 MB of memory, enough for two files of 400 KB stored raw
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_LRU, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    size_t size = 400 * 1024;
+    char *content = calloc(size, sizeof(char));
+    if (content == NULL) {
+        return -1;
+    }
+
+    char *filenames[3] = {"/test/file_a", "/test/file_b", "/test/file_c"};
+    int fds[3];
+    struct gnl_list_t *evicted_list = NULL;
+    int res;
+
+    for (size_t i=0; i<3; i++) {
+        fds[i] = gnl_simfs_file_system_open(fs, filenames[i], GNL_SIMFS_O_CREATE, 1);
+        if (fds[i] == -1) {
+            return -1;
+        }
+
+        // read the first file before writing the third one,
+        // so the least recently used file is the second one
+        if (i == 2) {
+            void *buf;
+            size_t count;
+
+            res = gnl_simfs_file_system_read(fs, fds[0], &buf, &count, 1);
+            if (res == -1) {
+                return -1;
+            }
+
+            free(buf);
+        }
+
+        res = gnl_simfs_file_system_write(fs, fds[i], content, size, 1, &evicted_list);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    // the second file must be the only evicted one
+    if (evicted_list == NULL || evicted_list->next != NULL) {
+        return -1;
+    }
+
+    struct gnl_simfs_evicted_file *evicted_file = evicted_list->el;
+    if (strcmp(evicted_file->name, filenames[1]) != 0 || evicted_file->count != size) {
+        return -1;
+    }
+
+    // the evicted file is handed over compressed, and decoded on demand
+    if (evicted_file->bytes != NULL || evicted_file->chunks == NULL) {
+        return -1;
+    }
+
+    res = gnl_simfs_evicted_file_decode(evicted_file);
+    if (res == -1 || evicted_file->chunks != NULL || memcmp(evicted_file->bytes, content, size) != 0) {
+        return -1;
+    }
+
+    if (fs->monitor->file_counter != 2) {
+        return -1;
+    }
+
+    gnl_list_destroy(&evicted_list, destroy_evicted_file);
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_evict_many() {
+    // 1 MB of memory, enough for four files of 200 KB stored raw
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_FIFO, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    size_t size = 200 * 1024;
+    char *content = calloc(700 * 1024, sizeof(char));
+    if (content == NULL) {
+        return -1;
+    }
+
+    char *filenames[5] = {"/test/file_a", "/test/file_b", "/test/file_c", "/test/file_d", "/test/file_e"};
+    struct gnl_list_t *evicted_list = NULL;
+    int fd;
+    int res;
+
+    for (size_t i=0; i<5; i++) {
+        fd = gnl_simfs_file_system_open(fs, filenames[i], GNL_SIMFS_O_CREATE, 1);
+        if (fd == -1) {
+            return -1;
+        }
+
+        // the last file needs the space of three files
+        res = gnl_simfs_file_system_write(fs, fd, content, i < 4 ? size : 700 * 1024, 1, &evicted_list);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    // the first three files are evicted by the same write
+    size_t evicted = 0;
+    for (struct gnl_list_t *current = evicted_list; current != NULL; current = current->next) {
+        struct gnl_simfs_evicted_file *evicted_file = current->el;
+
+        if (strcmp(evicted_file->name, filenames[3]) >= 0 || evicted_file->count != size) {
+            return -1;
+        }
+
+        evicted++;
+    }
+
+    if (evicted != 3 || fs->monitor->file_evictions != 3 || fs->monitor->file_counter != 2) {
+        return -1;
+    }
+
+    gnl_list_destroy(&evicted_list, destroy_evicted_file);
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_reclaim() {
+    // 1 MB of memory, four files of 200 KB stored raw fill it up to 78%
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_FIFO, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    size_t size = 200 * 1024;
+    char *content = calloc(size, sizeof(char));
+    if (content == NULL) {
+        return -1;
+    }
+
+    char *filenames[5] = {"/test/file_a", "/test/file_b", "/test/file_c", "/test/file_d", "/test/file_e"};
+    struct gnl_list_t *evicted_list = NULL;
+    int fd;
+    int res;
+
+    for (size_t i=0; i<4; i++) {
+        fd = gnl_simfs_file_system_open(fs, filenames[i], GNL_SIMFS_O_CREATE, 1);
+        if (fd == -1) {
+            return -1;
+        }
+
+        res = gnl_simfs_file_system_write(fs, fd, content, size, 1, &evicted_list);
+        if (res == -1 || evicted_list != NULL) {
+            return -1;
+        }
+    }
+
+    // the low watermark can not be above the high one
+    errno = 0;
+    if (gnl_simfs_file_system_reclaim(fs, 50, 70) != -1 || errno != EINVAL) {
+        return -1;
+    }
+
+    // below the high watermark nothing is evicted
+    if (gnl_simfs_file_system_reclaim(fs, 90, 50) != 0 || fs->monitor->file_evictions != 0) {
+        return -1;
+    }
+
+    // above the high watermark the two oldest files are evicted
+    // to go down to the low watermark
+    if (gnl_simfs_file_system_reclaim(fs, 70, 50) != 2 * size) {
+        return -1;
+    }
+
+    if (fs->monitor->file_evictions != 2 || fs->monitor->file_counter != 2) {
+        return -1;
+    }
+
+    // the evicted files are handed over to the next write
+    fd = gnl_simfs_file_system_open(fs, filenames[4], GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
+
+    res = gnl_simfs_file_system_write(fs, fd, content, 1024, 1, &evicted_list);
+    if (res == -1) {
+        return -1;
+    }
+
+    size_t evicted = 0;
+    for (struct gnl_list_t *current = evicted_list; current != NULL; current = current->next) {
+        struct gnl_simfs_evicted_file *evicted_file = current->el;
+
+        if (strcmp(evicted_file->name, filenames[2]) >= 0 || evicted_file->count != size) {
+            return -1;
+        }
+
+        evicted++;
+    }
+
+    if (evicted != 2) {
+        return -1;
+    }
+
+    gnl_list_destroy(&evicted_list, destroy_evicted_file);
+
+    // the evicted files are handed over only once
+    res = gnl_simfs_file_system_write(fs, fd, content, 1024, 1, &evicted_list);
+    if (res == -1 || evicted_list != NULL) {
+        return -1;
+    }
+
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_reclaim_without_dropping_evicted() {
+    // 1 MB of memory, 100 files of 8 KB stored raw fill it up to 78%
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 1000, NULL, NULL, GNL_SIMFS_RP_FIFO, GNL_SIMFS_COMPRESSION_NONE, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    size_t size = 8 * 1024;
+    char *content = calloc(size, sizeof(char));
+    if (content == NULL) {
+        return -1;
+    }
+
+    char filename[32];
+    char *evicted[200] = {0};
+    struct gnl_list_t *evicted_list = NULL;
+    int fd;
+    int res;
+
+    for (size_t batch=0; batch<2; batch++) {
+        for (size_t i=0; i<100; i++) {
+            sprintf(filename, "/test/file_%zu", batch * 100 + i);
+
+            fd = gnl_simfs_file_system_open(fs, filename, GNL_SIMFS_O_CREATE, 1);
+            if (fd == -1) {
+                return -1;
+            }
+
+            // the parked files are not handed over
+            res = gnl_simfs_file_system_write(fs, fd, content, size, 1, NULL);
+            if (res == -1) {
+                return -1;
+            }
+        }
+
+        // the first reclaim evicts more files than the bound of the queue, the
+        // second one evicts nothing since the files parked are not drained yet
+        if (gnl_simfs_file_system_reclaim(fs, 70, 0) != (batch == 0 ? 100 * size : 0)) {
+            return -1;
+        }
+    }
+
+    if (fs->monitor->file_evictions != 100 || fs->monitor->file_counter != 100) {
+        return -1;
+    }
+
+    // once drained, the reclaim evicts the second batch and the
+    // file of the write that drained the first one
+    char *drain_filenames[2] = {"/test/drain_a", "/test/drain_b"};
+
+    for (size_t i=0; i<2; i++) {
+        fd = gnl_simfs_file_system_open(fs, drain_filenames[i], GNL_SIMFS_O_CREATE, 1);
+        if (fd == -1) {
+            return -1;
+        }
+
+        res = gnl_simfs_file_system_write(fs, fd, content, 1024, 1, &evicted_list);
+        if (res == -1) {
+            return -1;
+        }
+
+        if (i == 0 && gnl_simfs_file_system_reclaim(fs, 70, 0) != 100 * size + 1024) {
+            return -1;
+        }
+    }
+
+    // every evicted file is handed over exactly once
+    for (struct gnl_list_t *current = evicted_list; current != NULL; current = current->next) {
+        struct gnl_simfs_evicted_file *evicted_file = current->el;
+        size_t i;
+
+        if (strcmp(evicted_file->name, drain_filenames[0]) == 0) {
+            continue;
+        }
+
+        if (sscanf(evicted_file->name, "/test/file_%zu", &i) != 1 || i >= 200 || evicted[i] != NULL) {
+            return -1;
+        }
+
+        evicted[i] = evicted_file->name;
+    }
+
+    for (size_t i=0; i<200; i++) {
+        if (evicted[i] == NULL) {
+            return -1;
+        }
+    }
+
+    gnl_list_destroy(&evicted_list, destroy_evicted_file);
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_not_write_memory_limit() {
+    long size;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./very_big_testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
+    }
+
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 1, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    int fd = gnl_simfs_file_system_open(fs, "/test/file_1", GNL_SIMFS_O_CREATE, 1);
+    if (fd != 0) {
+        return -1;
+    }
+
+    res = gnl_simfs_file_system_write(fs, fd, content, size, 1, NULL);
+    if (res != -1) {
+        return -1;
+    }
+
+    if (errno != E2BIG) {
+        return -1;
+    }
+
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+static int compare_string(const void *a, const void *b) {
+    return strcmp(a, b);
+}
+
+int can_remove_session() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    char *files[13] = {"/test/file_1", "/test/file_2", "/test/file_3"};
+
+    int res;
+    for (size_t i=0; i<3; i++) {
+        res = gnl_simfs_file_system_open(fs, files[i], GNL_SIMFS_O_CREATE | GNL_SIMFS_O_LOCK, 1);
+        if (res != i) {
+            return -1;
+        }
+    }
+
+    for (size_t i=0; i<3; i++) {
+        struct gnl_simfs_file_table *file_table = gnl_simfs_rts_get_shard(fs, files[i])->file_table;
+
+        struct gnl_list_t *list = NULL;
+        res = gnl_simfs_rts_shard_list(gnl_simfs_rts_get_shard(fs, files[i]), &list);
+        if (res == -1) {
+            return -1;
+        }
+
+        res = gnl_list_search(list, files[i], compare_string);
+        gnl_list_destroy(&list, free);
+
+        if (res == 0) {
+            return -1;
+        }
+
+        struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(file_table, files[i]);
+        if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) == 0) {
+            return -1;
+        }
+    }
+
+    gnl_simfs_file_system_remove_session(fs, 1, NULL);
+
+    for (size_t i=0; i<3; i++) {
+        struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(gnl_simfs_rts_get_shard(fs, files[i])->file_table, files[i]);
+        if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) > 0) {
+            return -1;
+        }
+
+        if (gnl_simfs_file_descriptor_table_get(fs->file_descriptor_table, i, 1) != NULL) {
+            return -1;
+        }
+    }
+
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_remove_session_despite_a_failure() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    int fd_1 = gnl_simfs_file_system_open(fs, "/test/file_1", GNL_SIMFS_O_CREATE, 1);
+    if (fd_1 == -1) {
+        return -1;
+    }
+
+    int fd_2 = gnl_simfs_file_system_open(fs, "/test/file_2", GNL_SIMFS_O_CREATE | GNL_SIMFS_O_LOCK, 1);
+    if (fd_2 == -1) {
+        return -1;
+    }
+
+    // the first file descriptor of the session can not be closed anymore
+    if (gnl_simfs_file_descriptor_table_remove(fs->file_descriptor_table, fd_1, 1) == -1) {
+        return -1;
+    }
+
+    errno = 0;
+    if (gnl_simfs_file_system_remove_session(fs, 1, NULL) != -1 || errno != EBADF) {
+        return -1;
+    }
+
+    // the other file is closed and unlocked anyway
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(fs, "/test/file_2");
+    if (inode == NULL || gnl_simfs_inode_has_refs(inode) != 0 || gnl_simfs_inode_is_file_locked(inode) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_size(fs->file_descriptor_table) != 0 || fs->session_table->count != 0) {
+        return -1;
+    }
+
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_remove_session_of_closed_files() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    // a file locked and closed, and a file only opened
+    int fd = gnl_simfs_file_system_open(fs, "/test/file_1", GNL_SIMFS_O_CREATE | GNL_SIMFS_O_LOCK, 1);
+    if (fd == -1 || gnl_simfs_file_system_close(fs, fd, 1) == -1) {
+        return -1;
+    }
+
+    fd = gnl_simfs_file_system_open(fs, "/test/file_2", GNL_SIMFS_O_CREATE, 1);
+    if (fd == -1) {
+        return -1;
+    }
+
+    // the closed file is still locked
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(fs, "/test/file_1");
+    if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) != 1) {
+        return -1;
+    }
+
+    struct gnl_list_t *targets = NULL;
+
+    if (gnl_simfs_file_system_remove_session(fs, 1, &targets) == -1) {
+        return -1;
+    }
+
+    if (gnl_simfs_inode_is_file_locked(inode) != 0) {
+        return -1;
+    }
+
+    // both the file unlocked and the file closed are reported
+    if (gnl_list_search(targets, "/test/file_1", compare_string) == 0
+        || gnl_list_search(targets, "/test/file_2", compare_string) == 0) {
+        return -1;
+    }
+
+    gnl_list_destroy(&targets, free);
+
+    inode = gnl_simfs_rts_get_inode(fs, "/test/file_2");
+    if (inode == NULL || gnl_simfs_inode_has_refs(inode) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_descriptor_table_size(fs->file_descriptor_table) != 0) {
+        return -1;
+    }
+
+    // the session is gone, and removing it again is a no-op
+    if (fs->session_table->count != 0 || gnl_simfs_file_system_remove_session(fs, 1, NULL) == -1) {
+        return -1;
+    }
+
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_not_wait_to_lock() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    // pid 1 and pid 2 open the same file
+    int fd_1 = gnl_simfs_file_system_open(fs, "/test/file_1", GNL_SIMFS_O_CREATE, 1);
+    if (fd_1 == -1) {
+        return -1;
+    }
+
+    int fd_2 = gnl_simfs_file_system_open(fs, "/test/file_1", 0, 2);
+    if (fd_2 == -1) {
+        return -1;
+    }
+
+    // the lock of pid 1 does not wait for pid 2 to close the file
+    if (gnl_simfs_file_system_lock(fs, fd_1, 1) != -1 || errno != EBUSY) {
+        return -1;
+    }
+
+    // pid 1 is waiting, so the lock of pid 2 would wait for pid 1 to close the file
+    if (gnl_simfs_file_system_lock(fs, fd_2, 2) != -1 || errno != EDEADLK) {
+        return -1;
+    }
+
+    // and the file can not be opened by other pids
+    if (gnl_simfs_file_system_open(fs, "/test/file_1", 0, 3) != -1 || errno != EBUSY) {
+        return -1;
+    }
+
+    if (gnl_simfs_file_system_close(fs, fd_2, 2) == -1) {
+        return -1;
+    }
+
+    // once pid 2 closed the file, pid 1 can lock it
+    if (gnl_simfs_file_system_lock(fs, fd_1, 1) == -1) {
+        return -1;
+    }
+
+    struct gnl_simfs_inode *inode = gnl_simfs_rts_get_inode(fs, "/test/file_1");
+    if (inode == NULL || gnl_simfs_inode_is_file_locked(inode) != 1 || gnl_simfs_inode_has_pending_locks(inode) != 0) {
+        return -1;
+    }
+
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_read_n() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    // an empty file system reads no files
+    errno = 0;
+    struct gnl_list_t *list = gnl_simfs_file_system_read_n(fs, 0, 1);
+    if (list != NULL || errno != 0) {
+        return -1;
+    }
+
+    char *filenames[3] = {"/test/file_1", "/test/file_2", "/test/file_3"};
+    char *contents[3] = {"content of the first file", "second", "third file"};
+
+    int fd;
+    int res;
+    for (size_t i=0; i<3; i++) {
+        fd = gnl_simfs_file_system_open(fs, filenames[i], GNL_SIMFS_O_CREATE, 1);
+        if (fd == -1) {
+            return -1;
+        }
+
+        res = gnl_simfs_file_system_write(fs, fd, contents[i], strlen(contents[i]), 1, NULL);
+        if (res == -1) {
+            return -1;
+        }
+
+        res = gnl_simfs_file_system_close(fs, fd, 1);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    // n <= 0 reads all the files, with their contents
+    list = gnl_simfs_file_system_read_n(fs, 0, 2);
+    if (list == NULL) {
+        return -1;
+    }
+
+    int count = 0;
+    struct gnl_list_t *current = list;
+    while (current != NULL) {
+        struct gnl_simfs_evicted_file *file = current->el;
+
+        size_t i;
+        for (i=0; i<3; i++) {
+            if (strcmp(file->name, filenames[i]) == 0) {
+                break;
+            }
+        }
+
+        if (i == 3 || file->count != strlen(contents[i]) || memcmp(file->bytes, contents[i], file->count) != 0) {
+            return -1;
+        }
+
+        count++;
+        current = current->next;
+    }
+
+    if (count != 3) {
+        return -1;
+    }
+
+    gnl_list_destroy(&list, destroy_evicted_file);
+
+    // read at most n files
+    list = gnl_simfs_file_system_read_n(fs, 1, 2);
+    if (list == NULL || list->next != NULL) {
+        return -1;
+    }
+
+    gnl_list_destroy(&list, destroy_evicted_file);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int can_shard_files() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(1, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    char filename[32];
+    int res;
+
+    for (size_t i=0; i<64; i++) {
+        sprintf(filename, "/test/file_%zu", i);
+
+        res = gnl_simfs_file_system_open(fs, filename, GNL_SIMFS_O_CREATE, 1);
+        if (res == -1) {
+            return -1;
+        }
+
+        // the file must be stored into its own shard
+        struct gnl_simfs_file_system_shard *shard = gnl_simfs_rts_get_shard(fs, filename);
+        if (shard == NULL || gnl_simfs_file_table_get(shard->file_table, filename) == NULL) {
+            return -1;
+        }
+    }
+
+    // the files must be spread among more than one shard
+    int used_shards = 0;
+    int files = 0;
+    for (size_t i=0; i<fs->shards_count; i++) {
+        int count = gnl_simfs_file_table_count(fs->shards[i].file_table);
+
+        if (count > 0) {
+            used_shards++;
+        }
+
+        files += count;
+    }
+
+    if (used_shards < 2 || files != 64) {
+        return -1;
+    }
+
+    // the listing must contain the files of all the shards
+    struct gnl_list_t *list = gnl_simfs_file_system_ls(fs, 1);
+    files = 0;
+
+    for (struct gnl_list_t *current = list; current != NULL; current = current->next) {
+        files++;
+    }
+
+    gnl_list_destroy(&list, free);
+
+    if (files != 64) {
+        return -1;
+    }
+
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+/**
+ * The arguments of the can_write_concurrently test threads.
+ */
+struct concurrent_write_args {
+    struct gnl_simfs_file_system *fs;
+    char *content;
+    long size;
+    unsigned int pid;
+    int res;
+};
+
+static void *concurrent_write(void *ptr) {
+    struct concurrent_write_args *args = ptr;
+    char filename[32];
+
+    args->res = -1;
+    sprintf(filename, "/test/file_%u", args->pid);
+
+    int fd = gnl_simfs_file_system_open(args->fs, filename, GNL_SIMFS_O_CREATE | GNL_SIMFS_O_LOCK, args->pid);
+    if (fd == -1) {
+        return NULL;
+    }
+
+    for (size_t i=0; i<4; i++) {
+        if (gnl_simfs_file_system_write(args->fs, fd, args->content, args->size, args->pid, NULL) == -1) {
+            return NULL;
+        }
+    }
+
+    void *buf;
+    size_t count;
+
+    if (gnl_simfs_file_system_read(args->fs, fd, &buf, &count, args->pid) == -1) {
+        return NULL;
+    }
+
+    if (count != 4 * args->size || memcmp(buf, args->content, args->size) != 0) {
+        return NULL;
+    }
+
+    free(buf);
+
+    if (gnl_simfs_file_system_close(args->fs, fd, args->pid) == -1) {
+        return NULL;
+    }
+
+    args->res = 0;
+
+    return NULL;
+}
+
+int can_write_concurrently() {
+    struct gnl_simfs_file_system *fs = gnl_simfs_file_system_init(500, 100, NULL, NULL, GNL_SIMFS_RP_NONE, GNL_SIMFS_COMPRESSION_HUFFMAN, 0);
+
+    if (fs == NULL) {
+        return -1;
+    }
+
+    long size;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
+    }
+
+    pthread_t threads[8];
+    struct concurrent_write_args args[8];
+
+    for (size_t i=0; i<8; i++) {
+        args[i].fs = fs;
+        args[i].content = content;
+        args[i].size = size;
+        args[i].pid = i + 1;
+
+        if (pthread_create(&threads[i], NULL, concurrent_write, &args[i]) != 0) {
+            return -1;
+        }
+    }
+
+    for (size_t i=0; i<8; i++) {
+        pthread_join(threads[i], NULL);
+
+        if (args[i].res == -1) {
+            return -1;
+        }
+    }
+
+    // the global accounting must track the files of all the shards
+    if (fs->monitor->file_counter != 8 || fs->reserved_bytes != 0) {
+        return -1;
+    }
+
+    free(content);
+    gnl_simfs_file_system_destroy(fs);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_simfs_file_system test:\n\n");
+
+    gnl_assert(can_init_a_filesystem, "can init a file system.");
+
+    gnl_assert(can_open_o_create, "can open a new file with GNL_SIMFS_O_CREATE flag.");
+    gnl_assert(can_not_open_o_create, "can not open an existing file with GNL_SIMFS_O_CREATE flag.");
+
+    gnl_assert(can_not_open_files_limit, "can not open a new file if the volume is full.");
+    gnl_assert(can_not_open_max_files, "can not open a new file if there are too many open files.");
+    gnl_assert(can_not_open, "can not open a file that does not exists.");
+    gnl_assert(can_not_open_lock, "can not open a file that is locked.");
+    gnl_assert(can_open, "can open a file that exists.");
+    gnl_assert(can_fstat, "can stat an open file with its current frequency.");
+
+    gnl_assert(can_write, "can write (and read) a file."); // this method tests also the read method
+    gnl_assert(can_write_buffer, "can write a buffer handing its ownership over to the file system.");
+    gnl_assert(can_write_in_chunks, "can write a file in chunks appended at once.");
+    gnl_assert(can_discard_a_chunked_write_not_ended, "can discard the chunks of a chunked write never ended.");
+    gnl_assert(can_write_auto_compression, "can write with the auto compression storing incompressible data as it is.");
+    gnl_assert(can_evict_lru, "can evict the least recently used file when the volume is full.");
+    gnl_assert(can_evict_many, "can evict all the files needed by a write in one pass.");
+    gnl_assert(can_reclaim, "can reclaim memory between the watermarks ahead of the writes.");
+    gnl_assert(can_reclaim_without_dropping_evicted, "can reclaim memory without dropping the evicted files.");
+    gnl_assert(can_remove_session, "can remove a session of a pid."); // this method tests also the read method
+    gnl_assert(can_remove_session_of_closed_files, "can remove a session of a pid that closed its locked files.");
+    gnl_assert(can_remove_session_despite_a_failure, "can remove a session of a pid despite a failure.");
+    gnl_assert(can_not_wait_to_lock, "can not wait to lock a file opened by other pids.");
+    gnl_assert(can_read_n, "can read the contents of n files at once.");
+
+    gnl_assert(can_shard_files, "can partition the files among the shards.");
+    gnl_assert(can_write_concurrently, "can write different files concurrently.");
 
     // the following test is heavy for valgrind
     //gnl_assert(can_not_write_memory_limit, "can not write a file if there are no space left on the volume.");
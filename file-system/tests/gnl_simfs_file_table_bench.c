@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <gnl_colorshell.h>
+#include <gnl_ternary_search_tree_t.h>
+#include "../src/gnl_simfs_file_table.c"
+
+// the number of files of the benchmark
+#define BENCH_FILES 100000
+
+// the number of runs of every benchmark
+#define BENCH_RUNS 10
+
+// the maximum length of the benchmark filenames
+#define BENCH_PATH_SIZE 128
+
+/**
+ * Get the elapsed seconds since the given start.
+ *
+ * @param start The start clock.
+ *
+ * @return      Returns the elapsed seconds.
+ */
+static double elapsed(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Look up the given filenames BENCH_RUNS times into the file table
+ * and into a ternary search tree holding the same files, and print
+ * the lookup throughput of both.
+ *
+ * @param name      The name of the benchmark.
+ * @param table     The file table.
+ * @param tree      The ternary search tree.
+ * @param filenames The filenames to look up.
+ * @param expected  The number of filenames expected to be found.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int bench(const char *name, struct gnl_simfs_file_table *table, struct gnl_ternary_search_tree_t *tree,
+                 char **filenames, int expected) {
+    double table_time;
+    double tree_time;
+    int found;
+    clock_t start;
+
+    found = 0;
+    start = clock();
+    for (size_t run=0; run<BENCH_RUNS; run++) {
+        for (size_t i=0; i<BENCH_FILES; i++) {
+            found += gnl_simfs_file_table_get(table, filenames[i]) != NULL;
+        }
+    }
+    table_time = elapsed(start);
+
+    if (found != expected * BENCH_RUNS) {
+        return -1;
+    }
+
+    found = 0;
+    start = clock();
+    for (size_t run=0; run<BENCH_RUNS; run++) {
+        for (size_t i=0; i<BENCH_FILES; i++) {
+            found += gnl_ternary_search_tree_get(tree, filenames[i]) != NULL;
+        }
+    }
+    tree_time = elapsed(start);
+
+    if (found != expected * BENCH_RUNS) {
+        return -1;
+    }
+
+    double lookups = (double)BENCH_FILES * BENCH_RUNS / 1000000;
+
+    printf("%-6s file table %8.2f M/s   ternary search tree %8.2f M/s\n", name, lookups / table_time,
+           lookups / tree_time);
+
+    return 0;
+}
+
+/**
+ * Remove all the given filenames from the file table and from a ternary
+ * search tree holding the same files, and print the remove throughput
+ * of both.
+ *
+ * @param table     The file table.
+ * @param tree      The ternary search tree.
+ * @param filenames The filenames to remove.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int bench_remove(struct gnl_simfs_file_table *table, struct gnl_ternary_search_tree_t *tree,
+                        char **filenames) {
+    double table_time;
+    double tree_time;
+    int res;
+    clock_t start;
+
+    start = clock();
+    for (size_t i=0; i<BENCH_FILES; i++) {
+        res = gnl_simfs_file_table_remove(table, filenames[i]);
+        if (res == -1) {
+            return -1;
+        }
+    }
+    table_time = elapsed(start);
+
+    start = clock();
+    for (size_t i=0; i<BENCH_FILES; i++) {
+        res = gnl_ternary_search_tree_remove(tree, filenames[i], NULL);
+        if (res == -1) {
+            return -1;
+        }
+    }
+    tree_time = elapsed(start);
+
+    if (gnl_simfs_file_table_count(table) != 0 || gnl_simfs_file_table_size(table) != 0) {
+        return -1;
+    }
+
+    double removes = (double)BENCH_FILES / 1000000;
+
+    printf("%-6s file table %8.2f M/s   ternary search tree %8.2f M/s\n", "remove", removes / table_time,
+           removes / tree_time);
+
+    return 0;
+}
+
+/**
+ * Visit an inode doing nothing. It should be passed
+ * to the gnl_simfs_file_table_visit method.
+ *
+ * @param inode The inode visited.
+ * @param arg   Unused.
+ *
+ * @return      Returns always 0.
+ */
+static int visit_inode(struct gnl_simfs_inode *inode, void *arg) {
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_simfs_file_table benchmark:\n\n");
+
+    char **filenames = calloc(BENCH_FILES, sizeof(char *));
+    char **missing = calloc(BENCH_FILES, sizeof(char *));
+    if (filenames == NULL || missing == NULL) {
+        return 1;
+    }
+
+    struct gnl_simfs_file_table *table = gnl_simfs_file_table_init();
+    struct gnl_ternary_search_tree_t *tree = NULL;
+    if (table == NULL) {
+        return 1;
+    }
+
+    int res;
+
+    // paths with long shared prefixes, as in a real directory tree
+    for (size_t i=0; i<BENCH_FILES; i++) {
+        filenames[i] = calloc(BENCH_PATH_SIZE, sizeof(char));
+        missing[i] = calloc(BENCH_PATH_SIZE, sizeof(char));
+        if (filenames[i] == NULL || missing[i] == NULL) {
+            return 1;
+        }
+
+        sprintf(filenames[i], "/home/user/documents/projects/project_%zu/src/file_%zu.c", i % 100, i);
+        sprintf(missing[i], "/home/user/documents/projects/project_%zu/src/file_%zu.h", i % 100, i);
+
+        if (gnl_simfs_file_table_create(table, filenames[i]) == NULL) {
+            return 1;
+        }
+
+        res = gnl_ternary_search_tree_put(&tree, filenames[i], filenames[i]);
+        if (res == -1) {
+            return 1;
+        }
+    }
+
+    res = bench("hit", table, tree, filenames, BENCH_FILES);
+    if (res == -1) {
+        return 1;
+    }
+
+    res = bench("miss", table, tree, missing, 0);
+    if (res == -1) {
+        return 1;
+    }
+
+    // the files are visited walking the contiguous entries
+    size_t cursor = gnl_simfs_file_table_count(table);
+
+    res = gnl_simfs_file_table_visit(table, &cursor, 0, visit_inode, NULL);
+    if (res != BENCH_FILES) {
+        return 1;
+    }
+
+    res = bench_remove(table, tree, filenames);
+    if (res == -1) {
+        return 1;
+    }
+
+    for (size_t i=0; i<BENCH_FILES; i++) {
+        free(filenames[i]);
+        free(missing[i]);
+    }
+
+    free(filenames);
+    free(missing);
+    gnl_ternary_search_tree_destroy(&tree, NULL);
+    gnl_simfs_file_table_destroy(table);
+
+    printf("\n");
+
+    return 0;
+}
+
+#undef BENCH_FILES
+#undef BENCH_RUNS
+#undef BENCH_PATH_SIZE
@@ -12,11 +12,11 @@ int can_init_a_ft() {
         return -1;
     }
 
-    if (table->table != NULL) {
+    if (table->slots != NULL || table->capacity != 0) {
         return -1;
     }
 
-    if (table->presence_list != NULL) {
+    if (table->entries != NULL || table->entries_capacity != 0) {
         return -1;
     }
 
@@ -173,12 +173,9 @@ int can_fflush() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_inode_copy(inode);
-    if (inode_copy == NULL) {
-        return -1;
-    }
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
-    res = gnl_simfs_inode_write(inode_copy, content, size);
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
@@ -187,7 +184,7 @@ int can_fflush() {
         return -1;
     }
 
-    res = gnl_simfs_file_table_fflush(table, inode_copy);
+    res = gnl_simfs_file_table_fflush(table, inode, &buffer);
     if (res == -1) {
         return -1;
     }
@@ -197,7 +194,6 @@ int can_fflush() {
     }
 
     free(content);
-    gnl_simfs_inode_copy_destroy(inode_copy);
     gnl_simfs_file_table_destroy(table);
 
     return 0;
@@ -218,30 +214,86 @@ int can_not_fflush() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode = gnl_simfs_file_table_create(table, "test");
+    // an inode not residing into the table
+    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
     if (inode == NULL) {
         return -1;
     }
 
-    res = gnl_simfs_inode_write(inode, content, size);
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
+
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
 
-    if (gnl_simfs_file_table_size(table) > 0) {
+    res = gnl_simfs_file_table_fflush(table, inode, &buffer);
+    if (res == 0) {
         return -1;
     }
 
-    res = gnl_simfs_file_table_fflush(table, inode);
-    if (res == 0) {
+    if (errno != ENOENT) {
         return -1;
     }
 
-    if (errno != EINVAL) {
+    if (gnl_simfs_file_table_size(table) > 0) {
         return -1;
     }
 
     free(content);
+    gnl_simfs_inode_buffer_clear(&buffer);
+    gnl_simfs_inode_destroy(inode);
+    gnl_simfs_file_table_destroy(table);
+
+    return 0;
+}
+
+int can_get_by_handle() {
+    struct gnl_simfs_file_table *table = gnl_simfs_file_table_init();
+    if (table == NULL) {
+        return -1;
+    }
+
+    struct gnl_simfs_inode *inode = gnl_simfs_file_table_create(table, "test");
+    if (inode == NULL) {
+        return -1;
+    }
+
+    struct gnl_simfs_inode_handle handle;
+    gnl_simfs_file_table_handle(inode, &handle);
+
+    if (gnl_simfs_file_table_get_by_handle(table, &handle) != inode) {
+        return -1;
+    }
+
+    int res = gnl_simfs_file_table_remove(table, "test");
+    if (res == -1) {
+        return -1;
+    }
+
+    // the handle of a removed inode is not resolved
+    errno = 0;
+    if (gnl_simfs_file_table_get_by_handle(table, &handle) != NULL || errno != ENOENT) {
+        return -1;
+    }
+
+    // not even to a new inode with the same name
+    inode = gnl_simfs_file_table_create(table, "test");
+    if (inode == NULL) {
+        return -1;
+    }
+
+    errno = 0;
+    if (gnl_simfs_file_table_get_by_handle(table, &handle) != NULL || errno != ENOENT) {
+        return -1;
+    }
+
+    gnl_simfs_file_table_handle(inode, &handle);
+
+    if (gnl_simfs_file_table_get_by_handle(table, &handle) != inode) {
+        return -1;
+    }
+
     gnl_simfs_file_table_destroy(table);
 
     return 0;
@@ -283,17 +335,14 @@ int can_remove() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_inode_copy(inode);
-    if (inode_copy == NULL) {
-        return -1;
-    }
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
-    res = gnl_simfs_inode_write(inode_copy, content, size);
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_table_fflush(table, inode_copy);
+    res = gnl_simfs_file_table_fflush(table, inode, &buffer);
     if (res == -1) {
         return -1;
     }
@@ -320,7 +369,6 @@ int can_remove() {
     }
 
     free(content);
-    gnl_simfs_inode_copy_destroy(inode_copy);
     gnl_simfs_file_table_destroy(table);
 
     return 0;
@@ -346,6 +394,89 @@ int can_not_remove() {
     return 0;
 }
 
+/**
+ * The arguments of the visitor of the tests.
+ */
+struct visit_args {
+    struct gnl_simfs_file_table *table;
+    int visited;
+    int missing;
+};
+
+static int visit_inode(struct gnl_simfs_inode *inode, void *arg) {
+    struct visit_args *args = arg;
+
+    args->visited++;
+
+    // every inode visited is reachable from its name
+    if (gnl_simfs_file_table_get(args->table, inode->name) != inode) {
+        args->missing++;
+    }
+
+    return 0;
+}
+
+int can_grow_and_remove_many() {
+    struct gnl_simfs_file_table *table = gnl_simfs_file_table_init();
+    if (table == NULL) {
+        return -1;
+    }
+
+    char filename[64];
+
+    // many more files than the initial capacity, to grow the index
+    for (int i=0; i<1000; i++) {
+        sprintf(filename, "/a/rather/long/path/shared/by/every/file/file_%d", i);
+
+        if (gnl_simfs_file_table_create(table, filename) == NULL) {
+            return -1;
+        }
+    }
+
+    // remove the even files
+    for (int i=0; i<1000; i+=2) {
+        sprintf(filename, "/a/rather/long/path/shared/by/every/file/file_%d", i);
+
+        if (gnl_simfs_file_table_remove(table, filename) == -1) {
+            return -1;
+        }
+    }
+
+    if (gnl_simfs_file_table_count(table) != 500) {
+        return -1;
+    }
+
+    // the odd files are still reachable, the even ones are not
+    for (int i=0; i<1000; i++) {
+        sprintf(filename, "/a/rather/long/path/shared/by/every/file/file_%d", i);
+
+        struct gnl_simfs_inode *inode = gnl_simfs_file_table_get(table, filename);
+        if ((i % 2 == 0) != (inode == NULL)) {
+            return -1;
+        }
+
+        if (inode != NULL && strcmp(inode->name, filename) != 0) {
+            return -1;
+        }
+    }
+
+    // the visit walks only the remaining files
+    struct visit_args args = {table, 0, 0};
+    size_t cursor = gnl_simfs_file_table_count(table);
+
+    if (gnl_simfs_file_table_visit(table, &cursor, 0, visit_inode, &args) != 500 || cursor != 0) {
+        return -1;
+    }
+
+    if (args.visited != 500 || args.missing != 0) {
+        return -1;
+    }
+
+    gnl_simfs_file_table_destroy(table);
+
+    return 0;
+}
+
 int can_get_size() {
     int res;
     long size;
@@ -366,17 +497,14 @@ int can_get_size() {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_inode_copy(inode);
-    if (inode_copy == NULL) {
-        return -1;
-    }
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
-    res = gnl_simfs_inode_write(inode_copy, content, size);
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_file_table_fflush(table, inode_copy);
+    res = gnl_simfs_file_table_fflush(table, inode, &buffer);
     if (res == -1) {
         return -1;
     }
@@ -386,7 +514,6 @@ int can_get_size() {
     }
 
     free(content);
-    gnl_simfs_inode_copy_destroy(inode_copy);
     gnl_simfs_file_table_destroy(table);
 
     return 0;
@@ -421,9 +548,23 @@ int can_get_count() {
     return 0;
 }
 
-int can_get_list() {
+static int visit_name(struct gnl_simfs_inode *inode, void *arg) {
+    char **names = arg;
+
+    // store the name into the first free position
+    while (*names != NULL) {
+        names++;
+    }
+
+    *names = inode->name;
+
+    // stop the visit on the third file
+    return strcmp(inode->name, "test3") == 0;
+}
+
+int can_visit() {
     struct gnl_simfs_file_table *table = gnl_simfs_file_table_init();
-    if (table == NULL || table->presence_list != NULL) {
+    if (table == NULL || table->entries != NULL) {
         return -1;
     }
 
@@ -433,27 +574,48 @@ int can_get_list() {
     gnl_simfs_file_table_create(table, "test4");
     gnl_simfs_file_table_create(table, "test5");
 
-    struct gnl_list_t *list = gnl_simfs_file_table_list(table);
+    char *names[6] = {NULL};
+    size_t cursor = gnl_simfs_file_table_count(table);
 
-    char *expected = malloc(6 * sizeof(char));
-    if (expected == NULL) {
+    // the entries are visited backwards, in place
+    int res = gnl_simfs_file_table_visit(table, &cursor, 2, visit_name, names);
+    if (res != 2 || cursor != 3) {
         return -1;
     }
 
-    int i=1;
-    struct gnl_list_t *current = list;
-    while (current != NULL) {
-        sprintf(expected, "%s%d", "test", i++);
+    if (strcmp(names[0], "test5") != 0 || strcmp(names[1], "test4") != 0) {
+        return -1;
+    }
 
-        if (strcmp(expected, current->el) != 0) {
-            return -1;
-        }
+    if (names[0] != gnl_simfs_file_table_get(table, "test5")->name) {
+        return -1;
+    }
+
+    // the visitor stops the visit
+    res = gnl_simfs_file_table_visit(table, &cursor, 0, visit_name, names);
+    if (res != 1 || cursor != 2 || strcmp(names[2], "test3") != 0) {
+        return -1;
+    }
+
+    // remove a file not visited yet between two pages, the
+    // last entry is moved under the cursor and visited again
+    gnl_simfs_file_table_remove(table, "test1");
 
-        current = current->next;
+    res = gnl_simfs_file_table_visit(table, &cursor, 0, visit_name, names);
+    if (res != 2 || cursor != 0) {
+        return -1;
+    }
+
+    if (strcmp(names[3], "test2") != 0 || strcmp(names[4], "test5") != 0) {
+        return -1;
+    }
+
+    // a visit over is over
+    res = gnl_simfs_file_table_visit(table, &cursor, 0, visit_name, names);
+    if (res != 0 || cursor != 0) {
+        return -1;
     }
 
-    free(expected);
-    gnl_list_destroy(&list, free);
     gnl_simfs_file_table_destroy(table);
 
     return 0;
@@ -470,15 +632,19 @@ int main() {
     gnl_assert(can_get, "can get an entry from a file table.");
     gnl_assert(can_not_get, "can not get a non-existing entry from a file table.");
 
-    gnl_assert(can_fflush, "can flush an entry with an entry copy in a file table.");
-    gnl_assert(can_not_fflush, "can not flush an entry with the original entry in a file table.");
+    gnl_assert(can_fflush, "can flush a buffer into an entry of a file table.");
+    gnl_assert(can_not_fflush, "can not flush a buffer into an entry not present in a file table.");
+
+    gnl_assert(can_get_by_handle, "can get an entry by handle only while it is present in a file table.");
 
     gnl_assert(can_remove, "can remove an entry from a file table.");
     gnl_assert(can_not_remove, "can not remove a non-existing entry from a file table.");
 
+    gnl_assert(can_grow_and_remove_many, "can grow a file table and remove many entries from it.");
+
     gnl_assert(can_get_size, "can get the size in bytes of a file table.");
     gnl_assert(can_get_count, "can get the number of files present into a file table.");
-    gnl_assert(can_get_list, "can get the list of files present into a file table.");
+    gnl_assert(can_visit, "can visit in place the files present into a file table.");
 
     // the gnl_simfs_file_table_destroy method is implicitly tested in every assertion
 
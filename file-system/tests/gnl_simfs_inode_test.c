@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <stddef.h>
 #include <gnl_colorshell.h>
 #include <gnl_file_to_pointer.h>
 #include <gnl_huffman_tree.h>
@@ -42,11 +43,11 @@ int can_init_an_inode() {
         return -1;
     }
 
-    if (inode->reference_count != 0) {
+    if (gnl_simfs_inode_reference_count(inode) != 0) {
         return -1;
     }
 
-    if (inode->reference_list != NULL) {
+    if (inode->refs_size != 0 || inode->refs_spill != NULL) {
         return -1;
     }
 
@@ -58,15 +59,7 @@ int can_init_an_inode() {
         return -1;
     }
 
-    if (inode->pending_locks != 0) {
-        return -1;
-    }
-
-    if (inode->buffer != NULL) {
-        return -1;
-    }
-
-    if (inode->buffer_size != 0) {
+    if (inode->pending_lock != 0) {
         return -1;
     }
 
@@ -201,7 +194,7 @@ int can_increase_refs() {
         return -1;
     }
 
-    if (inode->reference_count != 0) {
+    if (gnl_simfs_inode_reference_count(inode) != 0) {
         return -1;
     }
 
@@ -213,7 +206,12 @@ int can_increase_refs() {
         }
     }
 
-    if (inode->reference_count != 13) {
+    if (gnl_simfs_inode_reference_count(inode) != 13) {
+        return -1;
+    }
+
+    // the references of the same pid are counted once
+    if (inode->refs_size != 1 || inode->refs_spill != NULL) {
         return -1;
     }
 
@@ -237,11 +235,11 @@ int can_decrease_refs() {
         }
     }
 
-    if (inode->reference_count != 13) {
+    if (gnl_simfs_inode_reference_count(inode) != 13) {
         return -1;
     }
 
-    if (inode->reference_list == NULL) {
+    if (inode->refs_size != 13 || inode->refs_spill == NULL) {
         return -1;
     }
 
@@ -252,7 +250,11 @@ int can_decrease_refs() {
         }
     }
 
-    if (inode->reference_count != 0) {
+    if (gnl_simfs_inode_reference_count(inode) != 0) {
+        return -1;
+    }
+
+    if (inode->refs_size != 0 || inode->refs_spill != NULL) {
         return -1;
     }
 
@@ -273,7 +275,7 @@ int can_not_decrease_refs() {
         return -1;
     }
 
-    if (inode->reference_count != 0) {
+    if (gnl_simfs_inode_reference_count(inode) != 0) {
         return -1;
     }
 
@@ -291,7 +293,7 @@ int can_not_decrease_refs() {
         return -1;
     }
 
-    if (inode->reference_count != 1) {
+    if (gnl_simfs_inode_reference_count(inode) != 1) {
         return -1;
     }
 
@@ -385,26 +387,71 @@ int can_not_check_pid_refs() {
     return 0;
 }
 
-int can_increase_pending_locks() {
+int can_track_refs_by_owner() {
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
 
     if (inode == NULL) {
         return -1;
     }
 
-    if (inode->pending_locks != 0) {
+    // 3 references of pid 1, 1 of pid 2 and 2 of pid 3
+    unsigned int pids[] = {1, 2, 1, 3, 1, 3};
+    int res;
+
+    for (size_t i=0; i<6; i++) {
+        res = gnl_simfs_inode_increase_refs(inode, pids[i]);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    if (gnl_simfs_inode_reference_count(inode) != 6 || inode->refs_size != 3) {
         return -1;
     }
 
-    int res;
-    for (size_t i=0; i<13; i++) {
-        res = gnl_simfs_inode_increase_pending_locks(inode);
+    // the third owner does not fit within the inode
+    if (inode->refs_spill == NULL) {
+        return -1;
+    }
+
+    res = gnl_simfs_inode_decrease_refs(inode, 2);
+    if (res == -1) {
+        return -1;
+    }
+
+    // pid 2 has no references anymore
+    if (gnl_simfs_inode_has_other_pid_refs(inode, 2) != -1 || errno != EPERM) {
+        return -1;
+    }
+
+    if (gnl_simfs_inode_has_other_pid_refs(inode, 1) != 1) {
+        return -1;
+    }
+
+    for (size_t i=0; i<2; i++) {
+        res = gnl_simfs_inode_decrease_refs(inode, 3);
+        if (res == -1) {
+            return -1;
+        }
+    }
+
+    // pid 1 is now the only owner
+    if (gnl_simfs_inode_reference_count(inode) != 3 || inode->refs_size != 1) {
+        return -1;
+    }
+
+    if (gnl_simfs_inode_has_other_pid_refs(inode, 1) != 0) {
+        return -1;
+    }
+
+    for (size_t i=0; i<3; i++) {
+        res = gnl_simfs_inode_decrease_refs(inode, 1);
         if (res == -1) {
             return -1;
         }
     }
 
-    if (inode->pending_locks != 13) {
+    if (gnl_simfs_inode_reference_count(inode) != 0 || inode->refs_size != 0 || inode->refs_spill != NULL) {
         return -1;
     }
 
@@ -413,33 +460,56 @@ int can_increase_pending_locks() {
     return 0;
 }
 
-int can_decrease_pending_locks() {
+int hot_fields_fit_a_cache_line() {
+    return offsetof(struct gnl_simfs_inode, refs_capacity) + sizeof(unsigned short) <= 64 ? 0 : -1;
+}
+
+int can_set_pending_lock() {
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
 
     if (inode == NULL) {
         return -1;
     }
 
-    int res;
-    for (size_t i=0; i<13; i++) {
-        res = gnl_simfs_inode_increase_pending_locks(inode);
+    if (inode->pending_lock != 0) {
+        return -1;
+    }
+
+    // the same pid can be set more times
+    for (size_t i=0; i<2; i++) {
+        int res = gnl_simfs_inode_set_pending_lock(inode, 1);
         if (res == -1) {
             return -1;
         }
     }
 
-    if (inode->pending_locks != 13) {
+    if (inode->pending_lock != 1) {
         return -1;
     }
 
-    for (size_t i=0; i<13; i++) {
-        res = gnl_simfs_inode_decrease_pending_locks(inode);
-        if (res == -1) {
-            return -1;
-        }
+    gnl_simfs_inode_destroy(inode);
+
+    return 0;
+}
+
+int can_not_set_pending_lock_different_pid() {
+    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+
+    if (inode == NULL) {
+        return -1;
     }
 
-    if (inode->pending_locks != 0) {
+    int res = gnl_simfs_inode_set_pending_lock(inode, 1);
+    if (res == -1) {
+        return -1;
+    }
+
+    res = gnl_simfs_inode_set_pending_lock(inode, 2);
+    if (res != -1 || errno != EDEADLK) {
+        return -1;
+    }
+
+    if (inode->pending_lock != 1) {
         return -1;
     }
 
@@ -448,23 +518,26 @@ int can_decrease_pending_locks() {
     return 0;
 }
 
-int can_not_decrease_pending_locks() {
+int can_clear_pending_lock() {
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
 
     if (inode == NULL) {
         return -1;
     }
 
-    int res = gnl_simfs_inode_decrease_pending_locks(inode);
-    if (res != -1) {
+    int res = gnl_simfs_inode_set_pending_lock(inode, 1);
+    if (res == -1) {
         return -1;
     }
 
-    if (inode->pending_locks != 0) {
+    // a different pid does not clear the pending lock
+    res = gnl_simfs_inode_clear_pending_lock(inode, 2);
+    if (res == -1 || inode->pending_lock != 1) {
         return -1;
     }
 
-    if (errno != EPERM) {
+    res = gnl_simfs_inode_clear_pending_lock(inode, 1);
+    if (res == -1 || inode->pending_lock != 0) {
         return -1;
     }
 
@@ -485,13 +558,13 @@ int can_check_pending_locks() {
         return -1;
     }
 
-    res = gnl_simfs_inode_increase_pending_locks(inode);
+    res = gnl_simfs_inode_set_pending_lock(inode, 13);
     if (res == -1) {
         return -1;
     }
 
     res = gnl_simfs_inode_has_pending_locks(inode);
-    if (res != 1) {
+    if (res != 13) {
         return -1;
     }
 
@@ -501,7 +574,7 @@ int can_check_pending_locks() {
 }
 
 int can_write() {
-    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
     long size;
     char *content = NULL;
@@ -511,29 +584,32 @@ int can_write() {
         return -1;
     }
 
-    time_t start_time = time(NULL);
-
-    res = gnl_simfs_inode_write(inode, content, size);
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
 
-    time_t end_time = time(NULL);
+    if (buffer.chunks == NULL) {
+        return -1;
+    }
 
-    if (inode->ctime < start_time || inode->ctime > end_time) {
+    // the buffer contains the compressed bytes
+    struct gnl_huffman_tree_artifact *artifact = gnl_huffman_tree_encode(content, size);
+    if (artifact == NULL) {
         return -1;
     }
 
-    if (inode->buffer == NULL) {
+    if (buffer.size != gnl_huffman_tree_size(artifact)) {
         return -1;
     }
 
-    if (inode->buffer_size != size) {
+    if (buffer.chunks->count != size) {
         return -1;
     }
 
+    gnl_huffman_tree_destroy_artifact(artifact);
+    gnl_simfs_inode_buffer_clear(&buffer);
     free(content);
-    gnl_simfs_inode_destroy(inode);
 
     return 0;
 }
@@ -549,12 +625,14 @@ int can_read() {
         return -1;
     }
 
-    res = gnl_simfs_inode_write(inode, content, size);
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
+
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
     if (res == -1) {
         return -1;
     }
 
-    res = gnl_simfs_inode_fflush(inode);
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
     if (res == -1) {
         return -1;
     }
@@ -600,66 +678,141 @@ int can_read() {
     return 0;
 }
 
-int can_copy() {
+int can_read_chunk() {
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
 
-    inode->mtime = time(NULL);
-    int res = gnl_simfs_inode_write(inode, "string", 6);
+    long size;
+    char *content = NULL;
+
+    int res = gnl_file_to_pointer("./testfile.txt", &content, &size);
     if (res == -1) {
         return -1;
     }
 
-    struct gnl_simfs_inode *inode_copy = gnl_simfs_inode_copy(inode);
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
-    if (inode_copy->btime != inode->btime) {
+    // a compressed chunk followed by a chunk stored as it is
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, NULL, size);
+    if (res == -1) {
         return -1;
     }
 
-    if (inode_copy->mtime != inode->mtime) {
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_NONE, content, NULL, size);
+    if (res == -1) {
         return -1;
     }
 
-    if (inode_copy->atime != inode->atime) {
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
+    if (res == -1) {
         return -1;
     }
 
-    if (inode_copy->ctime < inode->ctime) {
+    char *file = malloc(2 * size);
+    if (file == NULL) {
         return -1;
     }
 
-    if (inode_copy->size != inode->size) {
-        return -1;
+    void *buf = NULL;
+    size_t count;
+    size_t offset = 0;
+
+    while (offset < 2 * size) {
+        res = gnl_simfs_inode_read_chunk(inode, offset, 100, &buf, &count);
+        if (res == -1 || count == 0) {
+            return -1;
+        }
+
+        // every piece is at most max bytes long, even of a compressed chunk
+        if (count > 100) {
+            return -1;
+        }
+
+        memcpy(file + offset, buf, count);
+        offset += count;
+        free(buf);
     }
 
-    if (strcmp(inode_copy->name, inode->name) != 0) {
+    if (memcmp(file, content, size) != 0 || memcmp(file + size, content, size) != 0) {
         return -1;
     }
 
-    if (inode_copy->direct_ptr != inode->direct_ptr) {
+    // past the end of the file
+    res = gnl_simfs_inode_read_chunk(inode, offset, 100, &buf, &count);
+    if (res == -1 || count != 0 || buf != NULL) {
         return -1;
     }
 
-    if (inode_copy->locked != inode->locked) {
+    free(file);
+    free(content);
+    gnl_simfs_inode_destroy(inode);
+
+    return 0;
+}
+
+int can_split_big_writes() {
+    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+
+    size_t size = 2 * GNL_SIMFS_INODE_CHUNK_MAX_COUNT + 10;
+    char *content = malloc(size);
+    if (content == NULL) {
         return -1;
     }
 
-    if (inode_copy->reference_count != inode->reference_count) {
+    for (size_t i=0; i<size; i++) {
+        content[i] = (char)('a' + i % 7);
+    }
+
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
+    void *owned = content;
+
+    int res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, content, &owned, size);
+    if (res != size || owned != content) {
         return -1;
     }
 
-    if (inode_copy->pending_locks != inode->pending_locks) {
+    // the bytes are split into bounded chunks
+    size_t chunks = 0;
+    for (struct gnl_simfs_inode_chunk *chunk = buffer.chunks; chunk != NULL; chunk = chunk->next) {
+        if (chunk->count > GNL_SIMFS_INODE_CHUNK_MAX_COUNT) {
+            return -1;
+        }
+
+        chunks++;
+    }
+
+    if (chunks != 3) {
         return -1;
     }
 
-    if (inode_copy->buffer != NULL) {
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
+    if (res == -1) {
         return -1;
     }
 
-    if (inode_copy->buffer_size != 0) {
+    // every chunk is read as a whole piece
+    void *buf = NULL;
+    size_t count;
+    size_t offset = 0;
+
+    while (offset < size) {
+        res = gnl_simfs_inode_read_chunk(inode, offset, GNL_SIMFS_INODE_CHUNK_MAX_COUNT, &buf, &count);
+        if (res == -1 || count == 0 || count > GNL_SIMFS_INODE_CHUNK_MAX_COUNT) {
+            return -1;
+        }
+
+        if (memcmp(buf, content + offset, count) != 0) {
+            return -1;
+        }
+
+        offset += count;
+        free(buf);
+    }
+
+    if (offset != size) {
         return -1;
     }
 
-    gnl_simfs_inode_copy_destroy(inode_copy);
+    free(content);
     gnl_simfs_inode_destroy(inode);
 
     return 0;
@@ -667,10 +820,11 @@ int can_copy() {
 
 int can_fflush() {
     struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
 
     time_t now = time(NULL);
 
-    int res = gnl_simfs_inode_write(inode, "string", 6);
+    int res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, "string", NULL, 6);
     if (res <= 0) {
         return -1;
     }
@@ -688,7 +842,7 @@ int can_fflush() {
         return -1;
     }
 
-    res = gnl_simfs_inode_fflush(inode);
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
     if (res != 0) {
         return -1;
     }
@@ -725,12 +879,18 @@ int can_fflush() {
         return -1;
     }
 
-    res = gnl_simfs_inode_write(inode, "anotherstring", 13);
+    free(bytes);
+
+    // every write is compressed into its own chunk, so the
+    // already flushed chunks are not compressed again
+    struct gnl_simfs_inode_chunk *first_chunk = inode->direct_ptr;
+
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, "anotherstring", NULL, 13);
     if (res <= 0) {
         return -1;
     }
 
-    res = gnl_simfs_inode_write(inode, "thefinalstring", 14);
+    res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, "thefinalstring", NULL, 14);
     if (res <= 0) {
         return -1;
     }
@@ -739,34 +899,53 @@ int can_fflush() {
         return -1;
     }
 
-    artifact = gnl_huffman_tree_encode("stringanotherstringthefinalstring", 33);
+    artifact = gnl_huffman_tree_encode("anotherstring", 13);
+    if (artifact == NULL) {
+        return -1;
+    }
+
+    artifact_size += gnl_huffman_tree_size(artifact);
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    artifact = gnl_huffman_tree_encode("thefinalstring", 14);
     if (artifact == NULL) {
         return -1;
     }
 
-    res = gnl_simfs_inode_fflush(inode);
+    artifact_size += gnl_huffman_tree_size(artifact);
+    gnl_huffman_tree_destroy_artifact(artifact);
+
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
     if (res != 0) {
         return -1;
     }
 
-    if (inode->size != gnl_huffman_tree_size(artifact)) {
+    if (inode->size != artifact_size) {
         return -1;
     }
 
-    free(bytes);
+    if (inode->direct_ptr != first_chunk) {
+        return -1;
+    }
 
-    res = gnl_huffman_tree_decode(artifact, (void *)&bytes, &count);
+    if (inode->last_chunk == first_chunk || inode->last_chunk->next != NULL) {
+        return -1;
+    }
+
+    if (buffer.chunks != NULL || buffer.size != 0) {
+        return -1;
+    }
+
+    res = gnl_simfs_inode_read(inode, (void **)&bytes, &count);
     if (res != 0) {
         return -1;
     }
 
-    tmp = realloc(bytes, count + 1);
-    if (tmp == NULL) {
+    if (count != 33) {
         return -1;
     }
-    bytes = tmp;
-    bytes[count] = '\0';
-    if (strcmp(bytes, "stringanotherstringthefinalstring") != 0) {
+
+    if (memcmp(bytes, "stringanotherstringthefinalstring", 33) != 0) {
         return -1;
     }
 
@@ -776,10 +955,40 @@ int can_fflush() {
     return 0;
 }
 
+int can_clear_buffer() {
+    struct gnl_simfs_inode *inode = gnl_simfs_inode_init("test");
+    struct gnl_simfs_inode_buffer buffer = {NULL, 0};
+
+    int res = gnl_simfs_inode_buffer_write(&buffer, GNL_SIMFS_COMPRESSION_HUFFMAN, "string", NULL, 6);
+    if (res <= 0) {
+        return -1;
+    }
+
+    gnl_simfs_inode_buffer_clear(&buffer);
+
+    if (buffer.chunks != NULL || buffer.size != 0) {
+        return -1;
+    }
+
+    res = gnl_simfs_inode_fflush_buffer(inode, &buffer);
+    if (res != 0) {
+        return -1;
+    }
+
+    if (inode->direct_ptr != NULL || inode->size != 0) {
+        return -1;
+    }
+
+    gnl_simfs_inode_destroy(inode);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_simfs_inode test:\n\n");
 
     gnl_assert(can_init_an_inode, "can init an inode.");
+    gnl_assert(hot_fields_fit_a_cache_line, "can fit the hot attributes of an inode in a cache line.");
 
     gnl_assert(can_lock, "can lock a file within an inode.");
     gnl_assert(can_not_lock_different_pid, "can not lock a not-owned file within an inode.");
@@ -794,16 +1003,20 @@ int main() {
     gnl_assert(can_not_check_pid_refs, "can not check if an inode has any other pid references besides the given "
                                        "pid if the given pid is not present into the reference list.");
 
-    gnl_assert(can_increase_pending_locks, "can increase an inode pending locks.");
-    gnl_assert(can_decrease_pending_locks, "can decrease an inode pending locks.");
-    gnl_assert(can_not_decrease_pending_locks, "can not decrease an inode pending locks if it was not previously increased.");
+    gnl_assert(can_track_refs_by_owner, "can track the references of an inode by owner.");
+
+    gnl_assert(can_set_pending_lock, "can set the pid waiting to lock a file within an inode.");
+    gnl_assert(can_not_set_pending_lock_different_pid, "can not set a pid waiting to lock a file within an inode if another pid is waiting.");
+    gnl_assert(can_clear_pending_lock, "can clear the pid waiting to lock a file within an inode.");
     gnl_assert(can_check_pending_locks, "can check if an inode has pending locks.");
 
-    gnl_assert(can_write, "can write bytes into the file within an inode.");
+    gnl_assert(can_write, "can write bytes into a buffer of a file.");
     gnl_assert(can_read, "can read from the file within an inode.");
+    gnl_assert(can_read_chunk, "can read the file within an inode in pieces.");
+    gnl_assert(can_split_big_writes, "can split the big writes into bounded chunks.");
 
-    gnl_assert(can_copy, "can get a copy of an inode.");
-    gnl_assert(can_fflush, "can fflush an inode.");
+    gnl_assert(can_fflush, "can fflush a buffer into an inode.");
+    gnl_assert(can_clear_buffer, "can clear a buffer of a file.");
 
     // the gnl_simfs_inode_destroy method is implicitly tested in every assertion
 
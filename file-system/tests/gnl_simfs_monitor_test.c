@@ -362,6 +362,27 @@ int can_add_evictions() {
     return 0;
 }
 
+int can_add_hits_and_misses() {
+    struct gnl_simfs_monitor *monitor = gnl_simfs_monitor_init();
+    if (monitor == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_monitor_file_hit(monitor) != 0 || gnl_simfs_monitor_file_missed(monitor) != 0) {
+        return -1;
+    }
+
+    gnl_simfs_monitor_file_hit(monitor);
+
+    if (monitor->file_hits != 2 || monitor->file_misses != 1) {
+        return -1;
+    }
+
+    gnl_simfs_monitor_destroy(monitor);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_simfs_monitor test:\n\n");
 
@@ -378,6 +399,7 @@ int main() {
     gnl_assert(can_peak_bytes, "can track the bytes peak.");
 
     gnl_assert(can_add_evictions, "can track file evictions.");
+    gnl_assert(can_add_hits_and_misses, "can track file hits and misses.");
 
     // the gnl_simfs_monitor_destroy method is implicitly tested in every assertion
 
@@ -0,0 +1,634 @@
+#include <stdio.h>
+#include <string.h>
+#include <gnl_colorshell.h>
+#include <gnl_assert.h>
+#include "../src/gnl_simfs_inode.c"
+#include "../src/gnl_simfs_policy_index.c"
+
+#define GNL_TEST_INODES 3
+
+/**
+ * Create an index with the given policy, containing GNL_TEST_INODES inodes
+ * inserted in order.
+ */
+static struct gnl_simfs_policy_index *create_index(enum gnl_simfs_replacement_policy policy, unsigned int aging,
+        struct gnl_simfs_inode **inodes) {
+    struct gnl_simfs_policy_index *index = gnl_simfs_policy_index_init(policy, aging);
+    if (index == NULL) {
+        return NULL;
+    }
+
+    char name[2] = "a";
+
+    for (size_t i=0; i<GNL_TEST_INODES; i++) {
+        inodes[i] = gnl_simfs_inode_init(name);
+        if (inodes[i] == NULL) {
+            return NULL;
+        }
+
+        if (gnl_simfs_policy_index_insert(index, inodes[i]) != 0) {
+            return NULL;
+        }
+
+        name[0]++;
+    }
+
+    return index;
+}
+
+static void destroy_index(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode **inodes) {
+    for (size_t i=0; i<GNL_TEST_INODES; i++) {
+        gnl_simfs_inode_destroy(inodes[i]);
+    }
+
+    gnl_simfs_policy_index_destroy(index);
+}
+
+int can_init_an_index() {
+    struct gnl_simfs_policy_index *index = gnl_simfs_policy_index_init(GNL_SIMFS_RP_LRU, 0);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (index->queues[0].head != NULL || index->queues[0].tail != NULL || index->buckets != NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_count(index) != 0) {
+        return -1;
+    }
+
+    gnl_simfs_policy_index_destroy(index);
+
+    return 0;
+}
+
+int can_not_get_a_victim() {
+    struct gnl_simfs_policy_index *index = gnl_simfs_policy_index_init(GNL_SIMFS_RP_FIFO, 0);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != NULL || errno != ENOENT) {
+        return -1;
+    }
+
+    gnl_simfs_policy_index_destroy(index);
+
+    if (gnl_simfs_policy_index_victim(NULL) != NULL || errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_get_fifo_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_FIFO, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the access does not change the order
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_lifo_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LIFO, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the access does not change the order
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[GNL_TEST_INODES - 1]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_lru_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LRU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    // the first inode becomes the most recently used
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[1]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_mru_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_MRU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[GNL_TEST_INODES - 1]) {
+        return -1;
+    }
+
+    // the first inode becomes the most recently used
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_lfu_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LFU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    // access the first inode once and the second one twice
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[2]) {
+        return -1;
+    }
+
+    // the frequencies are 1, 2 and 0, so there are three buckets
+    if (index->buckets->frequency != 0 || index->buckets->next->frequency != 1
+        || index->buckets->next->next->frequency != 2 || index->buckets->next->next->next != NULL) {
+        return -1;
+    }
+
+    // the emptied bucket is destroyed
+    gnl_simfs_policy_index_remove(index, inodes[2]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0] || index->buckets->frequency != 1) {
+        return -1;
+    }
+
+    // the first inode reaches the frequency of the second one,
+    // so the second one is the least recently accessed
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[1] || index->buckets->next != NULL) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+/**
+ * Evict the next victim of the given index, checking it is the expected one.
+ */
+static int evict_victim(struct gnl_simfs_policy_index *index, struct gnl_simfs_inode *expected) {
+    struct gnl_simfs_inode *victim = gnl_simfs_policy_index_victim(index);
+
+    if (victim != expected) {
+        return -1;
+    }
+
+    return gnl_simfs_policy_index_evict(index, victim);
+}
+
+int can_get_arc_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_ARC, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the second access moves the first inode to T2, so the victim is the
+    // least recently used inode of T1, which is bigger than its target
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (evict_victim(index, inodes[1]) != 0) {
+        return -1;
+    }
+
+    // the victim is remembered into B1
+    if (index->ghosts[0].count != 1 || gnl_simfs_policy_index_count(index) != GNL_TEST_INODES - 1) {
+        return -1;
+    }
+
+    // the re-creation of the victim grows the target of T1 and puts it into T2
+    if (gnl_simfs_policy_index_insert(index, inodes[1]) != 0) {
+        return -1;
+    }
+
+    if (index->target != 1 || index->ghosts[0].count != 0 || inodes[1]->policy_queue != 1) {
+        return -1;
+    }
+
+    // T1 does not exceed its target, so the victim comes from T2
+    if (evict_victim(index, inodes[0]) != 0 || index->ghosts[1].count != 1) {
+        return -1;
+    }
+
+    // the re-creation from B2 shrinks the target of T1
+    gnl_simfs_policy_index_insert(index, inodes[0]);
+
+    if (index->target != 0 || inodes[0]->policy_queue != 1) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_2q_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_2Q, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the accesses to A1in do not change the order
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (evict_victim(index, inodes[0]) != 0 || index->ghosts[0].count != 1) {
+        return -1;
+    }
+
+    // the re-creation of the victim puts it into Am
+    gnl_simfs_policy_index_insert(index, inodes[0]);
+
+    if (inodes[0]->policy_queue != 1 || index->ghosts[0].count != 0) {
+        return -1;
+    }
+
+    // A1in exceeds a quarter of the files, so it still provides the victims
+    if (evict_victim(index, inodes[1]) != 0) {
+        return -1;
+    }
+
+    // the victims of Am are not remembered
+    gnl_simfs_policy_index_remove(index, inodes[2]);
+
+    if (evict_victim(index, inodes[0]) != 0 || index->ghosts[0].count != 1) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_count(index) != 0) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_wtinylfu_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_WTINYLFU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the window holds one inode, so the first two inodes overflowed
+    // and they are both candidates to the admission
+    if (index->queues[0].head != inodes[2] || index->queues[1].head != NULL
+        || index->queues[3].head != inodes[0] || index->queues[3].tail != inodes[1]) {
+        return -1;
+    }
+
+    // the first candidate is admitted into the empty probation segment,
+    // the second one is not more frequent than the first one
+    if (evict_victim(index, inodes[1]) != 0) {
+        return -1;
+    }
+
+    if (index->queues[1].head != inodes[0] || index->queues[3].count != 0) {
+        return -1;
+    }
+
+    // the third inode is accessed within the window
+    gnl_simfs_policy_index_touch(index, inodes[2]);
+    gnl_simfs_policy_index_touch(index, inodes[2]);
+
+    // the third inode overflows the window as the new candidate, it is
+    // more frequent than the victim of the probation segment, so it is
+    // admitted and the victim of the probation segment is evicted
+    gnl_simfs_policy_index_insert(index, inodes[1]);
+
+    if (index->queues[3].head != inodes[2] || evict_victim(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    if (inodes[2]->policy_queue != 1 || index->queues[3].count != 0) {
+        return -1;
+    }
+
+    // an access to the probation segment promotes to the protected one
+    gnl_simfs_policy_index_touch(index, inodes[2]);
+
+    if (inodes[2]->policy_queue != 2) {
+        return -1;
+    }
+
+    // the main segments provide the victim while they are not empty
+    if (gnl_simfs_policy_index_victim(index) != inodes[2]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_get_gdsf_victim() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_GDSF, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the inodes have the same frequency, but the first one is bigger
+    inodes[0]->size = 1000;
+    inodes[1]->size = 10;
+    inodes[2]->size = 10;
+
+    for (size_t i=0; i<GNL_TEST_INODES; i++) {
+        gnl_simfs_policy_index_touch(index, inodes[i]);
+    }
+
+    if (evict_victim(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    // the priority of the victim inflates the next priorities
+    if (index->inflation != 0.001) {
+        return -1;
+    }
+
+    // the second inode is accessed more
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+
+    if (evict_victim(index, inodes[2]) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_count(index) != 1 || index->heap[0] != inodes[1]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_tick_the_clock() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LRU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the accesses in the same second never tie
+    for (size_t i=1; i<GNL_TEST_INODES; i++) {
+        if (inodes[i]->access_clock <= inodes[i - 1]->access_clock) {
+            return -1;
+        }
+    }
+
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+
+    if (inodes[0]->access_clock <= inodes[GNL_TEST_INODES - 1]->access_clock) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_frequency(index, inodes[0]) != 1) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_update() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_ARC, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    unsigned long long clock = inodes[GNL_TEST_INODES - 1]->access_clock;
+
+    // the use of the first inode makes it the most recently used of T1,
+    // but it is not a new reference, so it is not promoted to T2
+    if (gnl_simfs_policy_index_update(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    if (inodes[0]->access_clock <= clock || gnl_simfs_policy_index_frequency(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    if (inodes[0]->policy_queue != 0 || gnl_simfs_policy_index_victim(index) != inodes[1]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_age_frequencies() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+
+    // age the frequencies every 8 accesses
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LFU, 8, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the first inode is popular in the past
+    for (size_t i=0; i<6; i++) {
+        gnl_simfs_policy_index_touch(index, inodes[0]);
+    }
+
+    // the second inode is popular now, the 8th access halves the frequencies
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+
+    if (gnl_simfs_policy_index_frequency(index, inodes[0]) != 3 || gnl_simfs_policy_index_frequency(index, inodes[1]) != 1) {
+        return -1;
+    }
+
+    // after two more agings the second inode is more frequent
+    for (size_t i=0; i<16; i++) {
+        gnl_simfs_policy_index_touch(index, inodes[1]);
+    }
+
+    if (gnl_simfs_policy_index_frequency(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    // the first inode ties with the never accessed one, but it was accessed later
+    if (gnl_simfs_policy_index_victim(index) != inodes[2]) {
+        return -1;
+    }
+
+    gnl_simfs_policy_index_remove(index, inodes[2]);
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    // the buckets are merged
+    if (index->buckets->frequency != 0 || index->buckets->next == NULL || index->buckets->next->next != NULL) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_age_frequencies_in_order() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+
+    // age the frequencies every 2 accesses
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LFU, 2, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    // the first inode is accessed before the use of the third one,
+    // the access to the second one halves the frequencies
+    gnl_simfs_policy_index_touch(index, inodes[0]);
+    gnl_simfs_policy_index_update(index, inodes[2]);
+    gnl_simfs_policy_index_touch(index, inodes[1]);
+
+    // the merged bucket keeps the least recently touched first
+    if (index->buckets->next != NULL || index->buckets->head != inodes[0]
+        || index->buckets->head->policy_next != inodes[2] || index->buckets->tail != inodes[1]) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[0]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int can_remove() {
+    struct gnl_simfs_inode *inodes[GNL_TEST_INODES];
+    struct gnl_simfs_policy_index *index = create_index(GNL_SIMFS_RP_LRU, 0, inodes);
+
+    if (index == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_count(index) != GNL_TEST_INODES) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_remove(index, inodes[0]) != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_victim(index) != inodes[1]) {
+        return -1;
+    }
+
+    if (gnl_simfs_policy_index_count(index) != GNL_TEST_INODES - 1) {
+        return -1;
+    }
+
+    // remove from the middle
+    gnl_simfs_policy_index_insert(index, inodes[0]);
+    gnl_simfs_policy_index_remove(index, inodes[2]);
+
+    if (index->queues[0].head != inodes[1] || index->queues[0].tail != inodes[0] || inodes[1]->policy_next != inodes[0]) {
+        return -1;
+    }
+
+    destroy_index(index, inodes);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_simfs_policy_index test:\n\n");
+
+    gnl_assert(can_init_an_index, "can init a policy index.");
+    gnl_assert(can_not_get_a_victim, "can not get a victim from an empty policy index.");
+
+    gnl_assert(can_get_fifo_victim, "can get the victim with the FIFO replacement policy.");
+    gnl_assert(can_get_lifo_victim, "can get the victim with the LIFO replacement policy.");
+    gnl_assert(can_get_lru_victim, "can get the victim with the LRU replacement policy.");
+    gnl_assert(can_get_mru_victim, "can get the victim with the MRU replacement policy.");
+    gnl_assert(can_get_lfu_victim, "can get the victim with the LFU replacement policy.");
+    gnl_assert(can_get_arc_victim, "can get the victim with the ARC replacement policy.");
+    gnl_assert(can_get_2q_victim, "can get the victim with the 2Q replacement policy.");
+    gnl_assert(can_get_wtinylfu_victim, "can get the victim with the W-TinyLFU replacement policy.");
+    gnl_assert(can_get_gdsf_victim, "can get the victim with the GDSF replacement policy.");
+
+    gnl_assert(can_tick_the_clock, "can track the accesses with a logical clock.");
+    gnl_assert(can_update, "can track the use of an inode without a new reference.");
+    gnl_assert(can_age_frequencies, "can age the access frequencies.");
+    gnl_assert(can_age_frequencies_in_order, "can merge the aged frequencies keeping the recency order.");
+
+    gnl_assert(can_remove, "can remove an inode from a policy index.");
+
+    // the gnl_simfs_policy_index_destroy method is implicitly tested in every assertion
+
+    printf("\n");
+}
+
+#undef GNL_TEST_INODES
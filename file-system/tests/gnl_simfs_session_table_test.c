@@ -0,0 +1,158 @@
+#include <stdio.h>
+#include <string.h>
+#include <gnl_colorshell.h>
+#include <gnl_assert.h>
+#include "../src/gnl_simfs_session_table.c"
+
+int can_init_session_table() {
+    struct gnl_simfs_session_table *table = gnl_simfs_session_table_init();
+
+    if (table == NULL) {
+        return -1;
+    }
+
+    if (table->count != 0 || table->buckets == NULL) {
+        return -1;
+    }
+
+    gnl_simfs_session_table_destroy(table);
+
+    return 0;
+}
+
+int can_add_and_remove_fd() {
+    struct gnl_simfs_session_table *table = gnl_simfs_session_table_init();
+    if (table == NULL) {
+        return -1;
+    }
+
+    for (int fd=0; fd<10; fd++) {
+        if (gnl_simfs_session_table_add_fd(table, 1, fd) != 0) {
+            return -1;
+        }
+    }
+
+    if (gnl_simfs_session_table_remove_fd(table, 1, 4) != 0) {
+        return -1;
+    }
+
+    // a file descriptor not opened by the pid can not be removed
+    if (gnl_simfs_session_table_remove_fd(table, 1, 4) != -1 || errno != EBADF) {
+        return -1;
+    }
+
+    if (gnl_simfs_session_table_remove_fd(table, 2, 5) != -1 || errno != ENOENT) {
+        return -1;
+    }
+
+    struct gnl_simfs_session *session = gnl_simfs_session_table_detach(table, 1);
+    if (session == NULL || session->pid != 1 || session->fds_count != 9) {
+        return -1;
+    }
+
+    for (int i=0; i<session->fds_count; i++) {
+        if (session->fds[i] == 4) {
+            return -1;
+        }
+    }
+
+    gnl_simfs_session_destroy(session);
+    gnl_simfs_session_table_destroy(table);
+
+    return 0;
+}
+
+int can_add_and_remove_lock() {
+    struct gnl_simfs_session_table *table = gnl_simfs_session_table_init();
+    if (table == NULL) {
+        return -1;
+    }
+
+    if (gnl_simfs_session_table_add_lock(table, 1, "/file_1") != 0) {
+        return -1;
+    }
+
+    // a file already tracked is not tracked twice
+    if (gnl_simfs_session_table_add_lock(table, 1, "/file_1") != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_session_table_add_lock(table, 1, "/file_2") != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_session_table_remove_lock(table, 1, "/file_1") != 0) {
+        return -1;
+    }
+
+    if (gnl_simfs_session_table_remove_lock(table, 1, "/file_1") != -1 || errno != ENOENT) {
+        return -1;
+    }
+
+    struct gnl_simfs_session *session = gnl_simfs_session_table_detach(table, 1);
+    if (session == NULL || session->locks_count != 1 || strcmp(session->locks[0], "/file_2") != 0) {
+        return -1;
+    }
+
+    gnl_simfs_session_destroy(session);
+    gnl_simfs_session_table_destroy(table);
+
+    return 0;
+}
+
+int can_detach() {
+    struct gnl_simfs_session_table *table = gnl_simfs_session_table_init();
+    if (table == NULL) {
+        return -1;
+    }
+
+    // more sessions than buckets, to grow the table
+    for (unsigned int pid=1; pid<=1000; pid++) {
+        if (gnl_simfs_session_table_add_fd(table, pid, pid) != 0) {
+            return -1;
+        }
+    }
+
+    if (table->count != 1000 || table->buckets_count <= 64) {
+        return -1;
+    }
+
+    for (unsigned int pid=1; pid<=1000; pid+=2) {
+        struct gnl_simfs_session *session = gnl_simfs_session_table_detach(table, pid);
+
+        if (session == NULL || session->pid != pid || session->fds_count != 1 || session->fds[0] != pid) {
+            return -1;
+        }
+
+        gnl_simfs_session_destroy(session);
+    }
+
+    // a detached session is not present anymore
+    errno = EINVAL;
+    if (gnl_simfs_session_table_detach(table, 1) != NULL || errno != 0) {
+        return -1;
+    }
+
+    if (table->count != 500) {
+        return -1;
+    }
+
+    // the sessions left are destroyed with the table
+    gnl_simfs_session_table_destroy(table);
+
+    return 0;
+}
+
+int main() {
+    gnl_printf_yellow("> gnl_simfs_session_table test:\n\n");
+
+    gnl_assert(can_init_session_table, "can init a session table.");
+
+    gnl_assert(can_add_and_remove_fd, "can track the file descriptors of a pid.");
+    gnl_assert(can_add_and_remove_lock, "can track the locks of a pid.");
+    gnl_assert(can_detach, "can detach the session of a pid.");
+
+    // the gnl_simfs_session_table_destroy method is implicitly tested in every assertion
+
+    printf("\n");
+}
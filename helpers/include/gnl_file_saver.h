@@ -2,6 +2,34 @@
 #ifndef GNL_FILE_SAVER_H
 #define GNL_FILE_SAVER_H
 
+#include <stddef.h>
+
+/**
+ * Create (or truncate) filename within dirname and open it for writing,
+ * so that it can be written piece by piece with gnl_file_saver_write.
+ * If the path specified into the given dirname does not exist, the
+ * function will return an error.
+ *
+ * @param filename  The name of the file to create.
+ * @param dirname   The path where to create the file
+ *
+ * @return          Returns the file descriptor of the open file on
+ *                  success, -1 otherwise.
+ */
+extern int gnl_file_saver_open(const char *filename, const char *dirname);
+
+/**
+ * Write count bytes of the given buf into the file descriptor fd,
+ * returned by gnl_file_saver_open.
+ *
+ * @param fd        The file descriptor where to write.
+ * @param buf       The pointer to the bytes to write.
+ * @param count     The number of bytes to write.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_file_saver_write(int fd, const void *buf, size_t count);
+
 /**
  * Save count bytes of the given buf into filename within dirname.
  * If the path specified into the given dirname does not exist, the
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include <string.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
 #include "../include/gnl_macro_beg.h"
 #include "../include/gnl_file_saver.h"
@@ -38,7 +40,7 @@ static void nion_mkdir(const char *dir) {
 /**
  * {@inheritDoc}
  */
-int gnl_file_saver_save(const char *filename, const char *dirname, void *buf, size_t count) {
+int gnl_file_saver_open(const char *filename, const char *dirname) {
     // validate parameters
     GNL_NULL_CHECK(filename, EINVAL, -1);
     GNL_NULL_CHECK(dirname, EINVAL, -1);
@@ -59,19 +61,58 @@ int gnl_file_saver_save(const char *filename, const char *dirname, void *buf, si
     // create filename directories if necessary
     nion_mkdir(complete_path);
 
-    // write the file
-    FILE *fp;
+    // open the file
+    int fd = open(complete_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
 
-    fp = fopen(complete_path , "w");
-    GNL_NULL_CHECK(fp, errno, -1)
+    // free memory
+    free(complete_path);
 
-    unsigned long nwrite = fwrite(buf, 1, count, fp);
-    GNL_MINUS1_CHECK(nwrite, errno, -1)
+    return fd;
+}
 
-    fclose(fp);
+/**
+ * {@inheritDoc}
+ */
+int gnl_file_saver_write(int fd, const void *buf, size_t count) {
+    size_t nleft = count;
+    ssize_t nwrite;
+
+    // the bytes go straight to the file, with no stdio buffer in between
+    while (nleft > 0) {
+        nwrite = write(fd, buf, nleft);
+        if (nwrite == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return -1;
+        }
 
-    // free memory
-    free(complete_path);
+        nleft -= nwrite;
+        buf = (const char *)buf + nwrite;
+    }
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_file_saver_save(const char *filename, const char *dirname, void *buf, size_t count) {
+    int fd = gnl_file_saver_open(filename, dirname);
+    GNL_MINUS1_CHECK(fd, errno, -1)
+
+    // write the file
+    int res = gnl_file_saver_write(fd, buf, count);
+    int write_errno = errno;
+
+    close(fd);
+
+    if (res == -1) {
+        errno = write_errno;
+
+        return -1;
+    }
 
     return 0;
 }
@@ -2,6 +2,11 @@
 #ifndef GNL_MESSAGE_NNB_H
 #define GNL_MESSAGE_NNB_H
 
+#include <sys/uio.h>
+
+// the size of the encoded message_nnb without its bytes
+#define GNL_MESSAGE_NNB_METADATA_SIZE 21
+
 /**
  * The message_nnb message.
  */
@@ -59,4 +64,35 @@ extern int gnl_message_nnb_to_string(const struct gnl_message_nnb *message_nnb,
  */
 extern int gnl_message_nnb_from_string(const char *message, struct gnl_message_nnb *message_nnb);
 
+/**
+ * Encode the message_nnb into two io vectors without copying its bytes: the
+ * first one points to the encoded number and count, which are put into "dest",
+ * the second one points to the bytes of the message_nnb. The io vectors are
+ * valid until "dest" is freed or the message_nnb is destroyed.
+ *
+ * @param message_nnb   The message_nnb to be encoded.
+ * @param dest          The destination where to write the encoded number and count.
+ * @param iov           The destination array of (at least) two io vectors.
+ *
+ * @return              Returns the number of bytes referenced by the io vectors
+ *                      on success, -1 otherwise.
+ */
+extern int gnl_message_nnb_to_iovec(const struct gnl_message_nnb *message_nnb, char **dest, struct iovec *iov);
+
+/**
+ * Decode the message held by the given two io vectors and fill the message_nnb
+ * with it: the first one must point to the GNL_MESSAGE_NNB_METADATA_SIZE bytes
+ * of the encoded number and count, the second one to the bytes of the message,
+ * which are adopted by the message_nnb without being copied.
+ *
+ * @param iov           The array of two io vectors to decode, the bytes of the
+ *                      second one must be allocated with malloc.
+ * @param message_nnb   The struct to fill with the decoded message, it must be previously
+ *                      initialized with gnl_message_nnb_init.
+ *
+ * @return              Returns 0 on success, -1 otherwise. On failure the bytes
+ *                      are not adopted.
+ */
+extern int gnl_message_nnb_from_iovec(const struct iovec *iov, struct gnl_message_nnb *message_nnb);
+
 #endif //GNL_MESSAGE_NNB_H
\ No newline at end of file
@@ -2,6 +2,8 @@
 #ifndef GNL_MESSAGE_SB_H
 #define GNL_MESSAGE_SB_H
 
+#include <sys/uio.h>
+
 /**
  * The message_snb message.
  */
@@ -59,4 +61,19 @@ extern int gnl_message_snb_to_string(const struct gnl_message_snb *message_snb,
  */
 extern int gnl_message_snb_from_string(const char *message, struct gnl_message_snb *message_snb);
 
+/**
+ * Encode the message_snb into two io vectors without copying its bytes: the
+ * first one points to the encoded string and count, which are put into "dest",
+ * the second one points to the bytes of the message_snb. The io vectors are
+ * valid until "dest" is freed or the message_snb is destroyed.
+ *
+ * @param message_snb   The message_snb to be encoded.
+ * @param dest          The destination where to write the encoded string and count.
+ * @param iov           The destination array of (at least) two io vectors.
+ *
+ * @return              Returns the number of bytes referenced by the io vectors
+ *                      on success, -1 otherwise.
+ */
+extern int gnl_message_snb_to_iovec(const struct gnl_message_snb *message_snb, char **dest, struct iovec *iov);
+
 #endif //GNL_MESSAGE_SB_H
\ No newline at end of file
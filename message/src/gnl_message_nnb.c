@@ -100,6 +100,61 @@ int gnl_message_nnb_from_string(const char *message, struct gnl_message_nnb *mes
     return 0;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_message_nnb_to_iovec(const struct gnl_message_nnb *message_nnb, char **dest, struct iovec *iov) {
+    GNL_NULL_CHECK(message_nnb, EINVAL, -1)
+    GNL_NULL_CHECK(iov, EINVAL, -1)
+
+    GNL_CALLOC(*dest, GNL_MESSAGE_NNB_METADATA_SIZE, -1)
+
+    snprintf(*dest, GNL_MESSAGE_NNB_METADATA_SIZE, "%0*d%0*lu", MAX_DIGITS_INT, message_nnb->number, MAX_DIGITS_INT,
+             message_nnb->count);
+
+    // the bytes are referenced, not copied
+    iov[0].iov_base = *dest;
+    iov[0].iov_len = GNL_MESSAGE_NNB_METADATA_SIZE;
+    iov[1].iov_base = message_nnb->bytes;
+    iov[1].iov_len = message_nnb->count;
+
+    return gnl_message_nnb_size(message_nnb);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_message_nnb_from_iovec(const struct iovec *iov, struct gnl_message_nnb *message_nnb) {
+    GNL_NULL_CHECK(iov, EINVAL, -1)
+    GNL_NULL_CHECK(message_nnb, EINVAL, -1)
+
+    if (iov[0].iov_len != GNL_MESSAGE_NNB_METADATA_SIZE) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    // get the number and the count of bytes
+    int number;
+    size_t count;
+    int res = sscanf(iov[0].iov_base, "%"MAX_DIGITS_CHAR"d%"MAX_DIGITS_CHAR"lu", &number, &count);
+
+    // the metadata must describe exactly the given bytes
+    if (res != 2 || count != iov[1].iov_len) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    message_nnb->number = number;
+    message_nnb->count = count;
+
+    // adopt the bytes
+    message_nnb->bytes = iov[1].iov_base;
+
+    return 0;
+}
+
 #undef MAX_DIGITS_INT
 #undef MAX_DIGITS_CHAR
 
@@ -131,6 +131,30 @@ int gnl_message_snb_from_string(const char *message, struct gnl_message_snb *mes
     return 0;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_message_snb_to_iovec(const struct gnl_message_snb *message_snb, char **dest, struct iovec *iov) {
+    GNL_NULL_CHECK(message_snb, EINVAL, -1)
+    GNL_NULL_CHECK(iov, EINVAL, -1)
+
+    int message_snb_size = gnl_message_snb_size(message_snb);
+    int maxlen = message_snb_size - message_snb->count;
+
+    GNL_CALLOC(*dest, maxlen, -1)
+
+    snprintf(*dest, maxlen, "%0*lu%s%0*lu", MAX_DIGITS_INT, strlen(message_snb->string), message_snb->string,
+             MAX_DIGITS_INT, message_snb->count);
+
+    // the bytes are referenced, not copied
+    iov[0].iov_base = *dest;
+    iov[0].iov_len = maxlen;
+    iov[1].iov_base = message_snb->bytes;
+    iov[1].iov_len = message_snb->count;
+
+    return message_snb_size;
+}
+
 #undef MAX_DIGITS_INT
 #undef MAX_DIGITS_CHAR
 
@@ -147,6 +147,117 @@ int can_from_string_message() {
     return 0;
 }
 
+int can_to_iovec_message() {
+    int res;
+    long size;
+    char *content = NULL;
+
+    res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
+    }
+
+    struct gnl_message_nnb *message_nnb = gnl_message_nnb_init_with_args(220510, size, content);
+
+    char expected[21];
+    sprintf(expected, "0000220510%0*ld", 10, size);
+
+    char *message;
+    struct iovec iov[2];
+
+    res = gnl_message_nnb_to_iovec(message_nnb, &message, iov);
+
+    if (res != 21 + size) {
+        return -1;
+    }
+
+    if (iov[0].iov_base != message || iov[0].iov_len != 21 || strcmp(message, expected) != 0) {
+        return -1;
+    }
+
+    // the bytes must be referenced, not copied
+    if (iov[1].iov_base != message_nnb->bytes || iov[1].iov_len != size) {
+        return -1;
+    }
+
+    free(content);
+    free(message);
+    gnl_message_nnb_destroy(message_nnb);
+
+    return 0;
+}
+
+int can_from_iovec_message() {
+    int res;
+    long size;
+    char *content = NULL;
+
+    res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
+    }
+
+    struct gnl_message_nnb *message_nnb = gnl_message_nnb_init();
+
+    char metadata[21];
+    sprintf(metadata, "0000220510%0*ld", 10, size);
+
+    struct iovec iov[2];
+    iov[0].iov_base = metadata;
+    iov[0].iov_len = 21;
+    iov[1].iov_base = content;
+    iov[1].iov_len = size;
+
+    res = gnl_message_nnb_from_iovec(iov, message_nnb);
+
+    if (res != 0) {
+        return -1;
+    }
+
+    if (message_nnb->number != 220510 || message_nnb->count != size) {
+        return -1;
+    }
+
+    // the bytes must be adopted, not copied
+    if (message_nnb->bytes != content) {
+        return -1;
+    }
+
+    gnl_message_nnb_destroy(message_nnb);
+
+    return 0;
+}
+
+int can_not_from_iovec_message_with_wrong_count() {
+    int res;
+    char bytes[] = "bytes";
+
+    struct gnl_message_nnb *message_nnb = gnl_message_nnb_init();
+
+    char metadata[21];
+    sprintf(metadata, "0000220510%0*d", 10, 10);
+
+    struct iovec iov[2];
+    iov[0].iov_base = metadata;
+    iov[0].iov_len = 21;
+    iov[1].iov_base = bytes;
+    iov[1].iov_len = 5;
+
+    res = gnl_message_nnb_from_iovec(iov, message_nnb);
+
+    if (res != -1 || errno != EINVAL) {
+        return -1;
+    }
+
+    if (message_nnb->bytes != NULL) {
+        return -1;
+    }
+
+    gnl_message_nnb_destroy(message_nnb);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> message_nnb test:\n\n");
 
@@ -155,6 +266,9 @@ int main() {
 
     gnl_assert(can_to_string_message, "can get a message string from a message_nnb struct.");
     gnl_assert(can_from_string_message, "can get a message from a string into a message_nnb struct.");
+    gnl_assert(can_to_iovec_message, "can get the io vectors of a message_nnb struct.");
+    gnl_assert(can_from_iovec_message, "can get a message from io vectors into a message_nnb struct.");
+    gnl_assert(can_not_from_iovec_message_with_wrong_count, "can not get a message from io vectors with a wrong count.");
 
     // the message_nnb_destroy method is implicitly tested in every assertion
 
@@ -147,6 +147,51 @@ int can_from_string_message() {
     return 0;
 }
 
+int can_to_iovec_message() {
+    int res;
+    long size;
+    char *content = NULL;
+
+    res = gnl_file_to_pointer("./testfile.txt", &content, &size);
+    if (res == -1) {
+        return -1;
+    }
+
+    struct gnl_message_snb *message_snb = gnl_message_snb_init_with_args("/fake/path", size, content);
+
+    char *expected = calloc(31, sizeof(char *));
+    if (expected == NULL) {
+        return -1;
+    }
+
+    sprintf(expected, "0000000010/fake/path%0*ld", 10, size);
+
+    char *message;
+    struct iovec iov[2];
+
+    res = gnl_message_snb_to_iovec(message_snb, &message, iov);
+
+    if (res != (strlen(expected) + 1) + size) {
+        return -1;
+    }
+
+    if (iov[0].iov_base != message || iov[0].iov_len != 31 || strcmp(message, expected) != 0) {
+        return -1;
+    }
+
+    // the bytes must be referenced, not copied
+    if (iov[1].iov_base != message_snb->bytes || iov[1].iov_len != size) {
+        return -1;
+    }
+
+    free(content);
+    free(message);
+    free(expected);
+    gnl_message_snb_destroy(message_snb);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_message_snb test:\n\n");
 
@@ -155,6 +200,7 @@ int main() {
 
     gnl_assert(can_to_string_message, "can get a message string from a gnl_message_snb struct.");
     gnl_assert(can_from_string_message, "can get a message from a string into a gnl_message_snb struct.");
+    gnl_assert(can_to_iovec_message, "can get the io vectors of a gnl_message_snb struct.");
 
     // the gnl_message_snb_destroy method is implicitly tested in every assertion
 
@@ -44,7 +44,8 @@ extern int gnl_fss_api_close_connection(const char *sockname);
 extern int gnl_fss_api_open_file(const char *pathname, int flags);
 
 /**
- * Read a file from the server.
+ * Read a file from the server. The file is streamed by the server in
+ * bounded chunks, which are gathered into buf.
  *
  * @param pathname  The location of the file on the server.
  * @param buf       The pointer to the file read from the server.
@@ -54,6 +55,19 @@ extern int gnl_fss_api_open_file(const char *pathname, int flags);
  */
 extern int gnl_fss_api_read_file(const char *pathname, void **buf, size_t *size);
 
+/**
+ * Read a file from the server and store it within dirname, as gnl_file_saver_save
+ * does. The chunks streamed by the server are written to the file as soon as
+ * they arrive, so the file is never held whole in memory.
+ *
+ * @param pathname  The location of the file on the server.
+ * @param dirname   The directory where to store the file read.
+ * @param size      The size in bytes of the file read from the server.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_fss_api_read_file_to(const char *pathname, const char *dirname, size_t *size);
+
 /**
  * Read any N files from the server, if the server has less than N files,
  * they will all be read.
@@ -68,7 +82,9 @@ extern int gnl_fss_api_read_N_files(int N, const char *dirname);
 /**
  * Write a file to the server.
  * Return success only if the previous operation on the file was
- * gnl_fss_api_open_file(pathname, O_CREATE| O_LOCK).
+ * gnl_fss_api_open_file(pathname, O_CREATE| O_LOCK). The file is mapped
+ * into memory and sent in bounded chunks straight from the mapping, and it
+ * is stored by the server only once all the chunks are received.
  *
  * @param pathname  The path of the file to write on the server.
  * @param dirname   The path where to store the eventual trashed file from the server.
@@ -79,7 +95,9 @@ extern int gnl_fss_api_read_N_files(int N, const char *dirname);
 extern int gnl_fss_api_write_file(const char *pathname, const char *dirname);
 
 /**
- * Append a file to the server, this operation is atomic.
+ * Append a file to the server, this operation is atomic. At most
+ * GNL_SOCKET_REQUEST_MAX_WRITE_SIZE bytes can be appended at once,
+ * otherwise the append fails with EMSGSIZE.
  *
  * @param pathname  The location of the file on the server.
  * @param buf       The data to append to the file.
@@ -133,4 +151,24 @@ extern int gnl_fss_api_close_file(const char *pathname);
  */
 extern int gnl_fss_api_remove_file(const char *pathname);
 
+/**
+ * Start a pipeline: from now on gnl_fss_api_open_file, gnl_fss_api_lock_file,
+ * gnl_fss_api_unlock_file, gnl_fss_api_close_file and gnl_fss_api_remove_file
+ * only send their request, without waiting for the response. A file must be
+ * already open to be locked, unlocked or closed within a pipeline. The other
+ * apis fail until the pipeline is ended.
+ *
+ * @return  Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_fss_api_pipeline_begin();
+
+/**
+ * End the pipeline: read the responses of all the requests sent since the
+ * gnl_fss_api_pipeline_begin call, matching them by request id, and apply them.
+ *
+ * @return  Returns 0 if all the requests succeeded, -1 otherwise,
+ *          with the errno of the first failed request.
+ */
+extern int gnl_fss_api_pipeline_end();
+
 #endif //GNL_FSS_SERVER_API_H
\ No newline at end of file
@@ -2,6 +2,25 @@
 #ifndef GNL_FSS_CONFIG_H
 #define GNL_FSS_CONFIG_H
 
+/**
+ * The possible event loop backends of the server.
+ */
+enum gnl_fss_event_loop {
+
+    // wait for the clients with select, it can handle
+    // up to FD_SETSIZE file descriptors
+    GNL_FSS_EVENT_LOOP_SELECT,
+
+    // wait for the clients with an edge-triggered epoll,
+    // handing each ready client to one worker at a time
+    GNL_FSS_EVENT_LOOP_EPOLL,
+
+    // accept the clients with epoll and distribute them
+    // round-robin among the workers, each worker owns its
+    // clients and waits for them on its own epoll
+    GNL_FSS_EVENT_LOOP_REACTOR,
+};
+
 /**
  * Holds the configuration values.
  *
@@ -10,6 +29,13 @@
  * capacity             Capacity of the File Storage Server in MB.
  * limit                Maximum number of files stored by the File Storage Server.
  * replacement_policy   Storage replacement policy. Supported policies: 0-FIFO, 1-LRU, 2-LFU.
+ * compression          Compression of the stored files. Supported values: none, huffman, lz, auto.
+ * frequency_aging      Number of accesses after which the access frequencies of the files are halved,
+ *                      0 to never age them.
+ * eviction_high_watermark  Percentage of the capacity above which the reclaimer evicts files in background,
+ *                          0 to disable the reclaimer.
+ * eviction_low_watermark   Percentage of the capacity where the reclaimer stops evicting files.
+ * event_loop           The event loop backend. Supported values: select, epoll, reactor.
  * socket               Absolute path of the socket file.
  * log_filepath         Absolute path of the log file.
  * log_level            The log level. Accepted values: trace, debug, info, warn, error.
@@ -19,6 +45,11 @@ struct gnl_fss_config {
     int capacity;
     int limit;
     int replacement_policy;
+    int compression;
+    unsigned int frequency_aging;
+    unsigned int eviction_high_watermark;
+    unsigned int eviction_low_watermark;
+    int event_loop;
     char *socket;
     char *log_filepath;
     char *log_level;
@@ -2,7 +2,7 @@
 #ifndef GNL_FSS_THREAD_POOL_H
 #define GNL_FSS_THREAD_POOL_H
 
-#include <gnl_ts_bb_queue_t.h>
+#include <gnl_ts_mpmc_queue_t.h>
 #include <gnl_simfs_file_system.h>
 #include <gnl_logger.h>
 
@@ -36,16 +36,42 @@ extern void gnl_fss_thread_pool_destroy(struct gnl_fss_thread_pool *thread_pool)
  * into the given thread pool.
  *
  * @param thread_pool   The tread pool were to dispatch the message.
- * @param message       The message to be dispatched.
+ * @param message       The message to be dispatched, a ready client file
+ *                      descriptor or GNL_FSS_WORKER_TERMINATE.
  *
  * @return              Return 0 on success, -1 otherwise.
  */
-extern int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool, void *message);
+extern int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool, int message);
 
 /**
- * Return the channel file descriptor where to read a ready client file descriptor.
- * This channel is used by the workers to warn the master that a
- * client request is handled.
+ * Assign the given new client to one of the workers of the given thread pool,
+ * choosing them round-robin. The worker owns the client until it goes away,
+ * waiting for its requests and handling them end-to-end. It can be used only
+ * if the workers are reactors.
+ *
+ * @param thread_pool   The thread pool were to assign the client.
+ * @param fd_c          The file descriptor of the new client.
+ *
+ * @return              Return 0 on success, -1 otherwise.
+ */
+extern int gnl_fss_thread_pool_assign(struct gnl_fss_thread_pool *thread_pool, int fd_c);
+
+/**
+ * Return the max number of clients the given thread pool can serve at once.
+ * The master must not accept more clients than this: the queue of the workers
+ * and the ring of the handled clients are bounded, so beyond it the master and
+ * the workers could wait for each other to make room.
+ *
+ * @param thread_pool   The tread pool were to get the max number of clients.
+ *
+ * @return              The max number of clients on success, -1 otherwise.
+ */
+extern int gnl_fss_thread_pool_max_clients(struct gnl_fss_thread_pool *thread_pool);
+
+/**
+ * Return the channel file descriptor to watch to know when the workers
+ * have handled some client requests. It becomes readable when there are
+ * clients to get with gnl_fss_thread_pool_handled.
  *
  * @param thread_pool   The tread pool were to get the channel.
  *
@@ -54,4 +80,18 @@ extern int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool,
  */
 extern int gnl_fss_thread_pool_master_channel(struct gnl_fss_thread_pool *thread_pool);
 
+/**
+ * Get the clients given back by the workers after handling their requests,
+ * and put them into fds. A 0 means that a client has gone away. Call it
+ * when the master channel becomes readable.
+ *
+ * @param thread_pool   The tread pool were to get the clients.
+ * @param fds           The array where to put the clients.
+ * @param size          The size of the fds array.
+ *
+ * @return              The number of clients put into fds on success,
+ *                      -1 otherwise.
+ */
+extern int gnl_fss_thread_pool_handled(struct gnl_fss_thread_pool *thread_pool, int *fds, int size);
+
 #endif //GNL_FSS_THREAD_POOL_H
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include <gnl_simfs_file_system.h>
 #include <gnl_logger.h>
+#include <gnl_ts_mpsc_ring_t.h>
+#include <gnl_ts_mpmc_queue_t.h>
 
 #define GNL_FSS_WORKER_TERMINATE (-1970)
 
@@ -15,22 +17,24 @@ struct gnl_fss_worker;
 /**
  * Create a new worker config.
  *
- * @param id            The id of the worker.
- * @param worker_queue  The queue where to receive a ready file descriptor
- *                      from a main thread.
- * @param waiting_queue The queue to store the clients waiting for a
- *                      file unlocking.
- * @param pipe_channel  The pipe channel where to send the result to a
- *                      main thread.
- * @param file_system   The file system instance to use to store the files.
- * @param config        The configuration instance of the server.
+ * @param id                The id of the worker.
+ * @param worker_queue      The queue where to receive a ready file descriptor
+ *                          from a main thread.
+ * @param waiting_queue     The queue to store the clients waiting for a
+ *                          file unlocking.
+ * @param completion_ring   The ring where to give the handled clients back
+ *                          to a main thread.
+ * @param completion_fd     The eventfd to write to wake up a main thread
+ *                          after a client is given back.
+ * @param file_system       The file system instance to use to store the files.
+ * @param config            The configuration instance of the server.
  *
- * @return gnl_queue_t  Returns the new worker config created on success,
- *                      NULL otherwise.
+ * @return gnl_queue_t      Returns the new worker config created on success,
+ *                          NULL otherwise.
  */
-extern struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_bb_queue_t *worker_queue,
-        struct gnl_fss_waiting_list *waiting_queue, int pipe_channel, struct gnl_simfs_file_system *file_system,
-                const struct gnl_fss_config *config);
+extern struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_mpmc_queue_t *worker_queue,
+        struct gnl_fss_waiting_list *waiting_queue, struct gnl_ts_mpsc_ring_t *completion_ring, int completion_fd,
+                struct gnl_simfs_file_system *file_system, const struct gnl_fss_config *config);
 
 /**
  * Destroy a worker config. Attention: this method only deletes the
@@ -42,11 +46,29 @@ extern struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_bb
  */
 extern void gnl_fss_worker_destroy(struct gnl_fss_worker *worker);
 
+/**
+ * Make the given worker a reactor: instead of dequeueing the ready file descriptors
+ * from the worker queue, it waits for the clients it owns on the given epoll instance,
+ * and it handles their requests end-to-end. After a request is handled, the client is
+ * armed again into the epoll instance owning it, instead of being sent to the master.
+ *
+ * @param worker        The worker configuration.
+ * @param epfd          The epoll instance where the clients of the worker are registered.
+ * @param owners        The epoll instances owning the clients, indexed by their file
+ *                      descriptor.
+ * @param terminate_fd  The file descriptor, registered into the epoll instance, that
+ *                      becomes readable when the reactor must terminate.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_fss_worker_set_reactor(struct gnl_fss_worker *worker, int epfd, const int *owners, int terminate_fd);
+
 /**
  * Handle a client request dequeueing a ready file descriptor from the
  * worker queue given within the worker configuration passed using the
- * args argument, then return the result through the pipe channel given
- * within the worker configuration.
+ * args argument, then give the client back through the completion ring
+ * given within the worker configuration. If the worker is a reactor, then
+ * handle the requests of the clients it owns instead.
  *
  * @param args  It must contains the worker configuration struct.
  *
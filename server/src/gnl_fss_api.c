@@ -1,15 +1,25 @@
 #include <time.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <gnl_file_saver.h>
 #include <gnl_socket_request.h>
 #include <gnl_socket_response.h>
 #include <gnl_socket_service.h>
-#include <gnl_file_to_pointer.h>
 #include <gnl_ternary_search_tree_t.h>
 #include "../include/gnl_fss_api.h"
 #include <gnl_macro_beg.h>
 
+// the number of bytes of a file sent by one GNL_SOCKET_REQUEST_WRITE_CHUNK request
+#define GNL_FSS_API_CHUNK_SIZE 262144
+
+// the max number of GNL_SOCKET_REQUEST_WRITE_CHUNK requests sent
+// to the server whose response is not read yet
+#define GNL_FSS_API_STREAM_WINDOW 8
+
 /**
  * {@inheritDoc}
  */
@@ -35,6 +45,139 @@ int open_with_create_lock_flags = 0;
  */
 struct gnl_ternary_search_tree_t *file_descriptor_table;
 
+/**
+ * The id given to the last request sent to the server,
+ * 0 is never given since it marks a response without id.
+ */
+static unsigned int last_request_id = 0;
+
+/**
+ * A request sent to the server within a pipeline,
+ * whose response is not read yet.
+ *
+ * id       The id of the request.
+ * type     The type of the request.
+ * pathname The target of the request.
+ * flags    The flags of a GNL_SOCKET_REQUEST_OPEN request.
+ */
+struct pending_request {
+    unsigned int id;
+    enum gnl_socket_request_type type;
+    char *pathname;
+    int flags;
+};
+
+/**
+ * Whether a pipeline was started by the gnl_fss_api_pipeline_begin api.
+ */
+static int pipeline_active = 0;
+
+/**
+ * The requests sent within the pipeline, in sending order.
+ */
+static struct pending_request *pipeline_pending = NULL;
+
+/**
+ * The number of requests sent within the pipeline.
+ */
+static size_t pipeline_size = 0;
+
+/**
+ * The number of requests storable into pipeline_pending.
+ */
+static size_t pipeline_capacity = 0;
+
+/**
+ * Discard the requests pending from index "from" on, and leave
+ * the pipeline empty.
+ *
+ * @param from  The index of the first request to discard.
+ */
+static void pipeline_reset(size_t from) {
+    for (size_t i=from; i<pipeline_size; i++) {
+        free(pipeline_pending[i].pathname);
+    }
+
+    free(pipeline_pending);
+    pipeline_pending = NULL;
+    pipeline_size = 0;
+    pipeline_capacity = 0;
+}
+
+/**
+ * Get a new id for a request to send to the server.
+ *
+ * @return  Returns the new id, never 0.
+ */
+static unsigned int next_request_id() {
+    // skip the id 0 when the counter wraps
+    if (++last_request_id == 0) {
+        last_request_id = 1;
+    }
+
+    return last_request_id;
+}
+
+/**
+ * Give the given request a new id and send it to the server.
+ * A call to this invocation will destroy the given request.
+ *
+ * @param request   The request to send.
+ *
+ * @return          Returns the id of the request sent on success,
+ *                  0 otherwise.
+ */
+static unsigned int send_and_destroy_request_only(struct gnl_socket_request *request) {
+    GNL_NULL_CHECK(request, errno, 0)
+
+    unsigned int id = next_request_id();
+
+    int res = gnl_socket_request_set_id(request, id);
+    if (res == -1) {
+        gnl_socket_request_destroy(request);
+
+        return 0;
+    }
+
+    // send the request to the server
+    int bytes_sent = gnl_socket_service_send_request(socket_service_connection, request);
+
+    // clean memory
+    gnl_socket_request_destroy(request);
+
+    GNL_MINUS1_CHECK(bytes_sent, errno, 0)
+
+    return id;
+}
+
+/**
+ * Get the response of the request with the given id from the server. A
+ * response with id 0 is an error not bound to a request, it is taken as
+ * the response of the given request.
+ *
+ * @param id    The id of the request.
+ *
+ * @return      Returns the response from the server on success,
+ *              NULL otherwise.
+ */
+static struct gnl_socket_response *get_response(unsigned int id) {
+    struct gnl_socket_response *response = gnl_socket_service_get_response(socket_service_connection);
+    GNL_NULL_CHECK(response, errno, NULL)
+
+    unsigned int response_id = gnl_socket_response_get_id(response);
+
+    // the server answers the requests in order, a different id
+    // means the connection is out of sync
+    if (response_id != 0 && response_id != id) {
+        gnl_socket_response_destroy(response);
+        errno = EBADMSG;
+
+        return NULL;
+    }
+
+    return response;
+}
+
 /**
  * Send the given request to the server and get the response.
  * A call to this invocation will destroy the given request.
@@ -45,17 +188,573 @@ struct gnl_ternary_search_tree_t *file_descriptor_table;
  *                  NULL otherwise.
  */
 static struct gnl_socket_response *send_and_destroy_request(struct gnl_socket_request *request) {
-    GNL_NULL_CHECK(request, errno, NULL)
+    // the next response belongs to the first pipelined request
+    if (pipeline_active) {
+        gnl_socket_request_destroy(request);
+        errno = EINVAL;
 
-    // send the request to the server
+        return NULL;
+    }
+
+    unsigned int id = send_and_destroy_request_only(request);
+    if (id == 0) {
+        return NULL;
+    }
+
+    // get the response from the server
+    return get_response(id);
+}
+
+/**
+ * Apply the given response of a GNL_SOCKET_REQUEST_OPEN, GNL_SOCKET_REQUEST_LOCK,
+ * GNL_SOCKET_REQUEST_UNLOCK, GNL_SOCKET_REQUEST_CLOSE or GNL_SOCKET_REQUEST_REMOVE
+ * request to the client state. The response is not destroyed.
+ *
+ * @param type      The type of the request.
+ * @param pathname  The target of the request.
+ * @param flags     The flags of a GNL_SOCKET_REQUEST_OPEN request.
+ * @param response  The response received from the server.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int handle_response(enum gnl_socket_request_type type, const char *pathname, int flags,
+                           struct gnl_socket_response *response) {
+
+    int res = 0;
+    int tmp_res;
+    unsigned int *fd_copy = NULL;
+
+    // the response type expected on success
+    enum gnl_socket_response_type expected = type == GNL_SOCKET_REQUEST_OPEN
+            ? GNL_SOCKET_RESPONSE_OK_FD
+            : GNL_SOCKET_RESPONSE_OK;
+
+    int response_type = gnl_socket_response_type(response);
+
+    if (response_type == GNL_SOCKET_RESPONSE_ERROR) {
+        // an error occurred, set the errno
+        res = gnl_socket_response_get_error(response);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        errno = res;
+
+        return -1;
+    }
+
+    if (response_type != (int)expected) {
+        // if this point is reached, the response is not valid
+        errno = EBADMSG;
+
+        return -1;
+    }
+
+    switch (type) {
+
+        case GNL_SOCKET_REQUEST_OPEN:
+            // make a deep copy of the fd
+            fd_copy = malloc(sizeof(int));
+            GNL_NULL_CHECK(fd_copy, ENOMEM, -1)
+
+            // get the file descriptor from the response
+            *fd_copy = gnl_socket_response_get_fd(response);
+            GNL_MINUS1_CHECK(*fd_copy, errno, -1)
+
+            // add the deep copy into the file_descriptor_table
+            tmp_res = gnl_ternary_search_tree_put(&file_descriptor_table, pathname, fd_copy);
+            GNL_MINUS1_CHECK(tmp_res, errno, -1)
+
+            // if success, appropriately set the open_with_create_lock_flags
+            open_with_create_lock_flags = flags & (O_CREATE | O_LOCK);
+
+            return 0;
+
+        case GNL_SOCKET_REQUEST_CLOSE:
+            // remove the fd from the file_descriptor_table
+            tmp_res = gnl_ternary_search_tree_remove(file_descriptor_table, pathname, free);
+            GNL_MINUS1_CHECK(tmp_res, errno, -1)
+
+            break;
+
+        default:
+            // no need to do something else here
+            break;
+    }
+
+    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
+    open_with_create_lock_flags = 0;
+
+    return 0;
+}
+
+/**
+ * Send the given request to the server and apply its response to the client
+ * state. If a pipeline is active, then only send the request: its response
+ * will be applied by the gnl_fss_api_pipeline_end api.
+ * A call to this invocation will destroy the given request.
+ *
+ * @param request   The request to send.
+ * @param pathname  The target of the request.
+ * @param flags     The flags of a GNL_SOCKET_REQUEST_OPEN request.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int send_and_handle_request(struct gnl_socket_request *request, const char *pathname, int flags) {
+    GNL_NULL_CHECK(request, ENOMEM, -1)
+
+    int type = gnl_socket_request_type(request);
+    GNL_MINUS1_CHECK(type, errno, -1)
+
+    if (!pipeline_active) {
+        // send the request and get the response from the server
+        struct gnl_socket_response *response = send_and_destroy_request(request);
+        GNL_NULL_CHECK(response, errno, -1)
+
+        int res = handle_response(type, pathname, flags, response);
+
+        // free the memory
+        gnl_socket_response_destroy(response);
+
+        return res;
+    }
+
+    // make room for the pending request
+    if (pipeline_size == pipeline_capacity) {
+        size_t capacity = pipeline_capacity == 0 ? 8 : pipeline_capacity * 2;
+
+        struct pending_request *pending = realloc(pipeline_pending, capacity * sizeof(struct pending_request));
+        if (pending == NULL) {
+            gnl_socket_request_destroy(request);
+            errno = ENOMEM;
+
+            return -1;
+        }
+
+        pipeline_pending = pending;
+        pipeline_capacity = capacity;
+    }
+
+    struct pending_request *pending = &(pipeline_pending[pipeline_size]);
+
+    pending->pathname = malloc((strlen(pathname) + 1) * sizeof(char));
+    if (pending->pathname == NULL) {
+        gnl_socket_request_destroy(request);
+        errno = ENOMEM;
+
+        return -1;
+    }
+
+    strcpy(pending->pathname, pathname);
+
+    pending->type = type;
+    pending->flags = flags;
+
+    // send the request without waiting for the response
+    pending->id = send_and_destroy_request_only(request);
+    if (pending->id == 0) {
+        free(pending->pathname);
+
+        return -1;
+    }
+
+    pipeline_size++;
+
+    return 0;
+}
+
+/**
+ * Apply the given response of a GNL_SOCKET_REQUEST_WRITE or of a
+ * GNL_SOCKET_REQUEST_WRITE_END request: the files evicted by the server
+ * are stored into the given directory. The response is not destroyed.
+ *
+ * @param response  The response received from the server.
+ * @param dirname   The path where to store the eventual evicted files,
+ *                  if NULL they are stored nowhere.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int handle_write_response(struct gnl_socket_response *response, const char *dirname) {
+    int res = 0;
+    struct gnl_message_snb *file = NULL;
+
+    switch (gnl_socket_response_type(response)) {
+
+        case GNL_SOCKET_RESPONSE_ERROR:
+            // an error occurred, set the errno
+            res = gnl_socket_response_get_error(response);
+            GNL_MINUS1_CHECK(res, errno, -1)
+
+            errno = res;
+            res = -1;
+            break;
+
+        case GNL_SOCKET_RESPONSE_OK:
+            // no need to do something else here
+            break;
+
+        case GNL_SOCKET_RESPONSE_OK_FILE_LIST:
+            // success but one or more files were evicted
+
+            // for each received file
+            while ((file = gnl_socket_response_get_file(response)) != NULL) {
+
+                // if a dirname was provided, then save the file
+                if (dirname != NULL) {
+                    res = gnl_file_saver_save(file->string, dirname, file->bytes, file->count);
+
+                    if (res == -1) {
+                        // let the errno bubble
+                        break;
+                    }
+                }
+
+                gnl_message_snb_destroy(file);
+            }
+            break;
+
+        default:
+            // if this point is reached, the response is not valid
+            errno = EBADMSG;
+            res = -1;
+            break;
+    }
+
+    return res;
+}
+
+/**
+ * Wait for the response of the oldest GNL_SOCKET_REQUEST_WRITE_CHUNK
+ * request in flight, and take it out of the window.
+ *
+ * @param window    The ids of the requests in flight, oldest first.
+ * @param in_flight The pointer to the number of requests in flight.
+ *
+ * @return          Returns 0 if the chunk was written, -1 otherwise.
+ */
+static int wait_chunk_response(unsigned int *window, size_t *in_flight) {
+    unsigned int id = window[0];
+    int res;
+
+    memmove(window, window + 1, (*in_flight - 1) * sizeof(unsigned int));
+    (*in_flight)--;
+
+    struct gnl_socket_response *response = get_response(id);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    switch (gnl_socket_response_type(response)) {
+        case GNL_SOCKET_RESPONSE_OK:
+            res = 0;
+            break;
+
+        case GNL_SOCKET_RESPONSE_ERROR:
+            // an error occurred, set the errno
+            res = gnl_socket_response_get_error(response);
+            if (res != -1) {
+                errno = res;
+            }
+
+            res = -1;
+            break;
+
+        default:
+            // if this point is reached, the response is not valid
+            errno = EBADMSG;
+            res = -1;
+            break;
+    }
+
+    gnl_socket_response_destroy(response);
+
+    return res;
+}
+
+/**
+ * Send the given chunk of a file to the server as a GNL_SOCKET_REQUEST_WRITE_CHUNK
+ * request, which borrows the bytes instead of copying them.
+ *
+ * @param fd    The file descriptor of the file on the server.
+ * @param chunk The bytes of the chunk.
+ * @param count The number of bytes of the chunk.
+ *
+ * @return      Returns the id of the request sent on success,
+ *              0 otherwise.
+ */
+static unsigned int send_file_chunk(int fd, void *chunk, size_t count) {
+    struct gnl_socket_request *request = gnl_socket_request_init_borrowed(GNL_SOCKET_REQUEST_WRITE_CHUNK, fd, count,
+                                                                          chunk);
+    GNL_NULL_CHECK(request, errno, 0)
+
+    unsigned int id = next_request_id();
+    gnl_socket_request_set_id(request, id);
+
+    // the bytes are written to the socket straight from the chunk
     int bytes_sent = gnl_socket_service_send_request(socket_service_connection, request);
-    GNL_MINUS1_CHECK(bytes_sent, errno, NULL)
 
-    // clean memory
+    // give the bytes back before destroying the request
+    gnl_socket_request_release_bytes(request);
     gnl_socket_request_destroy(request);
 
-    // get the response from the server
-    return gnl_socket_service_get_response(socket_service_connection);
+    GNL_MINUS1_CHECK(bytes_sent, errno, 0)
+
+    return id;
+}
+
+/**
+ * Send the content of the given file to the server, as GNL_SOCKET_REQUEST_WRITE_CHUNK
+ * requests of GNL_FSS_API_CHUNK_SIZE bytes. The file is mapped into memory and
+ * the chunks are written to the socket straight from the mapping, so that the
+ * file is neither read nor copied into a buffer of the client. Up to
+ * GNL_FSS_API_STREAM_WINDOW chunks are sent before waiting for the response
+ * of the oldest one.
+ *
+ * @param fd    The file descriptor of the file on the server.
+ * @param file  The file descriptor of the local file to send.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int send_file_chunks(int fd, int file) {
+    unsigned int window[GNL_FSS_API_STREAM_WINDOW];
+    size_t in_flight = 0;
+    size_t offset = 0;
+    size_t count;
+    unsigned int id;
+    int res = 0;
+    int first_errno = 0;
+
+    struct stat file_stat;
+    res = fstat(file, &file_stat);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    size_t size = file_stat.st_size;
+
+    // an empty file has no chunks
+    if (size == 0) {
+        return 0;
+    }
+
+    char *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (map == MAP_FAILED) {
+        return -1;
+    }
+
+    // the file is read once, from the beginning to the end
+    posix_madvise(map, size, POSIX_MADV_SEQUENTIAL);
+
+    while (offset < size) {
+        // make room into the window
+        if (in_flight == GNL_FSS_API_STREAM_WINDOW && wait_chunk_response(window, &in_flight) == -1) {
+            res = -1;
+            first_errno = errno;
+            break;
+        }
+
+        count = size - offset < GNL_FSS_API_CHUNK_SIZE ? size - offset : GNL_FSS_API_CHUNK_SIZE;
+
+        id = send_file_chunk(fd, map + offset, count);
+        if (id == 0) {
+            res = -1;
+            first_errno = errno;
+            break;
+        }
+
+        window[in_flight++] = id;
+        offset += count;
+    }
+
+    // the responses of the chunks in flight must be read anyway
+    while (in_flight > 0) {
+        if (wait_chunk_response(window, &in_flight) == -1 && res == 0) {
+            res = -1;
+            first_errno = errno;
+        }
+    }
+
+    munmap(map, size);
+
+    if (res == -1) {
+        errno = first_errno;
+    }
+
+    return res;
+}
+
+/**
+ * Receive the file streamed by the server in answer to the GNL_SOCKET_REQUEST_READ_STREAM
+ * request with the given id: every GNL_SOCKET_RESPONSE_OK_CHUNK response is handed
+ * to the given sink as soon as it arrives, until the closing response. Once the
+ * sink fails, the remaining chunks are read and discarded.
+ *
+ * @param id    The id of the GNL_SOCKET_REQUEST_READ_STREAM request.
+ * @param sink  The function consuming a chunk, it returns 0 on success,
+ *              -1 otherwise.
+ * @param arg   The argument given to the sink.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int receive_file(unsigned int id, int (*sink)(void *arg, const void *bytes, size_t count), void *arg) {
+    struct gnl_socket_response *response;
+    int res = 0;
+    int first_errno = 0;
+    int done = 0;
+
+    // the file arrives in chunks, closed by an ok response
+    while (!done) {
+        response = get_response(id);
+
+        // the connection is lost or out of sync
+        if (response == NULL) {
+            res = -1;
+            first_errno = errno;
+            break;
+        }
+
+        switch (gnl_socket_response_type(response)) {
+
+            case GNL_SOCKET_RESPONSE_OK_CHUNK:
+                // once an error occurred, the chunks are only drained
+                if (res == 0 && sink(arg, gnl_socket_response_get_bytes(response),
+                                     gnl_socket_response_get_size(response)) == -1) {
+                    res = -1;
+                    first_errno = errno;
+                }
+                break;
+
+            case GNL_SOCKET_RESPONSE_OK:
+                done = 1;
+                break;
+
+            case GNL_SOCKET_RESPONSE_ERROR:
+                // an error occurred, set the errno
+                if (res == 0) {
+                    res = -1;
+                    first_errno = gnl_socket_response_get_error(response);
+                }
+
+                done = 1;
+                break;
+
+            default:
+                // if this point is reached, the response is not valid
+                if (res == 0) {
+                    res = -1;
+                    first_errno = EBADMSG;
+                }
+
+                done = 1;
+                break;
+        }
+
+        // free the memory
+        gnl_socket_response_destroy(response);
+    }
+
+    if (res == -1) {
+        errno = first_errno;
+    }
+
+    return res;
+}
+
+/**
+ * A growing buffer where to gather a streamed file.
+ *
+ * bytes    The bytes gathered.
+ * count    The number of bytes gathered.
+ */
+struct file_buffer {
+    void *bytes;
+    size_t count;
+};
+
+/**
+ * Append the given chunk to the file_buffer pointed by arg.
+ *
+ * @param arg   The file_buffer.
+ * @param bytes The bytes of the chunk.
+ * @param count The number of bytes of the chunk.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int buffer_sink(void *arg, const void *bytes, size_t count) {
+    struct file_buffer *buffer = (struct file_buffer *)arg;
+
+    void *tmp = realloc(buffer->bytes, buffer->count + count);
+    GNL_NULL_CHECK(tmp, ENOMEM, -1)
+
+    buffer->bytes = tmp;
+    memcpy((char *)buffer->bytes + buffer->count, bytes, count);
+    buffer->count += count;
+
+    return 0;
+}
+
+/**
+ * A file on disk where to store a streamed file.
+ *
+ * filename The name of the file.
+ * dirname  The directory where to store the file.
+ * fd       The file descriptor of the file, -1 until it is created.
+ * count    The number of bytes stored.
+ */
+struct file_saver {
+    const char *filename;
+    const char *dirname;
+    int fd;
+    size_t count;
+};
+
+/**
+ * Write the given chunk to the file_saver pointed by arg, the file is
+ * created at the first chunk.
+ *
+ * @param arg   The file_saver.
+ * @param bytes The bytes of the chunk.
+ * @param count The number of bytes of the chunk.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int file_sink(void *arg, const void *bytes, size_t count) {
+    struct file_saver *saver = (struct file_saver *)arg;
+
+    if (saver->fd == -1) {
+        saver->fd = gnl_file_saver_open(saver->filename, saver->dirname);
+        GNL_MINUS1_CHECK(saver->fd, errno, -1)
+    }
+
+    int res = gnl_file_saver_write(saver->fd, bytes, count);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    saver->count += count;
+
+    return 0;
+}
+
+/**
+ * Send a GNL_SOCKET_REQUEST_READ_STREAM request for the given pathname.
+ *
+ * @param pathname  The location of the file on the server.
+ *
+ * @return          Returns the id of the request sent on success,
+ *                  0 otherwise.
+ */
+static unsigned int send_read_stream_request(const char *pathname) {
+    // the chunks of the file are waited for one by one
+    if (pipeline_active) {
+        errno = EINVAL;
+
+        return 0;
+    }
+
+    // get the fd bound to the given pathname
+    void *fd_raw = gnl_ternary_search_tree_get(file_descriptor_table, pathname);
+    GNL_NULL_CHECK(fd_raw, EINVAL, 0);
+
+    int fd = *(int *)fd_raw;
+
+    // create the request to send to the server
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_READ_STREAM, 1, fd);
+    GNL_NULL_CHECK(request, ENOMEM, 0)
+
+    return send_and_destroy_request_only(request);
 }
 
 /**
@@ -104,6 +803,16 @@ int gnl_fss_api_open_connection(const char *sockname, int msec, const struct tim
         nanosleep(&tim, NULL);
     }
 
+    // agree with the server on the protocol framing
+    if (gnl_socket_service_negotiate(socket_service_connection) == -1) {
+        int negotiate_errno = errno;
+
+        gnl_socket_service_close(socket_service_connection);
+        errno = negotiate_errno;
+
+        return -1;
+    }
+
     // initialize the file descriptor table
     file_descriptor_table = NULL;
 
@@ -138,6 +847,10 @@ int gnl_fss_api_close_connection(const char *sockname) {
     // destroy the file descriptor table
     gnl_ternary_search_tree_destroy(&file_descriptor_table, NULL);
 
+    // the responses of a pipeline still active will never be read
+    pipeline_active = 0;
+    pipeline_reset(0);
+
     // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
     if (res == 0) {
         open_with_create_lock_flags = 0;
@@ -160,117 +873,84 @@ int gnl_fss_api_open_file(const char *pathname, int flags) {
     struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_OPEN, 2, pathname, flags);
     GNL_NULL_CHECK(request, ENOMEM, -1)
 
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
-
-    int res = 0;
-    int tmp_res;
-    unsigned int *fd_copy = NULL;
-
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
-
-            errno = res;
-            res = -1;
-            break;
-
-        case GNL_SOCKET_RESPONSE_OK_FD:
-            // if success, appropriately set the open_with_create_lock_flags
-            open_with_create_lock_flags = flags & (O_CREATE | O_LOCK);
+    return send_and_handle_request(request, pathname, flags);
+}
 
-            // make a deep copy of the fd
-            fd_copy = malloc(sizeof(int));
-            GNL_NULL_CHECK(fd_copy, ENOMEM, -1)
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_api_read_file(const char *pathname, void **buf, size_t *size) {
+    // validate the parameters
+    GNL_NULL_CHECK(pathname, EINVAL, -1)
 
-            // get the file descriptor from the response
-            *fd_copy = gnl_socket_response_get_fd(response);
-            GNL_MINUS1_CHECK(*fd_copy, errno, -1)
+    unsigned int id = send_read_stream_request(pathname);
+    if (id == 0) {
+        return -1;
+    }
 
-            // add the deep copy into the file_descriptor_table
-            tmp_res = gnl_ternary_search_tree_put(&file_descriptor_table, pathname, fd_copy);
-            GNL_MINUS1_CHECK(tmp_res, errno, -1)
+    struct file_buffer buffer;
+    buffer.bytes = NULL;
+    buffer.count = 0;
 
-            break;
+    int res = receive_file(id, buffer_sink, &buffer);
+    if (res == -1) {
+        int receive_errno = errno;
+        free(buffer.bytes);
+        errno = receive_errno;
 
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
+        return -1;
     }
 
-    // free the memory
-    gnl_socket_response_destroy(response);
+    *buf = buffer.bytes;
+    *size = buffer.count;
 
-    return res;
+    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
+    open_with_create_lock_flags = 0;
+
+    return 0;
 }
 
 /**
  * {@inheritDoc}
  */
-int gnl_fss_api_read_file(const char *pathname, void **buf, size_t *size) {
+int gnl_fss_api_read_file_to(const char *pathname, const char *dirname, size_t *size) {
     // validate the parameters
     GNL_NULL_CHECK(pathname, EINVAL, -1)
+    GNL_NULL_CHECK(dirname, EINVAL, -1)
 
-    // get the fd bound to the given pathname
-    void *fd_raw = gnl_ternary_search_tree_get(file_descriptor_table, pathname);
-    GNL_NULL_CHECK(fd_raw, EINVAL, -1);
-
-    int fd = *(int *)fd_raw;
-
-    // create the request to send to the server
-    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_READ, 1, fd);
-    GNL_NULL_CHECK(request, ENOMEM, -1)
-
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
-
-    int res = 0;
-
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
-            
-            errno = res;
-            res = -1;
-            break;
+    unsigned int id = send_read_stream_request(pathname);
+    if (id == 0) {
+        return -1;
+    }
 
-        case GNL_SOCKET_RESPONSE_OK_FILE:
-            // get the size
-            *size = gnl_socket_response_get_size(response);
+    struct file_saver saver;
+    saver.filename = pathname;
+    saver.dirname = dirname;
+    saver.fd = -1;
+    saver.count = 0;
 
-            // instantiate the buf
-            GNL_CALLOC(*buf, *size, -1)
+    int res = receive_file(id, file_sink, &saver);
 
-            // copy the received bytes into buf
-            memcpy(*buf, gnl_socket_response_get_bytes(response), *size);
-            break;
+    // an empty file has no chunks, create it anyway
+    if (res == 0 && saver.fd == -1) {
+        saver.fd = gnl_file_saver_open(pathname, dirname);
+        res = saver.fd == -1 ? -1 : 0;
+    }
 
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
+    if (saver.fd != -1) {
+        int receive_errno = errno;
+        close(saver.fd);
+        errno = receive_errno;
     }
 
-    // free the memory
-    gnl_socket_response_destroy(response);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    *size = saver.count;
 
     // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
-    if (res == 0) {
-        open_with_create_lock_flags = 0;
-    }
+    open_with_create_lock_flags = 0;
 
-    return res;
+    return 0;
 }
 
 /**
@@ -307,68 +987,24 @@ int gnl_fss_api_read_N_files(int N, const char *dirname) {
             // no need to do something else here
             break;
 
-        case GNL_SOCKET_RESPONSE_OK_FILE_LIST:
-
-            // for each received file
-            while ((file = gnl_socket_response_get_file(response)) != NULL) {
-
-                // increase the counter
-                file_read_count++;
-
-                // start reading the file
-                char *filename = file->string;
-
-                // open the file on the server
-                res = gnl_fss_api_open_file(filename, 0);
-                if (res == -1) {
-                    // let the errno bubble
-                    break;
-                }
-
-                // read the file
-                void *buf = NULL;
-                size_t size;
-
-                int res_read = gnl_fss_api_read_file(filename, &buf, &size);
-                int errno_read = errno;
-
-                // an eventual error during the read will be checked later
-
-                // close the file
-                int res_close = gnl_fss_api_close_file(filename);
-                int errno_close = errno;
+        case GNL_SOCKET_RESPONSE_OK_FILE_LIST:
 
-                // check if there was an error during the read
-                if (res_read == -1) {
-                    errno = errno_read;
-                    break;
-                }
+            // for each received file, the server sent up to N files
+            while ((file = gnl_socket_response_get_file(response)) != NULL) {
 
-                // check if there was an error during the close
-                if (res_close == -1) {
-                    errno = errno_close;
-                    break;
-                }
+                // increase the counter
+                file_read_count++;
 
                 // store the read file on disk
                 if (dirname != NULL) {
-                    res = gnl_file_saver_save(filename, dirname, buf, size);
-
-                    if (res == -1) {
-                        // let the errno bubble
-                        break;
-                    }
+                    res = gnl_file_saver_save(file->string, dirname, file->bytes, file->count);
                 }
 
                 //free memory
-                free(buf);
                 gnl_message_snb_destroy(file);
 
-                // check if we have to stop; we do the check here
-                // since at least 1 file must be read (N > 0) or
-                // all the files must be read (N <= 0), in addition
-                // at this point all the memory was freed
-                if (N > 0 && file_read_count == N) {
+                if (res == -1) {
+                    // let the errno bubble
                     break;
                 }
             }
@@ -409,19 +1045,60 @@ int gnl_fss_api_write_file(const char *pathname, const char *dirname) {
     // validate the parameters
     GNL_NULL_CHECK(pathname, EINVAL, -1)
 
+    // the responses of the chunks are waited for one by one
+    if (pipeline_active) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    // get the fd bound to the given pathname
+    void *fd_raw = gnl_ternary_search_tree_get(file_descriptor_table, pathname);
+    GNL_NULL_CHECK(fd_raw, EINVAL, -1);
+
+    int fd = *(int *)fd_raw;
+
     // get the file to send
-    long size;
-    char *file = NULL;
+    int file = open(pathname, O_RDONLY);
+    GNL_MINUS1_CHECK(file, errno, -1)
+
+    // start the chunked write
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_WRITE_BEGIN, 1, fd);
+    if (request == NULL) {
+        close(file);
+
+        return -1;
+    }
+
+    // the openFile(pathname, O_CREATE|O_LOCK) check holds until the write ends
+    int flags = open_with_create_lock_flags;
+    int res = send_and_handle_request(request, pathname, 0);
+    open_with_create_lock_flags = flags;
 
-    int res = gnl_file_to_pointer(pathname, &file, &size);
+    // send the file, the chunks are appended by the server at the end only
+    if (res == 0) {
+        res = send_file_chunks(fd, file);
+    }
 
+    close(file);
     GNL_MINUS1_CHECK(res, errno, -1)
 
-    // send the file through the "append" call
-    res = gnl_fss_api_append_to_file(pathname, file, size, dirname);
+    // end the chunked write
+    request = gnl_socket_request_init(GNL_SOCKET_REQUEST_WRITE_END, 1, fd);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    struct gnl_socket_response *response = send_and_destroy_request(request);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    res = handle_write_response(response, dirname);
+
+    // free the memory
+    gnl_socket_response_destroy(response);
 
-    // free memory
-    free(file);
+    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
+    if (res == 0) {
+        open_with_create_lock_flags = 0;
+    }
 
     return res;
 }
@@ -439,6 +1116,9 @@ int gnl_fss_api_append_to_file(const char *pathname, void *buf, size_t size, con
 
     int fd = *(int *)fd_raw;
 
+    // the server refuses the bigger writes
+    GNL_MINUS1_CHECK(-1 * (size > GNL_SOCKET_REQUEST_MAX_WRITE_SIZE), EMSGSIZE, -1)
+
     // create the request to send to the server
     struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_WRITE, 3, fd, size, buf);
     GNL_NULL_CHECK(request, errno, -1)
@@ -449,50 +1129,7 @@ int gnl_fss_api_append_to_file(const char *pathname, void *buf, size_t size, con
     // check the response
     GNL_NULL_CHECK(response, errno, -1)
 
-    int res = 0;
-    struct gnl_message_snb *file = NULL;
-
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
-
-            errno = res;
-            res = -1;
-            break;
-
-        case GNL_SOCKET_RESPONSE_OK:
-            // no need to do something else here
-            break;
-
-        case GNL_SOCKET_RESPONSE_OK_FILE_LIST:
-            // success but one or more files were evicted
-
-            // for each received file
-            while ((file = gnl_socket_response_get_file(response)) != NULL) {
-
-                // if a dirname was provided, then save the file
-                if (dirname != NULL) {
-                    res = gnl_file_saver_save(file->string, dirname, file->bytes, file->count);
-
-                    if (res == -1) {
-                        // let the errno bubble
-                        break;
-                    }
-                }
-
-                gnl_message_snb_destroy(file);
-            }
-            break;
-
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
-            break;
-    }
+    int res = handle_write_response(response, dirname);
 
     // free the memory
     gnl_socket_response_destroy(response);
@@ -522,43 +1159,7 @@ int gnl_fss_api_lock_file(const char *pathname) {
     struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_LOCK, 1, fd);
     GNL_NULL_CHECK(request, ENOMEM, -1)
 
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
-
-    int res = 0;
-
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
-
-            errno = res;
-            res = -1;
-            break;
-
-        case GNL_SOCKET_RESPONSE_OK:
-            // no need to do something else here
-            break;
-
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
-    }
-
-    // free the memory
-    gnl_socket_response_destroy(response);
-
-    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
-    if (res == 0) {
-        open_with_create_lock_flags = 0;
-    }
-
-    return res;
+    return send_and_handle_request(request, pathname, 0);
 }
 
 /**
@@ -578,43 +1179,7 @@ int gnl_fss_api_unlock_file(const char *pathname) {
     struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_UNLOCK, 1, fd);
     GNL_NULL_CHECK(request, ENOMEM, -1)
 
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
-
-    int res = 0;
-
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
-
-            errno = res;
-            res = -1;
-            break;
-
-        case GNL_SOCKET_RESPONSE_OK:
-            // no need to do something else here
-            break;
-
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
-    }
-
-    // free the memory
-    gnl_socket_response_destroy(response);
-
-    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
-    if (res == 0) {
-        open_with_create_lock_flags = 0;
-    }
-
-    return res;
+    return send_and_handle_request(request, pathname, 0);
 }
 
 /**
@@ -634,97 +1199,95 @@ int gnl_fss_api_close_file(const char *pathname) {
     struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_CLOSE, 1, fd);
     GNL_NULL_CHECK(request, ENOMEM, -1)
 
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
-
-    int res = 0;
-    int tmp_res;
-
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
+    return send_and_handle_request(request, pathname, 0);
+}
 
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_api_remove_file(const char *pathname) {
+    // validate the parameters
+    GNL_NULL_CHECK(pathname, EINVAL, -1)
 
-            errno = res;
-            res = -1;
-            break;
+    // create the request to send to the server
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_REMOVE, 1, pathname);
+    GNL_NULL_CHECK(request, ENOMEM, -1)
 
-        case GNL_SOCKET_RESPONSE_OK:
-            // remove the fd from the file_descriptor_table
-            tmp_res = gnl_ternary_search_tree_remove(file_descriptor_table, pathname, free);
-            GNL_MINUS1_CHECK(tmp_res, errno, -1)
+    return send_and_handle_request(request, pathname, 0);
+}
 
-            break;
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_api_pipeline_begin() {
+    // validate the state
+    if (!socket_service_connection_active || pipeline_active) {
+        errno = EINVAL;
 
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
-            res = -1;
+        return -1;
     }
 
-    // free the memory
-    gnl_socket_response_destroy(response);
-
-    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
-    if (res == 0) {
-        open_with_create_lock_flags = 0;
-    }
+    pipeline_active = 1;
+    pipeline_size = 0;
 
-    return res;
+    return 0;
 }
 
 /**
  * {@inheritDoc}
  */
-int gnl_fss_api_remove_file(const char *pathname) {
-    // validate the parameters
-    GNL_NULL_CHECK(pathname, EINVAL, -1)
+int gnl_fss_api_pipeline_end() {
+    // validate the state
+    if (!pipeline_active) {
+        errno = EINVAL;
 
-    // create the request to send to the server
-    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_REMOVE, 1, pathname);
-    GNL_NULL_CHECK(request, ENOMEM, -1)
+        return -1;
+    }
 
-    // send the request and get the response from the server
-    struct gnl_socket_response *response = send_and_destroy_request(request);
-    GNL_NULL_CHECK(response, errno, -1)
+    pipeline_active = 0;
 
+    struct gnl_socket_response *response;
     int res = 0;
+    int first_errno = 0;
+    size_t i;
 
-    // handle the response
-    switch (gnl_socket_response_type(response)) {
-
-        case GNL_SOCKET_RESPONSE_ERROR:
-            // an error occurred, set the errno
-            res = gnl_socket_response_get_error(response);
-            GNL_MINUS1_CHECK(res, errno, -1)
+    // the responses arrive in the sending order
+    for (i=0; i<pipeline_size; i++) {
+        struct pending_request *pending = &(pipeline_pending[i]);
 
-            errno = res;
-            res = -1;
-            break;
+        response = get_response(pending->id);
 
-        case GNL_SOCKET_RESPONSE_OK:
-            // no need to do something else here
+        // the connection is lost or out of sync, the
+        // remaining responses can not be read anymore
+        if (response == NULL) {
             break;
+        }
 
-        default:
-            // if this point is reached, the response is not valid
-            errno = EBADMSG;
+        if (handle_response(pending->type, pending->pathname, pending->flags, response) == -1 && res == 0) {
             res = -1;
+            first_errno = errno;
+        }
+
+        gnl_socket_response_destroy(response);
+        free(pending->pathname);
     }
 
-    // free the memory
-    gnl_socket_response_destroy(response);
+    // if the loop was broken, then report the broken connection
+    if (i < pipeline_size) {
+        res = -1;
+        first_errno = errno;
+    }
 
-    // if success reset the openFile(pathname, O_CREATE|O_LOCK) check
-    if (res == 0) {
-        open_with_create_lock_flags = 0;
+    pipeline_reset(i);
+
+    if (res == -1) {
+        errno = first_errno;
     }
 
     return res;
 }
 
+#undef GNL_FSS_API_CHUNK_SIZE
+#undef GNL_FSS_API_STREAM_WINDOW
+
 #include <gnl_macro_end.h>
\ No newline at end of file
@@ -91,6 +91,162 @@ static int get_replacement_policy_from_env(enum gnl_simfs_replacement_policy *re
         *replacement_policy = GNL_SIMFS_RP_LFU;
     }
 
+    else if ((strcmp("ARC", rp) == 0)) {
+        *replacement_policy = GNL_SIMFS_RP_ARC;
+    }
+
+    else if ((strcmp("2Q", rp) == 0)) {
+        *replacement_policy = GNL_SIMFS_RP_2Q;
+    }
+
+    else if ((strcmp("WTINYLFU", rp) == 0)) {
+        *replacement_policy = GNL_SIMFS_RP_WTINYLFU;
+    }
+
+    else if ((strcmp("GDSF", rp) == 0)) {
+        *replacement_policy = GNL_SIMFS_RP_GDSF;
+    }
+
+    else {
+        errno = EINVAL;
+        res = -1;
+    }
+
+    return res;
+}
+
+/**
+ * Get the real compression value from the env. The compression is
+ * optional: if it is not set, the files are compressed with huffman.
+ *
+ * @param compression   The pointer where to write the compression
+ *                      read from the env.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int get_compression_from_env(enum gnl_simfs_compression *compression) {
+    char *c = getenv("COMPRESSION");
+
+    int res = 0;
+
+    if (c == NULL || (strcmp("huffman", c) == 0)) {
+        *compression = GNL_SIMFS_COMPRESSION_HUFFMAN;
+    }
+
+    else if ((strcmp("none", c) == 0)) {
+        *compression = GNL_SIMFS_COMPRESSION_NONE;
+    }
+
+    else if ((strcmp("lz", c) == 0)) {
+        *compression = GNL_SIMFS_COMPRESSION_LZ;
+    }
+
+    else if ((strcmp("auto", c) == 0)) {
+        *compression = GNL_SIMFS_COMPRESSION_AUTO;
+    }
+
+    else {
+        errno = EINVAL;
+        res = -1;
+    }
+
+    return res;
+}
+
+/**
+ * Get the frequency aging value from the env. The frequency aging is
+ * optional: if it is not set, the access frequencies never age.
+ *
+ * @param frequency_aging   The pointer where to write the frequency aging
+ *                          read from the env.
+ *
+ * @return                  Returns 0 on success, -1 otherwise.
+ */
+static int get_frequency_aging_from_env(unsigned int *frequency_aging) {
+    if (getenv("FREQUENCY_AGING") == NULL) {
+        *frequency_aging = 0;
+
+        return 0;
+    }
+
+    int value = get_int_value_from_env("FREQUENCY_AGING");
+    if (value < 0) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    *frequency_aging = value;
+
+    return 0;
+}
+
+/**
+ * Get the eviction watermarks from the env. The watermarks are optional:
+ * if the high watermark is not set the reclaimer is disabled, if the low
+ * watermark is not set it is equal to the high watermark.
+ *
+ * @param high_watermark    The pointer where to write the high watermark
+ *                          read from the env.
+ * @param low_watermark     The pointer where to write the low watermark
+ *                          read from the env.
+ *
+ * @return                  Returns 0 on success, -1 otherwise.
+ */
+static int get_eviction_watermarks_from_env(unsigned int *high_watermark, unsigned int *low_watermark) {
+    if (getenv("EVICTION_HIGH_WATERMARK") == NULL) {
+        *high_watermark = 0;
+        *low_watermark = 0;
+
+        return 0;
+    }
+
+    int high = get_int_value_from_env("EVICTION_HIGH_WATERMARK");
+    int low = high;
+
+    if (getenv("EVICTION_LOW_WATERMARK") != NULL) {
+        low = get_int_value_from_env("EVICTION_LOW_WATERMARK");
+    }
+
+    // the watermarks are percentages of the capacity
+    if (high < 0 || high > 100 || low < 0 || low > high) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    *high_watermark = high;
+    *low_watermark = low;
+
+    return 0;
+}
+
+/**
+ * Get the real event loop value from the env. The event loop is
+ * optional: if it is not set, the server waits with select.
+ *
+ * @param event_loop    The pointer where to write the event loop
+ *                      read from the env.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int get_event_loop_from_env(enum gnl_fss_event_loop *event_loop) {
+    char *el = getenv("EVENT_LOOP");
+
+    int res = 0;
+
+    if (el == NULL || (strcmp("select", el) == 0)) {
+        *event_loop = GNL_FSS_EVENT_LOOP_SELECT;
+    }
+
+    else if ((strcmp("epoll", el) == 0)) {
+        *event_loop = GNL_FSS_EVENT_LOOP_EPOLL;
+    }
+
+    else if ((strcmp("reactor", el) == 0)) {
+        *event_loop = GNL_FSS_EVENT_LOOP_REACTOR;
+    }
+
     else {
         errno = EINVAL;
         res = -1;
@@ -110,6 +266,11 @@ struct gnl_fss_config *gnl_fss_config_init() {
     config->capacity = 100;
     config->limit = 100;
     config->replacement_policy = GNL_SIMFS_RP_NONE;
+    config->compression = GNL_SIMFS_COMPRESSION_HUFFMAN;
+    config->frequency_aging = 0;
+    config->eviction_high_watermark = 0;
+    config->eviction_low_watermark = 0;
+    config->event_loop = GNL_FSS_EVENT_LOOP_SELECT;
     config->socket = "/tmp/gnl_fss.sk";
     config->log_filepath = "/var/log/gnl_fss.log";
     config->log_level = "error";
@@ -139,6 +300,24 @@ struct gnl_fss_config *gnl_fss_config_init_from_env() {
 
     config->replacement_policy = rp;
 
+    enum gnl_simfs_compression compression;
+    res = get_compression_from_env(&compression);
+    GNL_MINUS1_CHECK_FREE_ON_ERROR(config, res, errno, NULL)
+
+    config->compression = compression;
+
+    res = get_frequency_aging_from_env(&(config->frequency_aging));
+    GNL_MINUS1_CHECK_FREE_ON_ERROR(config, res, errno, NULL)
+
+    res = get_eviction_watermarks_from_env(&(config->eviction_high_watermark), &(config->eviction_low_watermark));
+    GNL_MINUS1_CHECK_FREE_ON_ERROR(config, res, errno, NULL)
+
+    enum gnl_fss_event_loop event_loop;
+    res = get_event_loop_from_env(&event_loop);
+    GNL_MINUS1_CHECK_FREE_ON_ERROR(config, res, errno, NULL)
+
+    config->event_loop = event_loop;
+
     config->socket = getenv("SOCKET");
     config->log_filepath = getenv("LOG_FILE");
     config->log_level = getenv("LOG_LEVEL");
@@ -5,14 +5,26 @@
 #include <unistd.h>
 #include <errno.h>
 #include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <fcntl.h>
 #include <signal.h>
+#include <time.h>
+#include <pthread.h>
 #include <gnl_logger.h>
 #include "gnl_fss_thread_pool.c"
 #include <gnl_simfs_file_system.h>
 #include "../include/gnl_fss_server.h"
 #include <gnl_macro_beg.h>
 
-#define GNL_FSS_SERVER_BUFFER_LEN 11
+// the max number of handled clients got from the thread pool at once
+#define GNL_FSS_SERVER_HANDLED_BATCH 64
+
+// the max number of ready file descriptors returned by one epoll_wait
+#define GNL_FSS_SERVER_EPOLL_EVENTS 64
+
+// the interval between two heap size checks of the reclaimer
+#define GNL_FSS_SERVER_RECLAIMER_INTERVAL_MS 100
 
 volatile sig_atomic_t soft_termination = 0;
 volatile sig_atomic_t hard_termination = 0;
@@ -96,6 +108,148 @@ static struct gnl_fss_thread_pool *create_thread_pool(int size, struct gnl_simfs
     return thread_pool;
 }
 
+/**
+ * Holds the background reclaimer information.
+ */
+struct gnl_fss_reclaimer {
+
+    // the id of the reclaimer thread
+    pthread_t id;
+
+    // the file system instance where to reclaim memory
+    struct gnl_simfs_file_system *file_system;
+
+    // the percentage of the capacity above which to evict
+    unsigned int high_watermark;
+
+    // the percentage of the capacity where to stop evicting
+    unsigned int low_watermark;
+
+    // set to 1 to stop the reclaimer, guarded by mtx
+    int stop;
+
+    // the lock and the condition variable to use
+    // to wake up the reclaimer to stop it
+    pthread_mutex_t mtx;
+    pthread_cond_t cond;
+
+    // the logger instance to use for logging
+    const struct gnl_logger *logger;
+};
+
+/**
+ * Run the reclaimer: periodically check the heap size of the file
+ * system, evicting files in background when it crosses the high
+ * watermark, until the reclaimer is stopped.
+ *
+ * @param args  The gnl_fss_reclaimer instance.
+ *
+ * @return      Returns always NULL.
+ */
+static void *reclaimer_handle(void *args) {
+    struct gnl_fss_reclaimer *reclaimer = (struct gnl_fss_reclaimer *)args;
+
+    sigset_t set;
+    struct timespec deadline;
+    long long freed;
+
+    // the termination signals must be handled by the main thread
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGQUIT);
+    sigaddset(&set, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+    pthread_mutex_lock(&(reclaimer->mtx));
+
+    while (reclaimer->stop == 0) {
+        pthread_mutex_unlock(&(reclaimer->mtx));
+
+        freed = gnl_simfs_file_system_reclaim(reclaimer->file_system, reclaimer->high_watermark,
+                                              reclaimer->low_watermark);
+        if (freed == -1) {
+            gnl_logger_error(reclaimer->logger, "reclaimer error: %s", strerror(errno));
+        } else if (freed > 0) {
+            gnl_logger_debug(reclaimer->logger, "reclaimer freed %lld bytes", freed);
+        }
+
+        pthread_mutex_lock(&(reclaimer->mtx));
+
+        // wait for the next check, or for the stop
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += GNL_FSS_SERVER_RECLAIMER_INTERVAL_MS * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+
+        while (reclaimer->stop == 0 && pthread_cond_timedwait(&(reclaimer->cond), &(reclaimer->mtx), &deadline) == 0);
+    }
+
+    pthread_mutex_unlock(&(reclaimer->mtx));
+
+    return NULL;
+}
+
+/**
+ * Start the background reclaimer on the given file system.
+ *
+ * @param file_system   The file system instance where to reclaim memory.
+ * @param config        The configuration instance of the server.
+ * @param logger        The logger instance to use for logging.
+ *
+ * @return              Returns the started reclaimer on success,
+ *                      NULL otherwise.
+ */
+static struct gnl_fss_reclaimer *start_reclaimer(struct gnl_simfs_file_system *file_system,
+        const struct gnl_fss_config *config, const struct gnl_logger *logger) {
+
+    struct gnl_fss_reclaimer *reclaimer = (struct gnl_fss_reclaimer *)malloc(sizeof(struct gnl_fss_reclaimer));
+    GNL_NULL_CHECK(reclaimer, ENOMEM, NULL)
+
+    reclaimer->file_system = file_system;
+    reclaimer->high_watermark = config->eviction_high_watermark;
+    reclaimer->low_watermark = config->eviction_low_watermark;
+    reclaimer->stop = 0;
+    reclaimer->logger = logger;
+
+    int res = pthread_mutex_init(&(reclaimer->mtx), NULL);
+    GNL_MINUS1_CHECK(-1 * (res != 0), res, NULL)
+
+    res = pthread_cond_init(&(reclaimer->cond), NULL);
+    GNL_MINUS1_CHECK(-1 * (res != 0), res, NULL)
+
+    res = pthread_create(&(reclaimer->id), NULL, &reclaimer_handle, (void *)reclaimer);
+    GNL_MINUS1_CHECK(-1 * (res != 0), res, NULL)
+
+    gnl_logger_info(logger, "started the reclaimer, eviction watermarks: %u%% - %u%%", reclaimer->high_watermark,
+                    reclaimer->low_watermark);
+
+    return reclaimer;
+}
+
+/**
+ * Stop the given background reclaimer and destroy it.
+ *
+ * @param reclaimer The reclaimer to stop.
+ */
+static void stop_reclaimer(struct gnl_fss_reclaimer *reclaimer) {
+    if (reclaimer == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&(reclaimer->mtx));
+    reclaimer->stop = 1;
+    pthread_cond_signal(&(reclaimer->cond));
+    pthread_mutex_unlock(&(reclaimer->mtx));
+
+    pthread_join(reclaimer->id, NULL);
+
+    gnl_logger_info(reclaimer->logger, "stopped the reclaimer");
+
+    pthread_mutex_destroy(&(reclaimer->mtx));
+    pthread_cond_destroy(&(reclaimer->cond));
+    free(reclaimer);
+}
+
 /**
  * Create the server using the given socket name.
  *
@@ -159,11 +313,11 @@ static int run_server(int fd_skt, struct gnl_fss_thread_pool *thread_pool, const
     // file descriptor of a client
     int fd_c;
 
-    // read buffer
-    char buf[GNL_FSS_SERVER_BUFFER_LEN];
+    // clients given back by the thread pool
+    int handled[GNL_FSS_SERVER_HANDLED_BATCH];
 
-    // number of chars read
-    long nread;
+    // number of clients given back by the thread pool
+    int nhandled;
 
     // max active file descriptor index
     int fd_num = 0;
@@ -178,6 +332,10 @@ static int run_server(int fd_skt, struct gnl_fss_thread_pool *thread_pool, const
     int master_channel = gnl_fss_thread_pool_master_channel(thread_pool);
     GNL_MINUS1_CHECK(master_channel, errno, -1)
 
+    // get the max number of clients the thread pool can serve at once
+    int max_clients = gnl_fss_thread_pool_max_clients(thread_pool);
+    GNL_MINUS1_CHECK(max_clients, errno, -1)
+
     // reset mask
     FD_ZERO(&set);
 
@@ -255,6 +413,21 @@ static int run_server(int fd_skt, struct gnl_fss_thread_pool *thread_pool, const
                         continue;
                     }
 
+                    // if the thread pool can not serve more clients, refuse the connection
+                    if (active_connections >= max_clients) {
+                        res = close(fd_c);
+                        if (res == -1) {
+                            gnl_logger_error(logger, "error closing the refused client %d: %s, error ignored",
+                                             fd_c, strerror(errno));
+                        }
+
+                        gnl_logger_warn(logger, "the server has already %d active connections, connection from "
+                                                "client refused", active_connections);
+
+                        // resume for loop
+                        continue;
+                    }
+
                     gnl_logger_debug(logger, "connection from client accepted, assigned id %d", fd_c);
 
                     active_connections++;
@@ -268,35 +441,314 @@ static int run_server(int fd_skt, struct gnl_fss_thread_pool *thread_pool, const
                         fd_num = fd_c;
                     }
 
-                } else if (fd == master_channel) { // a worker has handled a request
+                } else if (fd == master_channel) { // the workers have handled some requests
+
+                    gnl_logger_debug(logger, "received messages from the thread pool");
 
-                    gnl_logger_debug(logger, "received message from the thread pool");
+                    // get the clients given back by the workers
+                    nhandled = gnl_fss_thread_pool_handled(thread_pool, handled, GNL_FSS_SERVER_HANDLED_BATCH);
+                    if (nhandled == -1) {
+                        gnl_logger_error(logger, "error reading the messages: %s", strerror(errno));
+
+                        // do not stop the server: the show must go on
+                        continue;
+                    }
 
-                    // clear the buffer
-                    memset(buf, 0, GNL_FSS_SERVER_BUFFER_LEN);
+                    for (int j=0; j<nhandled; j++) {
+                        fd_c = handled[j];
 
-                    // read the client file descriptor from the channel
-                    nread = gnl_socket_service_readn(fd, buf, GNL_FSS_SERVER_BUFFER_LEN);
-                    if (nread == -1) {
-                        gnl_logger_error(logger, "error reading the message: %s", strerror(errno));
+                        // if EOF...
+                        if (fd_c == 0) {
+                            active_connections--;
+
+                            gnl_logger_debug(logger, "a client has gone away");
+                            gnl_logger_debug(logger, "the server has now %d active connections", active_connections);
+
+                            // if we are in a "soft termination" and active_connections == 0,
+                            // then return
+                            if (soft_termination == 1 && active_connections == 0) {
+                                gnl_logger_debug(logger, "soft termination in progress, the server will shut down");
+                                return 0;
+                            }
+
+                            // resume for loop
+                            continue;
+                        }
+
+                        gnl_logger_debug(logger, "client %d request handled", fd_c);
+
+                        // put the client file descriptor back into the active file descriptors set
+                        FD_SET(fd_c, &set);
+
+                        gnl_logger_debug(logger, "client %d put into the active file descriptors set", fd_c);
+
+                        // update fd_num with the max file descriptor active index
+                        if (fd_c > fd_num) {
+                            fd_num = fd_c;
+                        }
+                    }
+
+                } else { // if there is an I/O request...
+
+                    gnl_logger_debug(logger, "I/O request received from client %d", fd);
+
+                    // remove the file descriptor from the active file descriptors set
+                    FD_CLR(fd, &set);
+
+                    gnl_logger_debug(logger, "client %d removed from the active file descriptors set", fd);
+
+                    // update fd_num
+                    if (fd == fd_num) {
+                        fd_num--;
+                    }
+
+                    // pass the file descriptor to the thread pool
+                    res = gnl_fss_thread_pool_dispatch(thread_pool, fd);
+                    if (res == -1) {
+                        gnl_logger_error(logger, "error dispatching the client %d to the thread pool: %s, "
+                                                 "the request will be dispatched again", fd, strerror(errno));
+
+                        // put the client back, so its pending request wakes up the select again
+                        FD_SET(fd, &set);
+
+                        if (fd > fd_num) {
+                            fd_num = fd;
+                        }
 
                         // do not stop the server: the show must go on
                         continue;
                     }
 
-                    // initialize the message struct sent by a worker
-                    struct gnl_message_n *message_from_worker = gnl_message_n_init();
-                    GNL_NULL_CHECK(message_from_worker, errno, -1)
+                    gnl_logger_debug(logger, "I/O request from client %d sent to the thread pool", fd);
+                }
+            }
+        }
 
-                    // decode the message sent by a worker
-                    res = gnl_message_n_from_string(buf, message_from_worker);
-                    GNL_MINUS1_CHECK(res, errno, -1)
+        gnl_logger_debug(logger, "select (system call) handling done, resume loop");
+    }
+}
+
+/**
+ * Raise the limit of the open file descriptors of the process to its
+ * maximum, so the epoll event loops can handle more than FD_SETSIZE
+ * connections.
+ *
+ * @param logger    The logger instance to use for logging.
+ */
+static void raise_open_files_limit(const struct gnl_logger *logger) {
+    struct rlimit limit;
+
+    if (getrlimit(RLIMIT_NOFILE, &limit) == -1) {
+        gnl_logger_warn(logger, "unable to get the open files limit: %s", strerror(errno));
+
+        return;
+    }
+
+    limit.rlim_cur = limit.rlim_max;
+
+    if (setrlimit(RLIMIT_NOFILE, &limit) == -1) {
+        gnl_logger_warn(logger, "unable to raise the open files limit: %s", strerror(errno));
+
+        return;
+    }
+
+    gnl_logger_debug(logger, "open files limit raised to %lu", (unsigned long)limit.rlim_cur);
+}
+
+/**
+ * Drop a client whose session is open but that the epoll event loop can not
+ * arm anymore. The connection is shut down and the client is dispatched to
+ * the thread pool, so a worker reads the end of file and removes its session
+ * as for a client gone away.
+ *
+ * @param fd_c          The client file descriptor.
+ * @param thread_pool   The tread pool were to dispatch the client.
+ * @param logger        The logger instance to use for logging.
+ */
+static void drop_client(int fd_c, struct gnl_fss_thread_pool *thread_pool, const struct gnl_logger *logger) {
+    int res;
+
+    res = shutdown(fd_c, SHUT_RDWR);
+    if (res == -1) {
+        gnl_logger_error(logger, "error shutting down the connection with client %d: %s, error ignored",
+                         fd_c, strerror(errno));
+    }
+
+    res = gnl_fss_thread_pool_dispatch(thread_pool, fd_c);
+    if (res == -1) {
+        gnl_logger_error(logger, "error dispatching the dropped client %d to the thread pool: %s, "
+                                 "its session will not be removed", fd_c, strerror(errno));
+    }
+}
+
+/**
+ * Run the epoll event loop of the server, handling new connections or requests.
+ *
+ * @param epfd              The epoll instance file descriptor, where the server
+ *                          file descriptor and the master channel are registered.
+ * @param fd_skt            The server file descriptor, it must be non-blocking.
+ * @param thread_pool       The tread pool were to dispatch the message.
+ * @param reactors          1 if the workers of the thread pool are reactors,
+ *                          0 otherwise.
+ * @param logger            The logger instance to use for logging.
+ *
+ * @return                  Returns 0 on termination, -1 on error.
+ */
+static int run_epoll_loop(int epfd, int fd_skt, struct gnl_fss_thread_pool *thread_pool, int reactors,
+        const struct gnl_logger *logger) {
+    int res;
+
+    // ready file descriptors
+    struct epoll_event events[GNL_FSS_SERVER_EPOLL_EVENTS];
+
+    // number of ready file descriptors
+    int nready;
+
+    // file descriptor of a ready event
+    int fd;
+
+    // file descriptor of a client
+    int fd_c;
+
+    // clients given back by the thread pool
+    int handled[GNL_FSS_SERVER_HANDLED_BATCH];
+
+    // number of clients given back by the thread pool
+    int nhandled;
+
+    // active connections
+    int active_connections = 0;
+
+    // get the master channel of the thread pool to read a result from a worker thread.
+    int master_channel = gnl_fss_thread_pool_master_channel(thread_pool);
+    GNL_MINUS1_CHECK(master_channel, errno, -1)
+
+    // get the max number of clients the thread pool can serve at once
+    int max_clients = gnl_fss_thread_pool_max_clients(thread_pool);
+    GNL_MINUS1_CHECK(max_clients, errno, -1)
+
+    while (1) {
+
+        // wait for connections
+        nready = epoll_wait(epfd, events, GNL_FSS_SERVER_EPOLL_EVENTS, -1);
+        if (nready == -1) {
+            if (errno == EINTR && hard_termination == 1) {
+                gnl_logger_info(logger, "hard termination: the server will shut down immediately, "
+                                        "every active connection will be closed.");
+
+                return 0;
+            }
+
+            if (errno == EINTR && soft_termination == 1) {
+                gnl_logger_info(logger, "soft termination: the server will shut down after every clients "
+                                        "request will be handled, no others connections will be accepted.");
+
+                if (active_connections == 0) {
+                    return 0;
+                } else {
+                    // wait for current active clients termination
+                    continue;
+                }
+            }
+
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // if this point is reached then there is an error, return
+            gnl_logger_error(logger, "epoll_wait (system call) returned with error: %s", strerror(errno));
+
+            return -1;
+        }
+
+        gnl_logger_debug(logger, "epoll_wait (system call) returned %d ready file descriptors, handling", nready);
+
+        // foreach ready file descriptor...
+        for (int i=0; i<nready; i++) {
+            fd = events[i].data.fd;
+
+            // if there are incoming connections...
+            if (fd == fd_skt) {
+
+                gnl_logger_debug(logger, "one or more clients requested to connect");
+
+                // the server file descriptor is edge-triggered,
+                // so accept every pending connection
+                while ((fd_c = accept(fd_skt, NULL, 0)) != -1) {
+
+                    // if a soft termination is in progress, refuse the connection
+                    if (soft_termination == 1) {
+                        res = close(fd_c);
+                        if (res == -1) {
+                            gnl_logger_error(logger, "error closing the refused client %d: %s, error ignored",
+                                             fd_c, strerror(errno));
+                        }
+
+                        gnl_logger_debug(logger, "soft termination in progress, connection from client refused");
+
+                        continue;
+                    }
+
+                    // if the thread pool can not serve more clients, refuse the connection
+                    if (active_connections >= max_clients) {
+                        res = close(fd_c);
+                        if (res == -1) {
+                            gnl_logger_error(logger, "error closing the refused client %d: %s, error ignored",
+                                             fd_c, strerror(errno));
+                        }
+
+                        gnl_logger_warn(logger, "the server has already %d active connections, connection from "
+                                                "client refused", active_connections);
+
+                        continue;
+                    }
 
-                    // finally, get the file descriptor
-                    fd_c = message_from_worker->number;
+                    // register the client file descriptor, or
+                    // hand it over to a reactor that will own it
+                    if (reactors) {
+                        res = gnl_fss_thread_pool_assign(thread_pool, fd_c);
+                    } else {
+                        res = arm_client(epfd, fd_c, EPOLL_CTL_ADD);
+                    }
+
+                    // the client has no session yet, so it can be just closed
+                    if (res == -1) {
+                        gnl_logger_error(logger, "error registering the client %d: %s, connection refused",
+                                         fd_c, strerror(errno));
 
-                    // the message_from_worker is not necessary anymore, destroy it
-                    gnl_message_n_destroy(message_from_worker);
+                        close(fd_c);
+
+                        // do not stop the server: the show must go on
+                        continue;
+                    }
+
+                    active_connections++;
+
+                    gnl_logger_debug(logger, "connection from client accepted, assigned id %d", fd_c);
+                    gnl_logger_debug(logger, "the server has now %d active connections", active_connections);
+                }
+
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ECONNABORTED && errno != EINTR) {
+                    gnl_logger_error(logger, "accept (system call) returned with error: %s", strerror(errno));
+
+                    // do not stop the server: the show must go on
+                }
+
+            } else if (fd == master_channel) { // the workers have handled some requests
+
+                gnl_logger_debug(logger, "received messages from the thread pool");
+
+                // get the clients given back by the workers
+                nhandled = gnl_fss_thread_pool_handled(thread_pool, handled, GNL_FSS_SERVER_HANDLED_BATCH);
+                if (nhandled == -1) {
+                    gnl_logger_error(logger, "error reading the messages: %s", strerror(errno));
+
+                    // do not stop the server: the show must go on
+                    continue;
+                }
+
+                for (int j=0; j<nhandled; j++) {
+                    fd_c = handled[j];
 
                     // if EOF...
                     if (fd_c == 0) {
@@ -318,49 +770,120 @@ static int run_server(int fd_skt, struct gnl_fss_thread_pool *thread_pool, const
 
                     gnl_logger_debug(logger, "client %d request handled", fd_c);
 
-                    // put the client file descriptor back into the active file descriptors set
-                    FD_SET(fd_c, &set);
+                    // arm the client file descriptor again, if the client
+                    // already sent another request it is reported at once
+                    res = arm_client(epfd, fd_c, EPOLL_CTL_MOD);
+                    if (res == -1) {
+                        gnl_logger_error(logger, "error arming again the client %d: %s, client dropped",
+                                         fd_c, strerror(errno));
 
-                    gnl_logger_debug(logger, "client %d put into the active file descriptors set", fd_c);
+                        drop_client(fd_c, thread_pool, logger);
 
-                    // update fd_num with the max file descriptor active index
-                    if (fd_c > fd_num) {
-                        fd_num = fd_c;
+                        // do not stop the server: the show must go on
+                        continue;
                     }
 
-                } else { // if there is an I/O request...
+                    gnl_logger_debug(logger, "client %d armed again", fd_c);
+                }
 
-                    gnl_logger_debug(logger, "I/O request received from client %d", fd);
+            } else { // if there is an I/O request...
 
-                    // remove the file descriptor from the active file descriptors set
-                    FD_CLR(fd, &set);
+                gnl_logger_debug(logger, "I/O request received from client %d", fd);
 
-                    gnl_logger_debug(logger, "client %d removed from the active file descriptors set", fd);
+                // the file descriptor is disarmed until the
+                // worker gives it back, so just pass it to the thread pool
+                res = gnl_fss_thread_pool_dispatch(thread_pool, fd);
+                if (res == -1) {
+                    gnl_logger_error(logger, "error dispatching the client %d to the thread pool: %s, "
+                                             "the request will be dispatched again", fd, strerror(errno));
 
-                    // update fd_num
-                    if (fd == fd_num) {
-                        fd_num--;
+                    // arm the client again, so its pending request wakes up the loop again
+                    res = arm_client(epfd, fd, EPOLL_CTL_MOD);
+                    if (res == -1) {
+                        gnl_logger_error(logger, "error arming again the client %d: %s, error ignored",
+                                         fd, strerror(errno));
                     }
 
-                    // copy the file descriptor to prevent changes side effects
-                    int *fd_copy = malloc(sizeof(int));
-                    GNL_NULL_CHECK(fd_copy, ENOMEM, -1)
-
-                    *fd_copy = fd;
-
-                    // pass the file descriptor to the thread pool
-                    res = gnl_fss_thread_pool_dispatch(thread_pool, fd_copy);
-                    GNL_MINUS1_CHECK(res, errno, -1)
-
-                    gnl_logger_debug(logger, "I/O request from client %d sent to the thread pool", fd);
+                    // do not stop the server: the show must go on
+                    continue;
                 }
+
+                gnl_logger_debug(logger, "I/O request from client %d sent to the thread pool", fd);
             }
         }
 
-        gnl_logger_debug(logger, "select (system call) handling done, resume loop");
+        gnl_logger_debug(logger, "epoll_wait (system call) handling done, resume loop");
     }
 }
 
+/**
+ * Run the server handling new connections or requests with an epoll
+ * event loop. Unlike the select event loop, it does not scan all the
+ * file descriptors on every wake up and it is not limited to FD_SETSIZE
+ * connections. If the workers are reactors, the event loop only accepts
+ * the connections and assigns them to the reactors, which own them
+ * until they go away.
+ *
+ * @param fd_skt            The server file descriptor.
+ * @param thread_pool       The tread pool were to dispatch the message.
+ * @param reactors          1 if the workers of the thread pool are reactors,
+ *                          0 otherwise.
+ * @param logger            The logger instance to use for logging.
+ *
+ * @return                  Returns 0 on termination, -1 on error.
+ */
+static int run_server_epoll(int fd_skt, struct gnl_fss_thread_pool *thread_pool, int reactors,
+        const struct gnl_logger *logger) {
+    int res;
+    struct epoll_event event;
+
+    // get the master channel of the thread pool to read a result from a worker thread.
+    int master_channel = gnl_fss_thread_pool_master_channel(thread_pool);
+    GNL_MINUS1_CHECK(master_channel, errno, -1)
+
+    // the server file descriptor is edge-triggered, so
+    // it must not block once the connections are drained
+    int flags = fcntl(fd_skt, F_GETFL);
+    GNL_MINUS1_CHECK(flags, errno, -1)
+
+    res = fcntl(fd_skt, F_SETFL, flags | O_NONBLOCK);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // create the epoll instance
+    int epfd = epoll_create1(0);
+    GNL_MINUS1_CHECK(epfd, errno, -1)
+
+    // register the server file descriptor
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = fd_skt;
+
+    res = epoll_ctl(epfd, EPOLL_CTL_ADD, fd_skt, &event);
+
+    // register the master channel, it is level-triggered
+    // since one message per time is read from it
+    if (res == 0) {
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = master_channel;
+
+        res = epoll_ctl(epfd, EPOLL_CTL_ADD, master_channel, &event);
+    }
+
+    if (res == 0) {
+        gnl_logger_debug(logger, "epoll event loop created");
+
+        res = run_epoll_loop(epfd, fd_skt, thread_pool, reactors, logger);
+    }
+
+    // close the epoll instance preserving the errno
+    int errno_loop = errno;
+    close(epfd);
+    errno = errno_loop;
+
+    return res;
+}
+
 int gnl_fss_server_start(const struct gnl_fss_config *config) {
     // validate the socket name
     char *socket_name = config->socket;
@@ -386,7 +909,7 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     // instantiate the file_system
     gnl_logger_debug(logger, "starting the file system...");
 
-    struct gnl_simfs_file_system *file_system = gnl_simfs_file_system_init(config->capacity, config->limit, config->log_filepath, config->log_level, config->replacement_policy);
+    struct gnl_simfs_file_system *file_system = gnl_simfs_file_system_init(config->capacity, config->limit, config->log_filepath, config->log_level, config->replacement_policy, config->compression, config->frequency_aging);
     GNL_NULL_CHECK(logger, errno, -1)
 
     gnl_logger_debug(logger, "file system started");
@@ -399,6 +922,19 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     gnl_logger_debug(logger, "capacity: %d MB", config->capacity);
     gnl_logger_debug(logger, "files limit: %d", config->limit);
     gnl_logger_debug(logger, "replacement policy: %s", dest);
+
+    // free memory
+    free(dest);
+
+    res = gnl_simfs_file_system_get_compression(file_system, &dest);
+    GNL_MINUS1_CHECK(res, errno, -1);
+
+    gnl_logger_debug(logger, "compression: %s", dest);
+    gnl_logger_debug(logger, "frequency aging: %u", config->frequency_aging);
+    gnl_logger_debug(logger, "eviction watermarks: %u%% - %u%%", config->eviction_high_watermark,
+                     config->eviction_low_watermark);
+    gnl_logger_debug(logger, "event loop: %s", config->event_loop == GNL_FSS_EVENT_LOOP_REACTOR ? "reactor" :
+                                               config->event_loop == GNL_FSS_EVENT_LOOP_EPOLL ? "epoll" : "select");
     gnl_logger_debug(logger, "socket filename: %s", config->socket);
     gnl_logger_debug(logger, "log file: %s", config->log_filepath);
     gnl_logger_debug(logger, "log level: %s", config->log_level);
@@ -406,6 +942,12 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     // free memory
     free(dest);
 
+    // the epoll event loops are not limited to FD_SETSIZE connections,
+    // raise the limit before the thread pool sizes its tables on it
+    if (config->event_loop != GNL_FSS_EVENT_LOOP_SELECT) {
+        raise_open_files_limit(logger);
+    }
+
     // start the thread pool
     struct gnl_fss_thread_pool *thread_pool = create_thread_pool(config->thread_workers, file_system, config, logger);
     if (thread_pool == NULL) {
@@ -414,6 +956,17 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
         return -1;
     }
 
+    // start the reclaimer, if enabled; on error the files are
+    // still evicted by the writes, so the server can go on
+    struct gnl_fss_reclaimer *reclaimer = NULL;
+
+    if (config->eviction_high_watermark > 0) {
+        reclaimer = start_reclaimer(file_system, config, logger);
+        if (reclaimer == NULL) {
+            gnl_logger_error(logger, "error starting the reclaimer: %s", strerror(errno));
+        }
+    }
+
     // socket connection file descriptor
     int fd_skt;
     int errno_main = 0;
@@ -422,8 +975,14 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     fd_skt = create_server(socket_name, logger);
     if (fd_skt >= 0) {
 
-        // run the server
-        res = run_server(fd_skt, thread_pool, logger);
+        // run the server with the configured event loop
+        if (config->event_loop == GNL_FSS_EVENT_LOOP_EPOLL) {
+            res = run_server_epoll(fd_skt, thread_pool, 0, logger);
+        } else if (config->event_loop == GNL_FSS_EVENT_LOOP_REACTOR) {
+            res = run_server_epoll(fd_skt, thread_pool, 1, logger);
+        } else {
+            res = run_server(fd_skt, thread_pool, logger);
+        }
 
         if (res == -1) {
             errno_main = errno;
@@ -440,6 +999,9 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     // if you reach this point means that the server execution
     // is terminated (due to an error or a signal)
 
+    // stop the reclaimer before touching the file system
+    stop_reclaimer(reclaimer);
+
     // print the file system status
     gnl_simfs_file_system_status(file_system);
 
@@ -464,6 +1026,8 @@ int gnl_fss_server_start(const struct gnl_fss_config *config) {
     return res;
 }
 
-#undef GNL_FSS_SERVER_BUFFER_LEN
+#undef GNL_FSS_SERVER_HANDLED_BATCH
+#undef GNL_FSS_SERVER_EPOLL_EVENTS
+#undef GNL_FSS_SERVER_RECLAIMER_INTERVAL_MS
 
 #include <gnl_macro_end.h>
\ No newline at end of file
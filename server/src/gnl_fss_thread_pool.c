@@ -1,12 +1,23 @@
 #include <stdlib.h>
 #include <errno.h>
 #include <pthread.h>
-#include <gnl_ts_bb_queue_t.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <gnl_ts_mpmc_queue_t.h>
+#include <gnl_ts_mpsc_ring_t.h>
 #include "./gnl_fss_waiting_list.c"
 #include "./gnl_fss_worker.c"
 #include "../include/gnl_fss_thread_pool.h"
 #include <gnl_macro_beg.h>
 
+// the max number of clients tracked by the thread pool
+#define GNL_FSS_THREAD_POOL_MAX_OWNERS 1048576
+
+// the max number of clients storable into the worker
+// queue and into the completion ring
+#define GNL_FSS_THREAD_POOL_MAX_QUEUED 65536
+
 /**
  * {@inheritDoc}
  */
@@ -19,8 +30,8 @@ struct gnl_fss_thread_pool {
     struct gnl_fss_worker **workers;
 
     // the thread-safe blocking bounded queue to use to
-    // receive a ready file descriptor from a main thread
-    struct gnl_ts_bb_queue_t *worker_queue;
+    // send a ready file descriptor to the workers
+    struct gnl_ts_mpmc_queue_t *worker_queue;
 
     // the waiting list to store the clients waiting for 
     // a file unlocking
@@ -29,17 +40,38 @@ struct gnl_fss_thread_pool {
     // the file system instance to use to store the files
     struct gnl_simfs_file_system *file_system;
 
-    // the pipe channel where to read a result from a
-    // worker thread
-    int pipe_master_channel;
+    // the ring where the workers give the handled
+    // clients back to the master thread
+    struct gnl_ts_mpsc_ring_t *completion_ring;
 
-    // the pipe channel where to send the result to a
-    // master thread
-    int pipe_worker_channel;
+    // the eventfd written by the workers to wake up
+    // the master thread after a client is given back
+    int completion_fd;
 
     // the size of the thread pool
     int size;
 
+    // the epoll instances of the workers, one per worker,
+    // NULL if the workers are not reactors
+    int *reactor_epfds;
+
+    // the epoll instances owning the clients, indexed
+    // by the client file descriptor
+    int *owners;
+
+    // the number of entries of the owners table
+    int owners_size;
+
+    // the reactor to which assign the next client
+    int next_reactor;
+
+    // the file descriptor that becomes readable
+    // when the reactors must terminate
+    int terminate_fd;
+
+    // the max number of clients the thread pool can serve at once
+    int max_clients;
+
     // the logger instance to use for logging
     struct gnl_logger *logger;
 };
@@ -79,28 +111,100 @@ struct gnl_fss_thread_pool *gnl_fss_thread_pool_init(int size, struct gnl_simfs_
     thread_pool->worker_ids = malloc(size * sizeof(pthread_t));
     GNL_NULL_CHECK(thread_pool->worker_ids, ENOMEM, NULL)
 
-    // instantiate the blocking bounded queue to communicate with the workers
-    thread_pool->worker_queue = gnl_ts_bb_queue_init(size);
-    GNL_NULL_CHECK(thread_pool->worker_queue, errno, NULL)
-
-    gnl_logger_debug(thread_pool->logger, "worker blocking bounded queue created");
-
     // instantiate the non-blocking queue for the waiting list
     thread_pool->waiting_list = gnl_fss_waiting_list_init();
     GNL_NULL_CHECK(thread_pool->waiting_list, errno, NULL)
 
     gnl_logger_debug(thread_pool->logger, "waiting non-blocking queue created");
 
-    // create the pipe channels
-    int pipe_channels[2];
+    // get the max number of file descriptors the process can open
+    struct rlimit limit;
 
-    res = pipe(pipe_channels);
+    res = getrlimit(RLIMIT_NOFILE, &limit);
     GNL_MINUS1_CHECK(res, errno, NULL)
 
-    thread_pool->pipe_master_channel = pipe_channels[0];
-    thread_pool->pipe_worker_channel = pipe_channels[1];
+    int clients_limit = GNL_FSS_THREAD_POOL_MAX_OWNERS;
+    if (limit.rlim_cur < GNL_FSS_THREAD_POOL_MAX_OWNERS) {
+        clients_limit = limit.rlim_cur;
+    }
+
+    // create the completion ring, every client can be given back at most
+    // once, plus once more if it is gone away
+    int completions = 2 * clients_limit;
+    if (completions > GNL_FSS_THREAD_POOL_MAX_QUEUED) {
+        completions = GNL_FSS_THREAD_POOL_MAX_QUEUED;
+    }
+
+    thread_pool->completion_ring = gnl_ts_mpsc_ring_init(completions);
+    GNL_NULL_CHECK(thread_pool->completion_ring, errno, NULL)
+
+    thread_pool->completion_fd = eventfd(0, EFD_NONBLOCK);
+    GNL_MINUS1_CHECK(thread_pool->completion_fd, errno, NULL)
+
+    gnl_logger_debug(thread_pool->logger, "workers completion ring created");
+
+    // instantiate the blocking bounded queue to communicate with the workers,
+    // every client is queued at most once, plus the termination messages
+    int queued = clients_limit + size;
+    if (queued > GNL_FSS_THREAD_POOL_MAX_QUEUED) {
+        queued = GNL_FSS_THREAD_POOL_MAX_QUEUED;
+    }
+
+    thread_pool->worker_queue = gnl_ts_mpmc_queue_init(queued);
+    GNL_NULL_CHECK(thread_pool->worker_queue, errno, NULL)
+
+    gnl_logger_debug(thread_pool->logger, "worker blocking bounded queue created");
+
+    // the ring and the queue are capped, so the clients served at once are
+    // bounded as well: within this bound the workers never wait for the master
+    // to make room into the ring, and the master never waits for the workers
+    // to make room into the queue
+    thread_pool->max_clients = clients_limit;
+    if (thread_pool->max_clients > completions / 2) {
+        thread_pool->max_clients = completions / 2;
+    }
+    if (thread_pool->max_clients > queued - size) {
+        thread_pool->max_clients = queued - size;
+    }
+
+    thread_pool->reactor_epfds = NULL;
+    thread_pool->owners = NULL;
+    thread_pool->owners_size = 0;
+    thread_pool->next_reactor = 0;
+    thread_pool->terminate_fd = -1;
+
+    // if the workers are reactors, create the epoll instance of each
+    // worker and the table of the owners, which holds an entry for
+    // every file descriptor the process can open
+    if (config->event_loop == GNL_FSS_EVENT_LOOP_REACTOR) {
+        thread_pool->owners_size = clients_limit;
+
+        thread_pool->owners = calloc(thread_pool->owners_size, sizeof(int));
+        GNL_NULL_CHECK(thread_pool->owners, ENOMEM, NULL)
+
+        thread_pool->reactor_epfds = calloc(size, sizeof(int));
+        GNL_NULL_CHECK(thread_pool->reactor_epfds, ENOMEM, NULL)
+
+        thread_pool->terminate_fd = eventfd(0, 0);
+        GNL_MINUS1_CHECK(thread_pool->terminate_fd, errno, NULL)
 
-    gnl_logger_debug(thread_pool->logger, "workers pipe channels created");
+        struct epoll_event event;
+
+        for (size_t i=0; i<size; i++) {
+            thread_pool->reactor_epfds[i] = epoll_create1(0);
+            GNL_MINUS1_CHECK(thread_pool->reactor_epfds[i], errno, NULL)
+
+            // the termination is level-triggered, so every reactor sees it
+            memset(&event, 0, sizeof(event));
+            event.events = EPOLLIN;
+            event.data.fd = thread_pool->terminate_fd;
+
+            res = epoll_ctl(thread_pool->reactor_epfds[i], EPOLL_CTL_ADD, thread_pool->terminate_fd, &event);
+            GNL_MINUS1_CHECK(res, errno, NULL)
+        }
+
+        gnl_logger_debug(thread_pool->logger, "reactors epoll instances created");
+    }
 
     // instantiate the thread pool workers
     thread_pool->workers = (struct gnl_fss_worker **) malloc(size * sizeof(struct gnl_fss_worker *));
@@ -110,9 +214,16 @@ struct gnl_fss_thread_pool *gnl_fss_thread_pool_init(int size, struct gnl_simfs_
 
     for (size_t i=0; i<size; i++) {
         thread_pool->workers[i] = gnl_fss_worker_init(i, thread_pool->worker_queue, thread_pool->waiting_list,
-                                                      thread_pool->pipe_worker_channel, thread_pool->file_system, config);
+                                                      thread_pool->completion_ring, thread_pool->completion_fd,
+                                                      thread_pool->file_system, config);
         GNL_NULL_CHECK(thread_pool->workers[i], errno, NULL)
 
+        if (thread_pool->reactor_epfds != NULL) {
+            res = gnl_fss_worker_set_reactor(thread_pool->workers[i], thread_pool->reactor_epfds[i],
+                                             thread_pool->owners, thread_pool->terminate_fd);
+            GNL_MINUS1_CHECK(res, errno, NULL)
+        }
+
         res = pthread_create(&(thread_pool->worker_ids[i]), NULL, &gnl_fss_worker_handle, (void *)thread_pool->workers[i]);
         if (res != 0) {
             gnl_logger_warn(thread_pool->logger, "error starting a thread: %s", strerror(errno));
@@ -143,25 +254,26 @@ void gnl_fss_thread_pool_destroy(struct gnl_fss_thread_pool *thread_pool) {
 
     gnl_logger_debug(thread_pool->logger, "destroy requested, proceeding");
 
-    // send one termination message per worker into the thread pool
-    gnl_logger_debug(thread_pool->logger, "sending a termination message to %d threads", thread_pool->size);
-
     int count = 0;
-    for (size_t i=0; i<thread_pool->size; i++) {
 
-        // create the termination message
-        int *termination_mex = malloc(sizeof(int));
-        if (termination_mex == NULL) {
-            errno = ENOMEM;
-            return;
-        }
+    // if the workers are reactors, then wake up all of them at once
+    if (thread_pool->reactor_epfds != NULL) {
+        gnl_logger_debug(thread_pool->logger, "sending the termination to %d reactors", thread_pool->size);
 
-        *termination_mex = GNL_FSS_WORKER_TERMINATE;
+        uint64_t terminate = 1;
+        if (write(thread_pool->terminate_fd, &terminate, sizeof(terminate)) == sizeof(terminate)) {
+            count = thread_pool->size;
+        }
+    } else {
+        // send one termination message per worker into the thread pool
+        gnl_logger_debug(thread_pool->logger, "sending a termination message to %d threads", thread_pool->size);
 
-        res = gnl_fss_thread_pool_dispatch(thread_pool, termination_mex);
+        for (size_t i=0; i<thread_pool->size; i++) {
+            res = gnl_fss_thread_pool_dispatch(thread_pool, GNL_FSS_WORKER_TERMINATE);
 
-        if (res != -1) {
-            count++;
+            if (res != -1) {
+                count++;
+            }
         }
     }
 
@@ -182,12 +294,23 @@ void gnl_fss_thread_pool_destroy(struct gnl_fss_thread_pool *thread_pool) {
     // destroy the worker ids
     free(thread_pool->worker_ids);
 
-    // close the pipe channels
-    close(thread_pool->pipe_master_channel);
-    close(thread_pool->pipe_worker_channel);
+    // destroy the completion ring
+    close(thread_pool->completion_fd);
+    gnl_ts_mpsc_ring_destroy(thread_pool->completion_ring);
+
+    // close the reactors epoll instances
+    if (thread_pool->reactor_epfds != NULL) {
+        for (size_t i=0; i<thread_pool->size; i++) {
+            close(thread_pool->reactor_epfds[i]);
+        }
+
+        close(thread_pool->terminate_fd);
+        free(thread_pool->reactor_epfds);
+        free(thread_pool->owners);
+    }
 
     // destroy the worker queue
-    gnl_ts_bb_queue_destroy(thread_pool->worker_queue, NULL);
+    gnl_ts_mpmc_queue_destroy(thread_pool->worker_queue);
 
     // destroy the waiting list
     gnl_fss_waiting_list_destroy(thread_pool->waiting_list);
@@ -204,12 +327,41 @@ void gnl_fss_thread_pool_destroy(struct gnl_fss_thread_pool *thread_pool) {
 /**
  * {@inheritDoc}
  */
-int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool, void *message) {
+int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool, int message) {
     GNL_NULL_CHECK(thread_pool, EINVAL, -1)
 
-    gnl_logger_debug(thread_pool->logger, "dispatching client %d message to the thread pool", *(int *)message);
+    gnl_logger_debug(thread_pool->logger, "dispatching client %d message to the thread pool", message);
 
-    return gnl_ts_bb_queue_enqueue(thread_pool->worker_queue, message);
+    return gnl_ts_mpmc_queue_enqueue(thread_pool->worker_queue, message);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_thread_pool_assign(struct gnl_fss_thread_pool *thread_pool, int fd_c) {
+    GNL_NULL_CHECK(thread_pool, EINVAL, -1)
+    GNL_NULL_CHECK(thread_pool->reactor_epfds, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (fd_c < 0 || fd_c >= thread_pool->owners_size), EBADF, -1)
+
+    // pick the reactors round-robin
+    int epfd = thread_pool->reactor_epfds[thread_pool->next_reactor];
+    thread_pool->next_reactor = (thread_pool->next_reactor + 1) % thread_pool->size;
+
+    // the owner must be set before the client can be handled
+    thread_pool->owners[fd_c] = epfd;
+
+    gnl_logger_debug(thread_pool->logger, "assigning client %d to the reactor on the epoll instance %d", fd_c, epfd);
+
+    return arm_client(epfd, fd_c, EPOLL_CTL_ADD);
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_thread_pool_max_clients(struct gnl_fss_thread_pool *thread_pool) {
+    GNL_NULL_CHECK(thread_pool, EINVAL, -1)
+
+    return thread_pool->max_clients;
 }
 
 /**
@@ -218,7 +370,44 @@ int gnl_fss_thread_pool_dispatch(struct gnl_fss_thread_pool *thread_pool, void *
 int gnl_fss_thread_pool_master_channel(struct gnl_fss_thread_pool *thread_pool) {
     GNL_NULL_CHECK(thread_pool, EINVAL, -1)
 
-    return thread_pool->pipe_master_channel;
+    return thread_pool->completion_fd;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_fss_thread_pool_handled(struct gnl_fss_thread_pool *thread_pool, int *fds, int size) {
+    GNL_NULL_CHECK(thread_pool, EINVAL, -1)
+    GNL_NULL_CHECK(fds, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (size <= 0), EINVAL, -1)
+
+    int res;
+    uint64_t wakeups;
+
+    // consume the wakeups before draining the ring, so a client given
+    // back while draining wakes up the master again
+    res = read(thread_pool->completion_fd, &wakeups, sizeof(wakeups));
+    if (res == -1 && errno != EAGAIN) {
+        return -1;
+    }
+
+    int count = 0;
+    while (count < size && gnl_ts_mpsc_ring_pop(thread_pool->completion_ring, &fds[count]) == 0) {
+        count++;
+    }
+
+    // the clients left into the ring must wake up the master again
+    if (count == size) {
+        wakeups = 1;
+
+        res = write(thread_pool->completion_fd, &wakeups, sizeof(wakeups));
+        GNL_MINUS1_CHECK(res, errno, -1)
+    }
+
+    return count;
 }
 
-#include <gnl_macro_end.h>
\ No newline at end of file
+#undef GNL_FSS_THREAD_POOL_MAX_OWNERS
+#undef GNL_FSS_THREAD_POOL_MAX_QUEUED
+
+#include <gnl_macro_end.h>
@@ -1,15 +1,27 @@
 #include <unistd.h>
 #include <errno.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
 #include <gnl_socket_request.h>
 #include <gnl_socket_response.h>
 #include <gnl_socket_service.h>
 #include <string.h>
-#include <gnl_message_n.h>
+#include <sched.h>
+#include <stdint.h>
+#include <gnl_ts_mpsc_ring_t.h>
+#include <gnl_ts_mpmc_queue_t.h>
 #include <gnl_list_t.h>
 #include <gnl_simfs_evicted_file.h>
 #include "../include/gnl_fss_worker.h"
 #include <gnl_macro_beg.h>
 
+// the max number of ready clients returned by one epoll_wait of a reactor
+#define GNL_FSS_WORKER_EPOLL_EVENTS 64
+
+// the max number of pipelined requests of a client handled in a row,
+// before giving the client back to let the others be served
+#define GNL_FSS_WORKER_PIPELINE_BUDGET 16
+
 /**
  * {@inheritDoc}
  */
@@ -20,21 +32,45 @@ struct gnl_fss_worker {
 
     // the thread-safe blocking bounded queue to use to
     // receive a ready file descriptor from a main thread
-    struct gnl_ts_bb_queue_t *worker_queue;
+    struct gnl_ts_mpmc_queue_t *worker_queue;
 
     // the waiting list to store the clients waiting for 
     // a file unlocking
     struct gnl_fss_waiting_list *waiting_list;
 
-    // the pipe channel where to send the result to the
-    // main thread
-    int pipe_channel;
+    // the ring where to give the handled clients back
+    // to the main thread
+    struct gnl_ts_mpsc_ring_t *completion_ring;
+
+    // the eventfd to wake up the main thread after a
+    // client is given back
+    int completion_fd;
 
     // the logger instance to use for logging
     struct gnl_logger *logger;
 
     // the file system instance to use to store the files
     struct gnl_simfs_file_system *file_system;
+
+    // the epoll instance where the clients owned by the
+    // worker are registered, -1 if the worker is not a reactor
+    int epfd;
+
+    // the epoll instances owning the clients indexed by their
+    // file descriptor, NULL if the worker is not a reactor
+    const int *owners;
+
+    // the file descriptor that becomes readable when
+    // the reactor must terminate
+    int terminate_fd;
+
+    // the client whose pipelined requests are being handled,
+    // -1 if no client is being handled
+    int pipelined_fd;
+
+    // 1 if the pipelined client was kept instead of being
+    // given back after its last request, 0 otherwise
+    int retained;
 };
 
 /**
@@ -77,6 +113,8 @@ static int waiting_list_subscribe(struct gnl_simfs_file_system *file_system, str
 
         case GNL_SOCKET_REQUEST_READ:
         case GNL_SOCKET_REQUEST_WRITE:
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+        case GNL_SOCKET_REQUEST_READ_STREAM:
         case GNL_SOCKET_REQUEST_LOCK:
             fd = gnl_socket_request_get_fd(request);
             break;
@@ -86,16 +124,22 @@ static int waiting_list_subscribe(struct gnl_simfs_file_system *file_system, str
             return -1;
     }
 
-    // if we have only the fd, get the inode to get the "target"
+    // if we have only the fd, get the status of its file to get the "target"
     if (fd >= 0) {
-        struct gnl_simfs_inode inode;
+        struct gnl_simfs_stat file_stat;
 
-        // get the inode of the fd
-        int res = gnl_simfs_file_system_fstat(file_system, fd, &inode, fd_c);
+        // get the status of the file of the fd
+        int res = gnl_simfs_file_system_fstat(file_system, fd, &file_stat, fd_c);
         GNL_MINUS1_CHECK(res, errno, -1)
 
-        // get the target
-        target = inode.name;
+        // the waiting list copies the target
+        res = gnl_fss_waiting_list_push(waiting_list, file_stat.name, fd_c, request);
+
+        int push_errno = errno;
+        free(file_stat.name);
+        errno = push_errno;
+
+        return res;
     }
 
     // put the target and the pid into the waiting list
@@ -103,7 +147,8 @@ static int waiting_list_subscribe(struct gnl_simfs_file_system *file_system, str
 }
 
 /**
- * Get the filename pointed by the fd of the given GNL_SOCKET_REQUEST_UNLOCK request.
+ * Get the filename pointed by the fd of the given GNL_SOCKET_REQUEST_UNLOCK or
+ * GNL_SOCKET_REQUEST_CLOSE request, that is the file released by the request.
  *
  * @param file_system   The file system instance.
  * @param request       The request of the client.
@@ -112,19 +157,19 @@ static int waiting_list_subscribe(struct gnl_simfs_file_system *file_system, str
  * @return              Returns the target on success,
  *                      NULL otherwise.
  */
-static char *get_unlock_request_target(struct gnl_simfs_file_system *file_system, struct gnl_socket_request *request,
+static char *get_request_target(struct gnl_simfs_file_system *file_system, struct gnl_socket_request *request,
         int fd_c) {
 
     // validate the parameters
     GNL_NULL_CHECK(file_system, EINVAL, NULL)
     GNL_NULL_CHECK(request, EINVAL, NULL)
 
-    char *target;
     int fd;
 
     // get the target
     switch (gnl_socket_request_type(request)) {
         case GNL_SOCKET_REQUEST_UNLOCK:
+        case GNL_SOCKET_REQUEST_CLOSE:
             fd = gnl_socket_request_get_fd(request);
             break;
 
@@ -133,21 +178,112 @@ static char *get_unlock_request_target(struct gnl_simfs_file_system *file_system
             return NULL;
     }
 
-    // get the inode to get the "target"
-    struct gnl_simfs_inode inode;
+    // get the status of the file of the fd to get the "target"
+    struct gnl_simfs_stat file_stat;
 
-    // get the inode of the fd
-    int res = gnl_simfs_file_system_fstat(file_system, fd, &inode, fd_c);
+    int res = gnl_simfs_file_system_fstat(file_system, fd, &file_stat, fd_c);
     GNL_MINUS1_CHECK(res, errno, NULL)
 
-    // get the target
-    GNL_CALLOC(target, strlen(inode.name) + 1, NULL)
-    strncpy(target, inode.name, strlen(inode.name));
+    // the name of the status is owned by the caller, so it is the target
+    return file_stat.name;
+}
 
-    // free memory
-    free(inode.name);
+/**
+ * Build the response carrying the given files, evicted by a write or read at
+ * once: a GNL_SOCKET_RESPONSE_OK response if the list is empty, a
+ * GNL_SOCKET_RESPONSE_OK_FILE_LIST response carrying the files otherwise.
+ * The given list is destroyed.
+ *
+ * @param list  The pointer to the list of the files.
+ *
+ * @return      Returns the response on success, NULL otherwise.
+ */
+static struct gnl_socket_response *evicted_files_response(struct gnl_list_t **list) {
+    struct gnl_socket_response *response;
+    struct gnl_simfs_evicted_file *evicted_file;
+    struct gnl_list_t *current;
+    int res = 0;
+
+    // if no file was evicted from the file system
+    if (*list == NULL) {
+        return gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
+    }
+
+    // if at least one file was evicted from the file system
+    response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_FILE_LIST, 0);
+    current = *list;
+
+    while (response != NULL && current != NULL) {
+        // decode the evicted file, outside the locks of the file
+        // system, then add the element to the response
+        evicted_file = (struct gnl_simfs_evicted_file *) current->el;
+        res = gnl_simfs_evicted_file_decode(evicted_file);
+        if (res == 0) {
+            res = gnl_socket_response_add_file(response, evicted_file->name, evicted_file->count,
+                                               evicted_file->bytes);
+        }
+
+        // if an error occurred, then stop
+        if (res == -1) {
+            gnl_socket_response_destroy(response);
+            response = NULL;
+            break;
+        }
+
+        // move on to the next element
+        current = current->next;
+    }
+
+    gnl_list_destroy(list, destroy_gnl_simfs_evicted_file);
+
+    return response;
+}
+
+/**
+ * Stream the file pointed by the fd of the given GNL_SOCKET_REQUEST_READ_STREAM
+ * request to the client, one GNL_SOCKET_RESPONSE_OK_CHUNK response for every
+ * piece of the file, so that no more than one piece is held in memory at once.
+ * The stream must be closed by the caller with a final response.
+ *
+ * @param file_system   The file system instance.
+ * @param request       The request of the client.
+ * @param fd_c          The client that owns the request.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+static int stream_file(struct gnl_simfs_file_system *file_system, struct gnl_socket_request *request, int fd_c) {
+    struct gnl_socket_response *response;
+    int fd = gnl_socket_request_get_fd(request);
+    size_t offset = 0;
+    size_t count;
+    void *buf;
+    int res;
+
+    for (;;) {
+        buf = NULL;
+        res = gnl_simfs_file_system_read_chunk(file_system, fd, offset, GNL_SOCKET_REQUEST_MAX_CHUNK_SIZE, &buf,
+                                               &count, fd_c);
+        GNL_MINUS1_CHECK(res, errno, -1)
 
-    return target;
+        // the end of the file is reached
+        if (count == 0) {
+            return 0;
+        }
+
+        response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_CHUNK, 3, "unknown", count, buf);
+        free(buf);
+        GNL_NULL_CHECK(response, errno, -1)
+
+        // a chunk belongs to the request as the final response does
+        gnl_socket_response_set_id(response, gnl_socket_request_get_id(request));
+        gnl_socket_response_set_version(response, gnl_socket_request_get_version(request));
+
+        res = gnl_socket_service_send_response(fd_c, response);
+        gnl_socket_response_destroy(response);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        offset += count;
+    }
 }
 
 /**
@@ -172,9 +308,6 @@ static struct gnl_socket_response *handle_request(struct gnl_simfs_file_system *
     void *buf = NULL;
     size_t count = 0;
     struct gnl_list_t *list = NULL;
-    struct gnl_list_t *current = NULL;
-    char *tmp;
-    struct gnl_simfs_evicted_file *evicted_file = NULL;
 
     // get the request parameters
     int request_flags = gnl_socket_request_get_flags(request);
@@ -196,38 +329,18 @@ static struct gnl_socket_response *handle_request(struct gnl_simfs_file_system *
             break;
 
         case GNL_SOCKET_REQUEST_READ_N:
+            // read the files at once, their contents travel within the response
             errno = 0;
-            list = gnl_simfs_file_system_ls(file_system, fd_c);
+            list = gnl_simfs_file_system_read_n(file_system, gnl_socket_request_get_n(request), fd_c);
 
             res = -1;
 
-            // if at least one file is present into the file system
-            if (list != NULL) {
-                response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_FILE_LIST, 0);
-                current = list;
-
-                while (current != NULL) {
-                    // add the filename to the response
-                    tmp = (char *)current->el;
-                    res = gnl_socket_response_add_file(response, tmp, (strlen(tmp) + 1), tmp);
-
-                    // if an error occurred, then stop
-                    if (res == -1) {
-                        gnl_socket_response_destroy(response);
-                        break;
-                    }
-
-                    // move on to the next element
-                    current = current->next;
-                }
-
-                gnl_list_destroy(&list, free);
-            }
-            // else if no file are present (the function returned NULL
-            // but no errors occurred, i.e. errno == 0)
-            else if (errno == 0) {
-                response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
-                res = 0;
+            // if at least one file was read, create an ok_file_list response,
+            // else if no file is present (the function returned NULL but no
+            // errors occurred, i.e. errno == 0) create an ok response
+            if (list != NULL || errno == 0) {
+                response = evicted_files_response(&list);
+                res = response == NULL ? -1 : 0;
             }
             break;
 
@@ -241,38 +354,62 @@ static struct gnl_socket_response *handle_request(struct gnl_simfs_file_system *
             break;
 
         case GNL_SOCKET_REQUEST_WRITE:
-            res = gnl_simfs_file_system_write(file_system, request_fd, request_bytes, request_size, fd_c, &list);
+            // hand the received buffer over to the file system, which keeps
+            // it without copying if the bytes are stored as they are
+            res = gnl_simfs_file_system_write_buffer(file_system, request_fd, &request_bytes, request_size, fd_c,
+                                                     &list);
+
+            // the buffer is owned by the file system now
+            if (request_bytes == NULL) {
+                gnl_socket_request_release_bytes(request);
+            }
+
+            // if success create an ok (or ok_file_list) response
+            if (res == 0) {
+                response = evicted_files_response(&list);
+                res = response == NULL ? -1 : 0;
+            }
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            res = gnl_simfs_file_system_write_begin(file_system, request_fd, fd_c);
+
+            // if success create an ok response
+            if (res == 0) {
+                response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
+            }
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            res = gnl_simfs_file_system_write_chunk(file_system, request_fd, &request_bytes, request_size, fd_c);
+
+            // the buffer is owned by the file system now
+            if (request_bytes == NULL) {
+                gnl_socket_request_release_bytes(request);
+            }
 
             // if success create an ok response
             if (res == 0) {
+                response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
+            }
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            res = gnl_simfs_file_system_write_end(file_system, request_fd, fd_c, &list);
 
-                // if no file was evicted from the file system
-                if (list == NULL) {
-                    response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
-                }
-                // if at least one file was evicted from the file system
-                else {
-                    response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_FILE_LIST, 0);
-                    current = list;
-
-                    while (current != NULL) {
-                        // add the element to the response
-                        evicted_file = (struct gnl_simfs_evicted_file *) current->el;
-                        res = gnl_socket_response_add_file(response, evicted_file->name, evicted_file->count,
-                                                           evicted_file->bytes);
-
-                        // if an error occurred, then stop
-                        if (res == -1) {
-                            gnl_socket_response_destroy(response);
-                            break;
-                        }
-
-                        // move on to the next element
-                        current = current->next;
-                    }
-
-                    gnl_list_destroy(&list, destroy_gnl_simfs_evicted_file);
-                }
+            // if success create an ok (or ok_file_list) response
+            if (res == 0) {
+                response = evicted_files_response(&list);
+                res = response == NULL ? -1 : 0;
+            }
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            res = stream_file(file_system, request, fd_c);
+
+            // if success close the stream with an ok response
+            if (res == 0) {
+                response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
             }
             break;
 
@@ -330,37 +467,82 @@ static struct gnl_socket_response *handle_request(struct gnl_simfs_file_system *
 }
 
 /**
- * Send the given fd_c to the master.
+ * Send the given fd_c to the master: push it into the completion ring,
+ * then wake up the master writing the completion eventfd.
  *
- * @param pipe_channel  The channel to use to communicate with the master.
- * @param fd_c          The client fd to send to the master, if 0, then the
- *                      master will consider a client gone.
+ * @param worker    The worker configuration.
+ * @param fd_c      The client fd to send to the master, if 0, then the
+ *                  master will consider a client gone.
  *
- * @return              Returns 0 on success, -1 otherwise.
+ * @return          Returns 0 on success, -1 otherwise.
  */
-static int send_message_to_master(int pipe_channel, int fd_c) {
-    // the message struct to send to the master
-    struct gnl_message_n *message_to_master;
-
-    message_to_master = gnl_message_n_init_with_args(fd_c);
-    GNL_NULL_CHECK(message_to_master, errno, -1)
+static int send_message_to_master(struct gnl_fss_worker *worker, int fd_c) {
+    int res;
 
-    // encode the message
-    char *message;
-    size_t nwrite = gnl_message_n_to_string(message_to_master, &message);
-    GNL_MINUS1_CHECK(nwrite, errno, -1)
+    // the ring is full only if the master is late, let it drain
+    while ((res = gnl_ts_mpsc_ring_push(worker->completion_ring, fd_c)) == -1 && errno == EAGAIN) {
+        sched_yield();
+    }
+    GNL_MINUS1_CHECK(res, errno, -1)
 
-    // send the message to the master
-    size_t writen = gnl_socket_service_writen(pipe_channel, message, nwrite);
-    GNL_MINUS1_CHECK(writen, errno, -1)
+    uint64_t wakeup = 1;
 
-    // free memory
-    free(message_to_master);
-    free(message);
+    res = write(worker->completion_fd, &wakeup, sizeof(wakeup));
+    GNL_MINUS1_CHECK(res, errno, -1)
 
     return 0;
 }
 
+/**
+ * Arm the given client file descriptor into the given epoll instance. The
+ * client is reported once, when it becomes ready to be read, then it is
+ * disarmed until it is armed again, so only one thread per time can
+ * handle it.
+ *
+ * @param epfd  The epoll instance file descriptor.
+ * @param fd_c  The client file descriptor to arm.
+ * @param op    EPOLL_CTL_ADD to register the client,
+ *              EPOLL_CTL_MOD to arm it again.
+ *
+ * @return      Returns 0 on success, -1 otherwise.
+ */
+static int arm_client(int epfd, int fd_c, int op) {
+    struct epoll_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+    event.data.fd = fd_c;
+
+    return epoll_ctl(epfd, op, fd_c, &event);
+}
+
+/**
+ * Give the given client back to the thread listening to its requests: the
+ * master, or the reactor owning the client if the worker is a reactor. If
+ * the client is the one whose pipelined requests are being handled, then
+ * it is only marked as retained.
+ *
+ * @param worker    The worker configuration.
+ * @param fd_c      The client to give back.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int give_back_client(struct gnl_fss_worker *worker, int fd_c) {
+    // keep the client whose pipelined requests are being handled,
+    // it will be given back when its requests are drained
+    if (fd_c == worker->pipelined_fd) {
+        worker->retained = 1;
+
+        return 0;
+    }
+
+    if (worker->owners == NULL) {
+        return send_message_to_master(worker, fd_c);
+    }
+
+    return arm_client(worker->owners[fd_c], fd_c, EPOLL_CTL_MOD);
+}
+
 /**
  * Send a GNL_SOCKET_RESPONSE_ERROR response to the given client and notify
  * the master that the handling is done. The error number that will be sent
@@ -388,14 +570,13 @@ static int handle_error(struct gnl_fss_worker *worker, int fd_c) {
 
     gnl_logger_debug(worker->logger, "response sent to client %d", fd_c);
 
-    gnl_logger_debug(worker->logger, "sending message to master to listen again client %d requests", fd_c);
+    gnl_logger_debug(worker->logger, "giving back client %d to listen again its requests", fd_c);
 
-    // send the message to the master to
-    // listen again the client requests
-    res = send_message_to_master(worker->pipe_channel, fd_c);
+    // give back the client to listen again its requests
+    res = give_back_client(worker, fd_c);
     GNL_MINUS1_CHECK(res, errno, -1)
 
-    gnl_logger_debug(worker->logger, "message sent");
+    gnl_logger_debug(worker->logger, "client given back");
 
     gnl_logger_debug(worker->logger, "error handled");
 
@@ -466,7 +647,6 @@ static int handle_fd_c_response(struct gnl_fss_worker *worker, int fd_c,
     }
 
     int res;
-    char *target = NULL;
 
     // if the target file of the request is locked
     if (gnl_socket_response_type(response) == GNL_SOCKET_RESPONSE_ERROR && gnl_socket_response_get_error(response) == EBUSY) {
@@ -493,117 +673,152 @@ static int handle_fd_c_response(struct gnl_fss_worker *worker, int fd_c,
 
         free(response_type);
 
-        // if the request is a GNL_SOCKET_REQUEST_UNLOCK request, then get the target pointed by
-        // the request fd, it will be used later to broadcast the waiting list
-        if (gnl_socket_request_type(request) == GNL_SOCKET_REQUEST_UNLOCK && gnl_socket_response_type(response) == GNL_SOCKET_RESPONSE_OK) {
-            // get the target
-            target = get_unlock_request_target(worker->file_system, request, fd_c);
-        }
-
         // send the response message to the client
         gnl_logger_debug(logger, "send the response to client %d", fd_c);
 
+        // tag the response with the id of its request, so a
+        // pipelining client can match them
+        res = gnl_socket_response_set_id(response, gnl_socket_request_get_id(request));
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        // answer with the protocol version the request came with
+        res = gnl_socket_response_set_version(response, gnl_socket_request_get_version(request));
+        GNL_MINUS1_CHECK(res, errno, -1)
+
         res = gnl_socket_service_send_response(fd_c, response);
         GNL_MINUS1_CHECK(res, errno, -1)
 
         gnl_logger_debug(logger, "response sent to client %d", fd_c);
 
-        gnl_logger_debug(worker->logger, "sending message to master to listen again client %d requests", fd_c);
+        gnl_logger_debug(worker->logger, "giving back client %d to listen again its requests", fd_c);
 
-        // send the message to the master to
-        // listen again the client requests
-        res = send_message_to_master(worker->pipe_channel, fd_c);
+        // give back the client to listen again its requests
+        res = give_back_client(worker, fd_c);
 
         if (res == -1) {
-            gnl_logger_debug(worker->logger, "error sending the message: %s", strerror(errno));
+            gnl_logger_debug(worker->logger, "error giving back the client: %s", strerror(errno));
         } else {
-            gnl_logger_debug(worker->logger, "message sent");
+            gnl_logger_debug(worker->logger, "client given back");
         }
     }
 
-    // check if there is any waiting pid
-    if (gnl_socket_request_type(request) == GNL_SOCKET_REQUEST_UNLOCK && gnl_socket_response_type(response) == GNL_SOCKET_RESPONSE_OK) {
+    // if this check is false, then the request was stored
+    // into the waiting list, and we can not destroy it, if it
+    // is true we can destroy it
+    if (gnl_socket_response_type(response) != GNL_SOCKET_RESPONSE_ERROR || gnl_socket_response_get_error(response) != EBUSY) {
+        gnl_socket_request_destroy(request);
+    }
 
-        gnl_logger_debug(logger, "broadcast to waiting pid");
+    // free memory
+    gnl_socket_response_destroy(response);
 
-        struct gnl_fss_waiting_list_el *popped_waiting_list_el;
-        int broadcast = 0;
+    return 0;
+}
+
+/**
+ * Handle the given request of the given client and send its response. If the
+ * request released a file, i.e. it is a successful unlock or close, then the
+ * name of the file is inserted into the given list of targets, so that the
+ * clients waiting for the file can be woken up.
+ *
+ * @param worker    The worker configuration.
+ * @param fd_c      The client that owns the request.
+ * @param request   The request received from the client.
+ * @param targets   The pointer to the list of the files released.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int handle_fd_c(struct gnl_fss_worker *worker, int fd_c, struct gnl_socket_request *request,
+        struct gnl_list_t **targets) {
+    char *target = NULL;
+    int res;
 
-        // reset the errno
-        errno = 0;
+    // the file released by a request is got before handling it,
+    // a closed file descriptor does not refer the file anymore
+    enum gnl_socket_request_type type = gnl_socket_request_type(request);
+    if (type == GNL_SOCKET_REQUEST_UNLOCK || type == GNL_SOCKET_REQUEST_CLOSE) {
+        target = get_request_target(worker->file_system, request, fd_c);
+    }
 
-        // check if we have a valid target
-        if (target == NULL) {
-            gnl_logger_warn(logger, "error during the target retrieving, stop broadcast: %s", strerror(errno));
-        }
-        // if we have a target, then proceed
-        else {
-            // for each waiting pid
-            while ((popped_waiting_list_el = gnl_fss_waiting_list_pop(worker->waiting_list, target)) != NULL) {
-                broadcast++;
-
-                gnl_logger_debug(logger, "broadcast to pid %d", popped_waiting_list_el->pid);
-
-                struct gnl_socket_response *tmp_response = handle_fd_c_request(worker, popped_waiting_list_el->pid,
-                                                                               popped_waiting_list_el->request);
-
-                // recursive call, this is necessary if a broadcast waiting pid
-                // is blocking another waiting pid. Without this call, if the first
-                // waiting pid unlock the file on where another waiting pid is waiting,
-                // then the another waiting pid will wait potentially forever
-                res = handle_fd_c_response(worker, popped_waiting_list_el->pid, popped_waiting_list_el->request, tmp_response);
-                if (res == -1) {
-                    gnl_logger_error(logger, "error during the handling of the response for the client fd %d: %s, "
-                                             "response ignored", popped_waiting_list_el->pid, strerror(errno));
-
-                    // handle the error
-                    handle_error(worker, popped_waiting_list_el->pid);
-                }
-
-                // free memory
-                free(popped_waiting_list_el);
-            }
+    struct gnl_socket_response *response = handle_fd_c_request(worker, fd_c, request);
 
-            // customize the log based on if we have broadcast
-            // something or not
-            if (broadcast == 0) {
-
-                // if errno==0, then no errors occurred, there simply not
-                // waiting pid to broadcast to
-                if (errno == 0) {
-                    gnl_logger_debug(logger, "no waiting pid to broadcast to");
-                } else {
-                    gnl_logger_warn(logger, "error during the broadcasting: %s", strerror(errno));
-                }
-            }
-        }
+    // the response is destroyed by the handling
+    int released = target != NULL && response != NULL && gnl_socket_response_type(response) == GNL_SOCKET_RESPONSE_OK;
+
+    res = handle_fd_c_response(worker, fd_c, request, response);
 
-        // free memory
+    if (!released) {
         free(target);
-    }
+    } else if (gnl_list_insert(targets, target) == -1) {
+        gnl_logger_warn(worker->logger, "error during the tracking of the file \"%s\" released by client %d: %s, "
+                                        "its waiting clients will not be woken up", target, fd_c, strerror(errno));
 
-    // if this check is false, then the request was stored
-    // into the waiting list, and we can not destroy it, if it
-    // is true we can destroy it
-    if (gnl_socket_response_type(response) != GNL_SOCKET_RESPONSE_ERROR || errno != EBUSY) {
-        gnl_socket_request_destroy(request);
+        free(target);
     }
 
-    // free memory
-    gnl_socket_response_destroy(response);
+    return res;
+}
 
-    return 0;
+/**
+ * Wake up the clients waiting for the files of the given list of targets: the
+ * request of every waiting client is handled again, and the client is put back
+ * into the waiting list if the file is still busy. The files released by the
+ * requests handled are appended to the list, and their waiting clients are
+ * woken up as well. The list is destroyed.
+ *
+ * @param worker    The worker configuration.
+ * @param targets   The pointer to the list of the files released.
+ */
+static void wake_waiting_clients(struct gnl_fss_worker *worker, struct gnl_list_t **targets) {
+    struct gnl_logger *logger = worker->logger;
+    struct gnl_fss_waiting_list_el *popped_waiting_list_el;
+    int res;
+
+    // the files released meanwhile are appended to the list,
+    // so they are reached by this same loop
+    for (struct gnl_list_t *current = *targets; current != NULL; current = current->next) {
+        char *target = current->el;
+        int broadcast = 0;
+
+        gnl_logger_debug(logger, "broadcast to the pids waiting for the file \"%s\"", target);
+
+        // for each waiting pid
+        while ((popped_waiting_list_el = gnl_fss_waiting_list_pop(worker->waiting_list, target)) != NULL) {
+            broadcast++;
+
+            gnl_logger_debug(logger, "broadcast to pid %d", popped_waiting_list_el->pid);
+
+            res = handle_fd_c(worker, popped_waiting_list_el->pid, popped_waiting_list_el->request, targets);
+            if (res == -1) {
+                gnl_logger_error(logger, "error during the handling of the response for the client fd %d: %s, "
+                                         "response ignored", popped_waiting_list_el->pid, strerror(errno));
+
+                // handle the error
+                handle_error(worker, popped_waiting_list_el->pid);
+            }
+
+            // free memory
+            free(popped_waiting_list_el);
+        }
+
+        if (broadcast == 0) {
+            gnl_logger_debug(logger, "no waiting pid to broadcast to");
+        }
+    }
+
+    gnl_list_destroy(targets, free);
 }
 
 /**
  * {@inheritDoc}
  */
-struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_bb_queue_t *worker_queue,
-        struct gnl_fss_waiting_list *waiting_list, int pipe_channel, struct gnl_simfs_file_system *file_system,
-                const struct gnl_fss_config *config) {
+struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_mpmc_queue_t *worker_queue,
+        struct gnl_fss_waiting_list *waiting_list, struct gnl_ts_mpsc_ring_t *completion_ring, int completion_fd,
+                struct gnl_simfs_file_system *file_system, const struct gnl_fss_config *config) {
 
     // validate parameters
-    if (worker_queue == NULL || waiting_list == NULL || file_system == NULL || config == NULL) {
+    if (worker_queue == NULL || waiting_list == NULL || completion_ring == NULL || completion_fd < 0
+        || file_system == NULL || config == NULL) {
         errno = EINVAL;
 
         return NULL;
@@ -630,11 +845,21 @@ struct gnl_fss_worker *gnl_fss_worker_init(pthread_t id, struct gnl_ts_bb_queue_
 
     worker->worker_queue = worker_queue;
     worker->waiting_list = waiting_list;
-    worker->pipe_channel = pipe_channel;
+    worker->completion_ring = completion_ring;
+    worker->completion_fd = completion_fd;
 
     // assign the file_system
     worker->file_system = file_system;
 
+    // the worker is not a reactor
+    worker->epfd = -1;
+    worker->owners = NULL;
+    worker->terminate_fd = -1;
+
+    // no client is being handled
+    worker->pipelined_fd = -1;
+    worker->retained = 0;
+
     gnl_logger_debug(worker->logger, "initialization completed");
 
     return worker;
@@ -657,141 +882,294 @@ void gnl_fss_worker_destroy(struct gnl_fss_worker *worker) {
 /**
  * {@inheritDoc}
  */
-void *gnl_fss_worker_handle(void* args) {
-    // decode args
-    struct gnl_fss_worker *worker = args;
+int gnl_fss_worker_set_reactor(struct gnl_fss_worker *worker, int epfd, const int *owners, int terminate_fd) {
+    // validate the parameters
+    GNL_NULL_CHECK(worker, EINVAL, -1)
+    GNL_NULL_CHECK(owners, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (epfd < 0 || terminate_fd < 0), EINVAL, -1)
 
-    // get the logger
-    struct gnl_logger *logger = worker->logger;
+    worker->epfd = epfd;
+    worker->owners = owners;
+    worker->terminate_fd = terminate_fd;
 
-    // file descriptor of a client read from the queue
-    int fd_c;
+    gnl_logger_debug(worker->logger, "the worker is a reactor on the epoll instance %d", epfd);
 
-    // temporary reference to a client file descriptor
-    void *raw_fd_c;
+    return 0;
+}
+
+/**
+ * Handle one request of the given ready client: read the request, handle it
+ * and send the response to the client, then give back the client. If the
+ * client has gone away, then close it and notify the master.
+ *
+ * @param worker    The worker configuration.
+ * @param fd_c      The ready client.
+ */
+static void handle_client_request(struct gnl_fss_worker *worker, int fd_c) {
+    // get the logger
+    struct gnl_logger *logger = worker->logger;
 
     // generic result var
     int res;
 
-    // the response sent to a client
-    struct gnl_socket_response *response;
+    // the files released by the client
+    struct gnl_list_t *targets = NULL;
 
-    gnl_logger_debug(logger, "ready, waiting for requests");
+    gnl_logger_debug(logger, "message sent by client %d", fd_c);
 
-    // work
-    while (1) {
+    // read data
+    struct gnl_socket_request *request = gnl_socket_service_get_request(fd_c);
 
-        // waiting for a ready file descriptor from the main thread
-        raw_fd_c = gnl_ts_bb_queue_dequeue(worker->worker_queue);
+    if (request == NULL) {
 
-        // check if there was an error
-        if (raw_fd_c == NULL) {
-            gnl_logger_error(logger, "error during the reading of the worker queue: %s, message ignored",
+        // if EOF...
+        if (errno == EPIPE) {
+
+            // close the current file descriptor
+            gnl_logger_debug(logger, "the message says that client %d has gone away", fd_c);
+
+            // remove the fd_c from the waiting list (if it was put there)
+            res = gnl_fss_waiting_list_remove(worker->waiting_list, fd_c);
+
+            // check if there was an error
+            if (res == -1) {
+                gnl_logger_error(logger, "error during the removing of pid %d from the waiting list: %s, "
+                                         "error ignored", fd_c, strerror(errno));
+            }
+
+            gnl_logger_debug(logger, "if client %d were present into the waiting list, then it was removed "
+                                     "from it", fd_c);
+
+            // remove the client session from the file system, the files
+            // closed and unlocked are collected to wake up their waiting clients
+            res = gnl_simfs_file_system_remove_session(worker->file_system, fd_c, &targets);
+            if (res == -1) {
+                gnl_logger_error(logger, "error during the removing of the client fd %d session "
+                                         "from the file system: %s, error ignored", fd_c, strerror(errno));
+            }
+
+            gnl_logger_debug(logger, "client %d session removed from the file system", fd_c);
+
+            // wake up the clients waiting for the files released by the client
+            wake_waiting_clients(worker, &targets);
+
+            // close the client file descriptor, if the worker is a
+            // reactor this also removes it from the epoll instance
+            res = close(fd_c);
+            if (res == -1) {
+                gnl_logger_error(logger, "error during the closing of the client fd %d: %s, error ignored",
+                                 fd_c, strerror(errno));
+            }
+
+            gnl_logger_debug(logger, "closed the connection with client %d", fd_c);
+
+            // send the message to the master, 0 means that a client has gone away
+            send_message_to_master(worker, 0);
+
+        }
+        // if the client negotiated the protocol version, there is nothing else to do
+        else if (errno == EAGAIN) {
+            gnl_logger_debug(logger, "protocol version negotiated with client %d", fd_c);
+
+            // give back the client to listen again its requests
+            res = give_back_client(worker, fd_c);
+            if (res == -1) {
+                gnl_logger_error(logger, "error giving back the client %d: %s", fd_c, strerror(errno));
+            }
+        } else {
+
+            gnl_logger_error(logger, "error during the reading of the message: %s, request ignored",
                              strerror(errno));
 
             // do not stop the server: the show must go on
-            continue;
 
+            // the request is not necessary anymore, destroy it
+            gnl_socket_request_destroy(request);
+
+            // handle the error
+            handle_error(worker, fd_c);
         }
+    }
+    // if "request" is not NULL
+    else {
+        gnl_logger_debug(logger, "the message is a request");
 
-        gnl_logger_debug(logger, "new message received");
+        res = handle_fd_c(worker, fd_c, request, &targets);
+        if (res == -1) {
+            gnl_logger_error(logger, "error during the handling of the response for the client fd %d: %s, "
+                                     "response ignored", fd_c, strerror(errno));
 
-        // cast raw client file descriptor
-        fd_c = *(int *)raw_fd_c;
+            // handle the error
+            handle_error(worker, fd_c);
+        }
 
-        // free memory
-        free(raw_fd_c);
+        // wake up the clients waiting for the file released, if any
+        wake_waiting_clients(worker, &targets);
+    }
+}
 
-        // if terminate message, put down the worker
-        if (fd_c == GNL_FSS_WORKER_TERMINATE) {
-            gnl_logger_debug(logger, "termination message, the thread will be ended");
+/**
+ * Handle the requests of the given ready client. A client may pipeline its
+ * requests, sending a request before the response of the previous one: while
+ * the client has another request already buffered, handle it without giving
+ * the client back, up to GNL_FSS_WORKER_PIPELINE_BUDGET requests. Then give
+ * back the client, unless it has gone away or it was put into the waiting list.
+ *
+ * @param worker    The worker configuration.
+ * @param fd_c      The ready client.
+ */
+static void handle_client(struct gnl_fss_worker *worker, int fd_c) {
+    int res;
+    int handled = 0;
+    char next;
 
-            // exit the loop
+    worker->pipelined_fd = fd_c;
+
+    do {
+        worker->retained = 0;
+
+        handle_client_request(worker, fd_c);
+        handled++;
+
+        // stop if the client was not given back: it has gone away,
+        // or it is waiting for a file unlocking
+        if (!worker->retained) {
             break;
         }
 
-        gnl_logger_debug(logger, "message sent by client %d", fd_c);
-
-        // read data
-        struct gnl_socket_request *request = gnl_socket_service_get_request(fd_c);
+        if (handled == GNL_FSS_WORKER_PIPELINE_BUDGET) {
+            gnl_logger_debug(worker->logger, "pipeline budget of client %d exhausted", fd_c);
 
-        if (request == NULL) {
+            break;
+        }
 
-            // if EOF...
-            if (errno == EPIPE) {
+        // check without waiting if the next request is already there
+    } while (recv(fd_c, &next, 1, MSG_PEEK | MSG_DONTWAIT) > 0);
 
-                // close the current file descriptor
-                gnl_logger_debug(logger, "the message says that client %d has gone away", fd_c);
+    worker->pipelined_fd = -1;
 
-                // remove the fd_c from the waiting list (if it was put there)
-                res = gnl_fss_waiting_list_remove(worker->waiting_list, fd_c);
+    if (worker->retained) {
+        gnl_logger_debug(worker->logger, "giving back client %d after %d requests", fd_c, handled);
 
-                // check if there was an error
-                if (res == -1) {
-                    gnl_logger_error(logger, "error during the removing of pid %d from the waiting list: %s, "
-                                             "error ignored", fd_c, strerror(errno));
-                }
+        res = give_back_client(worker, fd_c);
+        if (res == -1) {
+            gnl_logger_error(worker->logger, "error giving back the client %d: %s", fd_c, strerror(errno));
+        }
+    }
+}
 
-                gnl_logger_debug(logger, "if client %d were present into the waiting list, then it was removed "
-                                         "from it", fd_c);
+/**
+ * Run the given reactor: wait for its own clients on its epoll instance
+ * and handle their requests, until the reactor is terminated.
+ *
+ * @param worker    The worker configuration of the reactor.
+ */
+static void run_reactor(struct gnl_fss_worker *worker) {
+    // get the logger
+    struct gnl_logger *logger = worker->logger;
 
-                // remove the client session from the file system
-                res = gnl_simfs_file_system_remove_session(worker->file_system, fd_c);
-                if (res == -1) {
-                    gnl_logger_error(logger, "error during the removing of the client fd %d session "
-                                             "from the file system: %s, error ignored", fd_c, strerror(errno));
-                }
+    // ready clients
+    struct epoll_event events[GNL_FSS_WORKER_EPOLL_EVENTS];
 
-                gnl_logger_debug(logger, "client %d session removed from the file system", fd_c);
+    // number of ready clients
+    int nready;
 
-                // close the client file descriptor
-                res = close(fd_c);
-                if (res == -1) {
-                    gnl_logger_error(logger, "error during the closing of the client fd %d: %s, error ignored",
-                                     fd_c, strerror(errno));
-                }
+    // file descriptor of a ready client
+    int fd_c;
 
-                gnl_logger_debug(logger, "closed the connection with client %d", fd_c);
+    gnl_logger_debug(logger, "ready, waiting for requests on the epoll instance %d", worker->epfd);
 
-                // send the message to the master, 0 means that a client has gone away
-                send_message_to_master(worker->pipe_channel, 0);
+    // work
+    while (1) {
 
-            } else {
+        // waiting for ready clients
+        nready = epoll_wait(worker->epfd, events, GNL_FSS_WORKER_EPOLL_EVENTS, -1);
 
-                gnl_logger_error(logger, "error during the reading of the message: %s, request ignored",
+        // check if there was an error
+        if (nready == -1) {
+            if (errno != EINTR) {
+                gnl_logger_error(logger, "epoll_wait (system call) returned with error: %s, ignored",
                                  strerror(errno));
+            }
 
-                // do not stop the server: the show must go on
+            // do not stop the server: the show must go on
+            continue;
+        }
 
-                // the request is not necessary anymore, destroy it
-                gnl_socket_request_destroy(request);
+        for (int i=0; i<nready; i++) {
+            fd_c = events[i].data.fd;
 
-                // handle the error
-                handle_error(worker, fd_c);
+            // if terminate, put down the reactor
+            if (fd_c == worker->terminate_fd) {
+                gnl_logger_debug(logger, "termination requested, the thread will be ended");
 
-                // resume loop
-                continue;
+                return;
             }
+
+            // the client is disarmed until it is given back,
+            // so no other reactor can handle it meanwhile
+            handle_client(worker, fd_c);
         }
-        // if "request" is not NULL
-        else {
-            gnl_logger_debug(logger, "the message is a request");
+    }
+}
 
-            response = handle_fd_c_request(worker, fd_c, request);
+/**
+ * {@inheritDoc}
+ */
+void *gnl_fss_worker_handle(void* args) {
+    // decode args
+    struct gnl_fss_worker *worker = args;
 
-            res = handle_fd_c_response(worker, fd_c, request, response);
-            if (res == -1) {
-                gnl_logger_error(logger, "error during the handling of the response for the client fd %d: %s, "
-                                         "response ignored", fd_c, strerror(errno));
+    // get the logger
+    struct gnl_logger *logger = worker->logger;
 
-                // handle the error
-                handle_error(worker, fd_c);
-            }
+    // if the worker is a reactor, it owns its clients
+    if (worker->epfd >= 0) {
+        run_reactor(worker);
+
+        return NULL;
+    }
+
+    // file descriptor of a client read from the queue
+    int fd_c;
+
+    int res;
+
+    gnl_logger_debug(logger, "ready, waiting for requests");
+
+    // work
+    while (1) {
+
+        // waiting for a ready file descriptor from the main thread
+        res = gnl_ts_mpmc_queue_dequeue(worker->worker_queue, &fd_c);
+
+        // check if there was an error
+        if (res == -1) {
+            gnl_logger_error(logger, "error during the reading of the worker queue: %s, message ignored",
+                             strerror(errno));
+
+            // do not stop the server: the show must go on
+            continue;
+
+        }
+
+        gnl_logger_debug(logger, "new message received");
+
+        // if terminate message, put down the worker
+        if (fd_c == GNL_FSS_WORKER_TERMINATE) {
+            gnl_logger_debug(logger, "termination message, the thread will be ended");
+
+            // exit the loop
+            break;
         }
+
+        handle_client(worker, fd_c);
     }
 
     return NULL;
 }
 
 #undef GNL_FSS_WORKER_BUFFER_LEN
-#include <gnl_macro_end.h>
\ No newline at end of file
+#undef GNL_FSS_WORKER_EPOLL_EVENTS
+#undef GNL_FSS_WORKER_PIPELINE_BUDGET
+#include <gnl_macro_end.h>
@@ -161,6 +161,61 @@ int can_close() {
     return gnl_fss_api_close_connection(SOCKET_NAME);
 }
 
+int can_not_begin_a_pipeline_without_connection() {
+    int res = gnl_fss_api_pipeline_begin();
+
+    if (res == 0) {
+        return -1;
+    }
+
+    if (errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_not_end_a_pipeline_not_begun() {
+    int res = gnl_fss_api_pipeline_end();
+
+    if (res == 0) {
+        return -1;
+    }
+
+    if (errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_begin_and_end_a_pipeline() {
+    mock_gnl_socket_service_set_connect_result(0);
+    mock_gnl_socket_service_set_close_connection_result(0);
+
+    struct timespec tim;
+    tim.tv_sec = 0;
+    tim.tv_nsec = 1000000;
+
+    int res = gnl_fss_api_open_connection(SOCKET_NAME, 100, tim);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    res = gnl_fss_api_pipeline_begin();
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // only one pipeline per time
+    res = gnl_fss_api_pipeline_begin();
+    if (res == 0 || errno != EINVAL) {
+        return -1;
+    }
+
+    // an empty pipeline has no response to wait for
+    res = gnl_fss_api_pipeline_end();
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return gnl_fss_api_close_connection(SOCKET_NAME);
+}
+
 int main() {
     gnl_printf_yellow("> gnl_fss_api test:\n\n");
 
@@ -177,6 +232,11 @@ int main() {
     gnl_assert(can_not_close_different, "can not close a connection to a different socket.");
     gnl_assert(can_close, "can close a connection to a socket.");
 
+    // gnl_fss_api_pipeline_begin, gnl_fss_api_pipeline_end
+    gnl_assert(can_not_begin_a_pipeline_without_connection, "can not begin a pipeline without a connection.");
+    gnl_assert(can_not_end_a_pipeline_not_begun, "can not end a pipeline not begun.");
+    gnl_assert(can_begin_and_end_a_pipeline, "can begin and end a pipeline.");
+
     // gnl_fss_api_open_file
 
     printf("\n");
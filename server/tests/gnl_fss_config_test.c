@@ -29,6 +29,22 @@ int can_load_default() {
         return -1;
     }
 
+    if (config->compression != GNL_SIMFS_COMPRESSION_HUFFMAN) {
+        return -1;
+    }
+
+    if (config->frequency_aging != 0) {
+        return -1;
+    }
+
+    if (config->eviction_high_watermark != 0 || config->eviction_low_watermark != 0) {
+        return -1;
+    }
+
+    if (config->event_loop != GNL_FSS_EVENT_LOOP_SELECT) {
+        return -1;
+    }
+
     if (strcmp(config->socket, "/tmp/gnl_fss.sk") != 0) {
         return -1;
     }
@@ -72,6 +88,22 @@ int can_load_env() {
         return -1;
     }
 
+    if (config->compression != GNL_SIMFS_COMPRESSION_AUTO) {
+        return -1;
+    }
+
+    if (config->frequency_aging != 1000) {
+        return -1;
+    }
+
+    if (config->eviction_high_watermark != 90 || config->eviction_low_watermark != 70) {
+        return -1;
+    }
+
+    if (config->event_loop != GNL_FSS_EVENT_LOOP_EPOLL) {
+        return -1;
+    }
+
     if (strcmp(config->socket, "/tmp/fss_test.sk") != 0) {
         return -1;
     }
@@ -88,6 +120,11 @@ int can_load_env() {
     unsetenv("CAPACITY");
     unsetenv("LIMIT");
     unsetenv("REPLACEMENT_POLICY");
+    unsetenv("COMPRESSION");
+    unsetenv("FREQUENCY_AGING");
+    unsetenv("EVICTION_HIGH_WATERMARK");
+    unsetenv("EVICTION_LOW_WATERMARK");
+    unsetenv("EVENT_LOOP");
     unsetenv("SOCKET");
     unsetenv("LOG_FILE");
     unsetenv("LOG_LEVEL");
@@ -97,6 +134,133 @@ int can_load_env() {
     return 0;
 }
 
+int can_load_replacement_policies() {
+    const char *names[] = {"ARC", "2Q", "WTINYLFU", "GDSF"};
+    enum gnl_simfs_replacement_policy policies[] = {GNL_SIMFS_RP_ARC, GNL_SIMFS_RP_2Q, GNL_SIMFS_RP_WTINYLFU,
+                                                    GNL_SIMFS_RP_GDSF};
+
+    if (gnl_txtenv_load("./test_valid_config.txt", 0) != 0) {
+        return -1;
+    }
+
+    for (size_t i=0; i<4; i++) {
+        setenv("REPLACEMENT_POLICY", names[i], 1);
+
+        struct gnl_fss_config *config = gnl_fss_config_init_from_env();
+        if (config == NULL) {
+            return -1;
+        }
+
+        if (config->replacement_policy != policies[i]) {
+            return -1;
+        }
+
+        gnl_fss_config_destroy(config);
+    }
+
+    unsetenv("THREAD_WORKERS");
+    unsetenv("CAPACITY");
+    unsetenv("LIMIT");
+    unsetenv("REPLACEMENT_POLICY");
+    unsetenv("COMPRESSION");
+    unsetenv("FREQUENCY_AGING");
+    unsetenv("EVICTION_HIGH_WATERMARK");
+    unsetenv("EVICTION_LOW_WATERMARK");
+    unsetenv("EVENT_LOOP");
+    unsetenv("SOCKET");
+    unsetenv("LOG_FILE");
+    unsetenv("LOG_LEVEL");
+
+    return 0;
+}
+
+int can_load_event_loops() {
+    const char *names[] = {"select", "epoll", "reactor"};
+    enum gnl_fss_event_loop event_loops[] = {GNL_FSS_EVENT_LOOP_SELECT, GNL_FSS_EVENT_LOOP_EPOLL,
+                                             GNL_FSS_EVENT_LOOP_REACTOR};
+
+    if (gnl_txtenv_load("./test_valid_config.txt", 0) != 0) {
+        return -1;
+    }
+
+    for (size_t i=0; i<3; i++) {
+        setenv("EVENT_LOOP", names[i], 1);
+
+        struct gnl_fss_config *config = gnl_fss_config_init_from_env();
+        if (config == NULL) {
+            return -1;
+        }
+
+        if (config->event_loop != event_loops[i]) {
+            return -1;
+        }
+
+        gnl_fss_config_destroy(config);
+    }
+
+    // the event loop must be a supported one
+    setenv("EVENT_LOOP", "poll", 1);
+
+    struct gnl_fss_config *config = gnl_fss_config_init_from_env();
+    if (config != NULL || errno != EINVAL) {
+        return -1;
+    }
+
+    unsetenv("THREAD_WORKERS");
+    unsetenv("CAPACITY");
+    unsetenv("LIMIT");
+    unsetenv("REPLACEMENT_POLICY");
+    unsetenv("COMPRESSION");
+    unsetenv("FREQUENCY_AGING");
+    unsetenv("EVICTION_HIGH_WATERMARK");
+    unsetenv("EVICTION_LOW_WATERMARK");
+    unsetenv("EVENT_LOOP");
+    unsetenv("SOCKET");
+    unsetenv("LOG_FILE");
+    unsetenv("LOG_LEVEL");
+
+    return 0;
+}
+
+int can_not_load_invalid_watermarks() {
+    if (gnl_txtenv_load("./test_valid_config.txt", 0) != 0) {
+        return -1;
+    }
+
+    // the low watermark can not be above the high one
+    setenv("EVICTION_LOW_WATERMARK", "95", 1);
+
+    struct gnl_fss_config *config = gnl_fss_config_init_from_env();
+    if (config != NULL || errno != EINVAL) {
+        return -1;
+    }
+
+    // the watermarks are percentages
+    setenv("EVICTION_HIGH_WATERMARK", "101", 1);
+    unsetenv("EVICTION_LOW_WATERMARK");
+    unsetenv("EVENT_LOOP");
+
+    config = gnl_fss_config_init_from_env();
+    if (config != NULL || errno != EINVAL) {
+        return -1;
+    }
+
+    unsetenv("THREAD_WORKERS");
+    unsetenv("CAPACITY");
+    unsetenv("LIMIT");
+    unsetenv("REPLACEMENT_POLICY");
+    unsetenv("COMPRESSION");
+    unsetenv("FREQUENCY_AGING");
+    unsetenv("EVICTION_HIGH_WATERMARK");
+    unsetenv("EVICTION_LOW_WATERMARK");
+    unsetenv("EVENT_LOOP");
+    unsetenv("SOCKET");
+    unsetenv("LOG_FILE");
+    unsetenv("LOG_LEVEL");
+
+    return 0;
+}
+
 int can_not_load_with_error() {
     struct gnl_fss_config *config = gnl_fss_config_init_from_env();
     if (config != NULL) {
@@ -117,6 +281,9 @@ int main() {
 
     gnl_assert(can_load_default, "can load a default configuration.");
     gnl_assert(can_load_env, "can load the configuration from the env.");
+    gnl_assert(can_load_replacement_policies, "can load every replacement policy from the env.");
+    gnl_assert(can_load_event_loops, "can load every event loop from the env.");
+    gnl_assert(can_not_load_invalid_watermarks, "can not load invalid eviction watermarks from the env.");
     gnl_assert(can_not_load_with_error, "can not load an incorrect configuration from the env.");
 
     // the gnl_fss_config_destroy method is implicitly tested in every assertion
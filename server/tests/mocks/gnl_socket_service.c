@@ -31,6 +31,10 @@ struct gnl_socket_connection *gnl_socket_service_connect(const char *socket_name
     return NULL;
 }
 
+int gnl_socket_service_negotiate(struct gnl_socket_connection *connection) {
+    return 0;
+}
+
 int gnl_socket_service_close(struct gnl_socket_connection *connection) {
     if (gnl_socket_service_close_result >= 0) {
         free(connection->socket_name);
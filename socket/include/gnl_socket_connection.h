@@ -1,7 +1,19 @@
-
 #ifndef GNL_SOCKET_CONNECTION_H
 #define GNL_SOCKET_CONNECTION_H
 
+/**
+ * The versions of the wire protocol framing.
+ *
+ * GNL_SOCKET_PROTOCOL_V1   Every message starts with its type, its request id and
+ *                          its length written as 10 ASCII digits each, plus a '\0'.
+ * GNL_SOCKET_PROTOCOL_V2   Every message starts with a binary header of 18 bytes:
+ *                          magic, version, opcode, flags, request id and length.
+ */
+enum gnl_socket_protocol_version {
+    GNL_SOCKET_PROTOCOL_V1 = 1,
+    GNL_SOCKET_PROTOCOL_V2 = 2
+};
+
 /**
  * Socket connection instance.
  */
@@ -9,6 +21,7 @@ struct gnl_socket_connection {
     int fd; // the identifier of the socket connection
     char* socket_name; // the socket name
     int active; // if 1 the connection is active, otherwise (active == 0) is not.
+    int version; // the protocol version used to send the requests, see gnl_socket_service_negotiate.
 };
 
-#endif //GNL_SOCKET_CONNECTION_H
\ No newline at end of file
+#endif //GNL_SOCKET_CONNECTION_H
@@ -20,9 +20,22 @@ enum gnl_socket_request_type {
     GNL_SOCKET_REQUEST_LOCK,
     GNL_SOCKET_REQUEST_UNLOCK,
     GNL_SOCKET_REQUEST_CLOSE,
-    GNL_SOCKET_REQUEST_REMOVE
+    GNL_SOCKET_REQUEST_REMOVE,
+    GNL_SOCKET_REQUEST_WRITE_BEGIN,
+    GNL_SOCKET_REQUEST_WRITE_CHUNK,
+    GNL_SOCKET_REQUEST_WRITE_END,
+    GNL_SOCKET_REQUEST_READ_STREAM
 };
 
+// the maximum number of bytes carried by a GNL_SOCKET_REQUEST_WRITE_CHUNK
+// request, so the buffer of a chunk received by the server is bounded
+#define GNL_SOCKET_REQUEST_MAX_CHUNK_SIZE 1048576
+
+// the maximum number of bytes carried by a GNL_SOCKET_REQUEST_WRITE request,
+// so the buffer of a write received by the server is bounded, the bigger
+// files are sent by GNL_SOCKET_REQUEST_WRITE_CHUNK requests
+#define GNL_SOCKET_REQUEST_MAX_WRITE_SIZE 67108864
+
 /**
  * The socket request.
  */
@@ -42,12 +55,33 @@ struct gnl_socket_request;
  *              - GNL_SOCKET_REQUEST_UNLOCK: int fd
  *              - GNL_SOCKET_REQUEST_CLOSE: int fd
  *              - GNL_SOCKET_REQUEST_REMOVE: int fd
+ *              - GNL_SOCKET_REQUEST_WRITE_BEGIN: int fd
+ *              - GNL_SOCKET_REQUEST_WRITE_CHUNK: int fd, size_t size, char *bytes
+ *              - GNL_SOCKET_REQUEST_WRITE_END: int fd
+ *              - GNL_SOCKET_REQUEST_READ_STREAM: int fd
  *
  * @return      Returns a gnl_socket_request struct on success,
  *              NULL otherwise.
  */
 struct gnl_socket_request *gnl_socket_request_init(enum gnl_socket_request_type type, int num, ...);
 
+/**
+ * Create a GNL_SOCKET_REQUEST_WRITE or a GNL_SOCKET_REQUEST_WRITE_CHUNK request
+ * that borrows the given bytes: they are neither copied nor freed by the
+ * request, so they must be taken back with gnl_socket_request_release_bytes
+ * before the request is destroyed.
+ *
+ * @param type  The type of the request.
+ * @param fd    The file descriptor of the file where to write.
+ * @param count The number of bytes to write.
+ * @param bytes The bytes to write.
+ *
+ * @return      Returns a gnl_socket_request struct on success,
+ *              NULL otherwise.
+ */
+extern struct gnl_socket_request *gnl_socket_request_init_borrowed(enum gnl_socket_request_type type, int fd,
+        size_t count, void *bytes);
+
 /**
  * Destroy the socket request.
  *
@@ -88,6 +122,38 @@ extern size_t gnl_socket_request_to_string(const struct gnl_socket_request *requ
  */
 extern struct gnl_socket_request *gnl_socket_request_from_string(const char *message, enum gnl_socket_request_type type);
 
+/**
+ * Encode the given request into io vectors, so that it can be written
+ * with a single writev: the bytes of a GNL_SOCKET_REQUEST_WRITE or of a
+ * GNL_SOCKET_REQUEST_WRITE_CHUNK request are referenced by the io vectors,
+ * not copied. The io vectors are valid until dest is freed or the request
+ * is destroyed.
+ *
+ * @param request   The request to be encoded.
+ * @param dest      The pointer where to write the encoded part of the request.
+ * @param iov       The destination array of (at least) two io vectors.
+ *
+ * @return          Returns the number of io vectors written on success,
+ *                  -1 otherwise.
+ */
+extern int gnl_socket_request_to_iovec(const struct gnl_socket_request *request, char **dest, struct iovec *iov);
+
+/**
+ * Build a GNL_SOCKET_REQUEST_WRITE or a GNL_SOCKET_REQUEST_WRITE_CHUNK
+ * request from the given two io vectors, as described by
+ * gnl_message_nnb_from_iovec: the bytes of the second io vector are
+ * adopted by the request, not copied.
+ *
+ * @param iov       The array of two io vectors from where to build the request.
+ * @param type      The type of the request, GNL_SOCKET_REQUEST_WRITE or
+ *                  GNL_SOCKET_REQUEST_WRITE_CHUNK.
+ *
+ * @return          Returns the built gnl_socket_request on success,
+ *                  NULL otherwise. On failure the bytes are not adopted.
+ */
+extern struct gnl_socket_request *gnl_socket_request_from_iovec(const struct iovec *iov,
+        enum gnl_socket_request_type type);
+
 /**
  * Get the type code of the given request.
  *
@@ -98,6 +164,61 @@ extern struct gnl_socket_request *gnl_socket_request_from_string(const char *mes
  */
 extern int gnl_socket_request_type(const struct gnl_socket_request *request);
 
+/**
+ * Get the id of the given request. The id is chosen by the client and it is
+ * sent back within the response, so a client can send several requests
+ * without waiting for each response.
+ *
+ * @param request   The socket request.
+ *
+ * @return          Returns the request id on success, 0 if the request
+ *                  has no id or on failure.
+ */
+extern unsigned int gnl_socket_request_get_id(const struct gnl_socket_request *request);
+
+/**
+ * Set the id of the given request.
+ *
+ * @param request   The socket request.
+ * @param id        The id to set, 0 means no id.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_socket_request_set_id(struct gnl_socket_request *request, unsigned int id);
+
+/**
+ * Get the version of the wire protocol framing the given request travels with,
+ * see GNL_SOCKET_PROTOCOL_V1 and GNL_SOCKET_PROTOCOL_V2.
+ *
+ * @param request    The socket request.
+ *
+ * @return          Returns the protocol version on success, 0 if the
+ *                  version is unknown or on failure.
+ */
+extern unsigned int gnl_socket_request_get_version(const struct gnl_socket_request *request);
+
+/**
+ * Set the version of the wire protocol framing the given request travels with.
+ *
+ * @param request    The socket request.
+ * @param version   The protocol version to set, 0 means unknown.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_socket_request_set_version(struct gnl_socket_request *request, unsigned int version);
+
+/**
+ * Read the number of files to read from the given GNL_SOCKET_REQUEST_READ_N request,
+ * a number <= 0 asks for all the files. If the request is not a GNL_SOCKET_REQUEST_READ_N
+ * request, this invocation will fail.
+ *
+ * @param request   The socket request.
+ *
+ * @return          The number of files to read on success,
+ *                  -1 otherwise.
+ */
+extern int gnl_socket_request_get_n(const struct gnl_socket_request *request);
+
 /**
  * Read the file descriptor from the given GNL_SOCKET_REQUEST_READ, GNL_SOCKET_REQUEST_WRITE,
  * GNL_SOCKET_REQUEST_LOCK, GNL_SOCKET_REQUEST_UNLOCK, or GNL_SOCKET_REQUEST_CLOSE request.
@@ -134,8 +255,8 @@ extern char *gnl_socket_request_get_filename(const struct gnl_socket_request *re
 extern int gnl_socket_request_get_flags(const struct gnl_socket_request *request);
 
 /**
- * Get the count of bytes from the given GNL_SOCKET_REQUEST_WRITE request.
- * If the request is not a GNL_SOCKET_REQUEST_WRITE request,
+ * Get the count of bytes from the given GNL_SOCKET_REQUEST_WRITE or
+ * GNL_SOCKET_REQUEST_WRITE_CHUNK request. If the request is not one of them,
  * this invocation will fail.
  *
  * @param request   The request from where to get the count.
@@ -146,8 +267,8 @@ extern int gnl_socket_request_get_flags(const struct gnl_socket_request *request
 extern size_t gnl_socket_request_get_size(const struct gnl_socket_request *request);
 
 /**
- * Get the bytes from the given GNL_SOCKET_REQUEST_WRITE request.
- * If the request is not a GNL_SOCKET_REQUEST_WRITE request,
+ * Get the bytes from the given GNL_SOCKET_REQUEST_WRITE or
+ * GNL_SOCKET_REQUEST_WRITE_CHUNK request. If the request is not one of them,
  * this invocation will fail.
  *
  * @param request   The request from where to get the bytes.
@@ -157,4 +278,17 @@ extern size_t gnl_socket_request_get_size(const struct gnl_socket_request *reque
  */
 extern void *gnl_socket_request_get_bytes(const struct gnl_socket_request *request);
 
+/**
+ * Release the bytes of the given GNL_SOCKET_REQUEST_WRITE or
+ * GNL_SOCKET_REQUEST_WRITE_CHUNK request to the caller: the request will
+ * not reference (nor free) them anymore. If the request is not one of
+ * them, this invocation will fail.
+ *
+ * @param request   The request from where to release the bytes.
+ *
+ * @return          Returns the released bytes on success,
+ *                  NULL otherwise.
+ */
+extern void *gnl_socket_request_release_bytes(struct gnl_socket_request *request);
+
 #endif //GNL_SOCKET_REQUEST_H
\ No newline at end of file
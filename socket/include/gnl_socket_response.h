@@ -29,7 +29,12 @@ enum gnl_socket_response_type {
 
     // there was an error during the processing
     // of the request
-    GNL_SOCKET_RESPONSE_ERROR
+    GNL_SOCKET_RESPONSE_ERROR,
+
+    // the request is being processed and a chunk
+    // of a streamed file is returned, the stream
+    // is closed by a GNL_SOCKET_RESPONSE_OK response
+    GNL_SOCKET_RESPONSE_OK_CHUNK
 };
 
 /**
@@ -44,6 +49,7 @@ struct gnl_socket_response;
  * @param num   The number of the subsequent params.
  * @param ...   The list of params supported by the given response type:
  *              - GNL_SOCKET_RESPONSE_OK_FILE: char *filename, char *bytes
+ *              - GNL_SOCKET_RESPONSE_OK_CHUNK: char *filename, char *bytes
  *              - GNL_SOCKET_RESPONSE_OK_FD: int file_descriptor
  *              - GNL_SOCKET_RESPONSE_ERROR: int error_code
  *              The GNL_SOCKET_RESPONSE_OK_FILE_LIST response can not be initialized
@@ -106,6 +112,48 @@ extern int gnl_socket_response_get_error(const struct gnl_socket_response *respo
  */
 extern int gnl_socket_response_type(const struct gnl_socket_response *response);
 
+/**
+ * Get the id of the given response, that is the id of the
+ * request the response answers.
+ *
+ * @param response  The socket response.
+ *
+ * @return          Returns the response id on success, 0 if the response
+ *                  has no id or on failure.
+ */
+extern unsigned int gnl_socket_response_get_id(const struct gnl_socket_response *response);
+
+/**
+ * Set the id of the given response.
+ *
+ * @param response  The socket response.
+ * @param id        The id to set, 0 means no id.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_socket_response_set_id(struct gnl_socket_response *response, unsigned int id);
+
+/**
+ * Get the version of the wire protocol framing the given response travels with,
+ * see GNL_SOCKET_PROTOCOL_V1 and GNL_SOCKET_PROTOCOL_V2.
+ *
+ * @param response  The socket response.
+ *
+ * @return          Returns the protocol version on success, 0 if the
+ *                  version is unknown or on failure.
+ */
+extern unsigned int gnl_socket_response_get_version(const struct gnl_socket_response *response);
+
+/**
+ * Set the version of the wire protocol framing the given response travels with.
+ *
+ * @param response  The socket response.
+ * @param version   The protocol version to set, 0 means unknown.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_socket_response_set_version(struct gnl_socket_response *response, unsigned int version);
+
 /**
  * Get a string that represent the given response.
  *
@@ -117,6 +165,21 @@ extern int gnl_socket_response_type(const struct gnl_socket_response *response);
  */
 extern size_t gnl_socket_response_to_string(struct gnl_socket_response *response, char **dest);
 
+/**
+ * Encode the given response into io vectors, so that it can be written
+ * with a single writev: the bytes of a GNL_SOCKET_RESPONSE_OK_FILE or of a
+ * GNL_SOCKET_RESPONSE_OK_CHUNK response are referenced by the io vectors, not copied. The io vectors are valid
+ * until dest is freed or the response is destroyed.
+ *
+ * @param response  The response to be encoded.
+ * @param dest      The pointer where to write the encoded part of the response.
+ * @param iov       The destination array of (at least) two io vectors.
+ *
+ * @return          Returns the number of io vectors written on success (0 if
+ *                  the response has no payload), -1 otherwise.
+ */
+extern int gnl_socket_response_to_iovec(struct gnl_socket_response *response, char **dest, struct iovec *iov);
+
 /**
  * Build a response from the given string.
  *
@@ -155,9 +218,9 @@ extern int gnl_socket_response_add_file(struct gnl_socket_response *response, co
 extern struct gnl_message_snb *gnl_socket_response_get_file(struct gnl_socket_response *response);
 
 /**
- * Get the count of bytes from the given GNL_SOCKET_RESPONSE_OK_FILE response.
- * If the response is not a GNL_SOCKET_RESPONSE_OK_FILE response,
- * this invocation will fail.
+ * Get the count of bytes from the given GNL_SOCKET_RESPONSE_OK_FILE or
+ * GNL_SOCKET_RESPONSE_OK_CHUNK response. If the response is not
+ * one of them, this invocation will fail.
  *
  * @param response  The response from where to get the count.
  *
@@ -167,9 +230,9 @@ extern struct gnl_message_snb *gnl_socket_response_get_file(struct gnl_socket_re
 extern size_t gnl_socket_response_get_size(const struct gnl_socket_response *response);
 
 /**
- * Get the bytes from the given GNL_SOCKET_RESPONSE_OK_FILE response.
- * If the response is not a GNL_SOCKET_RESPONSE_OK_FILE response,
- * this invocation will fail.
+ * Get the bytes from the given GNL_SOCKET_RESPONSE_OK_FILE or
+ * GNL_SOCKET_RESPONSE_OK_CHUNK response. If the response is not
+ * one of them, this invocation will fail.
  *
  * @param response  The response from where to get the bytes.
  *
@@ -27,6 +27,19 @@ extern int gnl_socket_service_is_active(const struct gnl_socket_connection *conn
  */
 extern struct gnl_socket_connection *gnl_socket_service_connect(const char *socket_name);
 
+/**
+ * Negotiate the protocol version of the given connection with the server:
+ * offer the GNL_SOCKET_PROTOCOL_V2 framing and wait for the answer. If the
+ * server does not speak it, the connection keeps the GNL_SOCKET_PROTOCOL_V1
+ * framing. A server recognizes the framing of every message it receives,
+ * so a connection not negotiated keeps working with the old framing.
+ *
+ * @param connection    The socket_service_connection instance.
+ *
+ * @return              Returns 0 on success, -1 otherwise.
+ */
+extern int gnl_socket_service_negotiate(struct gnl_socket_connection *connection);
+
 /**
  * Close a connection to the given connection. Attention! This operation
  * will destroy the connection.
@@ -82,7 +95,9 @@ extern int gnl_socket_service_send_request(const struct gnl_socket_connection *c
         const struct gnl_socket_request *request);
 
 /**
- * Get a request from the given file descriptor.
+ * Get a request from the given file descriptor. If the message read
+ * is a client negotiating the protocol version, then answer it and
+ * fail with EAGAIN, since there is no request to handle.
  *
  * @param fd    The file descriptor from where to get the request.
  *
@@ -92,7 +107,8 @@ extern int gnl_socket_service_send_request(const struct gnl_socket_connection *c
 extern struct gnl_socket_request *gnl_socket_service_get_request(int fd);
 
 /**
- * Send the given response through the given file descriptor.
+ * Send the given response through the given file descriptor, framed with
+ * the protocol version of the response (see gnl_socket_response_set_version).
  *
  * @param fd        The file descriptor where to send the response.
  * @param response  The response to send.
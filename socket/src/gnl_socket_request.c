@@ -117,6 +117,8 @@
  */
 struct gnl_socket_request {
     enum gnl_socket_request_type type;
+    unsigned int id;
+    unsigned int version;
     union {
         struct gnl_message_sn *open;
         struct gnl_message_n *read;
@@ -126,9 +128,35 @@ struct gnl_socket_request {
         struct gnl_message_n *unlock;
         struct gnl_message_n *close;
         struct gnl_message_s *remove;
+        struct gnl_message_n *write_begin;
+        struct gnl_message_nnb *write_chunk;
+        struct gnl_message_n *write_end;
+        struct gnl_message_n *read_stream;
     } payload;
 };
 
+/**
+ * Get the message carrying the bytes of the given GNL_SOCKET_REQUEST_WRITE
+ * or GNL_SOCKET_REQUEST_WRITE_CHUNK request.
+ *
+ * @param request   The request from where to get the message.
+ *
+ * @return          Returns the message on success, NULL otherwise.
+ */
+static struct gnl_message_nnb *get_bytes_message(const struct gnl_socket_request *request) {
+    switch (request->type) {
+        case GNL_SOCKET_REQUEST_WRITE:
+            return request->payload.write;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            return request->payload.write_chunk;
+
+        default:
+            errno = EINVAL;
+            return NULL;
+    }
+}
+
 /**
  * {@inheritDoc}
  */
@@ -180,6 +208,26 @@ int gnl_socket_request_get_type(const struct gnl_socket_request *request, char *
             strcpy(*dest, "REMOVE");
             break;
 
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+        GNL_CALLOC(*dest, 12, -1);
+            strcpy(*dest, "WRITE_BEGIN");
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+        GNL_CALLOC(*dest, 12, -1);
+            strcpy(*dest, "WRITE_CHUNK");
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+        GNL_CALLOC(*dest, 10, -1);
+            strcpy(*dest, "WRITE_END");
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+        GNL_CALLOC(*dest, 12, -1);
+            strcpy(*dest, "READ_STREAM");
+            break;
+
         default:
             errno = EINVAL;
             return -1;
@@ -196,6 +244,12 @@ struct gnl_socket_request *gnl_socket_request_init(enum gnl_socket_request_type
     struct gnl_socket_request *socket_request = (struct gnl_socket_request *)malloc(sizeof(struct gnl_socket_request));
     GNL_NULL_CHECK(socket_request, ENOMEM, NULL)
 
+    // the id is assigned by the sender, if needed
+    socket_request->id = 0;
+
+    // the version of the framing it travels with, 0 if unknown
+    socket_request->version = 0;
+
     // initialize valist for num number of arguments
     va_list a_list;
     va_start(a_list, num);
@@ -256,6 +310,22 @@ struct gnl_socket_request *gnl_socket_request_init(enum gnl_socket_request_type
             GNL_REQUEST_S_INIT(num, socket_request->payload.remove, a_list)
             break;
 
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            GNL_REQUEST_N_INIT(num, socket_request->payload.write_begin, a_list)
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            GNL_REQUEST_NNB_INIT(num, socket_request->payload.write_chunk, a_list)
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            GNL_REQUEST_N_INIT(num, socket_request->payload.write_end, a_list)
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            GNL_REQUEST_N_INIT(num, socket_request->payload.read_stream, a_list)
+            break;
+
         default:
             errno = EINVAL;
             return NULL;
@@ -268,6 +338,31 @@ struct gnl_socket_request *gnl_socket_request_init(enum gnl_socket_request_type
     return socket_request;
 }
 
+/**
+ * {@inheritDoc}
+ */
+struct gnl_socket_request *gnl_socket_request_init_borrowed(enum gnl_socket_request_type type, int fd,
+        size_t count, void *bytes) {
+
+    // only the write requests carry bytes worth to be borrowed
+    if (type != GNL_SOCKET_REQUEST_WRITE && type != GNL_SOCKET_REQUEST_WRITE_CHUNK) {
+        errno = EINVAL;
+
+        return NULL;
+    }
+
+    struct gnl_socket_request *request = gnl_socket_request_init(type, 0);
+    GNL_NULL_CHECK(request, ENOMEM, NULL)
+
+    struct gnl_message_nnb *message = get_bytes_message(request);
+
+    message->number = fd;
+    message->count = count;
+    message->bytes = bytes;
+
+    return request;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -308,6 +403,22 @@ void gnl_socket_request_destroy(struct gnl_socket_request *request) {
         case GNL_SOCKET_REQUEST_REMOVE:
             gnl_message_s_destroy(request->payload.remove);
             break;
+
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            gnl_message_n_destroy(request->payload.write_begin);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            gnl_message_nnb_destroy(request->payload.write_chunk);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            gnl_message_n_destroy(request->payload.write_end);
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            gnl_message_n_destroy(request->payload.read_stream);
+            break;
     }
 
     free(request);
@@ -366,6 +477,22 @@ struct gnl_socket_request *gnl_socket_request_from_string(const char *message, e
             GNL_REQUEST_S_READ_MESSAGE(message, request->payload.remove, type);
             break;
 
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            GNL_REQUEST_N_READ_MESSAGE(message, request->payload.write_begin, type);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            GNL_REQUEST_NNB_READ_MESSAGE(message, request->payload.write_chunk, type);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            GNL_REQUEST_N_READ_MESSAGE(message, request->payload.write_end, type);
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            GNL_REQUEST_N_READ_MESSAGE(message, request->payload.read_stream, type);
+            break;
+
         default:
             errno = EINVAL;
             return NULL;
@@ -420,6 +547,22 @@ size_t gnl_socket_request_to_string(const struct gnl_socket_request *request, ch
             message_len = gnl_message_s_to_string(request->payload.remove, dest);
             break;
 
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            message_len = gnl_message_n_to_string(request->payload.write_begin, dest);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            message_len = gnl_message_nnb_to_string(request->payload.write_chunk, dest);
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            message_len = gnl_message_n_to_string(request->payload.write_end, dest);
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            message_len = gnl_message_n_to_string(request->payload.read_stream, dest);
+            break;
+
         default:
             errno = EINVAL;
             return -1;
@@ -436,6 +579,62 @@ size_t gnl_socket_request_to_string(const struct gnl_socket_request *request, ch
     return message_len;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_request_to_iovec(const struct gnl_socket_request *request, char **dest, struct iovec *iov) {
+    // validate the parameters
+    GNL_NULL_CHECK(request, EINVAL, -1)
+    GNL_NULL_CHECK(iov, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (*dest != NULL), EINVAL, -1)
+
+    // the bytes of a write request are referenced, not copied
+    if (request->type == GNL_SOCKET_REQUEST_WRITE || request->type == GNL_SOCKET_REQUEST_WRITE_CHUNK) {
+        int res = gnl_message_nnb_to_iovec(get_bytes_message(request), dest, iov);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        return 2;
+    }
+
+    // the other requests are small, so they are encoded as a whole
+    size_t message_len = gnl_socket_request_to_string(request, dest);
+    GNL_MINUS1_CHECK(message_len, errno, -1)
+
+    iov[0].iov_base = *dest;
+    iov[0].iov_len = message_len;
+
+    return 1;
+}
+
+/**
+ * {@inheritDoc}
+ */
+struct gnl_socket_request *gnl_socket_request_from_iovec(const struct iovec *iov, enum gnl_socket_request_type type) {
+    //validate the parameters
+    GNL_NULL_CHECK(iov, EINVAL, NULL)
+
+    // only the write requests carry bytes worth to be adopted
+    if (type != GNL_SOCKET_REQUEST_WRITE && type != GNL_SOCKET_REQUEST_WRITE_CHUNK) {
+        errno = EINVAL;
+
+        return NULL;
+    }
+
+    struct gnl_socket_request *request = gnl_socket_request_init(type, 0);
+    GNL_NULL_CHECK(request, ENOMEM, NULL)
+
+    int res = gnl_message_nnb_from_iovec(iov, get_bytes_message(request));
+    if (res == -1) {
+        int from_iovec_errno = errno;
+        gnl_socket_request_destroy(request);
+        errno = from_iovec_errno;
+
+        return NULL;
+    }
+
+    return request;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -445,6 +644,61 @@ int gnl_socket_request_type(const struct gnl_socket_request *request) {
     return request->type;
 }
 
+/**
+ * {@inheritDoc}
+ */
+unsigned int gnl_socket_request_get_id(const struct gnl_socket_request *request) {
+    GNL_NULL_CHECK(request, EINVAL, 0)
+
+    return request->id;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_request_set_id(struct gnl_socket_request *request, unsigned int id) {
+    GNL_NULL_CHECK(request, EINVAL, -1)
+
+    request->id = id;
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+unsigned int gnl_socket_request_get_version(const struct gnl_socket_request *request) {
+    GNL_NULL_CHECK(request, EINVAL, 0)
+
+    return request->version;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_request_set_version(struct gnl_socket_request *request, unsigned int version) {
+    GNL_NULL_CHECK(request, EINVAL, -1)
+
+    request->version = version;
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_request_get_n(const struct gnl_socket_request *request) {
+    GNL_NULL_CHECK(request, EINVAL, -1)
+
+    if (request->type != GNL_SOCKET_REQUEST_READ_N) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    return request->payload.read_N->number;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -475,6 +729,22 @@ int gnl_socket_request_get_fd(const struct gnl_socket_request *request) {
             fd = request->payload.close->number;
             break;
 
+        case GNL_SOCKET_REQUEST_WRITE_BEGIN:
+            fd = request->payload.write_begin->number;
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_CHUNK:
+            fd = request->payload.write_chunk->number;
+            break;
+
+        case GNL_SOCKET_REQUEST_WRITE_END:
+            fd = request->payload.write_end->number;
+            break;
+
+        case GNL_SOCKET_REQUEST_READ_STREAM:
+            fd = request->payload.read_stream->number;
+            break;
+
         default:
             errno = EINVAL;
             break;
@@ -537,13 +807,10 @@ int gnl_socket_request_get_flags(const struct gnl_socket_request *request) {
 size_t gnl_socket_request_get_size(const struct gnl_socket_request *request) {
     GNL_NULL_CHECK(request, EINVAL, -1)
 
-    if (request->type != GNL_SOCKET_REQUEST_WRITE) {
-        errno = EINVAL;
+    struct gnl_message_nnb *message = get_bytes_message(request);
+    GNL_NULL_CHECK(message, EINVAL, -1)
 
-        return -1;
-    }
-
-    return request->payload.write->count;
+    return message->count;
 }
 
 /**
@@ -552,13 +819,25 @@ size_t gnl_socket_request_get_size(const struct gnl_socket_request *request) {
 void *gnl_socket_request_get_bytes(const struct gnl_socket_request *request) {
     GNL_NULL_CHECK(request, EINVAL, NULL)
 
-    if (request->type != GNL_SOCKET_REQUEST_WRITE) {
-        errno = EINVAL;
+    struct gnl_message_nnb *message = get_bytes_message(request);
+    GNL_NULL_CHECK(message, EINVAL, NULL)
 
-        return NULL;
-    }
+    return message->bytes;
+}
+
+/**
+ * {@inheritDoc}
+ */
+void *gnl_socket_request_release_bytes(struct gnl_socket_request *request) {
+    GNL_NULL_CHECK(request, EINVAL, NULL)
+
+    struct gnl_message_nnb *message = get_bytes_message(request);
+    GNL_NULL_CHECK(message, EINVAL, NULL)
+
+    void *bytes = message->bytes;
+    message->bytes = NULL;
 
-    return request->payload.write->bytes;
+    return bytes;
 }
 
 #undef MAX_DIGITS_CHAR
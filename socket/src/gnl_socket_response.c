@@ -31,14 +31,38 @@
  */
 struct gnl_socket_response {
     enum gnl_socket_response_type type;
+    unsigned int id;
+    unsigned int version;
     union {
         struct gnl_message_nq *ok_file_list;
         struct gnl_message_snb *ok_file;
         struct gnl_message_n *ok_fd;
         struct gnl_message_n *error;
+        struct gnl_message_snb *ok_chunk;
     } payload;
 };
 
+/**
+ * Get the file message carried by the given response.
+ *
+ * @param response  The response from where to get the message.
+ *
+ * @return          Returns the message if the response is a
+ *                  GNL_SOCKET_RESPONSE_OK_FILE or a GNL_SOCKET_RESPONSE_OK_CHUNK
+ *                  response, NULL otherwise.
+ */
+static struct gnl_message_snb *get_file_message(const struct gnl_socket_response *response) {
+    switch (response->type) {
+        case GNL_SOCKET_RESPONSE_OK_FILE:
+            return response->payload.ok_file;
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            return response->payload.ok_chunk;
+        default:
+            errno = EINVAL;
+            return NULL;
+    }
+}
+
 /**
  * {@inheritDoc}
  */
@@ -75,6 +99,11 @@ int gnl_socket_response_get_type(const struct gnl_socket_response *response, cha
             strcpy(*dest, "ERROR");
             break;
 
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            GNL_CALLOC(*dest, 9, -1);
+            strcpy(*dest, "OK_CHUNK");
+            break;
+
         default:
             errno = EINVAL;
             return -1;
@@ -91,6 +120,12 @@ struct gnl_socket_response *gnl_socket_response_init(enum gnl_socket_response_ty
     struct gnl_socket_response *socket_response = (struct gnl_socket_response *)malloc(sizeof(struct gnl_socket_response));
     GNL_NULL_CHECK(socket_response, ENOMEM, NULL)
 
+    // the id is assigned by the sender, if needed
+    socket_response->id = 0;
+
+    // the version of the framing it travels with, 0 if unknown
+    socket_response->version = 0;
+
     // initialize valist for num number of arguments
     va_list a_list;
     va_start(a_list, num);
@@ -152,6 +187,25 @@ struct gnl_socket_response *gnl_socket_response_init(enum gnl_socket_response_ty
             GNL_RESPONSE_N_INIT(num, socket_response->payload.error, a_list)
             break;
 
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            switch (num) {
+                case 0:
+                    socket_response->payload.ok_chunk = gnl_message_snb_init();
+                    break;
+                case 3:
+                    buffer_s = va_arg(a_list, char *);
+                    buffer_n = va_arg(a_list, int);
+                    buffer_b = va_arg(a_list, void *);
+                    socket_response->payload.ok_chunk = gnl_message_snb_init_with_args(buffer_s, buffer_n, buffer_b);
+                    break;
+                default:
+                    errno = EINVAL;
+                    return NULL;
+            }
+
+            GNL_NULL_CHECK(socket_response->payload.ok_chunk, ENOMEM, NULL)
+            break;
+
         default:
             errno = EINVAL;
             free(socket_response);
@@ -185,6 +239,9 @@ void gnl_socket_response_destroy(struct gnl_socket_response *response) {
         case GNL_SOCKET_RESPONSE_ERROR:
             gnl_message_n_destroy(response->payload.error);
             break;
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            gnl_message_snb_destroy(response->payload.ok_chunk);
+            break;
     }
 
     free(response);
@@ -229,6 +286,46 @@ int gnl_socket_response_type(const struct gnl_socket_response *response) {
     return response->type;
 }
 
+/**
+ * {@inheritDoc}
+ */
+unsigned int gnl_socket_response_get_id(const struct gnl_socket_response *response) {
+    GNL_NULL_CHECK(response, EINVAL, 0)
+
+    return response->id;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_response_set_id(struct gnl_socket_response *response, unsigned int id) {
+    GNL_NULL_CHECK(response, EINVAL, -1)
+
+    response->id = id;
+
+    return 0;
+}
+
+/**
+ * {@inheritDoc}
+ */
+unsigned int gnl_socket_response_get_version(const struct gnl_socket_response *response) {
+    GNL_NULL_CHECK(response, EINVAL, 0)
+
+    return response->version;
+}
+
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_response_set_version(struct gnl_socket_response *response, unsigned int version) {
+    GNL_NULL_CHECK(response, EINVAL, -1)
+
+    response->version = version;
+
+    return 0;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -281,6 +378,14 @@ struct gnl_socket_response *gnl_socket_response_from_string(const char *message,
             GNL_MINUS1_CHECK(res, errno, NULL)
             break;
 
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_CHUNK, 0);
+            GNL_NULL_CHECK(response, ENOMEM, NULL)
+
+            res = gnl_message_snb_from_string(message, response->payload.ok_chunk);
+            GNL_MINUS1_CHECK(res, errno, NULL)
+            break;
+
         default:
             errno = EINVAL;
             return NULL;
@@ -321,6 +426,10 @@ size_t gnl_socket_response_to_string(struct gnl_socket_response *response, char
             len = gnl_message_n_to_string(response->payload.error, dest);
             break;
 
+        case GNL_SOCKET_RESPONSE_OK_CHUNK:
+            len = gnl_message_snb_to_string(response->payload.ok_chunk, dest);
+            break;
+
         default:
             errno = EINVAL;
             return -1;
@@ -330,6 +439,37 @@ size_t gnl_socket_response_to_string(struct gnl_socket_response *response, char
     return len;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_response_to_iovec(struct gnl_socket_response *response, char **dest, struct iovec *iov) {
+    // validate the parameters
+    GNL_NULL_CHECK(response, EINVAL, -1)
+    GNL_NULL_CHECK(iov, EINVAL, -1)
+    GNL_MINUS1_CHECK(-1 * (*dest != NULL), EINVAL, -1)
+
+    // the bytes of a file (or chunk) response are referenced, not copied
+    if (response->type == GNL_SOCKET_RESPONSE_OK_FILE || response->type == GNL_SOCKET_RESPONSE_OK_CHUNK) {
+        int res = gnl_message_snb_to_iovec(get_file_message(response), dest, iov);
+        GNL_MINUS1_CHECK(res, errno, -1)
+
+        return 2;
+    }
+
+    size_t len = gnl_socket_response_to_string(response, dest);
+    GNL_MINUS1_CHECK(len, errno, -1)
+
+    // the response has no payload
+    if (len == 0) {
+        return 0;
+    }
+
+    iov[0].iov_base = *dest;
+    iov[0].iov_len = len;
+
+    return 1;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -373,13 +513,10 @@ struct gnl_message_snb *gnl_socket_response_get_file(struct gnl_socket_response
 size_t gnl_socket_response_get_size(const struct gnl_socket_response *response) {
     GNL_NULL_CHECK(response, EINVAL, -1)
 
-    if (response->type != GNL_SOCKET_RESPONSE_OK_FILE) {
-        errno = EINVAL;
+    struct gnl_message_snb *message = get_file_message(response);
+    GNL_NULL_CHECK(message, EINVAL, -1)
 
-        return -1;
-    }
-
-    return response->payload.ok_file->count;
+    return message->count;
 }
 
 /**
@@ -388,13 +525,10 @@ size_t gnl_socket_response_get_size(const struct gnl_socket_response *response)
 void *gnl_socket_response_get_bytes(const struct gnl_socket_response *response) {
     GNL_NULL_CHECK(response, EINVAL, NULL)
 
-    if (response->type != GNL_SOCKET_RESPONSE_OK_FILE) {
-        errno = EINVAL;
-
-        return NULL;
-    }
+    struct gnl_message_snb *message = get_file_message(response);
+    GNL_NULL_CHECK(message, EINVAL, NULL)
 
-    return response->payload.ok_file->bytes;
+    return message->bytes;
 }
 
 #undef MAX_DIGITS_CHAR
@@ -4,52 +4,303 @@
 #include <sys/un.h>
 #include <unistd.h>
 #include <errno.h>
+#include <stdint.h>
+#include <sys/uio.h>
 #include "../include/gnl_socket_service.h"
 #include <gnl_macro_beg.h>
 
 #define MAX_DIGITS_CHAR "10"
 #define MAX_DIGITS_INT 10
-#define PROTOCOL_SIZE (MAX_DIGITS_INT + MAX_DIGITS_INT)
+#define PROTOCOL_SIZE (MAX_DIGITS_INT + MAX_DIGITS_INT + MAX_DIGITS_INT)
+
+// the size of the binary header of the GNL_SOCKET_PROTOCOL_V2 framing
+#define PROTOCOL_V2_SIZE 18
+
+// the first two bytes of a GNL_SOCKET_PROTOCOL_V2 message, never
+// digits, so they can not be the start of a GNL_SOCKET_PROTOCOL_V1 one
+#define PROTOCOL_V2_MAGIC_0 'G'
+#define PROTOCOL_V2_MAGIC_1 'L'
+
+// the flag of the message used to negotiate the protocol version
+#define PROTOCOL_FLAG_HELLO 0x0001
+
+// the maximum number of io vectors of a message: header, metadata, bytes
+#define PROTOCOL_MAX_IOVEC 3
 
 /**
- * Write a socket message into the given file descriptor.
+ * The metadata framing a socket message.
  *
- * @param fd        The file descriptor where to write the message.
- * @param message   The message to write.
- * @param type      The operation type to encode.
- * @param count     The number of bytes of the message.
+ * version  The protocol version of the framing.
+ * type     The operation type.
+ * flags    The flags of the message, GNL_SOCKET_PROTOCOL_V2 only.
+ * id       The request id.
+ * length   The number of bytes of the message.
+ */
+struct protocol_header {
+    int version;
+    int type;
+    unsigned int flags;
+    unsigned int id;
+    size_t length;
+};
+
+/**
+ * Encode the given header into the GNL_SOCKET_PROTOCOL_V2 binary header,
+ * the numbers are written in network byte order.
+ *
+ * @param header    The header to encode.
+ * @param dest      The buffer where to write, of PROTOCOL_V2_SIZE bytes.
+ */
+static void encode_protocol_v2_header(const struct protocol_header *header, unsigned char *dest) {
+    uint64_t length = header->length;
+
+    dest[0] = PROTOCOL_V2_MAGIC_0;
+    dest[1] = PROTOCOL_V2_MAGIC_1;
+    dest[2] = (unsigned char)header->version;
+    dest[3] = (unsigned char)header->type;
+    dest[4] = (unsigned char)(header->flags >> 8);
+    dest[5] = (unsigned char)header->flags;
+
+    for (int i=0; i<4; i++) {
+        dest[6 + i] = (unsigned char)(header->id >> (8 * (3 - i)));
+    }
+
+    for (int i=0; i<8; i++) {
+        dest[10 + i] = (unsigned char)(length >> (8 * (7 - i)));
+    }
+}
+
+/**
+ * Decode the given GNL_SOCKET_PROTOCOL_V2 binary header.
+ *
+ * @param src       The buffer to decode, of PROTOCOL_V2_SIZE bytes.
+ * @param header    The header where to put the decoded metadata.
  *
  * @return          Returns 0 on success, -1 otherwise.
  */
-static size_t write_protocol_message(int fd, const char *message, int type, size_t count) {
+static int decode_protocol_v2_header(const unsigned char *src, struct protocol_header *header) {
+    uint64_t length = 0;
+
+    header->version = src[2];
+    header->type = src[3];
+    header->flags = ((unsigned int)src[4] << 8) | src[5];
+    header->id = 0;
+
+    for (int i=0; i<4; i++) {
+        header->id = (header->id << 8) | src[6 + i];
+    }
+
+    for (int i=0; i<8; i++) {
+        length = (length << 8) | src[10 + i];
+    }
+
+    // the version must be known, a hello message may offer a newer one
+    if (header->version < GNL_SOCKET_PROTOCOL_V2
+        || (header->version > GNL_SOCKET_PROTOCOL_V2 && !(header->flags & PROTOCOL_FLAG_HELLO))
+        || length > SIZE_MAX) {
+        errno = EBADMSG;
+
+        return -1;
+    }
+
+    header->length = length;
+
+    return 0;
+}
+
+/**
+ * Write all the bytes referenced by the given io vectors into the given
+ * file descriptor, retrying on partial writes.
+ *
+ * @param fd        The file descriptor where to write.
+ * @param iov       The io vectors to write.
+ * @param iovcnt    The number of io vectors, at most PROTOCOL_MAX_IOVEC.
+ *
+ * @return          Returns the number of bytes written on success,
+ *                  -1 otherwise.
+ */
+static ssize_t writevn(int fd, const struct iovec *iov, int iovcnt) {
+    struct iovec vec[PROTOCOL_MAX_IOVEC];
+    struct iovec *current = vec;
+    size_t n = 0;
+    size_t nleft;
+    ssize_t nwritten;
+
+    // work on a copy, the io vectors are advanced on partial writes
+    for (int i=0; i<iovcnt; i++) {
+        vec[i] = iov[i];
+        n += iov[i].iov_len;
+    }
+
+    nleft = n;
+
+    while (nleft > 0) {
+        if ((nwritten = writev(fd, current, iovcnt)) < 0) {
+            if (nleft == n) {
+                // error, return -1
+                return -1;
+            } else {
+                // error, return amount written so far
+                break;
+            }
+        } else if (nwritten == 0) {
+            break;
+        }
+
+        nleft -= nwritten;
+
+        // skip the io vectors completely written
+        while (iovcnt > 0 && (size_t)nwritten >= current->iov_len) {
+            nwritten -= current->iov_len;
+            current++;
+            iovcnt--;
+        }
+
+        // advance into the io vector partially written
+        if (iovcnt > 0) {
+            current->iov_base = (char *)current->iov_base + nwritten;
+            current->iov_len -= nwritten;
+        }
+    }
+
+    // return >= 0
+    return (n - nleft);
+}
+
+/**
+ * Read from the given file descriptor into the buffers of the given
+ * io vectors until they are full, retrying on partial reads.
+ *
+ * @param fd        The file descriptor where to read.
+ * @param iov       The io vectors where to read.
+ * @param iovcnt    The number of io vectors, at most PROTOCOL_MAX_IOVEC.
+ *
+ * @return          Returns the number of bytes read on success,
+ *                  -1 otherwise.
+ */
+static ssize_t readvn(int fd, const struct iovec *iov, int iovcnt) {
+    struct iovec vec[PROTOCOL_MAX_IOVEC];
+    struct iovec *current = vec;
+    size_t n = 0;
+    size_t nleft;
+    ssize_t nread;
+
+    // work on a copy, the io vectors are advanced on partial reads
+    for (int i=0; i<iovcnt; i++) {
+        vec[i] = iov[i];
+        n += iov[i].iov_len;
+    }
+
+    nleft = n;
+
+    while (nleft > 0) {
+        if ((nread = readv(fd, current, iovcnt)) < 0) {
+            if (nleft == n) {
+                // error, return -1
+                return -1;
+            } else {
+                // error, return amount read so far
+                break;
+            }
+        } else if (nread == 0) {
+            // EOF
+            break;
+        }
+
+        nleft -= nread;
+
+        // skip the io vectors completely filled
+        while (iovcnt > 0 && (size_t)nread >= current->iov_len) {
+            nread -= current->iov_len;
+            current++;
+            iovcnt--;
+        }
+
+        // advance into the io vector partially filled
+        if (iovcnt > 0) {
+            current->iov_base = (char *)current->iov_base + nread;
+            current->iov_len -= nread;
+        }
+    }
+
+    // return >= 0
+    return (n - nleft);
+}
+
+/**
+ * Write a socket message into the given file descriptor, framed
+ * with the protocol version given by the header. The header and the
+ * payload are gathered by a single writev, so the payload is never
+ * copied into a framing buffer.
+ *
+ * @param fd            The file descriptor where to write the message.
+ * @param header        The header of the message.
+ * @param payload       The io vectors of the message, of header->length bytes
+ *                      overall.
+ * @param payload_cnt   The number of io vectors of the message, at most
+ *                      PROTOCOL_MAX_IOVEC - 1.
+ *
+ * @return              Returns the number of bytes written on success,
+ *                      -1 otherwise.
+ */
+static size_t write_protocol_message(int fd, const struct protocol_header *header, const struct iovec *payload,
+        int payload_cnt) {
+    size_t count = header->length;
+
     // validate parameters
-    // if count is > 0 then the message must not be NULL
+    // if count is > 0 then the payload must not be NULL
     if (count > 0) {
-        GNL_NULL_CHECK(message, EINVAL, -1);
+        GNL_NULL_CHECK(payload, EINVAL, -1);
     }
 
-    char *protocol_message;
+    if (payload_cnt < 0 || payload_cnt > PROTOCOL_MAX_IOVEC - 1) {
+        errno = EINVAL;
 
-    // allocate memory for the protocol message building
-    GNL_CALLOC(protocol_message, PROTOCOL_SIZE + 1 + count, -1)
+        return -1;
+    }
 
-    int maxlen = PROTOCOL_SIZE + 1; // count also the '\0' char
+    // large enough for the header of every protocol version
+    char protocol_message[PROTOCOL_SIZE + 1];
+    int header_len;
 
-    // add the protocol metadata
-    snprintf(protocol_message, maxlen, "%0*d%0*lu", MAX_DIGITS_INT, type, MAX_DIGITS_INT, count);
+    if (header->version == GNL_SOCKET_PROTOCOL_V2) {
+        // the opcode is a single byte
+        if (header->type < 0 || header->type > 0xff) {
+            errno = EINVAL;
 
-    // add the rest of the message (if the count is > 0)
-    if (count > 0) {
-        memcpy(protocol_message + maxlen, message, count);
+            return -1;
+        }
+
+        header_len = PROTOCOL_V2_SIZE;
+        encode_protocol_v2_header(header, (unsigned char *)protocol_message);
+    } else {
+        header_len = PROTOCOL_SIZE + 1; // count also the '\0' char
+        snprintf(protocol_message, header_len, "%0*d%0*u%0*lu", MAX_DIGITS_INT, header->type, MAX_DIGITS_INT,
+                 header->id, MAX_DIGITS_INT, count);
     }
 
-    int len = maxlen + count;
+    struct iovec iov[PROTOCOL_MAX_IOVEC];
+    size_t payload_len = 0;
 
-    // send the request
-    int nwrite = gnl_socket_service_writen(fd, protocol_message, len);
+    iov[0].iov_base = protocol_message;
+    iov[0].iov_len = header_len;
 
-    // free memory
-    free(protocol_message);
+    for (int i=0; i<payload_cnt; i++) {
+        iov[i + 1] = payload[i];
+        payload_len += payload[i].iov_len;
+    }
+
+    // the header must describe exactly the payload
+    if (payload_len != count) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    size_t len = header_len + count;
+
+    // send the message
+    ssize_t nwrite = writevn(fd, iov, payload_cnt + 1);
 
     // check the result of the sending
     if (nwrite <= 0) {
@@ -58,45 +309,39 @@ static size_t write_protocol_message(int fd, const char *message, int type, size
         return -1;
     }
 
+    if (nwrite != len) {
+        errno = EIO;
+
+        return -1;
+    }
+
     return nwrite;
 }
 
 /**
- * Read a socket message from a file descriptor. If an error occurs,
- * the given "dest" pointer value is unpredictable and it should not
- * be used. No leaks are raised.
+ * Read the header of a socket message from a file descriptor, the protocol
+ * version is recognized from the first bytes of the message.
  *
  * @param fd        The file descriptor where to read.
- * @param dest      The destination where to put the socket message.
- * @param type      The pointer where to put the operation type.
+ * @param header    The header where to put the metadata of the message.
  *
  * @return          Returns the number of bytes read on success,
- *                  -1 otherwise.
+ *                  0 if the connection is closed, -1 otherwise.
  */
-static size_t read_protocol_message(int fd, char **dest, int *type) {
-    char *protocol_message;
-    size_t message_len;
+static size_t read_protocol_header(int fd, struct protocol_header *header) {
+    // large enough for the header of every protocol version
+    char protocol_message[PROTOCOL_SIZE + 1];
 
-    // allocate memory for the initial message reading
-    GNL_CALLOC(protocol_message, PROTOCOL_SIZE + 1, -1)
-
-    // read the first 21 chars, the protocol standard puts
-    // the type of the message in the first 10 chars and the
-    // size of the message in the second 10 chars, the remaining
-    // byte is the null terminator char
-    ssize_t proto_nread = gnl_socket_service_readn(fd, protocol_message, PROTOCOL_SIZE + 1);
+    // read the first PROTOCOL_V2_SIZE bytes, every message is at least that long
+    ssize_t proto_nread = gnl_socket_service_readn(fd, protocol_message, PROTOCOL_V2_SIZE);
 
     // if nread == 0, the connection is closed, return
     if (proto_nread == 0) {
-        free(protocol_message);
-
         return 0;
     }
 
     // check if the read succeeded
-    if (proto_nread != (PROTOCOL_SIZE + 1)) {
-        free(protocol_message);
-
+    if (proto_nread != PROTOCOL_V2_SIZE) {
         // if nread == -1, let the errno bubble
         if (proto_nread != -1) {
             errno = EBADMSG;
@@ -105,21 +350,64 @@ static size_t read_protocol_message(int fd, char **dest, int *type) {
         return -1;
     }
 
-    // get the operation type and the message length
-    sscanf(protocol_message, "%"MAX_DIGITS_CHAR"d%"MAX_DIGITS_CHAR"lu", type, &message_len);
+    if (protocol_message[0] == PROTOCOL_V2_MAGIC_0 && protocol_message[1] == PROTOCOL_V2_MAGIC_1) {
+        int res = decode_protocol_v2_header((unsigned char *)protocol_message, header);
+        GNL_MINUS1_CHECK(res, errno, -1)
+    } else {
+        // the GNL_SOCKET_PROTOCOL_V1 standard puts the type of the message in
+        // the first 10 chars, the request id in the second 10 chars and the size
+        // of the message in the third 10 chars, the remaining byte is the null
+        // terminator char: read the rest of it
+        ssize_t nread = gnl_socket_service_readn(fd, protocol_message + PROTOCOL_V2_SIZE,
+                                                 PROTOCOL_SIZE + 1 - PROTOCOL_V2_SIZE);
+
+        if (nread != PROTOCOL_SIZE + 1 - PROTOCOL_V2_SIZE) {
+            // if nread == -1, let the errno bubble
+            if (nread != -1) {
+                errno = EBADMSG;
+            }
 
-    // free memory
-    free(protocol_message);
+            return -1;
+        }
 
-    // check the message_len
-    if (message_len < 0) {
-        errno = EBADMSG;
+        proto_nread += nread;
 
-        return -1;
+        // do not trust the sender for the null terminator char
+        protocol_message[PROTOCOL_SIZE] = '\0';
+
+        // get the operation type, the request id and the message length
+        int res = sscanf(protocol_message, "%"MAX_DIGITS_CHAR"d%"MAX_DIGITS_CHAR"u%"MAX_DIGITS_CHAR"lu",
+                         &(header->type), &(header->id), &(header->length));
+
+        if (res != 3) {
+            errno = EBADMSG;
+
+            return -1;
+        }
+
+        header->version = GNL_SOCKET_PROTOCOL_V1;
+        header->flags = 0;
     }
 
+    return proto_nread;
+}
+
+/**
+ * Read the payload of a socket message, described by the given header,
+ * from a file descriptor. If an error occurs, the given "dest" pointer
+ * value is unpredictable and it should not be used. No leaks are raised.
+ *
+ * @param fd        The file descriptor where to read.
+ * @param header    The header of the message.
+ * @param dest      The destination where to put the socket message.
+ *
+ * @return          Returns the number of bytes read on success,
+ *                  -1 otherwise.
+ */
+static size_t read_protocol_payload(int fd, const struct protocol_header *header, char **dest) {
     // if the message len is > 0, read the message
-    size_t nread = 0;
+    size_t message_len = header->length;
+    ssize_t nread = 0;
 
     if (message_len > 0) {
         // allocate memory for the payload message
@@ -142,9 +430,161 @@ static size_t read_protocol_message(int fd, char **dest, int *type) {
         }
     }
 
+    return nread;
+}
+
+/**
+ * Read a socket message from a file descriptor, the protocol version
+ * is recognized from the first bytes of the message. If an error occurs,
+ * the given "dest" pointer value is unpredictable and it should not
+ * be used. No leaks are raised.
+ *
+ * @param fd        The file descriptor where to read.
+ * @param header    The header where to put the metadata of the message.
+ * @param dest      The destination where to put the socket message.
+ *
+ * @return          Returns the number of bytes read on success,
+ *                  0 if the connection is closed, -1 otherwise.
+ */
+static size_t read_protocol_message(int fd, struct protocol_header *header, char **dest) {
+    size_t proto_nread = read_protocol_header(fd, header);
+
+    // if nread == 0 the connection is closed, if nread == -1 let the errno bubble
+    if (proto_nread == 0 || proto_nread == -1) {
+        return proto_nread;
+    }
+
+    size_t nread = read_protocol_payload(fd, header, dest);
+    GNL_MINUS1_CHECK(nread, errno, -1)
+
     return proto_nread + nread;
 }
 
+/**
+ * Skip the given number of bytes of a payload from a file descriptor,
+ * without allocating them, so the next message can still be read.
+ *
+ * @param fd        The file descriptor where to read.
+ * @param length    The number of bytes to skip.
+ */
+static void skip_payload(int fd, size_t length) {
+    char skip[4096];
+    size_t left = length;
+    ssize_t nread;
+
+    while (left > 0) {
+        nread = gnl_socket_service_readn(fd, skip, left < sizeof(skip) ? left : sizeof(skip));
+        if (nread <= 0) {
+            break;
+        }
+
+        left -= nread;
+    }
+}
+
+/**
+ * Read the payload of a write (or write chunk) request, described by the
+ * given header, from a file descriptor. The metadata and the bytes are
+ * scattered by a single readv: the bytes land into their own buffer, which
+ * is adopted by the built request without being copied. A write bigger than
+ * GNL_SOCKET_REQUEST_MAX_WRITE_SIZE, or a chunk bigger than
+ * GNL_SOCKET_REQUEST_MAX_CHUNK_SIZE, is skipped without allocating it, and
+ * refused with EMSGSIZE. On any error the payload is skipped, unless the
+ * read itself fails.
+ *
+ * @param fd        The file descriptor where to read.
+ * @param header    The header of the message.
+ *
+ * @return          Returns the built request on success, NULL otherwise.
+ */
+static struct gnl_socket_request *read_write_request(int fd, const struct protocol_header *header) {
+    if (header->length < GNL_MESSAGE_NNB_METADATA_SIZE) {
+        skip_payload(fd, header->length);
+        errno = EBADMSG;
+
+        return NULL;
+    }
+
+    size_t count = header->length - GNL_MESSAGE_NNB_METADATA_SIZE;
+    size_t max = header->type == GNL_SOCKET_REQUEST_WRITE_CHUNK
+            ? GNL_SOCKET_REQUEST_MAX_CHUNK_SIZE
+            : GNL_SOCKET_REQUEST_MAX_WRITE_SIZE;
+
+    if (count > max) {
+        skip_payload(fd, header->length);
+        errno = EMSGSIZE;
+
+        return NULL;
+    }
+
+    char metadata[GNL_MESSAGE_NNB_METADATA_SIZE];
+
+    void *bytes = malloc(count > 0 ? count : 1);
+    if (bytes == NULL) {
+        skip_payload(fd, header->length);
+        errno = ENOMEM;
+
+        return NULL;
+    }
+
+    struct iovec iov[2];
+
+    iov[0].iov_base = metadata;
+    iov[0].iov_len = GNL_MESSAGE_NNB_METADATA_SIZE;
+    iov[1].iov_base = bytes;
+    iov[1].iov_len = count;
+
+    ssize_t nread = readvn(fd, iov, 2);
+
+    // check if the read succeeded, if not the payload
+    // can not be skipped since the stream is broken
+    if (nread != header->length) {
+        free(bytes);
+
+        // if nread == -1, let the errno bubble
+        if (nread != -1) {
+            errno = EBADMSG;
+        }
+
+        return NULL;
+    }
+
+    // do not trust the sender for the null terminator char
+    metadata[GNL_MESSAGE_NNB_METADATA_SIZE - 1] = '\0';
+
+    struct gnl_socket_request *request = gnl_socket_request_from_iovec(iov, header->type);
+    if (request == NULL) {
+        free(bytes);
+        errno = EBADMSG;
+
+        return NULL;
+    }
+
+    return request;
+}
+
+/**
+ * Write a hello message into the given file descriptor, the message
+ * used to negotiate the protocol version of a connection.
+ *
+ * @param fd        The file descriptor where to write the message.
+ * @param version   The protocol version offered or chosen.
+ *
+ * @return          Returns the number of bytes written on success,
+ *                  -1 otherwise.
+ */
+static size_t write_hello_message(int fd, int version) {
+    struct protocol_header header;
+
+    header.version = version;
+    header.type = 0;
+    header.flags = PROTOCOL_FLAG_HELLO;
+    header.id = 0;
+    header.length = 0;
+
+    return write_protocol_message(fd, &header, NULL, 0);
+}
+
 /**
  * {@inheritDoc}
  */
@@ -201,9 +641,58 @@ struct gnl_socket_connection *gnl_socket_service_connect(const char *socket_name
     // activate flag
     connection->active = 1;
 
+    // until negotiated, speak the protocol every server understands
+    connection->version = GNL_SOCKET_PROTOCOL_V1;
+
     return connection;
 }
 
+/**
+ * {@inheritDoc}
+ */
+int gnl_socket_service_negotiate(struct gnl_socket_connection *connection) {
+    //validate parameters
+    GNL_NULL_CHECK(connection, EINVAL, -1);
+
+    // check if the connection is active
+    if (!gnl_socket_service_is_active(connection)) {
+        errno = EINVAL;
+
+        return -1;
+    }
+
+    // offer the newest protocol version
+    size_t nwrite = write_hello_message(connection->fd, GNL_SOCKET_PROTOCOL_V2);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    struct protocol_header header;
+    char *message = NULL;
+
+    size_t nread = read_protocol_message(connection->fd, &header, &message);
+
+    // the payload of the answer is not needed
+    free(message);
+
+    GNL_MINUS1_CHECK(nread, errno, -1)
+
+    // if nread == 0 the connection is closed, return
+    if (nread == 0) {
+        errno = EPIPE;
+
+        return -1;
+    }
+
+    // a server not speaking the GNL_SOCKET_PROTOCOL_V2 answers with
+    // something else than a hello message
+    if (header.version == GNL_SOCKET_PROTOCOL_V2 && (header.flags & PROTOCOL_FLAG_HELLO)) {
+        connection->version = GNL_SOCKET_PROTOCOL_V2;
+    } else {
+        connection->version = GNL_SOCKET_PROTOCOL_V1;
+    }
+
+    return 0;
+}
+
 /**
  * {@inheritDoc}
  */
@@ -304,19 +793,32 @@ int gnl_socket_service_send_request(const struct gnl_socket_connection *connecti
     }
 
     char *message = NULL;
+    struct iovec iov[PROTOCOL_MAX_IOVEC - 1];
 
-    // get the request message
-    size_t bytes = gnl_socket_request_to_string(request, &message);
+    // get the request message, the bytes of a write request are not copied
+    int iovcnt = gnl_socket_request_to_iovec(request, &message, iov);
 
-    if (bytes == -1) {
+    if (iovcnt == -1) {
         free(message);
         // let the errno bubble
 
         return -1;
     }
 
+    struct protocol_header header;
+
+    header.version = connection->version;
+    header.type = gnl_socket_request_type(request);
+    header.flags = 0;
+    header.id = gnl_socket_request_get_id(request);
+    header.length = 0;
+
+    for (int i=0; i<iovcnt; i++) {
+        header.length += iov[i].iov_len;
+    }
+
     // send the request message through the socket
-    size_t nwrite = write_protocol_message(connection->fd, message, gnl_socket_request_type(request), bytes);
+    size_t nwrite = write_protocol_message(connection->fd, &header, iov, iovcnt);
 
     // free memory
     free(message);
@@ -332,17 +834,12 @@ int gnl_socket_service_send_request(const struct gnl_socket_connection *connecti
  */
 struct gnl_socket_request *gnl_socket_service_get_request(int fd) {
     char *message = NULL;
-    int type;
-
-    size_t nread = read_protocol_message(fd, &message, &type);
+    struct protocol_header header;
 
-    // check the reading result
-    if (nread == -1) {
-        free(message);
-        // let the errno bubble
+    size_t nread = read_protocol_header(fd, &header);
 
-        return NULL;
-    }
+    // check the reading result, let the errno bubble
+    GNL_MINUS1_CHECK(nread, errno, NULL)
 
     // if nread == 0 the connection is closed, return
     if (nread == 0) {
@@ -351,9 +848,43 @@ struct gnl_socket_request *gnl_socket_service_get_request(int fd) {
         return NULL;
     }
 
-    // get the request from the message
     struct gnl_socket_request *request;
-    request = gnl_socket_request_from_string(message, type);
+
+    // the bytes of a write request are read straight into their own buffer
+    if ((header.type == GNL_SOCKET_REQUEST_WRITE || header.type == GNL_SOCKET_REQUEST_WRITE_CHUNK)
+        && !(header.flags & PROTOCOL_FLAG_HELLO)) {
+        request = read_write_request(fd, &header);
+        GNL_NULL_CHECK(request, errno, NULL)
+
+        gnl_socket_request_set_id(request, header.id);
+        gnl_socket_request_set_version(request, header.version);
+
+        return request;
+    }
+
+    nread = read_protocol_payload(fd, &header, &message);
+
+    // check the reading result, let the errno bubble
+    GNL_MINUS1_CHECK(nread, errno, NULL)
+
+    // if the client is negotiating the protocol version, answer
+    // with the newest version known by both
+    if (header.flags & PROTOCOL_FLAG_HELLO) {
+        free(message);
+
+        int version = header.version > GNL_SOCKET_PROTOCOL_V2 ? GNL_SOCKET_PROTOCOL_V2 : header.version;
+
+        size_t nwrite = write_hello_message(fd, version);
+        GNL_MINUS1_CHECK(nwrite, errno, NULL)
+
+        // there is no request to handle
+        errno = EAGAIN;
+
+        return NULL;
+    }
+
+    // get the request from the message
+    request = gnl_socket_request_from_string(message, header.type);
 
     // free memory
     free(message);
@@ -361,6 +892,9 @@ struct gnl_socket_request *gnl_socket_service_get_request(int fd) {
     // check the request
     GNL_NULL_CHECK(request, errno, NULL);
 
+    gnl_socket_request_set_id(request, header.id);
+    gnl_socket_request_set_version(request, header.version);
+
     return request;
 }
 
@@ -372,19 +906,33 @@ int gnl_socket_service_send_response(int fd, struct gnl_socket_response *respons
     GNL_NULL_CHECK(response, EINVAL, -1);
 
     char *message = NULL;
+    struct iovec iov[PROTOCOL_MAX_IOVEC - 1];
 
-    // get the request message
-    size_t bytes = gnl_socket_response_to_string(response, &message);
+    // get the response message, the bytes of a file are not copied
+    int iovcnt = gnl_socket_response_to_iovec(response, &message, iov);
 
-    if (bytes == -1) {
+    if (iovcnt == -1) {
         free(message);
         // let the errno bubble
 
         return -1;
     }
 
-    // send the request message through the socket
-    size_t nwrite = write_protocol_message(fd, message, gnl_socket_response_type(response), bytes);
+    struct protocol_header header;
+
+    // answer with the protocol version of the request
+    header.version = gnl_socket_response_get_version(response);
+    header.type = gnl_socket_response_type(response);
+    header.flags = 0;
+    header.id = gnl_socket_response_get_id(response);
+    header.length = 0;
+
+    for (int i=0; i<iovcnt; i++) {
+        header.length += iov[i].iov_len;
+    }
+
+    // send the response message through the socket
+    size_t nwrite = write_protocol_message(fd, &header, iov, iovcnt);
 
     // free memory
     free(message);
@@ -410,9 +958,9 @@ struct gnl_socket_response *gnl_socket_service_get_response(const struct gnl_soc
     }
 
     char *message = NULL;
-    int type;
+    struct protocol_header header;
 
-    size_t nread = read_protocol_message(connection->fd, &message, &type);
+    size_t nread = read_protocol_message(connection->fd, &header, &message);
 
     // check the reading result
     if (nread == -1) {
@@ -431,7 +979,7 @@ struct gnl_socket_response *gnl_socket_service_get_response(const struct gnl_soc
 
     // get the request from the message
     struct gnl_socket_response *response;
-    response = gnl_socket_response_from_string(message, type);
+    response = gnl_socket_response_from_string(message, header.type);
 
     // free memory
     free(message);
@@ -439,10 +987,18 @@ struct gnl_socket_response *gnl_socket_service_get_response(const struct gnl_soc
     // check the request
     GNL_NULL_CHECK(response, errno, NULL);
 
+    gnl_socket_response_set_id(response, header.id);
+    gnl_socket_response_set_version(response, header.version);
+
     return response;
 }
 
 #undef MAX_DIGITS_CHAR
 #undef MAX_DIGITS_INT
 #undef PROTOCOL_SIZE
+#undef PROTOCOL_V2_SIZE
+#undef PROTOCOL_V2_MAGIC_0
+#undef PROTOCOL_V2_MAGIC_1
+#undef PROTOCOL_FLAG_HELLO
+#undef PROTOCOL_MAX_IOVEC
 #include <gnl_macro_end.h>
\ No newline at end of file
@@ -789,6 +789,169 @@ int can_get_type_remove() {
     GNL_TEST_GET_TYPE(GNL_SOCKET_REQUEST_REMOVE, "REMOVE");
 }
 
+int can_init_empty_write_begin() {
+    GNL_TEST_EMPTY_REQUEST_N(GNL_SOCKET_REQUEST_WRITE_BEGIN, request->payload.write_begin)
+}
+
+int can_init_args_write_begin() {
+    GNL_TEST_REQUEST_N_ARGS(GNL_SOCKET_REQUEST_WRITE_BEGIN, request->payload.write_begin)
+}
+
+int can_from_string_write_begin() {
+    GNL_TEST_REQUEST_N_FROM_STRING(GNL_SOCKET_REQUEST_WRITE_BEGIN, request->payload.write_begin)
+}
+
+int can_to_string_write_begin() {
+    GNL_TEST_REQUEST_N_TO_STRING(GNL_SOCKET_REQUEST_WRITE_BEGIN)
+}
+
+int can_init_args_write_chunk() {
+    GNL_TEST_REQUEST_NNB_ARGS(GNL_SOCKET_REQUEST_WRITE_CHUNK, request->payload.write_chunk)
+}
+
+int can_from_string_write_chunk() {
+    GNL_TEST_REQUEST_NNB_FROM_STRING(GNL_SOCKET_REQUEST_WRITE_CHUNK, request->payload.write_chunk)
+}
+
+int can_to_string_write_chunk() {
+    GNL_TEST_REQUEST_NNB_TO_STRING(GNL_SOCKET_REQUEST_WRITE_CHUNK)
+}
+
+int can_init_empty_write_end() {
+    GNL_TEST_EMPTY_REQUEST_N(GNL_SOCKET_REQUEST_WRITE_END, request->payload.write_end)
+}
+
+int can_init_args_write_end() {
+    GNL_TEST_REQUEST_N_ARGS(GNL_SOCKET_REQUEST_WRITE_END, request->payload.write_end)
+}
+
+int can_from_string_write_end() {
+    GNL_TEST_REQUEST_N_FROM_STRING(GNL_SOCKET_REQUEST_WRITE_END, request->payload.write_end)
+}
+
+int can_to_string_write_end() {
+    GNL_TEST_REQUEST_N_TO_STRING(GNL_SOCKET_REQUEST_WRITE_END)
+}
+
+int can_init_empty_read_stream() {
+    GNL_TEST_EMPTY_REQUEST_N(GNL_SOCKET_REQUEST_READ_STREAM, request->payload.read_stream)
+}
+
+int can_init_args_read_stream() {
+    GNL_TEST_REQUEST_N_ARGS(GNL_SOCKET_REQUEST_READ_STREAM, request->payload.read_stream)
+}
+
+int can_from_string_read_stream() {
+    GNL_TEST_REQUEST_N_FROM_STRING(GNL_SOCKET_REQUEST_READ_STREAM, request->payload.read_stream)
+}
+
+int can_to_string_read_stream() {
+    GNL_TEST_REQUEST_N_TO_STRING(GNL_SOCKET_REQUEST_READ_STREAM)
+}
+
+int can_init_borrowed_write_chunk() {
+    char bytes[] = "borrowed bytes";
+    struct gnl_socket_request *request = gnl_socket_request_init_borrowed(GNL_SOCKET_REQUEST_WRITE_CHUNK, 7, 14,
+                                                                          bytes);
+
+    if (request == NULL) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_fd(request) != 7 || gnl_socket_request_get_size(request) != 14) {
+        return -1;
+    }
+
+    // the bytes are referenced, not copied
+    if (gnl_socket_request_get_bytes(request) != bytes) {
+        return -1;
+    }
+
+    if (gnl_socket_request_release_bytes(request) != bytes) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    // only the write requests carry bytes
+    request = gnl_socket_request_init_borrowed(GNL_SOCKET_REQUEST_READ, 7, 14, bytes);
+    if (request != NULL || errno != EINVAL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_get_type_write_begin() {
+    GNL_TEST_GET_TYPE(GNL_SOCKET_REQUEST_WRITE_BEGIN, "WRITE_BEGIN");
+}
+
+int can_get_type_write_chunk() {
+    GNL_TEST_GET_TYPE(GNL_SOCKET_REQUEST_WRITE_CHUNK, "WRITE_CHUNK");
+}
+
+int can_get_type_write_end() {
+    GNL_TEST_GET_TYPE(GNL_SOCKET_REQUEST_WRITE_END, "WRITE_END");
+}
+
+int can_get_type_read_stream() {
+    GNL_TEST_GET_TYPE(GNL_SOCKET_REQUEST_READ_STREAM, "READ_STREAM");
+}
+
+int can_get_n() {
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_READ_N, 1, 5);
+
+    if (request == NULL) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_n(request) != 5) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    // only the read N requests carry a number of files
+    request = gnl_socket_request_init(GNL_SOCKET_REQUEST_CLOSE, 1, 5);
+    if (request == NULL) {
+        return -1;
+    }
+
+    errno = 0;
+    if (gnl_socket_request_get_n(request) != -1 || errno != EINVAL) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    return 0;
+}
+
+int can_set_the_id() {
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_CLOSE, 1, 15);
+
+    if (request == NULL) {
+        return -1;
+    }
+
+    // a new request has no id
+    if (gnl_socket_request_get_id(request) != 0) {
+        return -1;
+    }
+
+    if (gnl_socket_request_set_id(request, 42) != 0) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_id(request) != 42) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_socket_request test:\n\n");
 
@@ -832,6 +995,26 @@ int main() {
     gnl_assert(can_from_string_remove, "can create from string a GNL_SOCKET_REQUEST_REMOVE request type message.");
     gnl_assert(can_to_string_remove, "can format to string a GNL_SOCKET_REQUEST_REMOVE request type.");
 
+    gnl_assert(can_init_empty_write_begin, "can init an empty GNL_SOCKET_REQUEST_WRITE_BEGIN request type.");
+    gnl_assert(can_init_args_write_begin, "can init a GNL_SOCKET_REQUEST_WRITE_BEGIN request type with args.");
+    gnl_assert(can_from_string_write_begin, "can create from string a GNL_SOCKET_REQUEST_WRITE_BEGIN request type message.");
+    gnl_assert(can_to_string_write_begin, "can format to string a GNL_SOCKET_REQUEST_WRITE_BEGIN request type.");
+
+    gnl_assert(can_init_args_write_chunk, "can init a GNL_SOCKET_REQUEST_WRITE_CHUNK request type with args.");
+    gnl_assert(can_from_string_write_chunk, "can create from string a GNL_SOCKET_REQUEST_WRITE_CHUNK request type message.");
+    gnl_assert(can_to_string_write_chunk, "can format to string a GNL_SOCKET_REQUEST_WRITE_CHUNK request type.");
+    gnl_assert(can_init_borrowed_write_chunk, "can init a GNL_SOCKET_REQUEST_WRITE_CHUNK request type borrowing its bytes.");
+
+    gnl_assert(can_init_empty_write_end, "can init an empty GNL_SOCKET_REQUEST_WRITE_END request type.");
+    gnl_assert(can_init_args_write_end, "can init a GNL_SOCKET_REQUEST_WRITE_END request type with args.");
+    gnl_assert(can_from_string_write_end, "can create from string a GNL_SOCKET_REQUEST_WRITE_END request type message.");
+    gnl_assert(can_to_string_write_end, "can format to string a GNL_SOCKET_REQUEST_WRITE_END request type.");
+
+    gnl_assert(can_init_empty_read_stream, "can init an empty GNL_SOCKET_REQUEST_READ_STREAM request type.");
+    gnl_assert(can_init_args_read_stream, "can init a GNL_SOCKET_REQUEST_READ_STREAM request type with args.");
+    gnl_assert(can_from_string_read_stream, "can create from string a GNL_SOCKET_REQUEST_READ_STREAM request type message.");
+    gnl_assert(can_to_string_read_stream, "can format to string a GNL_SOCKET_REQUEST_READ_STREAM request type.");
+
     gnl_assert(can_not_write_empty_request, "can not write an empty request");
     gnl_assert(can_not_write_not_empty_dest, "can not write into a not empty destination");
 
@@ -843,6 +1026,13 @@ int main() {
     gnl_assert(can_get_type_unlock, "can get the type string of a GNL_SOCKET_REQUEST_UNLOCK request type");
     gnl_assert(can_get_type_close, "can get the type string of a GNL_SOCKET_REQUEST_CLOSE request type");
     gnl_assert(can_get_type_remove, "can get the type string of a GNL_SOCKET_REQUEST_REMOVE request type");
+    gnl_assert(can_get_type_write_begin, "can get the type string of a GNL_SOCKET_REQUEST_WRITE_BEGIN request type");
+    gnl_assert(can_get_type_write_chunk, "can get the type string of a GNL_SOCKET_REQUEST_WRITE_CHUNK request type");
+    gnl_assert(can_get_type_write_end, "can get the type string of a GNL_SOCKET_REQUEST_WRITE_END request type");
+    gnl_assert(can_get_type_read_stream, "can get the type string of a GNL_SOCKET_REQUEST_READ_STREAM request type");
+
+    gnl_assert(can_get_n, "can get the number of files of a GNL_SOCKET_REQUEST_READ_N request");
+    gnl_assert(can_set_the_id, "can set and get the id of a request");
 
     // the gnl_socket_request_destroy method is implicitly tested in every assertion
 
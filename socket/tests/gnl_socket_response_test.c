@@ -555,6 +555,73 @@ int can_get_type_error() {
     GNL_TEST_TO_STRING(GNL_SOCKET_RESPONSE_ERROR, "ERROR");
 }
 
+int can_get_type_ok_chunk() {
+    GNL_TEST_TO_STRING(GNL_SOCKET_RESPONSE_OK_CHUNK, "OK_CHUNK");
+}
+
+int can_init_args_ok_chunk() {
+    char content[] = "a chunk of a file";
+    struct gnl_socket_response *response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_CHUNK, 3, "./testfile.txt", 17, content);
+
+    if (response == NULL) {
+        return -1;
+    }
+
+    if (response->type != GNL_SOCKET_RESPONSE_OK_CHUNK) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_size(response) != 17) {
+        return -1;
+    }
+
+    if (memcmp(gnl_socket_response_get_bytes(response), content, 17) != 0) {
+        return -1;
+    }
+
+    // the chunk is framed like a file
+    char *dest = NULL;
+    struct iovec iov[2];
+    int res = gnl_socket_response_to_iovec(response, &dest, iov);
+    if (res != 2) {
+        return -1;
+    }
+
+    if (iov[1].iov_len != 17 || memcmp(iov[1].iov_base, content, 17) != 0) {
+        return -1;
+    }
+
+    free(dest);
+    gnl_socket_response_destroy(response);
+
+    return 0;
+}
+
+int can_set_the_id() {
+    struct gnl_socket_response *response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK, 0);
+
+    if (response == NULL) {
+        return -1;
+    }
+
+    // a new response has no id
+    if (gnl_socket_response_get_id(response) != 0) {
+        return -1;
+    }
+
+    if (gnl_socket_response_set_id(response, 42) != 0) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_id(response) != 42) {
+        return -1;
+    }
+
+    gnl_socket_response_destroy(response);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_socket_response test:\n\n");
 
@@ -590,6 +657,11 @@ int main() {
     gnl_assert(can_get_type_ok_fd, "can get the type string of a GNL_SOCKET_RESPONSE_OK_FD response type");
     gnl_assert(can_get_type_ok, "can get the type string of a GNL_SOCKET_RESPONSE_OK response type");
     gnl_assert(can_get_type_error, "can get the type string of a GNL_SOCKET_RESPONSE_ERROR response type");
+    gnl_assert(can_get_type_ok_chunk, "can get the type string of a GNL_SOCKET_RESPONSE_OK_CHUNK response type");
+
+    gnl_assert(can_init_args_ok_chunk, "can init a GNL_SOCKET_RESPONSE_OK_CHUNK response type with args.");
+
+    gnl_assert(can_set_the_id, "can set and get the id of a response");
 
     // the gnl_socket_response_destroy method is implicitly tested in every assertion
 
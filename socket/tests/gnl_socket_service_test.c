@@ -201,6 +201,517 @@ int can_not_readn() {
     return !res;
 }
 
+/**
+ * Send a GNL_SOCKET_REQUEST_CLOSE request framed with the given protocol version
+ * through a socket pair, then get it from the other end.
+ *
+ * @param version   The protocol version to use.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int send_and_get_request(int version) {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = version;
+
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_CLOSE, 1, 15);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    gnl_socket_request_set_id(request, 42);
+
+    res = gnl_socket_service_send_request(&pair_connection, request);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_request_destroy(request);
+
+    request = gnl_socket_service_get_request(sv[1]);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    if (gnl_socket_request_type(request) != GNL_SOCKET_REQUEST_CLOSE) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_fd(request) != 15) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_id(request) != 42) {
+        return -1;
+    }
+
+    // the framing is recognized by the receiver
+    if (gnl_socket_request_get_version(request) != version) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+int can_send_and_get_a_request_v1() {
+    return send_and_get_request(GNL_SOCKET_PROTOCOL_V1);
+}
+
+int can_send_and_get_a_request_v2() {
+    return send_and_get_request(GNL_SOCKET_PROTOCOL_V2);
+}
+
+int can_send_and_get_a_response_v2() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = GNL_SOCKET_PROTOCOL_V2;
+
+    struct gnl_socket_response *response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_FD, 1, 7);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    gnl_socket_response_set_id(response, 42);
+    gnl_socket_response_set_version(response, GNL_SOCKET_PROTOCOL_V2);
+
+    res = gnl_socket_service_send_response(sv[1], response);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_response_destroy(response);
+
+    response = gnl_socket_service_get_response(&pair_connection);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    if (gnl_socket_response_type(response) != GNL_SOCKET_RESPONSE_OK_FD) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_fd(response) != 7) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_id(response) != 42) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_version(response) != GNL_SOCKET_PROTOCOL_V2) {
+        return -1;
+    }
+
+    gnl_socket_response_destroy(response);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+/**
+ * Send a write (or write chunk) request through a socket pair with the
+ * given protocol version, then get it back from the other end.
+ *
+ * @param version   The protocol version of the framing.
+ * @param type      The type of the request.
+ *
+ * @return          Returns 0 on success, -1 otherwise.
+ */
+static int send_and_get_write_request(int version, enum gnl_socket_request_type type) {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = version;
+
+    // large enough to be written and read in more than one go
+    size_t count = 32768;
+    char *bytes;
+    GNL_CALLOC(bytes, count, -1)
+
+    for (size_t i=0; i<count; i++) {
+        bytes[i] = (char)(i % 251);
+    }
+
+    struct gnl_socket_request *request = gnl_socket_request_init(type, 3, 15, count, bytes);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    res = gnl_socket_service_send_request(&pair_connection, request);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_request_destroy(request);
+
+    request = gnl_socket_service_get_request(sv[1]);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    if (gnl_socket_request_type(request) != type) {
+        return -1;
+    }
+
+    if (gnl_socket_request_get_fd(request) != 15 || gnl_socket_request_get_size(request) != count) {
+        return -1;
+    }
+
+    if (memcmp(gnl_socket_request_get_bytes(request), bytes, count) != 0) {
+        return -1;
+    }
+
+    // the received bytes can be handed over
+    void *received = gnl_socket_request_release_bytes(request);
+    if (received == NULL || gnl_socket_request_get_bytes(request) != NULL) {
+        return -1;
+    }
+
+    free(received);
+    free(bytes);
+    gnl_socket_request_destroy(request);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+int can_send_and_get_a_write_request() {
+    int res = send_and_get_write_request(GNL_SOCKET_PROTOCOL_V1, GNL_SOCKET_REQUEST_WRITE);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    return send_and_get_write_request(GNL_SOCKET_PROTOCOL_V2, GNL_SOCKET_REQUEST_WRITE);
+}
+
+int can_send_and_get_a_write_chunk_request() {
+    return send_and_get_write_request(GNL_SOCKET_PROTOCOL_V2, GNL_SOCKET_REQUEST_WRITE_CHUNK);
+}
+
+int can_not_get_an_oversized_write_chunk_request() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // only the header is sent, the chunk must be refused before reading it
+    struct protocol_header header;
+    header.version = GNL_SOCKET_PROTOCOL_V2;
+    header.type = GNL_SOCKET_REQUEST_WRITE_CHUNK;
+    header.flags = 0;
+    header.id = 1;
+    header.length = GNL_MESSAGE_NNB_METADATA_SIZE + GNL_SOCKET_REQUEST_MAX_CHUNK_SIZE + 1;
+
+    // the size of a protocol v2 header
+    unsigned char encoded[18];
+    encode_protocol_v2_header(&header, encoded);
+
+    ssize_t nwrite = gnl_socket_service_writen(sv[0], encoded, 18);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    close(sv[0]);
+
+    struct gnl_socket_request *request = gnl_socket_service_get_request(sv[1]);
+
+    close(sv[1]);
+
+    if (request != NULL) {
+        return -1;
+    }
+
+    if (errno != EMSGSIZE) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_not_get_an_oversized_write_request() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // only the header is sent, the write must be refused before reading it
+    struct protocol_header header;
+    header.version = GNL_SOCKET_PROTOCOL_V2;
+    header.type = GNL_SOCKET_REQUEST_WRITE;
+    header.flags = 0;
+    header.id = 1;
+    header.length = GNL_MESSAGE_NNB_METADATA_SIZE + GNL_SOCKET_REQUEST_MAX_WRITE_SIZE + 1;
+
+    // the size of a protocol v2 header
+    unsigned char encoded[18];
+    encode_protocol_v2_header(&header, encoded);
+
+    ssize_t nwrite = gnl_socket_service_writen(sv[0], encoded, 18);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    close(sv[0]);
+
+    struct gnl_socket_request *request = gnl_socket_service_get_request(sv[1]);
+
+    close(sv[1]);
+
+    if (request != NULL) {
+        return -1;
+    }
+
+    if (errno != EMSGSIZE) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_skip_a_malformed_write_request() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = GNL_SOCKET_PROTOCOL_V2;
+
+    // a write whose payload is too short to hold its metadata
+    struct protocol_header header;
+    header.version = GNL_SOCKET_PROTOCOL_V2;
+    header.type = GNL_SOCKET_REQUEST_WRITE;
+    header.flags = 0;
+    header.id = 1;
+    header.length = 10;
+
+    // the size of a protocol v2 header
+    unsigned char encoded[18];
+    encode_protocol_v2_header(&header, encoded);
+
+    ssize_t nwrite = gnl_socket_service_writen(sv[0], encoded, 18);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    nwrite = gnl_socket_service_writen(sv[0], "0123456789", 10);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    // followed by a valid request
+    struct gnl_socket_request *request = gnl_socket_request_init(GNL_SOCKET_REQUEST_CLOSE, 1, 7);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    res = gnl_socket_service_send_request(&pair_connection, request);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_request_destroy(request);
+
+    request = gnl_socket_service_get_request(sv[1]);
+    if (request != NULL || errno != EBADMSG) {
+        return -1;
+    }
+
+    // the payload of the malformed write is skipped
+    request = gnl_socket_service_get_request(sv[1]);
+    GNL_NULL_CHECK(request, errno, -1)
+
+    if (gnl_socket_request_type(request) != GNL_SOCKET_REQUEST_CLOSE || gnl_socket_request_get_fd(request) != 7) {
+        return -1;
+    }
+
+    gnl_socket_request_destroy(request);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+int can_send_and_get_a_file_response() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = GNL_SOCKET_PROTOCOL_V2;
+
+    size_t count = 32768;
+    char *bytes;
+    GNL_CALLOC(bytes, count, -1)
+
+    for (size_t i=0; i<count; i++) {
+        bytes[i] = (char)(i % 251);
+    }
+
+    struct gnl_socket_response *response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_OK_FILE, 3, "/file", count,
+                                                                     bytes);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    gnl_socket_response_set_version(response, GNL_SOCKET_PROTOCOL_V2);
+
+    res = gnl_socket_service_send_response(sv[1], response);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_response_destroy(response);
+
+    response = gnl_socket_service_get_response(&pair_connection);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    if (gnl_socket_response_type(response) != GNL_SOCKET_RESPONSE_OK_FILE) {
+        return -1;
+    }
+
+    if (gnl_socket_response_get_size(response) != count) {
+        return -1;
+    }
+
+    if (memcmp(gnl_socket_response_get_bytes(response), bytes, count) != 0) {
+        return -1;
+    }
+
+    free(bytes);
+    gnl_socket_response_destroy(response);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+int can_use_a_short_header_v2() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct protocol_header header;
+    header.type = GNL_SOCKET_REQUEST_CLOSE;
+    header.flags = 0;
+    header.id = 1;
+    header.length = 0;
+
+    header.version = GNL_SOCKET_PROTOCOL_V1;
+    size_t v1_len = write_protocol_message(sv[0], &header, NULL, 0);
+
+    header.version = GNL_SOCKET_PROTOCOL_V2;
+    size_t v2_len = write_protocol_message(sv[0], &header, NULL, 0);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    // 3 fields of 10 digits plus the '\0' char against 18 bytes
+    if (v1_len != 31 || v2_len != 18) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_not_get_a_malformed_message() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    // neither a GNL_SOCKET_PROTOCOL_V1 nor a GNL_SOCKET_PROTOCOL_V2 header
+    char garbage[31];
+    memset(garbage, 'x', 31);
+
+    gnl_socket_service_writen(sv[0], garbage, 31);
+
+    struct gnl_socket_request *request = gnl_socket_service_get_request(sv[1]);
+
+    close(sv[0]);
+    close(sv[1]);
+
+    if (request != NULL) {
+        return -1;
+    }
+
+    if (errno != EBADMSG) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int can_negotiate_the_protocol() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = GNL_SOCKET_PROTOCOL_V1;
+
+    // the server side: answer the hello as soon as it arrives,
+    // the socket pair buffers the answer in the meantime
+    size_t nwrite = write_hello_message(sv[1], GNL_SOCKET_PROTOCOL_V2);
+    GNL_MINUS1_CHECK(nwrite, errno, -1)
+
+    res = gnl_socket_service_negotiate(&pair_connection);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    if (pair_connection.version != GNL_SOCKET_PROTOCOL_V2) {
+        return -1;
+    }
+
+    // the hello sent by the client is answered by the server, without a request
+    struct gnl_socket_request *request = gnl_socket_service_get_request(sv[1]);
+    if (request != NULL || errno != EAGAIN) {
+        return -1;
+    }
+
+    struct protocol_header header;
+    char *message = NULL;
+
+    size_t nread = read_protocol_message(sv[0], &header, &message);
+    if (nread != 18 || header.flags == 0 || header.version != GNL_SOCKET_PROTOCOL_V2) {
+        return -1;
+    }
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
+int can_fall_back_to_the_protocol_v1() {
+    int sv[2];
+    int res = socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    struct gnl_socket_connection pair_connection;
+    pair_connection.fd = sv[0];
+    pair_connection.socket_name = NULL;
+    pair_connection.active = 1;
+    pair_connection.version = GNL_SOCKET_PROTOCOL_V1;
+
+    // a server not speaking the GNL_SOCKET_PROTOCOL_V2 answers with an error
+    struct gnl_socket_response *response = gnl_socket_response_init(GNL_SOCKET_RESPONSE_ERROR, 1, EBADMSG);
+    GNL_NULL_CHECK(response, errno, -1)
+
+    res = gnl_socket_service_send_response(sv[1], response);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    gnl_socket_response_destroy(response);
+
+    res = gnl_socket_service_negotiate(&pair_connection);
+    GNL_MINUS1_CHECK(res, errno, -1)
+
+    if (pair_connection.version != GNL_SOCKET_PROTOCOL_V1) {
+        return -1;
+    }
+
+    close(sv[0]);
+    close(sv[1]);
+
+    return 0;
+}
+
 int main() {
     gnl_printf_yellow("> gnl_socket_service test:\n\n");
 
@@ -220,6 +731,21 @@ int main() {
     gnl_assert(can_readn, "can read N bytes from a socket.");
     gnl_assert(can_not_readn, "can not read N bytes from a not open file descriptor.");
 
+    // protocol
+    gnl_assert(can_send_and_get_a_request_v1, "can send and get a request with the protocol v1 framing.");
+    gnl_assert(can_send_and_get_a_request_v2, "can send and get a request with the protocol v2 framing.");
+    gnl_assert(can_send_and_get_a_response_v2, "can send and get a response with the protocol v2 framing.");
+    gnl_assert(can_send_and_get_a_write_request, "can send and get a write request without copying its bytes.");
+    gnl_assert(can_send_and_get_a_file_response, "can send and get a file response without copying its bytes.");
+    gnl_assert(can_send_and_get_a_write_chunk_request, "can send and get a write chunk request.");
+    gnl_assert(can_not_get_an_oversized_write_chunk_request, "can not get a write chunk request bigger than the max chunk size.");
+    gnl_assert(can_not_get_an_oversized_write_request, "can not get a write request bigger than the max write size.");
+    gnl_assert(can_skip_a_malformed_write_request, "can skip the payload of a malformed write request.");
+    gnl_assert(can_use_a_short_header_v2, "can frame a message with a shorter header with the protocol v2.");
+    gnl_assert(can_not_get_a_malformed_message, "can not get a message with a malformed header.");
+    gnl_assert(can_negotiate_the_protocol, "can negotiate the protocol v2 with a server.");
+    gnl_assert(can_fall_back_to_the_protocol_v1, "can fall back to the protocol v1 if the server does not speak the v2.");
+
     printf("\n");
 }
 
@@ -0,0 +1,82 @@
+#!/bin/bash
+
+SCRIPTPATH="$( cd -- "$(dirname "$0")" >/dev/null 2>&1 || exit; pwd -P )"
+
+# the policies to compare, each one with its own configuration file
+POLICIES="${POLICIES:-fifo lru lfu arc 2q wtinylfu gdsf}"
+
+# the workload: a hot set of small files read on every round, mixed
+# with a one-shot scan of big files, bigger than the capacity, written
+# and never read again: the hit ratio is the one of the hot set
+ROUNDS=5
+HOT_FILES=16
+HOT_SIZE=15000
+SCAN_FILES=40
+SCAN_SIZE=30000
+
+DATASET=/tmp/gnl_fss_policy_comparison_test
+SOCKET=/tmp/LSOfilestorage_policy_comparison_test.sk
+
+# change directory to the client directory
+cd ../client/ || exit 1
+
+# generate the dataset
+rm -rf $DATASET
+mkdir -p $DATASET
+
+for COUNTER in $(seq 1 $HOT_FILES)
+do
+head -c $HOT_SIZE /dev/urandom > $DATASET/hot$COUNTER.bin
+done
+
+for ROUND in $(seq 1 $ROUNDS)
+do
+for COUNTER in $(seq 1 $SCAN_FILES)
+do
+head -c $SCAN_SIZE /dev/urandom > $DATASET/scan$ROUND-$COUNTER.bin
+done
+done
+
+# read a file, writing it again on a miss as a cache would do
+read_file() {
+    if ./main -f $SOCKET -p -r "$1" 2>/dev/null | grep -q "Open file.*KO"; then
+        ./main -f $SOCKET -W "$1" 2>/dev/null
+    fi
+}
+
+for POLICY in $POLICIES
+do
+    # run the server with the policy under test
+    ../server/main -f $SCRIPTPATH/config-policy-comparison-test-$POLICY.txt > $DATASET/status-$POLICY.txt &
+    SERVER_PID=$!
+    sleep 1
+
+    # write the hot set
+    for COUNTER in $(seq 1 $HOT_FILES)
+    do
+    ./main -f $SOCKET -W $DATASET/hot$COUNTER.bin
+    done
+
+    for ROUND in $(seq 1 $ROUNDS)
+    do
+        # read the hot set
+        for COUNTER in $(seq 1 $HOT_FILES)
+        do
+        read_file $DATASET/hot$COUNTER.bin
+        done
+
+        # scan files never accessed again
+        for COUNTER in $(seq 1 $SCAN_FILES)
+        do
+        ./main -f $SOCKET -W $DATASET/scan$ROUND-$COUNTER.bin 2>/dev/null
+        done
+    done
+
+    # stop the server, it prints its status at exit
+    kill -HUP $SERVER_PID
+    wait $SERVER_PID
+
+    echo "$POLICY: $(grep "Hit ratio" $DATASET/status-$POLICY.txt)"
+done
+
+rm -rf $DATASET
@@ -0,0 +1,51 @@
+#!/bin/bash
+
+SCRIPTPATH="$( cd -- "$(dirname "$0")" >/dev/null 2>&1 || exit; pwd -P )"
+
+# the socket of the server under test
+SOCKET=/tmp/LSOfilestorage_reactor_lock_test.sk
+
+# the file opened and locked by both clients
+FILE=$SCRIPTPATH/dataset/generic/meme.jpg
+
+# the max time in seconds a client can take before it is considered stuck
+TIMEOUT_SECS=30
+
+# change directory to the client directory
+cd ../client/ || exit 1
+
+# store the file
+./main -f $SOCKET -p -W $FILE
+
+# run client 1 and 2 (-l): both open the file and, after 1 second, lock it. Client 2 starts
+# 300 milliseconds later, so the lock of client 1 arrives while client 2 has the file open;
+# both clients are handled by the only reactor of the server, which must not block on the lock
+timeout $TIMEOUT_SECS ./main -f $SOCKET -p -t 1000 -l $FILE > /tmp/gnl_reactor_lock_test_client_1.txt &
+CLIENT_1_PID=$!
+
+sleep 0.3
+
+timeout $TIMEOUT_SECS ./main -f $SOCKET -p -t 1000 -l $FILE > /tmp/gnl_reactor_lock_test_client_2.txt &
+CLIENT_2_PID=$!
+
+wait $CLIENT_1_PID
+CLIENT_1_RES=$?
+
+wait $CLIENT_2_PID
+CLIENT_2_RES=$?
+
+cat /tmp/gnl_reactor_lock_test_client_1.txt /tmp/gnl_reactor_lock_test_client_2.txt
+
+# timeout exits with 124 if the client was stuck
+if [ $CLIENT_1_RES -eq 124 ] || [ $CLIENT_2_RES -eq 124 ]; then
+    echo "Reactor lock test failed: a client was stuck for more than $TIMEOUT_SECS seconds"
+    exit 1
+fi
+
+# client 1 waited for client 2 to close the file, then it locked it
+if ! grep -A2 "Operation: Lock file" /tmp/gnl_reactor_lock_test_client_1.txt | grep -q "Status: OK"; then
+    echo "Reactor lock test failed: client 1 could not lock the file"
+    exit 1
+fi
+
+echo "Reactor lock test passed"